@@ -0,0 +1,138 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+#ifndef _KOKKOSKERNELS_MAPPEDFILE_HPP
+#define _KOKKOSKERNELS_MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define KOKKOSKERNELS_IMPL_HAVE_MMAP
+#endif
+
+namespace KokkosKernels {
+namespace Impl {
+
+/// \brief Read-only, contiguous view of the whole content of a file.
+///
+/// The file is memory-mapped where mmap is available (POSIX), so that only
+/// the touched pages are read from disk. Elsewhere, the file is read into a
+/// heap buffer. Either way, data() stays valid until close() or destruction.
+///
+/// When opened with copy_on_write, the pages can also be modified through
+/// mutable_data(): the changes are private to the process and never written
+/// back to the file.
+class MappedFile {
+ public:
+  MappedFile() : ptr(nullptr), nbytes(0), mapped(false), writable(false) {}
+
+  explicit MappedFile(const std::string &filename, bool copy_on_write = false)
+      : MappedFile() {
+    open(filename, copy_on_write);
+  }
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  ~MappedFile() { close(); }
+
+  void open(const std::string &filename, bool copy_on_write = false) {
+    close();
+    writable = copy_on_write;
+#ifdef KOKKOSKERNELS_IMPL_HAVE_MMAP
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("MappedFile: cannot open " + filename);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      ::close(fd);
+      throw std::runtime_error("MappedFile: cannot stat " + filename);
+    }
+    nbytes = static_cast<size_t>(st.st_size);
+    if (nbytes > 0) {
+      const int prot = copy_on_write ? PROT_READ | PROT_WRITE : PROT_READ;
+      void *addr     = ::mmap(nullptr, nbytes, prot, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED) {
+        // the file is (usually) read front to back
+        ::madvise(addr, nbytes, MADV_SEQUENTIAL);
+        ptr    = static_cast<const char *>(addr);
+        mapped = true;
+      }
+    }
+    ::close(fd);
+    if (nbytes == 0 || mapped) return;
+#endif
+    // fall back to reading the whole file
+    std::ifstream is(filename, std::ios::in | std::ios::binary);
+    if (!is) {
+      throw std::runtime_error("MappedFile: cannot open " + filename);
+    }
+    is.seekg(0, std::ios::end);
+    nbytes = static_cast<size_t>(is.tellg());
+    is.seekg(0, std::ios::beg);
+    buffer.resize(nbytes);
+    if (nbytes > 0 && !is.read(buffer.data(), nbytes)) {
+      throw std::runtime_error("MappedFile: cannot read " + filename);
+    }
+    ptr = buffer.data();
+  }
+
+  void close() {
+#ifdef KOKKOSKERNELS_IMPL_HAVE_MMAP
+    if (mapped) {
+      ::munmap(const_cast<char *>(ptr), nbytes);
+    }
+#endif
+    buffer.clear();
+    buffer.shrink_to_fit();
+    ptr      = nullptr;
+    nbytes   = 0;
+    mapped   = false;
+    writable = false;
+  }
+
+  const char *data() const { return ptr; }
+  char *mutable_data() {
+    if (!writable) {
+      throw std::runtime_error(
+          "MappedFile: mutable_data() requires a copy-on-write mapping");
+    }
+    return const_cast<char *>(ptr);
+  }
+  size_t size() const { return nbytes; }
+  bool is_mapped() const { return mapped; }
+
+ private:
+  const char *ptr;
+  size_t nbytes;
+  bool mapped;
+  bool writable;
+  std::vector<char> buffer;
+};
+
+}  // namespace Impl
+}  // namespace KokkosKernels
+
+#endif  // _KOKKOSKERNELS_MAPPEDFILE_HPP
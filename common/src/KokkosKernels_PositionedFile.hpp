@@ -0,0 +1,136 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+#ifndef _KOKKOSKERNELS_POSITIONEDFILE_HPP
+#define _KOKKOSKERNELS_POSITIONEDFILE_HPP
+
+#include <cstddef>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define KOKKOSKERNELS_IMPL_HAVE_PWRITE
+#endif
+
+namespace KokkosKernels {
+namespace Impl {
+
+/// \brief Output file written at explicit offsets.
+///
+/// write_at() can be called concurrently from several threads, as long as
+/// the written ranges do not overlap: it uses pwrite where available
+/// (POSIX), and a locked stream elsewhere. The file is created, or
+/// truncated, by open().
+class PositionedFile {
+ public:
+  PositionedFile() = default;
+
+  explicit PositionedFile(const std::string &filename) { open(filename); }
+
+  PositionedFile(const PositionedFile &) = delete;
+  PositionedFile &operator=(const PositionedFile &) = delete;
+
+  ~PositionedFile() { close(); }
+
+  void open(const std::string &filename) {
+    close();
+    name = filename;
+#ifdef KOKKOSKERNELS_IMPL_HAVE_PWRITE
+    fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+      throw std::runtime_error("PositionedFile: cannot open " + filename);
+    }
+#else
+    os.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!os) {
+      throw std::runtime_error("PositionedFile: cannot open " + filename);
+    }
+#endif
+  }
+
+  /// Reserves space for the first bytes of the file, so that the writes do
+  /// not have to extend it. This is only a hint: failures are ignored.
+  void preallocate(size_t bytes) {
+#if defined(KOKKOSKERNELS_IMPL_HAVE_PWRITE) && defined(__linux__)
+    if (fd >= 0 && bytes > 0) (void)::posix_fallocate(fd, 0, bytes);
+#else
+    (void)bytes;
+#endif
+  }
+
+  void write_at(size_t offset, const void *data, size_t bytes) {
+    const char *src = static_cast<const char *>(data);
+#ifdef KOKKOSKERNELS_IMPL_HAVE_PWRITE
+    while (bytes > 0) {
+      const ssize_t n = ::pwrite(fd, src, bytes, offset);
+      if (n < 0) {
+        if (errno == EINTR) continue;
+        throw std::runtime_error("PositionedFile: failed to write " + name);
+      }
+      src += n;
+      offset += n;
+      bytes -= n;
+    }
+#else
+    std::lock_guard<std::mutex> lock(mutex);
+    os.seekp(offset);
+    os.write(src, bytes);
+    if (!os) {
+      throw std::runtime_error("PositionedFile: failed to write " + name);
+    }
+#endif
+  }
+
+  /// Sets the size of the file (e.g. after preallocate())
+  void truncate(size_t bytes) {
+#ifdef KOKKOSKERNELS_IMPL_HAVE_PWRITE
+    if (::ftruncate(fd, bytes) != 0) {
+      throw std::runtime_error("PositionedFile: cannot resize " + name);
+    }
+#else
+    // streams cannot shrink a file, it is never preallocated
+    (void)bytes;
+#endif
+  }
+
+  void close() {
+#ifdef KOKKOSKERNELS_IMPL_HAVE_PWRITE
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+#else
+    if (os.is_open()) os.close();
+#endif
+  }
+
+ private:
+  std::string name;
+#ifdef KOKKOSKERNELS_IMPL_HAVE_PWRITE
+  int fd = -1;
+#else
+  std::ofstream os;
+  std::mutex mutex;
+#endif
+};
+
+}  // namespace Impl
+}  // namespace KokkosKernels
+
+#endif  // _KOKKOSKERNELS_POSITIONEDFILE_HPP
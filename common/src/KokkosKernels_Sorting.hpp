@@ -44,6 +44,14 @@ template <
     typename Comparator = Impl::DefaultComparator<typename View::value_type>>
 void bitonicSort(View v, const Comparator& comp = Comparator());
 
+// Radix sort: sorts keys (unsigned integers) on all the threads of exec, and
+// permutes perm along with them (unless perm is empty). Stable. Not in-place:
+// requires scratch views keysAux and permAux of the same length as keys.
+template <typename ExecSpace, typename KeyView, typename PermView>
+void radixSort2(const ExecSpace& exec, const KeyView& keys,
+                const PermView& perm, const KeyView& keysAux,
+                const PermView& permAux);
+
 // --------------------------------------------------------
 // Serial sorting (callable inside any kernel or host code)
 // --------------------------------------------------------
@@ -268,6 +276,110 @@ void bitonicSort(View v, const Comparator& comp) {
   }
 }
 
+namespace Impl {
+
+// Counts the keys of every block in every bucket of the current digit.
+// hist is bucket-major, so that its prefix sum gives the first position of
+// every (bucket, block) pair in the output.
+template <typename KeyView, typename HistView>
+struct RadixHistogramFunctor {
+  KeyView keys;
+  HistView hist;
+  size_t blockSize, numBlocks;
+  int shift;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const size_t b) const {
+    for (size_t d = 0; d < 256; d++) hist(d * numBlocks + b) = 0;
+    const size_t end = Kokkos::min(keys.extent(0), (b + 1) * blockSize);
+    for (size_t i = b * blockSize; i < end; i++) {
+      hist(((keys(i) >> shift) & 0xFF) * numBlocks + b)++;
+    }
+  }
+};
+
+// Moves the keys of every block, in order, to their position in the output.
+template <typename KeyView, typename PermView, typename HistView>
+struct RadixScatterFunctor {
+  KeyView keys, keysOut;
+  PermView perm, permOut;
+  HistView hist;
+  size_t blockSize, numBlocks;
+  int shift;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const size_t b) const {
+    const size_t end = Kokkos::min(keys.extent(0), (b + 1) * blockSize);
+    for (size_t i = b * blockSize; i < end; i++) {
+      const size_t pos = hist(((keys(i) >> shift) & 0xFF) * numBlocks + b)++;
+      keysOut(pos)     = keys(i);
+      if (perm.extent(0)) permOut(pos) = perm(i);
+    }
+  }
+};
+
+}  // namespace Impl
+
+// Least significant digit radix sort, 8 bits at a time. Each thread counts
+// and then scatters a contiguous block of the keys, so that the sort is
+// stable. Pros: O(n) work and parallel over the whole array, so suited to a
+// single very long array. Con: requires auxiliary storage, and this version
+// only works for integers.
+template <typename ExecSpace, typename KeyView, typename PermView>
+void radixSort2(const ExecSpace& exec, const KeyView& keys,
+                const PermView& perm, const KeyView& keysAux,
+                const PermView& permAux) {
+  using key_t = typename KeyView::non_const_value_type;
+  static_assert(
+      std::is_integral<key_t>::value && std::is_unsigned<key_t>::value,
+      "radixSort2 can only be run on unsigned integers.");
+  using range_t  = Kokkos::RangePolicy<ExecSpace>;
+  using hist_t   = Kokkos::View<size_t*, typename ExecSpace::memory_space>;
+  const size_t n = keys.extent(0);
+  if (n <= 1) return;
+  key_t maxVal = 0;
+  Kokkos::parallel_reduce(
+      "KokkosKernels::radixSort2::max", range_t(exec, 0, n),
+      KOKKOS_LAMBDA(const size_t i, key_t& lmax) {
+        if (lmax < keys(i)) lmax = keys(i);
+      },
+      Kokkos::Max<key_t>(maxVal));
+  int passes = 0;
+  while (maxVal) {
+    maxVal >>= 8;
+    passes++;
+  }
+  const size_t concurrency = Kokkos::max<size_t>(1, exec.concurrency());
+  const size_t blockSize =
+      Kokkos::max<size_t>(1024, (n + concurrency - 1) / concurrency);
+  const size_t numBlocks = (n + blockSize - 1) / blockSize;
+  hist_t hist(Kokkos::view_alloc(exec, Kokkos::WithoutInitializing,
+                                 "radixSort2 histogram"),
+              256 * numBlocks);
+  // the data alternates between (keys, perm) and (keysAux, permAux)
+  for (int p = 0; p < passes; p++) {
+    const bool inAux     = p % 2;
+    const KeyView& src   = inAux ? keysAux : keys;
+    const KeyView& dst   = inAux ? keys : keysAux;
+    const PermView& psrc = inAux ? permAux : perm;
+    const PermView& pdst = inAux ? perm : permAux;
+    Kokkos::parallel_for(
+        "KokkosKernels::radixSort2::histogram", range_t(exec, 0, numBlocks),
+        Impl::RadixHistogramFunctor<KeyView, hist_t>{src, hist, blockSize,
+                                                     numBlocks, 8 * p});
+    KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<ExecSpace>(
+        exec, hist.extent(0), hist);
+    Kokkos::parallel_for(
+        "KokkosKernels::radixSort2::scatter", range_t(exec, 0, numBlocks),
+        Impl::RadixScatterFunctor<KeyView, PermView, hist_t>{
+            src, dst, psrc, pdst, hist, blockSize, numBlocks, 8 * p});
+  }
+  // Move the data back into the main arrays if an odd number of passes was
+  // done
+  if (passes % 2) {
+    Kokkos::deep_copy(exec, keys, keysAux);
+    Kokkos::deep_copy(exec, perm, permAux);
+  }
+}
+
 // Radix sort for integers, on a single thread within a team.
 // Pros: few diverging branches, so OK for sorting on a single GPU vector lane.
 // Better on CPU cores. Con: requires auxiliary storage, and this version only
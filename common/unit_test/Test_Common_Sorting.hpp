@@ -27,7 +27,10 @@
 #include <KokkosKernels_default_types.hpp>
 #include <Kokkos_ArithTraits.hpp>
 #include <Kokkos_Complex.hpp>
+#include <algorithm>
 #include <cstdlib>
+#include <utility>
+#include <vector>
 
 // Generate n randomized counts with mean <avg>.
 // Then prefix-sum into randomOffsets.
@@ -429,6 +432,42 @@ void testBitonicSort(size_t n) {
   ASSERT_TRUE(ordered);
 }
 
+template <typename Device, typename Key>
+void testRadixSort2(size_t n, Key maxKey) {
+  using exec_space = typename Device::execution_space;
+  using mem_space  = typename Device::memory_space;
+  using KeyView    = Kokkos::View<Key*, mem_space>;
+  using PermView   = Kokkos::View<int*, mem_space>;
+  KeyView keys("Radix sort keys", n);
+  KeyView keysAux("Radix sort keys aux", n);
+  PermView perm("Radix sort perm", n);
+  PermView permAux("Radix sort perm aux", n);
+  auto keysHost = Kokkos::create_mirror_view(keys);
+  auto permHost = Kokkos::create_mirror_view(perm);
+  std::vector<std::pair<Key, int>> reference(n);
+  srand(34567);
+  for (size_t i = 0; i < n; i++) {
+    // many duplicates, to check that the sort is stable
+    keysHost(i)  = Key(rand() % (size_t(maxKey) + 1));
+    permHost(i)  = i;
+    reference[i] = std::make_pair(keysHost(i), int(i));
+  }
+  Kokkos::deep_copy(keys, keysHost);
+  Kokkos::deep_copy(perm, permHost);
+  KokkosKernels::radixSort2(exec_space(), keys, perm, keysAux, permAux);
+  std::stable_sort(
+      reference.begin(), reference.end(),
+      [](const std::pair<Key, int>& a, const std::pair<Key, int>& b) {
+        return a.first < b.first;
+      });
+  Kokkos::deep_copy(keysHost, keys);
+  Kokkos::deep_copy(permHost, perm);
+  for (size_t i = 0; i < n; i++) {
+    ASSERT_EQ(keysHost(i), reference[i].first);
+    ASSERT_EQ(permHost(i), reference[i].second);
+  }
+}
+
 // Check that the view is weakly ordered according to Comparator:
 // Comparator never says that element i+1 belongs before element i.
 template <typename View, typename Comparator>
@@ -547,6 +586,15 @@ TEST_F(TestCategory, common_team_bitonic2) {
   }
 }
 
+TEST_F(TestCategory, common_device_radix) {
+  // one, two and three passes of 8 bits
+  testRadixSort2<TestDevice, unsigned>(100000, 200);
+  testRadixSort2<TestDevice, unsigned>(54321, 60000);
+  testRadixSort2<TestDevice, unsigned>(3000, 1000000);
+  testRadixSort2<TestDevice, uint64_t>(250000, 10000000);
+  testRadixSort2<TestDevice, unsigned>(1, 10);
+}
+
 TEST_F(TestCategory, common_device_bitonic) {
   // Test device-level bitonic with some larger arrays
   testBitonicSort<TestDevice, char>(243743);
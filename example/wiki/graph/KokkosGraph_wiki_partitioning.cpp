@@ -0,0 +1,58 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#include "KokkosGraph_wiki_9pt_stencil.hpp"
+#include "KokkosGraph_Partition.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+
+int main() {
+  Kokkos::initialize();
+// graph_partition needs lambdas in Cuda builds, like coarse_builder
+#if !defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_CUDA_LAMBDA)
+  {
+    using Device = Kokkos::Device<ExecSpace, DeviceSpace>;
+    using Matrix =
+        KokkosSparse::CrsMatrix<default_scalar, Ordinal, Device, void, Offset>;
+    using GraphDemo::numVertices;
+    RowmapType rowmapDevice;
+    ColindsType colindsDevice;
+    // Step 1: Generate the graph on host, allocate space on device, and copy.
+    // See function "generate9pt" below.
+    GraphDemo::generate9pt(rowmapDevice, colindsDevice);
+    // Step 2: Give every edge a weight of 1
+    const Offset numEdges = colindsDevice.extent(0);
+    Matrix::values_type::non_const_type weights("Edge weights", numEdges);
+    Kokkos::deep_copy(weights, 1);
+    Matrix graph("Graph", numVertices, numVertices, numEdges, weights,
+                 rowmapDevice, colindsDevice);
+    // Step 3: Partition into 4 parts of at most 3% above the average size,
+    // and print the result
+    {
+      const Ordinal numParts = 4;
+      Kokkos::View<Ordinal*, DeviceSpace> parts;
+      auto cut = KokkosGraph::Experimental::graph_partition(graph, numParts,
+                                                            parts, 0.03);
+      std::cout << "Partition into " << numParts << " parts (edge cut " << cut
+                << "):\n";
+      // part labels can be printed in the same way as colors
+      GraphDemo::printColoring(parts, numParts);
+      putchar('\n');
+    }
+  }
+#endif
+  Kokkos::finalize();
+  return 0;
+}
@@ -19,100 +19,559 @@
 
 #include "Kokkos_Core.hpp"
 #include "KokkosKernels_Utils.hpp"
-#include <vector>
-#include <algorithm>
+#include "KokkosKernels_SimpleUtils.hpp"
+#include "KokkosKernels_Sorting.hpp"
+#include "KokkosGraph_ConnectedComponents_impl.hpp"
+#include <Kokkos_ArithTraits.hpp>
+#include <cstdint>
+#include <utility>
 
 namespace KokkosGraph {
 namespace Experimental {
 namespace Impl {
 
-template <typename rowmap_t, typename entries_t, typename lno_view_t>
-struct SerialRCM {
-  using size_type       = typename rowmap_t::non_const_value_type;
-  using lno_t           = typename entries_t::non_const_value_type;
-  using host_rowmap_t   = Kokkos::View<size_type*, Kokkos::HostSpace>;
-  using host_lno_view_t = Kokkos::View<lno_t*, Kokkos::HostSpace>;
+// Level-synchronous reverse Cuthill-McKee ordering.
+//
+// Every connected component is ordered from a pseudo-peripheral root (George
+// and Liu: repeated BFS from a vertex of minimal degree of the last level,
+// while the number of levels grows), starting from its vertex of minimal
+// degree. The components are found first (see
+// KokkosGraph_ConnectedComponents_impl.hpp), so that the searches of all the
+// components run together, one BFS level at a time, and so does the
+// Cuthill-McKee order, which is built one BFS level at a time:
+//  - every unlabeled neighbor of the frontier gets as parent its frontier
+//    neighbor coming first in the order (atomic_min)
+//  - every frontier vertex counts its children, and a prefix sum gives where
+//    they go in the order
+//  - every frontier vertex sorts its children by degree (then index), and
+//    labels them with their position in the order.
+// Within a component, the levels do not interact with the other components,
+// so a stable sort of the order by component (the components in the order
+// of their vertex of minimal degree) gives the order the serial algorithm
+// produces, with ties between equal degrees broken by index: the labels do
+// not depend on the scheduling.
+template <typename execution_space, typename rowmap_t, typename entries_t,
+          typename lno_view_t>
+struct ParallelRCM {
+  using size_type    = typename rowmap_t::non_const_value_type;
+  using lno_t        = typename entries_t::non_const_value_type;
+  using memory_space = typename lno_view_t::memory_space;
+  using work_view_t  = Kokkos::View<lno_t*, memory_space>;
+  using counter_t    = Kokkos::View<lno_t, memory_space>;
+  using range_t      = Kokkos::RangePolicy<execution_space>;
+  using degree_key_t = uint64_t;
+  using key_view_t   = Kokkos::View<degree_key_t*, memory_space>;
+  using device_t     = Kokkos::Device<execution_space, memory_space>;
+
+  // label values of the vertices being placed in the next level
+  static constexpr lno_t UNLABELED = -1;
+  static constexpr lno_t COUNTED   = -2;
+  static constexpr lno_t PLACED    = -3;
 
+  execution_space exec;
   lno_t numVerts;
-  host_rowmap_t rowmap;
-  host_lno_view_t entries;
+  rowmap_t rowmap;
+  entries_t entries;
+  // position of every vertex in the Cuthill-McKee order, or UNLABELED
+  work_view_t label;
+  // the vertices in Cuthill-McKee order
+  work_view_t order;
+  // position in order of the parent of every vertex of the next level
+  work_view_t parent;
+  // children offsets of the frontier
+  work_view_t offsets;
+  // pseudo-peripheral search: BFS level of every vertex, or -1, and queue
+  work_view_t level;
+  work_view_t queue;
+  counter_t queueTail;
+  // connected component of every vertex
+  work_view_t comp;
+  lno_t numComps;
 
-  SerialRCM(const rowmap_t& rowmap_, const entries_t& entries_)
+  ParallelRCM(const rowmap_t& rowmap_, const entries_t& entries_)
       : numVerts(rowmap_.extent(0) - 1),
-        rowmap(Kokkos::view_alloc(Kokkos::WithoutInitializing, "HostRowmap"),
-               rowmap_.extent(0)),
-        entries(Kokkos::view_alloc(Kokkos::WithoutInitializing, "HostEntries"),
-                entries_.extent(0)) {
-    Kokkos::deep_copy(rowmap, rowmap_);
-    Kokkos::deep_copy(entries, entries_);
+        rowmap(rowmap_),
+        entries(entries_),
+        label(Kokkos::view_alloc(Kokkos::WithoutInitializing, "RCM label"),
+              numVerts),
+        order(Kokkos::view_alloc(Kokkos::WithoutInitializing, "RCM order"),
+              numVerts),
+        parent(Kokkos::view_alloc(Kokkos::WithoutInitializing, "RCM parent"),
+               numVerts),
+        offsets(Kokkos::view_alloc(Kokkos::WithoutInitializing, "RCM offsets"),
+                numVerts),
+        level(Kokkos::view_alloc(Kokkos::WithoutInitializing, "RCM level"),
+              numVerts),
+        queue(Kokkos::view_alloc(Kokkos::WithoutInitializing, "RCM queue"),
+              numVerts),
+        queueTail("RCM queue tail") {}
+
+  KOKKOS_INLINE_FUNCTION static lno_t degree(const rowmap_t& rowmap,
+                                             const lno_t v) {
+    return rowmap(v + 1) - rowmap(v);
+  }
+
+  // degree * numVerts + v, the degree capped at numVerts - 1
+  KOKKOS_INLINE_FUNCTION static degree_key_t degreeKey(const rowmap_t& rowmap,
+                                                       const lno_t v,
+                                                       const lno_t numVerts) {
+    lno_t deg = degree(rowmap, v);
+    if (deg >= numVerts) deg = numVerts - 1;
+    return degree_key_t(deg) * numVerts + v;
   }
 
-  lno_t findPseudoPeripheral() {
-    // Choose vertex with smallest degree
-    lno_t periph    = -1;
-    lno_t periphDeg = numVerts;
-    for (lno_t i = 0; i < numVerts; i++) {
-      lno_t deg = rowmap(i + 1) - rowmap(i);
-      if (deg < periphDeg) {
-        periph    = i;
-        periphDeg = deg;
-        if (deg == 0) break;
+  // Minimum degree key of every component
+  struct CompMinDegreeFunctor {
+    rowmap_t rowmap;
+    work_view_t comp;
+    key_view_t compKey;
+    lno_t numVerts;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t v) const {
+      Kokkos::atomic_min(&compKey(comp(v)), degreeKey(rowmap, v, numVerts));
+    }
+  };
+
+  // vertices(c) := the vertex of key keys(c), for the components active(i)
+  struct KeyVertexFunctor {
+    work_view_t active;
+    key_view_t keys;
+    work_view_t vertices;
+    lno_t numVerts;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      const lno_t c = active(i);
+      vertices(c)   = lno_t(keys(c) % degree_key_t(numVerts));
+    }
+  };
+
+  // Puts the seeds of the components active(i) in the queue, at level 0
+  struct SeedFunctor {
+    work_view_t active;
+    work_view_t seeds;
+    work_view_t queue;
+    work_view_t level;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      const lno_t v = seeds(active(i));
+      queue(i)      = v;
+      level(v)      = 0;
+    }
+  };
+
+  struct ResetCompFunctor {
+    work_view_t active;
+    work_view_t depth;
+    key_view_t keys;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      depth(active(i)) = 0;
+      keys(active(i))  = Kokkos::ArithTraits<degree_key_t>::max();
+    }
+  };
+
+  // Number of levels (minus one) of the search in every component
+  struct DepthFunctor {
+    work_view_t queue;
+    work_view_t comp;
+    work_view_t level;
+    work_view_t depth;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      const lno_t v = queue(i);
+      Kokkos::atomic_max(&depth(comp(v)), level(v));
+    }
+  };
+
+  // Minimum degree key over the last level of the search in every component
+  struct LastLevelFunctor {
+    rowmap_t rowmap;
+    work_view_t queue;
+    work_view_t comp;
+    work_view_t level;
+    work_view_t depth;
+    key_view_t keys;
+    lno_t numVerts;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      const lno_t v = queue(i);
+      if (level(v) != depth(comp(v))) return;
+      Kokkos::atomic_min(&keys(comp(v)), degreeKey(rowmap, v, numVerts));
+    }
+  };
+
+  // Moves the root of the components active(i) to their candidate if that
+  // makes more levels, and lists them in nextActive; the others are done.
+  struct ImproveFunctor {
+    work_view_t active;
+    work_view_t nextActive;
+    work_view_t roots;
+    work_view_t depth;
+    key_view_t keys;
+    work_view_t cands;
+    work_view_t candDepth;
+    key_view_t candKeys;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i, lno_t& offset,
+                                           const bool final) const {
+      const lno_t c = active(i);
+      if (candDepth(c) <= depth(c)) return;
+      if (final) {
+        roots(c)           = cands(c);
+        depth(c)           = candDepth(c);
+        keys(c)            = candKeys(c);
+        nextActive(offset) = c;
       }
+      offset++;
     }
-    return periph;
-  }
+  };
 
-  lno_view_t rcm() {
-    lno_t start = findPseudoPeripheral();
-    host_lno_view_t q(Kokkos::view_alloc(Kokkos::WithoutInitializing, "Queue"),
-                      numVerts);
-    host_lno_view_t label(
-        Kokkos::view_alloc(Kokkos::WithoutInitializing, "Permutation"),
-        numVerts);
-    for (lno_t i = 0; i < numVerts; i++) label(i) = -1;
-    lno_t qhead  = 0;
-    lno_t qtail  = 0;
-    label(start) = qtail;
-    q(qtail++)   = start;
-    std::vector<lno_t> neighbors;
-    lno_t outerQueue = 0;
-    while (true) {
-      lno_t v = q(qhead++);
-      neighbors.clear();
-      for (size_type j = rowmap(v); j < rowmap(v + 1); j++) {
-        lno_t nei = entries(j);
-        if (nei == v || nei >= numVerts) continue;
-        if (label(nei) == -1) {
-          neighbors.push_back(nei);
+  // The roots in the order of the components, at the start of the order
+  struct InitOrderFunctor {
+    work_view_t compOrder;
+    work_view_t roots;
+    work_view_t order;
+    work_view_t label;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t k) const {
+      const lno_t v = roots(compOrder(k));
+      order(k)      = v;
+      label(v)      = k;
+    }
+  };
+
+  struct InvertFunctor {
+    work_view_t perm;
+    work_view_t inverse;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t k) const {
+      inverse(perm(k)) = k;
+    }
+  };
+
+  struct CompRankFunctor {
+    work_view_t order;
+    work_view_t comp;
+    work_view_t compRank;
+    key_view_t keys;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t k) const {
+      keys(k) = compRank(comp(order(k)));
+    }
+  };
+
+  // Pseudo-peripheral search: appends the unvisited, unlabeled neighbors of
+  // queue(i) to queue, at level depth + 1.
+  struct BfsExpandFunctor {
+    rowmap_t rowmap;
+    entries_t entries;
+    work_view_t label;
+    work_view_t level;
+    work_view_t queue;
+    counter_t queueTail;
+    lno_t numVerts;
+    lno_t depth;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      const lno_t u = queue(i);
+      for (size_type j = rowmap(u); j < rowmap(u + 1); j++) {
+        const lno_t w = entries(j);
+        if (w == u || w >= numVerts || label(w) != UNLABELED) continue;
+        if (level(w) != -1) continue;
+        if (Kokkos::atomic_compare_exchange(&level(w), lno_t(-1),
+                                            lno_t(depth + 1)) == -1) {
+          queue(Kokkos::atomic_fetch_add(&queueTail(), lno_t(1))) = w;
         }
       }
-      std::sort(neighbors.begin(), neighbors.end(),
-                [&](lno_t n1, lno_t n2) -> bool {
-                  // return true if n1 has a lower degree than n2
-                  return (rowmap(n1 + 1) - rowmap(n1)) <
-                         (rowmap(n2 + 1) - rowmap(n2));
-                });
-      // label and enqueue all unlabeled neighbors
-      for (lno_t nei : neighbors) {
-        label(nei) = qtail;
-        q(qtail++) = nei;
+    }
+  };
+
+  struct ResetLevelFunctor {
+    work_view_t level;
+    work_view_t queue;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      level(queue(i)) = -1;
+    }
+  };
+
+  // parent(w) := min(parent(w), i) for the unlabeled neighbors w of order(i)
+  struct ParentFunctor {
+    rowmap_t rowmap;
+    entries_t entries;
+    work_view_t label;
+    work_view_t order;
+    work_view_t parent;
+    lno_t numVerts;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      const lno_t u = order(i);
+      for (size_type j = rowmap(u); j < rowmap(u + 1); j++) {
+        const lno_t w = entries(j);
+        if (w >= numVerts || label(w) != UNLABELED) continue;
+        if (parent(w) > i) Kokkos::atomic_min(&parent(w), i);
       }
-      if (qtail == numVerts) {
-        // have labeled all vertices
-        break;
-      } else if (qhead == qtail) {
-        // have exhausted this connected component, but others remain unlabeled
-        while (label(outerQueue) != -1) outerQueue++;
-        label(outerQueue) = qtail;
-        q(qtail++)        = outerQueue;
+    }
+  };
+
+  // Without place, counts the children of order(i) in offsets(i - begin).
+  // With place, writes them in order from end + offsets(i - begin) on,
+  // sorts them by degree and labels them.
+  template <bool place>
+  struct ChildrenFunctor {
+    rowmap_t rowmap;
+    entries_t entries;
+    work_view_t label;
+    work_view_t order;
+    work_view_t parent;
+    work_view_t offsets;
+    lno_t numVerts;
+    lno_t begin;
+    lno_t end;
+
+    KOKKOS_INLINE_FUNCTION bool less(const lno_t a, const lno_t b) const {
+      const lno_t da = degree(rowmap, a);
+      const lno_t db = degree(rowmap, b);
+      return da < db || (da == db && a < b);
+    }
+
+    KOKKOS_INLINE_FUNCTION void siftDown(const lno_t first, lno_t root,
+                                         const lno_t size) const {
+      while (2 * root + 1 < size) {
+        lno_t child = 2 * root + 1;
+        if (child + 1 < size &&
+            less(order(first + child), order(first + child + 1))) {
+          child++;
+        }
+        if (!less(order(first + root), order(first + child))) return;
+        const lno_t tmp      = order(first + root);
+        order(first + root)  = order(first + child);
+        order(first + child) = tmp;
+        root                 = child;
       }
     }
+
+    // heap sort of order(first), ..., order(first + n - 1)
+    KOKKOS_INLINE_FUNCTION void sort(const lno_t first, const lno_t n) const {
+      for (lno_t k = n / 2 - 1; k >= 0; k--) siftDown(first, k, n);
+      for (lno_t size = n - 1; size > 0; size--) {
+        const lno_t tmp     = order(first);
+        order(first)        = order(first + size);
+        order(first + size) = tmp;
+        siftDown(first, 0, size);
+      }
+    }
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      const lno_t u        = order(i);
+      const lno_t first    = place ? end + offsets(i - begin) : 0;
+      const lno_t expected = place ? COUNTED : UNLABELED;
+      const lno_t desired  = place ? PLACED : COUNTED;
+      lno_t count          = 0;
+      for (size_type j = rowmap(u); j < rowmap(u + 1); j++) {
+        const lno_t w = entries(j);
+        if (w >= numVerts || parent(w) != i || label(w) != expected) continue;
+        // the first occurrence of w in the row claims it
+        if (Kokkos::atomic_compare_exchange(&label(w), expected, desired) !=
+            expected) {
+          continue;
+        }
+        if constexpr (place) order(first + count) = w;
+        count++;
+      }
+      if constexpr (place) {
+        sort(first, count);
+        for (lno_t k = first; k < first + count; k++) label(order(k)) = k;
+      } else {
+        offsets(i - begin) = count;
+      }
+    }
+  };
+
+  struct ReverseFunctor {
+    work_view_t label;
+    lno_view_t labelOut;
+    lno_t numVerts;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t v) const {
+      labelOut(v) = numVerts - label(v) - 1;
+    }
+  };
+
+  // Runs a BFS from seeds(c) over the components active(i), i < numActive,
+  // and returns the number of vertices reached, listed in queue.
+  lno_t bfsLevels(const work_view_t& active, const lno_t numActive,
+                  const work_view_t& seeds) {
+    Kokkos::parallel_for("RCM::bfsSeed", range_t(exec, 0, numActive),
+                         SeedFunctor{active, seeds, queue, level});
+    Kokkos::deep_copy(exec, queueTail, numActive);
+    lno_t begin = 0, end = numActive, depth = 0;
+    while (begin < end) {
+      Kokkos::parallel_for("RCM::bfsExpand", range_t(exec, begin, end),
+                           BfsExpandFunctor{rowmap, entries, label, level,
+                                            queue, queueTail, numVerts,
+                                            depth});
+      lno_t tail = 0;
+      Kokkos::deep_copy(exec, tail, queueTail);
+      exec.fence();
+      begin = end;
+      end   = tail;
+      depth++;
+    }
+    return end;
+  }
+
+  // Levels (minus one) of the last BFS in depth, and minimum degree key of
+  // its last level in keys, for the components active(i); resets the levels.
+  void measureLevels(const work_view_t& active, const lno_t numActive,
+                     const lno_t reached, const work_view_t& depth,
+                     const key_view_t& keys) {
+    Kokkos::parallel_for("RCM::resetComps", range_t(exec, 0, numActive),
+                         ResetCompFunctor{active, depth, keys});
+    Kokkos::parallel_for("RCM::depth", range_t(exec, 0, reached),
+                         DepthFunctor{queue, comp, level, depth});
+    Kokkos::parallel_for("RCM::lastLevel", range_t(exec, 0, reached),
+                         LastLevelFunctor{rowmap, queue, comp, level, depth,
+                                          keys, numVerts});
+    Kokkos::parallel_for("RCM::resetLevels", range_t(exec, 0, reached),
+                         ResetLevelFunctor{level, queue});
+  }
+
+  // Pseudo-peripheral roots of all the components, from the vertices of
+  // minimal degree compKey.
+  work_view_t findPseudoPeripherals(const key_view_t& compKey) {
+    work_view_t active(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "RCM active"),
+        numComps);
+    work_view_t nextActive(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "RCM next active"),
+        numComps);
+    work_view_t roots(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "RCM roots"),
+        numComps);
+    work_view_t cands(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "RCM candidates"),
+        numComps);
+    work_view_t depth(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "RCM depth"),
+        numComps);
+    work_view_t candDepth(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "RCM cand depth"),
+        numComps);
+    key_view_t keys(Kokkos::view_alloc(Kokkos::WithoutInitializing, "RCM keys"),
+                    numComps);
+    key_view_t candKeys(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "RCM cand keys"),
+        numComps);
+    KokkosKernels::Impl::sequential_fill(active);
+    lno_t numActive = numComps;
+    Kokkos::parallel_for("RCM::roots", range_t(exec, 0, numActive),
+                         KeyVertexFunctor{active, compKey, roots, numVerts});
+    measureLevels(active, numActive, bfsLevels(active, numActive, roots),
+                  depth, keys);
+    while (numActive) {
+      Kokkos::parallel_for("RCM::candidates", range_t(exec, 0, numActive),
+                           KeyVertexFunctor{active, keys, cands, numVerts});
+      measureLevels(active, numActive, bfsLevels(active, numActive, cands),
+                    candDepth, candKeys);
+      lno_t numImproved = 0;
+      Kokkos::parallel_scan(
+          "RCM::improve", range_t(exec, 0, numActive),
+          ImproveFunctor{active, nextActive, roots, depth, keys, cands,
+                         candDepth, candKeys},
+          numImproved);
+      std::swap(active, nextActive);
+      numActive = numImproved;
+    }
+    return roots;
+  }
+
+  // Orders the components whose roots are order(begin), ..., order(end - 1).
+  // Returns the number of vertices ordered so far.
+  lno_t cuthillMcKee(lno_t begin, lno_t end) {
+    while (begin < end) {
+      const lno_t frontier = end - begin;
+      Kokkos::parallel_for("RCM::parents", range_t(exec, begin, end),
+                           ParentFunctor{rowmap, entries, label, order, parent,
+                                         numVerts});
+      Kokkos::parallel_for(
+          "RCM::countChildren", range_t(exec, begin, end),
+          ChildrenFunctor<false>{rowmap, entries, label, order, parent,
+                                 offsets, numVerts, begin, end});
+      lno_t numChildren = 0;
+      KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<execution_space>(
+          exec, frontier, offsets, numChildren);
+      Kokkos::parallel_for(
+          "RCM::placeChildren", range_t(exec, begin, end),
+          ChildrenFunctor<true>{rowmap, entries, label, order, parent, offsets,
+                                numVerts, begin, end});
+      begin = end;
+      end += numChildren;
+    }
+    return end;
+  }
+
+  lno_view_t rcm() {
+    Kokkos::deep_copy(exec, label, UNLABELED);
+    Kokkos::deep_copy(exec, level, lno_t(-1));
+    Kokkos::deep_copy(exec, parent, Kokkos::ArithTraits<lno_t>::max());
+    exec.fence();
+    comp = KokkosGraph::Impl::ConnectedComponents<device_t, rowmap_t, entries_t,
+                                                  work_view_t>(rowmap, entries)
+               .compute(numComps);
+    key_view_t compKey(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "RCM comp keys"),
+        numComps);
+    Kokkos::deep_copy(exec, compKey, Kokkos::ArithTraits<degree_key_t>::max());
+    Kokkos::parallel_for("RCM::compMinDegree", range_t(exec, 0, numVerts),
+                         CompMinDegreeFunctor{rowmap, comp, compKey, numVerts});
+    const work_view_t roots = findPseudoPeripherals(compKey);
+    // the components in the order of their vertex of minimal degree
+    work_view_t compOrder(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "RCM comp order"),
+        numComps);
+    KokkosKernels::Impl::sequential_fill(compOrder);
+    if (numComps > 1) {
+      key_view_t keysAux(
+          Kokkos::view_alloc(Kokkos::WithoutInitializing, "RCM keys aux"),
+          numComps);
+      work_view_t permAux(
+          Kokkos::view_alloc(Kokkos::WithoutInitializing, "RCM perm aux"),
+          numComps);
+      KokkosKernels::radixSort2(exec, compKey, compOrder, keysAux, permAux);
+    }
+    Kokkos::parallel_for("RCM::initOrder", range_t(exec, 0, numComps),
+                         InitOrderFunctor{compOrder, roots, order, label});
+    cuthillMcKee(0, numComps);
+    if (numComps > 1) {
+      // group the order by component, keeping the order within each
+      work_view_t compRank(
+          Kokkos::view_alloc(Kokkos::WithoutInitializing, "RCM comp rank"),
+          numComps);
+      Kokkos::parallel_for("RCM::compRank", range_t(exec, 0, numComps),
+                           InvertFunctor{compOrder, compRank});
+      key_view_t keys(
+          Kokkos::view_alloc(Kokkos::WithoutInitializing, "RCM keys"),
+          numVerts);
+      Kokkos::parallel_for("RCM::groupKeys", range_t(exec, 0, numVerts),
+                           CompRankFunctor{order, comp, compRank, keys});
+      key_view_t keysAux(
+          Kokkos::view_alloc(Kokkos::WithoutInitializing, "RCM keys aux"),
+          numVerts);
+      work_view_t permAux(
+          Kokkos::view_alloc(Kokkos::WithoutInitializing, "RCM perm aux"),
+          numVerts);
+      KokkosKernels::radixSort2(exec, keys, order, keysAux, permAux);
+      Kokkos::parallel_for("RCM::relabel", range_t(exec, 0, numVerts),
+                           InvertFunctor{order, label});
+    }
+    // reverse the labels
     lno_view_t labelOut(
         Kokkos::view_alloc(Kokkos::WithoutInitializing, "RCM Permutation"),
         numVerts);
-    // reverse the labels
-    for (lno_t i = 0; i < numVerts; i++) label(i) = numVerts - label(i) - 1;
-    Kokkos::deep_copy(labelOut, label);
+    Kokkos::parallel_for("RCM::reverse", range_t(exec, 0, numVerts),
+                         ReverseFunctor{label, labelOut, numVerts});
+    exec.fence();
     return labelOut;
   }
 };
@@ -0,0 +1,228 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSGRAPH_BALANCECOLOR_IMPL_HPP
+#define _KOKKOSGRAPH_BALANCECOLOR_IMPL_HPP
+
+#include "Kokkos_Core.hpp"
+#include "KokkosGraph_IncrementalColor_impl.hpp"
+#include <cstdint>
+
+namespace KokkosGraph {
+namespace Impl {
+
+// Sizes of the color classes: sizes(c) is the number of vertices of color c,
+// for c in 1...numColors (sizes(0) counts the uncolored vertices).
+template <typename exec_space, typename colors_t, typename sizes_t>
+struct ColorClassSizes {
+  using color_t   = typename colors_t::non_const_value_type;
+  using range_pol = Kokkos::RangePolicy<exec_space>;
+
+  struct MaxColorFunctor {
+    colors_t colors;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const size_t v,
+                                           color_t& lmax) const {
+      if (colors(v) > lmax) lmax = colors(v);
+    }
+  };
+
+  struct CountFunctor {
+    colors_t colors;
+    sizes_t sizes;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const size_t v) const {
+      Kokkos::atomic_increment(&sizes(colors(v)));
+    }
+  };
+
+  static color_t numColors(const colors_t& colors) {
+    color_t maxColor = 0;
+    Kokkos::parallel_reduce("KokkosGraph::ColorClassSizes::numColors",
+                            range_pol(0, colors.extent(0)),
+                            MaxColorFunctor{colors},
+                            Kokkos::Max<color_t>(maxColor));
+    return maxColor;
+  }
+
+  static sizes_t count(const colors_t& colors, color_t numColors) {
+    sizes_t sizes("Color class sizes", numColors + 1);
+    Kokkos::parallel_for("KokkosGraph::ColorClassSizes::count",
+                         range_pol(0, colors.extent(0)),
+                         CountFunctor{colors, sizes});
+    return sizes;
+  }
+};
+
+// Guided recoloring of a valid distance-1 (or distance-2) coloring of a
+// symmetric graph, towards color classes of equal size (Lu et al., "Balanced
+// coloring for parallel computing applications"), keeping the number of
+// colors. The target size is the number of vertices over the number of
+// colors, rounded up. In every round, each vertex of a class above the
+// target proposes to move to the smallest class below the target among the
+// colors not used in its neighborhood; the moves reserve their place in the
+// class sizes atomically, so no class goes above the target or a donor
+// below it. Of two vertices within the distance proposing the same color,
+// the smaller one moves. The rounds stop when no vertex moves, or after
+// MAX_ROUNDS.
+template <typename device_t, typename rowmap_t, typename entries_t,
+          typename colors_t, bool distance2>
+struct BalanceColoring {
+  using exec_space  = typename device_t::execution_space;
+  using mem_space   = typename device_t::memory_space;
+  using lno_t       = typename entries_t::non_const_value_type;
+  using color_t     = typename colors_t::non_const_value_type;
+  using range_pol   = Kokkos::RangePolicy<exec_space>;
+  using sizes_t     = Kokkos::View<lno_t*, mem_space>;
+  using proposals_t = Kokkos::View<color_t*, mem_space>;
+  using nbhd_t      = ColorNeighborhood<rowmap_t, entries_t, distance2>;
+  using forbidden_t = ForbiddenColorsVisitor<colors_t, lno_t>;
+  using class_sizes = ColorClassSizes<exec_space, colors_t, sizes_t>;
+
+  static constexpr int MAX_ROUNDS = 20;
+
+  nbhd_t nbhd;
+  colors_t colors;
+  color_t numColors;
+  lno_t target;
+  sizes_t sizes;
+  proposals_t proposals;
+
+  BalanceColoring(const rowmap_t& rowmap_, const entries_t& entries_,
+                  lno_t numVerts_, const colors_t& colors_)
+      : nbhd{rowmap_, entries_, numVerts_},
+        colors(colors_),
+        numColors(class_sizes::numColors(colors_)),
+        target(numColors ? (numVerts_ + numColors - 1) / numColors : 0),
+        sizes(class_sizes::count(colors_, numColors)),
+        proposals(Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                                     "Color proposals"),
+                  numVerts_) {}
+
+  struct ProposeFunctor {
+    nbhd_t nbhd;
+    colors_t colors;
+    color_t numColors;
+    lno_t target;
+    sizes_t sizes;
+    proposals_t proposals;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t v) const {
+      const color_t c = colors(v);
+      proposals(v)    = c;
+      if (c == 0 || sizes(c) <= target) return;
+      color_t best   = 0;
+      lno_t bestSize = target;
+      for (color_t offset = 0; offset < numColors;
+           offset += forbidden_t::BITS) {
+        forbidden_t visitor{colors, offset, 0};
+        nbhd.visit(v, visitor);
+        for (color_t b = 0; b < forbidden_t::BITS; b++) {
+          const color_t cand = offset + b + 1;
+          if (cand > numColors) break;
+          if (cand == c || (visitor.forbidden & (uint64_t(1) << b))) continue;
+          const lno_t size = sizes(cand);
+          if (size < bestSize) {
+            best     = cand;
+            bestSize = size;
+          }
+        }
+      }
+      if (!best) return;
+      if (Kokkos::atomic_fetch_add(&sizes(best), lno_t(1)) >= target) {
+        Kokkos::atomic_decrement(&sizes(best));
+        return;
+      }
+      if (Kokkos::atomic_fetch_sub(&sizes(c), lno_t(1)) <= target) {
+        Kokkos::atomic_increment(&sizes(c));
+        Kokkos::atomic_decrement(&sizes(best));
+        return;
+      }
+      proposals(v) = best;
+    }
+  };
+
+  // Finds a moving vertex y < v proposing the same color as v.
+  struct ConflictVisitor {
+    colors_t colors;
+    proposals_t proposals;
+    lno_t v;
+    color_t proposal;
+    bool conflict;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t y) {
+      if (y < v && proposals(y) == proposal && colors(y) != proposal)
+        conflict = true;
+    }
+  };
+
+  // Cancels the conflicting moves, and gives back their places.
+  struct ResolveFunctor {
+    nbhd_t nbhd;
+    colors_t colors;
+    sizes_t sizes;
+    proposals_t proposals;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t v) const {
+      const color_t p = proposals(v);
+      if (p == colors(v)) return;
+      ConflictVisitor visitor{colors, proposals, v, p, false};
+      nbhd.visit(v, visitor);
+      if (!visitor.conflict) return;
+      Kokkos::atomic_decrement(&sizes(p));
+      Kokkos::atomic_increment(&sizes(colors(v)));
+      proposals(v) = colors(v);
+    }
+  };
+
+  struct ApplyFunctor {
+    colors_t colors;
+    proposals_t proposals;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t v, lno_t& moved) const {
+      if (proposals(v) == colors(v)) return;
+      colors(v) = proposals(v);
+      moved++;
+    }
+  };
+
+  // Returns the number of vertices moved.
+  lno_t run() {
+    const lno_t n = nbhd.numVerts;
+    lno_t total   = 0;
+    if (!numColors) return total;
+    for (int round = 0; round < MAX_ROUNDS; round++) {
+      Kokkos::parallel_for(
+          "KokkosGraph::BalanceColor::propose", range_pol(0, n),
+          ProposeFunctor{nbhd, colors, numColors, target, sizes, proposals});
+      Kokkos::parallel_for("KokkosGraph::BalanceColor::resolve",
+                           range_pol(0, n),
+                           ResolveFunctor{nbhd, colors, sizes, proposals});
+      lno_t moved = 0;
+      Kokkos::parallel_reduce("KokkosGraph::BalanceColor::apply",
+                              range_pol(0, n),
+                              ApplyFunctor{colors, proposals}, moved);
+      if (!moved) break;
+      total += moved;
+    }
+    return total;
+  }
+};
+
+}  // namespace Impl
+}  // namespace KokkosGraph
+
+#endif
@@ -0,0 +1,566 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSGRAPH_CONNECTEDCOMPONENTS_IMPL_HPP
+#define _KOKKOSGRAPH_CONNECTEDCOMPONENTS_IMPL_HPP
+
+#include "Kokkos_Core.hpp"
+#include "KokkosKernels_SimpleUtils.hpp"
+#include "KokkosSparse_Utils.hpp"
+#include <Kokkos_ArithTraits.hpp>
+#include <cstdint>
+#include <unordered_map>
+
+namespace KokkosGraph {
+namespace Impl {
+
+// Numbers the components 0, 1, ... in the order of their smallest vertex:
+// rep(v) is any vertex of the component of v, and labels(v) its number.
+template <typename exec_space, typename lno_view_t, typename labels_t>
+struct ComponentNumbering {
+  using lno_t     = typename lno_view_t::non_const_value_type;
+  using range_pol = Kokkos::RangePolicy<exec_space>;
+
+  struct MinVertexFunctor {
+    lno_view_t rep;
+    lno_view_t minVertex;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t v) const {
+      Kokkos::atomic_min(&minVertex(rep(v)), v);
+    }
+  };
+
+  // headId(v) is the number of the component whose smallest vertex is v
+  struct HeadScanFunctor {
+    lno_view_t rep;
+    lno_view_t minVertex;
+    lno_view_t headId;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t v, lno_t& offset,
+                                           const bool final) const {
+      if (minVertex(rep(v)) != v) return;
+      if (final) headId(v) = offset;
+      offset++;
+    }
+  };
+
+  struct LabelFunctor {
+    lno_view_t rep;
+    lno_view_t minVertex;
+    lno_view_t headId;
+    labels_t labels;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t v) const {
+      labels(v) = headId(minVertex(rep(v)));
+    }
+  };
+
+  static labels_t number(const lno_view_t& rep, lno_t& numComponents) {
+    const lno_t n = rep.extent(0);
+    lno_view_t minVertex(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "component min"), n);
+    Kokkos::deep_copy(minVertex, Kokkos::ArithTraits<lno_t>::max());
+    Kokkos::parallel_for("KokkosGraph::components::minVertex",
+                         range_pol(0, n), MinVertexFunctor{rep, minVertex});
+    lno_view_t headId(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "component heads"), n);
+    numComponents = 0;
+    Kokkos::parallel_scan("KokkosGraph::components::heads", range_pol(0, n),
+                          HeadScanFunctor{rep, minVertex, headId},
+                          numComponents);
+    labels_t labels(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "Component Labels"),
+        n);
+    Kokkos::parallel_for("KokkosGraph::components::label", range_pol(0, n),
+                         LabelFunctor{rep, minVertex, headId, labels});
+    return labels;
+  }
+};
+
+// Connected components of a symmetric graph by Afforest (Sutton, Ben-Nun
+// and Barak): union-find with lock-free linking, where every link points
+// the larger root to the smaller one.
+//  - the first NEIGHBOR_ROUNDS neighbors of every vertex are linked, and the
+//    trees compressed: this already finds most of the giant component, if
+//    there is one
+//  - the most frequent component among NUM_SAMPLES sampled vertices is
+//    assumed to be the giant one, and its vertices skip their remaining
+//    edges: an edge to another component is linked from the other end
+//  - every other vertex links its remaining neighbors, and the trees are
+//    compressed again.
+template <typename device_t, typename rowmap_t, typename entries_t,
+          typename labels_t>
+struct ConnectedComponents {
+  using exec_space = typename device_t::execution_space;
+  using mem_space  = typename device_t::memory_space;
+  using size_type  = typename rowmap_t::non_const_value_type;
+  using lno_t      = typename entries_t::non_const_value_type;
+  using range_pol  = Kokkos::RangePolicy<exec_space>;
+  using lno_view_t = Kokkos::View<lno_t*, mem_space>;
+
+  static constexpr int NEIGHBOR_ROUNDS = 2;
+  static constexpr int NUM_SAMPLES     = 1024;
+
+  rowmap_t rowmap;
+  entries_t entries;
+  lno_t numVerts;
+  // union-find parent of every vertex
+  lno_view_t comp;
+
+  ConnectedComponents(const rowmap_t& rowmap_, const entries_t& entries_)
+      : rowmap(rowmap_),
+        entries(entries_),
+        numVerts(rowmap_.extent(0) ? rowmap_.extent(0) - 1 : 0),
+        comp(Kokkos::view_alloc(Kokkos::WithoutInitializing, "CC parent"),
+             numVerts) {}
+
+  // Links neighbors [first, last) of the row of every vertex (from the
+  // NEIGHBOR_ROUNDS-th on if last is -1), except for the vertices in the
+  // component skip.
+  struct LinkFunctor {
+    rowmap_t rowmap;
+    entries_t entries;
+    lno_view_t comp;
+    lno_t numVerts;
+    int first;
+    int last;
+    lno_t skip;
+
+    KOKKOS_INLINE_FUNCTION void link(const lno_t u, const lno_t v) const {
+      lno_t p1 = comp(u);
+      lno_t p2 = comp(v);
+      while (p1 != p2) {
+        const lno_t high  = p1 > p2 ? p1 : p2;
+        const lno_t low   = p1 > p2 ? p2 : p1;
+        const lno_t pHigh = comp(high);
+        // already linked, or high was a root and now points to low
+        if (pHigh == low) break;
+        if (pHigh == high &&
+            Kokkos::atomic_compare_exchange(&comp(high), high, low) == high)
+          break;
+        p1 = comp(comp(high));
+        p2 = comp(low);
+      }
+    }
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t v) const {
+      if (skip != -1 && comp(v) == skip) return;
+      const size_type begin = rowmap(v) + first;
+      const size_type end =
+          last == -1 ? rowmap(v + 1)
+                     : Kokkos::min(rowmap(v + 1), size_type(rowmap(v) + last));
+      for (size_type j = begin; j < end; j++) {
+        const lno_t w = entries(j);
+        if (w < numVerts) link(v, w);
+      }
+    }
+  };
+
+  struct CompressFunctor {
+    lno_view_t comp;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t v) const {
+      while (comp(v) != comp(comp(v))) comp(v) = comp(comp(v));
+    }
+  };
+
+  struct SampleFunctor {
+    lno_view_t comp;
+    lno_view_t samples;
+    lno_t numVerts;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const int k) const {
+      // a fixed pseudo-random vertex, for reproducibility
+      const uint64_t h = (uint64_t(k) + 1) * 0x9E3779B97F4A7C15ULL;
+      samples(k)       = comp((h >> 17) % uint64_t(numVerts));
+    }
+  };
+
+  void linkRange(const int first, const int last, const lno_t skip) {
+    Kokkos::parallel_for(
+        "KokkosGraph::CC::link", range_pol(0, numVerts),
+        LinkFunctor{rowmap, entries, comp, numVerts, first, last, skip});
+    Kokkos::parallel_for("KokkosGraph::CC::compress", range_pol(0, numVerts),
+                         CompressFunctor{comp});
+  }
+
+  // The most frequent component among the samples
+  lno_t largestComponent() {
+    lno_view_t samples(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "CC samples"),
+        NUM_SAMPLES);
+    Kokkos::parallel_for("KokkosGraph::CC::sample",
+                         Kokkos::RangePolicy<exec_space, int>(0, NUM_SAMPLES),
+                         SampleFunctor{comp, samples, numVerts});
+    auto hSamples =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), samples);
+    std::unordered_map<lno_t, int> counts;
+    lno_t largest = hSamples(0);
+    for (int k = 0; k < NUM_SAMPLES; k++) {
+      const int count = ++counts[hSamples(k)];
+      if (count > counts[largest] ||
+          (count == counts[largest] && hSamples(k) < largest))
+        largest = hSamples(k);
+    }
+    return largest;
+  }
+
+  labels_t compute(lno_t& numComponents) {
+    numComponents = 0;
+    if (!numVerts) return labels_t("Component Labels", 0);
+    KokkosKernels::Impl::sequential_fill(comp);
+    for (int r = 0; r < NEIGHBOR_ROUNDS; r++) linkRange(r, r + 1, -1);
+    linkRange(NEIGHBOR_ROUNDS, -1, largestComponent());
+    // every root is the smallest vertex of its component
+    return ComponentNumbering<exec_space, lno_view_t, labels_t>::number(
+        comp, numComponents);
+  }
+};
+
+// Strongly connected components of a directed graph (Multistep, Slota,
+// Rajamanickam and Madduri):
+//  - trimming: a vertex without an in-edge or without an out-edge from the
+//    vertices left is a component by itself (up to TRIM_ROUNDS rounds)
+//  - forward-backward: the component of the vertex with the largest product
+//    of in- and out-degrees is the intersection of the vertices it reaches
+//    and of those reaching it; on most graphs, this is the giant component
+//  - coloring, for the rest: every vertex takes the largest vertex id that
+//    reaches it, which splits the vertices left into sets closed under
+//    reachability; the component of every vertex v colored v is the set of
+//    the vertices of its color that reach it, found backward from v. These
+//    steps are repeated until all the vertices are assigned.
+// Each search is a level-synchronous BFS over a queue.
+template <typename device_t, typename rowmap_t, typename entries_t,
+          typename labels_t>
+struct StronglyConnectedComponents {
+  using exec_space    = typename device_t::execution_space;
+  using mem_space     = typename device_t::memory_space;
+  using size_type     = typename rowmap_t::non_const_value_type;
+  using lno_t         = typename entries_t::non_const_value_type;
+  using range_pol     = Kokkos::RangePolicy<exec_space>;
+  using lno_view_t    = Kokkos::View<lno_t*, mem_space>;
+  using offset_view_t = Kokkos::View<size_type*, mem_space>;
+  using counter_t     = Kokkos::View<lno_t, mem_space>;
+  using key_t         = uint64_t;
+
+  static constexpr int TRIM_ROUNDS = 8;
+
+  lno_t numVerts;
+  // the graph without self loops, and its transpose
+  offset_view_t outRowmap;
+  lno_view_t outEntries;
+  offset_view_t inRowmap;
+  lno_view_t inEntries;
+  // representative of the component of every vertex, or -1 while unassigned
+  lno_view_t scc;
+  // the searches only cross edges between unassigned vertices of equal color
+  lno_view_t color;
+  lno_view_t fwMark;
+  lno_view_t bwMark;
+  lno_view_t queue;
+  counter_t queueTail;
+  lno_t stamp;
+
+  // Counts (filtered empty) or copies the entries of each row that are
+  // neither self loops nor out of range.
+  struct FilterFunctor {
+    rowmap_t rowmap;
+    entries_t entries;
+    lno_t numVerts;
+    offset_view_t filteredRowmap;
+    lno_view_t filtered;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      const bool fill   = filtered.extent(0);
+      size_type counter = fill ? filteredRowmap(i) : 0;
+      for (size_type j = rowmap(i); j < rowmap(i + 1); j++) {
+        const lno_t nei = entries(j);
+        if (nei >= numVerts || nei == i) continue;
+        if (fill) filtered(counter) = nei;
+        counter++;
+      }
+      if (!fill) filteredRowmap(i) = counter;
+    }
+  };
+
+  StronglyConnectedComponents(const rowmap_t& rowmap,
+                              const entries_t& entries)
+      : numVerts(rowmap.extent(0) ? rowmap.extent(0) - 1 : 0),
+        outRowmap("SCC rowmap", numVerts + 1),
+        inRowmap("SCC transpose rowmap", numVerts + 1),
+        scc(Kokkos::view_alloc(Kokkos::WithoutInitializing, "SCC reps"),
+            numVerts),
+        color(Kokkos::view_alloc(Kokkos::WithoutInitializing, "SCC colors"),
+              numVerts),
+        fwMark(Kokkos::view_alloc(Kokkos::WithoutInitializing, "SCC fw"),
+               numVerts),
+        bwMark(Kokkos::view_alloc(Kokkos::WithoutInitializing, "SCC bw"),
+               numVerts),
+        queue(Kokkos::view_alloc(Kokkos::WithoutInitializing, "SCC queue"),
+              numVerts),
+        queueTail("SCC queue tail"),
+        stamp(0) {
+    Kokkos::parallel_for("KokkosGraph::SCC::countFiltered",
+                         range_pol(0, numVerts),
+                         FilterFunctor{rowmap, entries, numVerts, outRowmap,
+                                       lno_view_t()});
+    size_type nnz = 0;
+    KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<exec_space>(
+        numVerts + 1, outRowmap, nnz);
+    outEntries = lno_view_t(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "SCC entries"), nnz);
+    Kokkos::parallel_for(
+        "KokkosGraph::SCC::filter", range_pol(0, numVerts),
+        FilterFunctor{rowmap, entries, numVerts, outRowmap, outEntries});
+    inEntries = lno_view_t(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "SCC transpose"),
+        nnz);
+    KokkosSparse::Impl::transpose_graph<offset_view_t, lno_view_t,
+                                        offset_view_t, lno_view_t,
+                                        offset_view_t, exec_space>(
+        numVerts, numVerts, outRowmap, outEntries, inRowmap, inEntries);
+  }
+
+  // Assigns to itself every unassigned vertex without an unassigned out- or
+  // in-neighbor.
+  struct TrimFunctor {
+    offset_view_t outRowmap;
+    lno_view_t outEntries;
+    offset_view_t inRowmap;
+    lno_view_t inEntries;
+    lno_view_t scc;
+
+    KOKKOS_INLINE_FUNCTION bool hasActive(const offset_view_t& rowmap,
+                                          const lno_view_t& entries,
+                                          const lno_t v) const {
+      for (size_type j = rowmap(v); j < rowmap(v + 1); j++) {
+        if (scc(entries(j)) == -1) return true;
+      }
+      return false;
+    }
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t v,
+                                           lno_t& trimmed) const {
+      if (scc(v) != -1) return;
+      if (!hasActive(outRowmap, outEntries, v) ||
+          !hasActive(inRowmap, inEntries, v)) {
+        scc(v) = v;
+        trimmed++;
+      }
+    }
+  };
+
+  // The unassigned vertex with the largest product of degrees (capped at
+  // numVerts - 1), ties going to the smallest index
+  struct PivotFunctor {
+    offset_view_t outRowmap;
+    offset_view_t inRowmap;
+    lno_view_t scc;
+    lno_t numVerts;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t v, key_t& lmax) const {
+      if (scc(v) != -1) return;
+      const double product = double(outRowmap(v + 1) - outRowmap(v)) *
+                             double(inRowmap(v + 1) - inRowmap(v));
+      const key_t capped =
+          product < double(numVerts - 1) ? key_t(product) : key_t(numVerts - 1);
+      const key_t key = capped * numVerts + (numVerts - 1 - v);
+      if (key > lmax) lmax = key;
+    }
+  };
+
+  // Gives every unassigned vertex the color c (or its own index if c is -1)
+  struct ColorFunctor {
+    lno_view_t scc;
+    lno_view_t color;
+    lno_t c;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t v) const {
+      if (scc(v) == -1) color(v) = c == -1 ? v : c;
+    }
+  };
+
+  // Pushes the largest colors along the out-edges
+  struct PropagateFunctor {
+    offset_view_t outRowmap;
+    lno_view_t outEntries;
+    lno_view_t scc;
+    lno_view_t color;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t v,
+                                           lno_t& changed) const {
+      if (scc(v) != -1) return;
+      const lno_t c = color(v);
+      for (size_type j = outRowmap(v); j < outRowmap(v + 1); j++) {
+        const lno_t w = outEntries(j);
+        if (scc(w) == -1 && color(w) < c) {
+          Kokkos::atomic_max(&color(w), c);
+          changed++;
+        }
+      }
+    }
+  };
+
+  // Starts a search from every unassigned vertex v of color v
+  struct SeedFunctor {
+    lno_view_t scc;
+    lno_view_t color;
+    lno_view_t mark;
+    lno_view_t queue;
+    counter_t queueTail;
+    lno_t stamp;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t v) const {
+      if (scc(v) != -1 || color(v) != v) return;
+      mark(v) = stamp;
+      queue(Kokkos::atomic_fetch_add(&queueTail(), lno_t(1))) = v;
+    }
+  };
+
+  // Appends the unmarked neighbors of queue(i) of the same color to queue
+  struct ExpandFunctor {
+    offset_view_t rowmap;
+    lno_view_t entries;
+    lno_view_t scc;
+    lno_view_t color;
+    lno_view_t mark;
+    lno_view_t queue;
+    counter_t queueTail;
+    lno_t stamp;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      const lno_t u = queue(i);
+      for (size_type j = rowmap(u); j < rowmap(u + 1); j++) {
+        const lno_t w = entries(j);
+        if (scc(w) != -1 || color(w) != color(u) || mark(w) == stamp) continue;
+        if (Kokkos::atomic_exchange(&mark(w), stamp) != stamp) {
+          queue(Kokkos::atomic_fetch_add(&queueTail(), lno_t(1))) = w;
+        }
+      }
+    }
+  };
+
+  // Assigns the unassigned vertices reached backward (and forward, if
+  // fwStamp is not -1) to the component of their color
+  struct AssignFunctor {
+    lno_view_t scc;
+    lno_view_t color;
+    lno_view_t fwMark;
+    lno_view_t bwMark;
+    lno_t fwStamp;
+    lno_t bwStamp;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t v,
+                                           lno_t& assigned) const {
+      if (scc(v) != -1 || bwMark(v) != bwStamp) return;
+      if (fwStamp != -1 && fwMark(v) != fwStamp) return;
+      scc(v) = color(v);
+      assigned++;
+    }
+  };
+
+  // Marks with a new stamp the vertices reachable along (rowmap, entries)
+  // from the seeds, and returns the stamp.
+  lno_t search(const offset_view_t& rowmap, const lno_view_t& entries,
+               const lno_view_t& mark) {
+    stamp++;
+    Kokkos::deep_copy(queueTail, lno_t(0));
+    Kokkos::parallel_for(
+        "KokkosGraph::SCC::seed", range_pol(0, numVerts),
+        SeedFunctor{scc, color, mark, queue, queueTail, stamp});
+    lno_t begin = 0, end = 0;
+    Kokkos::deep_copy(end, queueTail);
+    while (begin < end) {
+      Kokkos::parallel_for("KokkosGraph::SCC::expand", range_pol(begin, end),
+                           ExpandFunctor{rowmap, entries, scc, color, mark,
+                                         queue, queueTail, stamp});
+      begin = end;
+      Kokkos::deep_copy(end, queueTail);
+    }
+    return stamp;
+  }
+
+  lno_t trim(lno_t remaining) {
+    for (int r = 0; r < TRIM_ROUNDS && remaining; r++) {
+      lno_t trimmed = 0;
+      Kokkos::parallel_reduce(
+          "KokkosGraph::SCC::trim", range_pol(0, numVerts),
+          TrimFunctor{outRowmap, outEntries, inRowmap, inEntries, scc},
+          trimmed);
+      remaining -= trimmed;
+      if (!trimmed) break;
+    }
+    return remaining;
+  }
+
+  lno_t forwardBackward(lno_t remaining) {
+    key_t key = 0;
+    Kokkos::parallel_reduce(
+        "KokkosGraph::SCC::pivot", range_pol(0, numVerts),
+        PivotFunctor{outRowmap, inRowmap, scc, numVerts},
+        Kokkos::Max<key_t>(key));
+    const lno_t pivot = numVerts - 1 - lno_t(key % key_t(numVerts));
+    Kokkos::parallel_for("KokkosGraph::SCC::color", range_pol(0, numVerts),
+                         ColorFunctor{scc, color, pivot});
+    const lno_t fwStamp = search(outRowmap, outEntries, fwMark);
+    const lno_t bwStamp = search(inRowmap, inEntries, bwMark);
+    lno_t assigned      = 0;
+    Kokkos::parallel_reduce(
+        "KokkosGraph::SCC::assign", range_pol(0, numVerts),
+        AssignFunctor{scc, color, fwMark, bwMark, fwStamp, bwStamp}, assigned);
+    return remaining - assigned;
+  }
+
+  lno_t coloring(lno_t remaining) {
+    Kokkos::parallel_for("KokkosGraph::SCC::color", range_pol(0, numVerts),
+                         ColorFunctor{scc, color, lno_t(-1)});
+    lno_t changed = 0;
+    do {
+      changed = 0;
+      Kokkos::parallel_reduce(
+          "KokkosGraph::SCC::propagate", range_pol(0, numVerts),
+          PropagateFunctor{outRowmap, outEntries, scc, color}, changed);
+    } while (changed);
+    const lno_t bwStamp = search(inRowmap, inEntries, bwMark);
+    lno_t assigned      = 0;
+    Kokkos::parallel_reduce(
+        "KokkosGraph::SCC::assign", range_pol(0, numVerts),
+        AssignFunctor{scc, color, fwMark, bwMark, lno_t(-1), bwStamp},
+        assigned);
+    return remaining - assigned;
+  }
+
+  labels_t compute(lno_t& numComponents) {
+    numComponents = 0;
+    if (!numVerts) return labels_t("Component Labels", 0);
+    Kokkos::deep_copy(scc, lno_t(-1));
+    Kokkos::deep_copy(fwMark, lno_t(0));
+    Kokkos::deep_copy(bwMark, lno_t(0));
+    lno_t remaining = trim(numVerts);
+    if (remaining) remaining = forwardBackward(remaining);
+    while (remaining) {
+      remaining = trim(remaining);
+      if (remaining) remaining = coloring(remaining);
+    }
+    return ComponentNumbering<exec_space, lno_view_t, labels_t>::number(
+        scc, numComponents);
+  }
+};
+
+}  // namespace Impl
+}  // namespace KokkosGraph
+
+#endif
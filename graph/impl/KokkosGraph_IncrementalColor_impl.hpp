@@ -0,0 +1,304 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSGRAPH_INCREMENTALCOLOR_IMPL_HPP
+#define _KOKKOSGRAPH_INCREMENTALCOLOR_IMPL_HPP
+
+#include "Kokkos_Core.hpp"
+#include <cstdint>
+#include <utility>
+
+namespace KokkosGraph {
+namespace Impl {
+
+// The distance-1 or distance-2 neighborhood of a vertex, without the vertex
+// itself. Entries >= numVerts are ignored, and a vertex may be visited more
+// than once.
+template <typename rowmap_t, typename entries_t, bool distance2>
+struct ColorNeighborhood {
+  using size_type = typename rowmap_t::non_const_value_type;
+  using lno_t     = typename entries_t::non_const_value_type;
+
+  rowmap_t rowmap;
+  entries_t entries;
+  lno_t numVerts;
+
+  template <typename visitor_t>
+  KOKKOS_INLINE_FUNCTION void visit(const lno_t v, visitor_t& visitor) const {
+    for (size_type i = rowmap(v); i < rowmap(v + 1); i++) {
+      const lno_t x = entries(i);
+      if (x == v || x >= numVerts) continue;
+      visitor(x);
+      if (!distance2) continue;
+      for (size_type j = rowmap(x); j < rowmap(x + 1); j++) {
+        const lno_t y = entries(j);
+        if (y != v && y < numVerts) visitor(y);
+      }
+    }
+  }
+};
+
+// Bans the colors (offset, offset + BITS] found in a neighborhood: bit b of
+// forbidden is set if color offset + b + 1 is used.
+template <typename colors_t, typename lno_t>
+struct ForbiddenColorsVisitor {
+  using color_t = typename colors_t::non_const_value_type;
+
+  static constexpr color_t BITS = 64;
+
+  colors_t colors;
+  color_t offset;
+  uint64_t forbidden;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const lno_t y) {
+    const color_t c = colors(y);
+    if (c > offset && c <= offset + BITS) {
+      forbidden |= uint64_t(1) << (c - offset - 1);
+    }
+  }
+};
+
+// Updates a valid distance-1 (or distance-2) coloring of a symmetric graph
+// after edges were inserted and removed. Only the vertices that need it are
+// recolored:
+//  - for each pair of vertices with the same color that an inserted edge
+//    brought within distance 1 (or 2), the larger one
+//  - the uncolored vertices (color 0), such as the new ones
+//  - the endpoints of the removed edges, which may now fit a lower color.
+// These are recolored speculatively in parallel, each taking the smallest
+// color not used in its neighborhood, and of two marked vertices that end up
+// in conflict the larger one is recolored again, until there is no conflict.
+// A recolored vertex never takes a color larger than its old one if that is
+// still free, so the number of colors stays stable over many updates.
+template <typename device_t, typename rowmap_t, typename entries_t,
+          typename colors_t, bool distance2>
+struct IncrementalColoring {
+  using exec_space  = typename device_t::execution_space;
+  using mem_space   = typename device_t::memory_space;
+  using size_type   = typename rowmap_t::non_const_value_type;
+  using lno_t       = typename entries_t::non_const_value_type;
+  using color_t     = typename colors_t::non_const_value_type;
+  using range_pol   = Kokkos::RangePolicy<exec_space>;
+  using lno_view_t  = Kokkos::View<lno_t*, mem_space>;
+  using flag_view_t = Kokkos::View<int*, mem_space>;
+  using nbhd_t      = ColorNeighborhood<rowmap_t, entries_t, distance2>;
+  using forbidden_t = ForbiddenColorsVisitor<colors_t, lno_t>;
+
+  nbhd_t nbhd;
+  colors_t colors;
+  // the vertices to recolor
+  flag_view_t recolor;
+
+  IncrementalColoring(const rowmap_t& rowmap_, const entries_t& entries_,
+                      lno_t numVerts_, const colors_t& colors_)
+      : nbhd{rowmap_, entries_, numVerts_},
+        colors(colors_),
+        recolor("Recolor flags", numVerts_) {}
+
+  // Marks as candidates the endpoints of every inserted edge and, for
+  // distance 2, their neighbors: any new conflict is between two of them.
+  template <typename edges_t>
+  struct MarkInsertedFunctor {
+    nbhd_t nbhd;
+    edges_t src;
+    edges_t dst;
+    flag_view_t candidate;
+
+    KOKKOS_INLINE_FUNCTION void markAround(const lno_t u) const {
+      candidate(u) = 1;
+      if (!distance2) return;
+      for (size_type i = nbhd.rowmap(u); i < nbhd.rowmap(u + 1); i++) {
+        const lno_t x = nbhd.entries(i);
+        if (x < nbhd.numVerts) candidate(x) = 1;
+      }
+    }
+
+    KOKKOS_INLINE_FUNCTION void operator()(const size_type i) const {
+      const lno_t u = src(i);
+      const lno_t v = dst(i);
+      if (u == v || u < 0 || v < 0 || u >= nbhd.numVerts ||
+          v >= nbhd.numVerts)
+        return;
+      markAround(u);
+      markAround(v);
+    }
+  };
+
+  template <typename edges_t>
+  struct MarkRemovedFunctor {
+    edges_t src;
+    edges_t dst;
+    lno_t numVerts;
+    flag_view_t recolor;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const size_type i) const {
+      const lno_t u = src(i);
+      const lno_t v = dst(i);
+      if (u == v || u < 0 || v < 0 || u >= numVerts || v >= numVerts) return;
+      recolor(u) = 1;
+      recolor(v) = 1;
+    }
+  };
+
+  // Finds a vertex y < v with the color of v among the flagged ones.
+  struct ConflictVisitor {
+    colors_t colors;
+    flag_view_t flags;
+    lno_t v;
+    color_t color;
+    bool conflict;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t y) {
+      if (y < v && flags(y) && colors(y) == color) conflict = true;
+    }
+  };
+
+  struct CheckFunctor {
+    nbhd_t nbhd;
+    colors_t colors;
+    flag_view_t candidate;
+    flag_view_t recolor;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t v) const {
+      if (colors(v) == 0) {
+        recolor(v) = 1;
+      } else if (candidate(v)) {
+        ConflictVisitor visitor{colors, candidate, v, colors(v), false};
+        nbhd.visit(v, visitor);
+        if (visitor.conflict) recolor(v) = 1;
+      }
+    }
+  };
+
+  struct CompactFunctor {
+    flag_view_t flags;
+    lno_view_t list;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t v, lno_t& offset,
+                                           const bool final) const {
+      if (!flags(v)) return;
+      if (final) list(offset) = v;
+      offset++;
+    }
+  };
+
+  // First fit: the smallest color not used in the neighborhood, looked for
+  // forbidden_t::BITS colors at a time.
+  struct AssignFunctor {
+    nbhd_t nbhd;
+    colors_t colors;
+    lno_view_t worklist;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      const lno_t v = worklist(i);
+      for (color_t offset = 0;; offset += forbidden_t::BITS) {
+        forbidden_t visitor{colors, offset, 0};
+        nbhd.visit(v, visitor);
+        if (visitor.forbidden == ~uint64_t(0)) continue;
+        color_t c = 0;
+        while (visitor.forbidden & (uint64_t(1) << c)) c++;
+        colors(v) = offset + c + 1;
+        return;
+      }
+    }
+  };
+
+  // Keeps the vertices of the worklist that conflict with a smaller one.
+  struct ConflictFunctor {
+    nbhd_t nbhd;
+    colors_t colors;
+    flag_view_t recolor;
+    lno_view_t worklist;
+    lno_view_t next;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i, lno_t& offset,
+                                           const bool final) const {
+      const lno_t v = worklist(i);
+      ConflictVisitor visitor{colors, recolor, v, colors(v), false};
+      nbhd.visit(v, visitor);
+      if (!visitor.conflict) return;
+      if (final) next(offset) = v;
+      offset++;
+    }
+  };
+
+  struct SetFlagFunctor {
+    lno_view_t list;
+    flag_view_t flags;
+    int value;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      flags(list(i)) = value;
+    }
+  };
+
+  template <typename edges_t>
+  void markInserted(const edges_t& src, const edges_t& dst) {
+    const lno_t n = nbhd.numVerts;
+    flag_view_t candidate("Recolor candidates", n);
+    Kokkos::parallel_for(
+        "KokkosGraph::IncrementalColor::markInserted",
+        range_pol(0, src.extent(0)),
+        MarkInsertedFunctor<edges_t>{nbhd, src, dst, candidate});
+    Kokkos::parallel_for("KokkosGraph::IncrementalColor::check",
+                         range_pol(0, n),
+                         CheckFunctor{nbhd, colors, candidate, recolor});
+  }
+
+  template <typename edges_t>
+  void markRemoved(const edges_t& src, const edges_t& dst) {
+    Kokkos::parallel_for(
+        "KokkosGraph::IncrementalColor::markRemoved",
+        range_pol(0, src.extent(0)),
+        MarkRemovedFunctor<edges_t>{src, dst, nbhd.numVerts, recolor});
+  }
+
+  void recolorMarked() {
+    const lno_t n      = nbhd.numVerts;
+    lno_t worklistSize = 0;
+    lno_view_t worklist(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "Recolor worklist"),
+        n);
+    lno_view_t next(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "Recolor next"), n);
+    Kokkos::parallel_scan("KokkosGraph::IncrementalColor::worklist",
+                          range_pol(0, n), CompactFunctor{recolor, worklist},
+                          worklistSize);
+    while (worklistSize) {
+      Kokkos::parallel_for("KokkosGraph::IncrementalColor::assign",
+                           range_pol(0, worklistSize),
+                           AssignFunctor{nbhd, colors, worklist});
+      lno_t nextSize = 0;
+      Kokkos::parallel_scan(
+          "KokkosGraph::IncrementalColor::conflicts",
+          range_pol(0, worklistSize),
+          ConflictFunctor{nbhd, colors, recolor, worklist, next}, nextSize);
+      Kokkos::parallel_for("KokkosGraph::IncrementalColor::unmark",
+                           range_pol(0, worklistSize),
+                           SetFlagFunctor{worklist, recolor, 0});
+      Kokkos::parallel_for("KokkosGraph::IncrementalColor::remark",
+                           range_pol(0, nextSize),
+                           SetFlagFunctor{next, recolor, 1});
+      std::swap(worklist, next);
+      worklistSize = nextSize;
+    }
+  }
+};
+
+}  // namespace Impl
+}  // namespace KokkosGraph
+
+#endif
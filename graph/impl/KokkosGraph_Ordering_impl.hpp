@@ -0,0 +1,721 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSGRAPH_ORDERING_IMPL_HPP
+#define _KOKKOSGRAPH_ORDERING_IMPL_HPP
+
+#include "Kokkos_Core.hpp"
+#include "KokkosKernels_SimpleUtils.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosGraph_CoarsenConstruct.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace KokkosGraph {
+namespace Experimental {
+namespace Impl {
+
+// Approximate minimum degree ordering (Amestoy, Davis and Duff), on the host.
+//
+// The graph being eliminated is stored as a quotient graph: the eliminated
+// vertices are elements, each standing for the clique formed by its
+// variables, and each remaining variable keeps its lists of adjacent
+// variables and elements. The pivot absorbs the elements adjacent to it into
+// a new element Lp. Variables with the same adjacency are merged into
+// supervariables, eliminated together; the external degrees of the variables
+// of Lp are replaced by the upper bound
+//   min(d_old + |Lp \ i|, |A_i \ i| + |Lp \ i| + sum_e |L_e \ Lp|, n - k),
+// and the elements contained in Lp are absorbed (aggressive absorption).
+// Ties between variables of equal degree are broken by index, so the
+// ordering is deterministic.
+template <typename lno_t>
+class ApproximateMinimumDegree {
+ public:
+  // adj must be symmetric, without self loops or duplicates
+  explicit ApproximateMinimumDegree(std::vector<std::vector<lno_t>> adj)
+      : n(adj.size()),
+        vars(std::move(adj)),
+        elems(n),
+        members(n),
+        nv(n, 1),
+        degree(n),
+        esize(n, 0),
+        w(n, 0),
+        status(n, VARIABLE),
+        mark(n, -1),
+        wmark(n, -1) {}
+
+  // Returns the vertices in elimination order.
+  std::vector<lno_t> order() {
+    std::set<std::pair<lno_t, lno_t>> queue;
+    for (lno_t i = 0; i < n; i++) {
+      members[i].push_back(i);
+      degree[i] = vars[i].size();
+      queue.emplace(degree[i], i);
+    }
+    std::vector<lno_t> perm;
+    perm.reserve(n);
+    lno_t eliminated = 0;
+    for (lno_t step = 0; !queue.empty(); step++) {
+      const lno_t p = queue.begin()->second;
+      queue.erase(queue.begin());
+      // Lp: the variables adjacent to p, directly or through its elements
+      std::vector<lno_t> Lp;
+      auto addVariable = [&](lno_t i) {
+        if (status[i] == VARIABLE && mark[i] != step) {
+          mark[i] = step;
+          Lp.push_back(i);
+        }
+      };
+      mark[p] = step;
+      for (lno_t i : vars[p]) addVariable(i);
+      for (lno_t e : elems[p]) {
+        if (status[e] != ELEMENT) continue;
+        for (lno_t i : vars[e]) addVariable(i);
+        absorb(e);
+      }
+      status[p] = ELEMENT;
+      eliminated += nv[p];
+      perm.insert(perm.end(), members[p].begin(), members[p].end());
+      lno_t degme = 0;
+      for (lno_t i : Lp) {
+        queue.erase(std::make_pair(degree[i], i));
+        degme += nv[i];
+      }
+      // w(e) = |L_e \ Lp| for the other elements adjacent to Lp
+      for (lno_t i : Lp) {
+        for (lno_t e : elems[i]) {
+          if (status[e] != ELEMENT) continue;
+          if (wmark[e] != step) {
+            wmark[e] = step;
+            w[e]     = esize[e];
+          }
+          w[e] -= nv[i];
+        }
+      }
+      // the variables of Lp are now adjacent through p; the elements
+      // contained in Lp are absorbed
+      for (lno_t i : Lp) {
+        auto& E = elems[i];
+        E.erase(std::remove_if(E.begin(), E.end(),
+                               [&](lno_t e) {
+                                 if (status[e] != ELEMENT) return true;
+                                 if (w[e] == 0) absorb(e);
+                                 return w[e] == 0;
+                               }),
+                E.end());
+        E.push_back(p);
+        auto& V = vars[i];
+        V.erase(std::remove_if(V.begin(), V.end(),
+                               [&](lno_t j) {
+                                 return status[j] != VARIABLE ||
+                                        mark[j] == step;
+                               }),
+                V.end());
+      }
+      mergeIndistinguishable(Lp);
+      for (lno_t i : Lp) {
+        if (status[i] != VARIABLE) continue;
+        lno_t bound = degme - nv[i];
+        for (lno_t e : elems[i]) {
+          if (e != p) bound += w[e];
+        }
+        for (lno_t j : vars[i]) bound += nv[j];
+        degree[i] = std::min({degree[i] + degme - nv[i], bound,
+                              n - eliminated - nv[i]});
+        queue.emplace(degree[i], i);
+      }
+      Lp.erase(std::remove_if(Lp.begin(), Lp.end(),
+                              [&](lno_t i) { return status[i] != VARIABLE; }),
+               Lp.end());
+      vars[p]  = std::move(Lp);
+      elems[p] = std::vector<lno_t>();
+      esize[p] = degme;
+    }
+    return perm;
+  }
+
+ private:
+  enum Status : char { VARIABLE, MERGED, ELEMENT, ABSORBED };
+
+  void absorb(lno_t e) {
+    status[e] = ABSORBED;
+    vars[e]   = std::vector<lno_t>();
+  }
+
+  // Merges the variables of Lp with identical (pruned) adjacency lists,
+  // found by hashing the lists.
+  void mergeIndistinguishable(const std::vector<lno_t>& Lp) {
+    std::vector<std::pair<std::size_t, lno_t>> hashes;
+    hashes.reserve(Lp.size());
+    for (lno_t i : Lp) {
+      std::sort(elems[i].begin(), elems[i].end());
+      std::sort(vars[i].begin(), vars[i].end());
+      std::size_t h = 0;
+      for (lno_t e : elems[i]) h += e;
+      for (lno_t j : vars[i]) h += j;
+      hashes.emplace_back(h, i);
+    }
+    std::sort(hashes.begin(), hashes.end());
+    for (std::size_t a = 0; a < hashes.size(); a++) {
+      const lno_t i = hashes[a].second;
+      if (status[i] != VARIABLE) continue;
+      for (std::size_t b = a + 1;
+           b < hashes.size() && hashes[b].first == hashes[a].first; b++) {
+        const lno_t j = hashes[b].second;
+        if (status[j] != VARIABLE || elems[i] != elems[j] ||
+            vars[i] != vars[j])
+          continue;
+        nv[i] += nv[j];
+        nv[j]     = 0;
+        status[j] = MERGED;
+        members[i].insert(members[i].end(), members[j].begin(),
+                          members[j].end());
+        members[j] = std::vector<lno_t>();
+        elems[j]   = std::vector<lno_t>();
+        vars[j]    = std::vector<lno_t>();
+      }
+    }
+  }
+
+  lno_t n;
+  // adjacent variables; for an element, its variables
+  std::vector<std::vector<lno_t>> vars;
+  // adjacent elements
+  std::vector<std::vector<lno_t>> elems;
+  // the vertices of each supervariable
+  std::vector<std::vector<lno_t>> members;
+  // size of each supervariable (0 once merged)
+  std::vector<lno_t> nv;
+  // approximate external degree of each variable
+  std::vector<lno_t> degree;
+  // |L_e| of each element, counting the supervariable sizes
+  std::vector<lno_t> esize;
+  std::vector<lno_t> w;
+  std::vector<Status> status;
+  std::vector<lno_t> mark;
+  std::vector<lno_t> wmark;
+};
+
+// exclude from Cuda builds without lambdas enabled, like coarse_builder
+#if !defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_CUDA_LAMBDA)
+
+// Nested dissection ordering (George), with multilevel bisection.
+//
+// Each subgraph larger than leafSize is extracted and bisected: it is
+// coarsened with coarse_builder, the coarsest graph is split by graph growing
+// from a few seeds (keeping the smallest cut), and the split is projected
+// back level by level and refined by moving the vertices with a positive
+// gain, one side at a time, within a 5% imbalance. The boundary of the side
+// with the fewer boundary vertices is the vertex separator, numbered after
+// the two sides, which are then dissected in turn. The remaining subgraphs
+// (the leaves) are ordered by approximate minimum degree on the host, in
+// parallel over the leaves.
+//
+// coarse_builder uses random matchings, so the ordering is not deterministic.
+template <typename device_t, typename rowmap_t, typename entries_t,
+          typename labels_t>
+struct NestedDissection {
+  using exec_space    = typename device_t::execution_space;
+  using size_type     = typename rowmap_t::non_const_value_type;
+  using lno_t         = typename entries_t::non_const_value_type;
+  using range_pol     = Kokkos::RangePolicy<exec_space>;
+  using matrix_t      =
+      KokkosSparse::CrsMatrix<lno_t, lno_t, device_t, void, size_type>;
+  using coarsener_t   = coarse_builder<matrix_t>;
+  using lno_view_t    = typename coarsener_t::vtx_view_t;
+  using offset_view_t = typename coarsener_t::edge_view_t;
+  using part_view_t   = Kokkos::View<int*, typename matrix_t::device_type>;
+  using g_rowmap_t    = typename matrix_t::row_map_type;
+  using g_entries_t   = typename matrix_t::index_type;
+  using g_values_t    = typename matrix_t::values_type;
+
+  static constexpr int REFINE_SWEEPS = 8;
+  static constexpr int GROW_SEEDS    = 4;
+
+  rowmap_t rowmap;
+  entries_t entries;
+  lno_t numVerts;
+  lno_t leafSize;
+  labels_t labels;
+  // position of each vertex in its subgraph
+  lno_view_t localIds;
+  // the last subgraph extracted with each vertex
+  lno_view_t owner;
+
+  NestedDissection(const rowmap_t& rowmap_, const entries_t& entries_,
+                   lno_t leafSize_)
+      : rowmap(rowmap_),
+        entries(entries_),
+        numVerts(rowmap_.extent(0) ? rowmap_.extent(0) - 1 : 0),
+        leafSize(leafSize_),
+        labels(Kokkos::view_alloc(Kokkos::WithoutInitializing, "ND Labels"),
+               numVerts),
+        localIds(Kokkos::view_alloc(Kokkos::WithoutInitializing, "ND ids"),
+                 numVerts),
+        owner(Kokkos::view_alloc(Kokkos::WithoutInitializing, "ND owner"),
+              numVerts) {
+    Kokkos::deep_copy(owner, lno_t(-1));
+  }
+
+  struct MarkFunctor {
+    lno_view_t verts;
+    lno_view_t owner;
+    lno_view_t localIds;
+    lno_t stamp;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      owner(verts(i))    = stamp;
+      localIds(verts(i)) = i;
+    }
+  };
+
+  // Counts (subEntries empty) or fills the rows of the subgraph induced by
+  // the vertices marked with stamp.
+  struct ExtractFunctor {
+    rowmap_t rowmap;
+    entries_t entries;
+    lno_view_t verts;
+    lno_view_t owner;
+    lno_view_t localIds;
+    lno_t numVerts;
+    lno_t stamp;
+    offset_view_t subRowmap;
+    lno_view_t subEntries;
+    lno_view_t subValues;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      const lno_t v     = verts(i);
+      const bool fill   = subEntries.extent(0);
+      size_type counter = fill ? subRowmap(i) : 0;
+      for (size_type j = rowmap(v); j < rowmap(v + 1); j++) {
+        const lno_t nei = entries(j);
+        if (nei >= numVerts || nei == v || owner(nei) != stamp) continue;
+        if (fill) {
+          subEntries(counter) = localIds(nei);
+          subValues(counter)  = 1;
+        }
+        counter++;
+      }
+      if (!fill) subRowmap(i) = counter;
+    }
+  };
+
+  struct ProjectFunctor {
+    g_entries_t vcmap;
+    part_view_t coarsePart;
+    part_view_t finePart;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      finePart(i) = coarsePart(vcmap(i));
+    }
+  };
+
+  // Weight of side 1
+  struct SideWeightFunctor {
+    part_view_t part;
+    lno_view_t vtxWgts;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i, lno_t& sum) const {
+      if (part(i) == 1) sum += vtxWgts(i);
+    }
+  };
+
+  // moveWgts(i) is the weight of i if i is on side and moving it to the
+  // other side reduces the cut, 0 otherwise.
+  struct GainFunctor {
+    g_rowmap_t rowmap;
+    g_entries_t entries;
+    g_values_t values;
+    lno_view_t vtxWgts;
+    part_view_t part;
+    int side;
+    lno_view_t moveWgts;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      lno_t gain = 0;
+      if (part(i) == side) {
+        for (size_type j = rowmap(i); j < rowmap(i + 1); j++) {
+          if (entries(j) == i) continue;
+          gain += part(entries(j)) == side ? -values(j) : values(j);
+        }
+      }
+      moveWgts(i) = gain > 0 ? vtxWgts(i) : lno_t(0);
+    }
+  };
+
+  // Moves the candidates in index order, as long as the moved weight fits.
+  // The candidates all leave the same side, so the cut decreases by at least
+  // the sum of their gains.
+  struct MoveFunctor {
+    lno_view_t moveWgts;
+    part_view_t part;
+    int side;
+    lno_t allowed;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i, lno_t& offset,
+                                           bool final) const {
+      const lno_t wgt = moveWgts(i);
+      if (final && wgt > 0 && offset + wgt <= allowed) part(i) = 1 - side;
+      offset += wgt;
+    }
+  };
+
+  // Counts the vertices of side adjacent to the other side; if sep is not
+  // empty, they are put in the separator (part 2).
+  struct SeparatorFunctor {
+    g_rowmap_t rowmap;
+    g_entries_t entries;
+    part_view_t part;
+    int side;
+    part_view_t sep;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i, lno_t& count) const {
+      bool boundary = false;
+      if (part(i) == side) {
+        for (size_type j = rowmap(i); j < rowmap(i + 1) && !boundary; j++) {
+          boundary = part(entries(j)) == 1 - side;
+        }
+      }
+      if (boundary) count++;
+      if (sep.extent(0)) sep(i) = boundary ? 2 : part(i);
+    }
+  };
+
+  // Lists the vertices of verts in part which, in order (counts them if
+  // selected is empty).
+  struct SelectFunctor {
+    part_view_t part;
+    int which;
+    lno_view_t verts;
+    lno_view_t selected;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i, lno_t& offset,
+                                           bool final) const {
+      if (part(i) != which) return;
+      if (final && selected.extent(0)) selected(offset) = verts(i);
+      offset++;
+    }
+  };
+
+  struct LabelFunctor {
+    lno_view_t verts;
+    labels_t labels;
+    lno_t first;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      labels(verts(i)) = first + i;
+    }
+  };
+
+  // The subgraph induced by verts, with unit weights.
+  matrix_t extract(const lno_view_t& verts, lno_t stamp) {
+    const lno_t n = verts.extent(0);
+    Kokkos::parallel_for("KokkosGraph::ND::mark", range_pol(0, n),
+                         MarkFunctor{verts, owner, localIds, stamp});
+    offset_view_t subRowmap("ND subgraph rowmap", n + 1);
+    ExtractFunctor extractor{rowmap,   entries,   verts,
+                             owner,    localIds,  numVerts,
+                             stamp,    subRowmap, lno_view_t(),
+                             lno_view_t()};
+    Kokkos::parallel_for("KokkosGraph::ND::count", range_pol(0, n),
+                         extractor);
+    size_type nnz = 0;
+    KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<exec_space>(
+        n + 1, subRowmap, nnz);
+    extractor.subEntries = lno_view_t(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "ND subgraph entries"),
+        nnz);
+    extractor.subValues = lno_view_t(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "ND subgraph values"),
+        nnz);
+    if (nnz) {
+      Kokkos::parallel_for("KokkosGraph::ND::fill", range_pol(0, n),
+                           extractor);
+    }
+    return matrix_t("ND subgraph", n, n, nnz, extractor.subValues, subRowmap,
+                    extractor.subEntries);
+  }
+
+  // Lists the vertices of verts in part which, in order.
+  lno_view_t select(const part_view_t& part, int which,
+                    const lno_view_t& verts) {
+    const lno_t n = verts.extent(0);
+    lno_t count   = 0;
+    Kokkos::parallel_scan("KokkosGraph::ND::countPart", range_pol(0, n),
+                          SelectFunctor{part, which, verts, lno_view_t()},
+                          count);
+    lno_view_t selected(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "ND vertices"), count);
+    if (count) {
+      Kokkos::parallel_scan("KokkosGraph::ND::selectPart", range_pol(0, n),
+                            SelectFunctor{part, which, verts, selected});
+    }
+    return selected;
+  }
+
+  // Graph growing bisection of the coarsest graph, on the host: side 0 grows
+  // breadth-first from a seed until it holds half of the weight. The seeds
+  // are two far apart vertices, 0 and n / 2; the smallest cut is kept.
+  part_view_t growBisection(const matrix_t& g, const lno_view_t& vtxWgts) {
+    const lno_t n = g.numRows();
+    auto hRowmap  = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                       g.graph.row_map);
+    auto hEntries = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                        g.graph.entries);
+    auto hValues =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), g.values);
+    auto hWgts =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), vtxWgts);
+    lno_t total = 0;
+    for (lno_t i = 0; i < n; i++) total += hWgts(i);
+    std::vector<lno_t> queue;
+    std::vector<char> seen(n);
+    // Visits the vertices breadth-first from seed; with restart, continues
+    // from the first unseen vertex once a component is exhausted. Stops when
+    // visit returns false, and returns the last vertex visited.
+    auto sweep = [&](lno_t seed, bool restart, auto&& visit) -> lno_t {
+      std::fill(seen.begin(), seen.end(), char(0));
+      queue.assign(1, seed);
+      seen[seed]  = 1;
+      size_t head = 0;
+      lno_t next  = 0;
+      lno_t last  = seed;
+      while (true) {
+        if (head == queue.size()) {
+          if (!restart) break;
+          while (next < n && seen[next]) next++;
+          if (next == n) break;
+          seen[next] = 1;
+          queue.push_back(next);
+        }
+        const lno_t u = queue[head++];
+        if (!visit(u)) break;
+        last = u;
+        for (size_type j = hRowmap(u); j < hRowmap(u + 1); j++) {
+          const lno_t nei = hEntries(j);
+          if (!seen[nei]) {
+            seen[nei] = 1;
+            queue.push_back(nei);
+          }
+        }
+      }
+      return last;
+    };
+    auto visitAll   = [](lno_t) { return true; };
+    const lno_t far = sweep(0, false, visitAll);
+    const lno_t seeds[GROW_SEEDS] = {far, sweep(far, false, visitAll), 0,
+                                     n / 2};
+    std::vector<int> side(n), best;
+    lno_t bestCut = 0;
+    for (lno_t seed : seeds) {
+      std::fill(side.begin(), side.end(), 1);
+      lno_t weight = 0;
+      sweep(seed, true, [&](lno_t u) {
+        if (2 * weight >= total) return false;
+        side[u] = 0;
+        weight += hWgts(u);
+        return true;
+      });
+      lno_t cut = 0;
+      for (lno_t u = 0; u < n; u++) {
+        for (size_type j = hRowmap(u); j < hRowmap(u + 1); j++) {
+          if (side[hEntries(j)] != side[u]) cut += hValues(j);
+        }
+      }
+      if (best.empty() || cut < bestCut) {
+        best    = side;
+        bestCut = cut;
+      }
+    }
+    part_view_t part(Kokkos::view_alloc(Kokkos::WithoutInitializing, "ND part"),
+                     n);
+    auto hPart = Kokkos::create_mirror_view(part);
+    for (lno_t u = 0; u < n; u++) hPart(u) = best[u];
+    Kokkos::deep_copy(part, hPart);
+    return part;
+  }
+
+  // Refines the bisection part of g; total is the weight of the graph.
+  void refine(const matrix_t& g, const lno_view_t& vtxWgts,
+              const part_view_t& part, lno_t total) {
+    const lno_t n         = g.numRows();
+    const lno_t maxWeight = total / 2 + total / 40 + 1;
+    lno_view_t moveWgts(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "ND move weights"), n);
+    int idle = 0;
+    for (int pass = 0; pass < 2 * REFINE_SWEEPS && idle < 2; pass++) {
+      const int side = pass % 2;
+      lno_t weight1  = 0;
+      Kokkos::parallel_reduce("KokkosGraph::ND::sideWeight", range_pol(0, n),
+                              SideWeightFunctor{part, vtxWgts}, weight1);
+      // the moves go to the other side, which must stay under maxWeight
+      const lno_t allowed =
+          maxWeight - (side == 0 ? weight1 : total - weight1);
+      lno_t candidates = 0;
+      if (allowed > 0) {
+        Kokkos::parallel_for("KokkosGraph::ND::gains", range_pol(0, n),
+                             GainFunctor{g.graph.row_map, g.graph.entries,
+                                         g.values, vtxWgts, part, side,
+                                         moveWgts});
+        Kokkos::parallel_scan("KokkosGraph::ND::move", range_pol(0, n),
+                              MoveFunctor{moveWgts, part, side, allowed},
+                              candidates);
+      }
+      idle = candidates ? 0 : idle + 1;
+    }
+  }
+
+  // The vertex separator of the bisection part of g: the boundary of the
+  // side with the fewer boundary vertices.
+  part_view_t separate(const matrix_t& g, const part_view_t& part) {
+    const lno_t n     = g.numRows();
+    lno_t boundary[2] = {0, 0};
+    for (int side = 0; side < 2; side++) {
+      Kokkos::parallel_reduce("KokkosGraph::ND::boundary", range_pol(0, n),
+                              SeparatorFunctor{g.graph.row_map, g.graph.entries,
+                                               part, side, part_view_t()},
+                              boundary[side]);
+    }
+    const int side = boundary[1] < boundary[0] ? 1 : 0;
+    part_view_t sep(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "ND separator"), n);
+    lno_t sepSize = 0;
+    Kokkos::parallel_reduce(
+        "KokkosGraph::ND::separator", range_pol(0, n),
+        SeparatorFunctor{g.graph.row_map, g.graph.entries, part, side, sep},
+        sepSize);
+    return sep;
+  }
+
+  // Splits g in two sides and a separator (parts 0, 1 and 2).
+  part_view_t bisect(const matrix_t& g) {
+    typename coarsener_t::coarsen_handle handle;
+    coarsener_t::generate_coarse_graphs(handle, g, true);
+    // the vertex weights add up to the number of vertices at every level
+    const lno_t total = g.numRows();
+    auto coarse       = handle.results.rbegin();
+    part_view_t part  = growBisection(coarse->mtx, coarse->vtx_wgts);
+    refine(coarse->mtx, coarse->vtx_wgts, part, total);
+    for (auto fine = std::next(coarse); fine != handle.results.rend();
+         ++coarse, ++fine) {
+      const lno_t n = fine->mtx.numRows();
+      part_view_t finePart(
+          Kokkos::view_alloc(Kokkos::WithoutInitializing, "ND part"), n);
+      Kokkos::parallel_for(
+          "KokkosGraph::ND::project", range_pol(0, n),
+          ProjectFunctor{coarse->interp_mtx.graph.entries, part, finePart});
+      part = finePart;
+      refine(fine->mtx, fine->vtx_wgts, part, total);
+    }
+    return separate(g, part);
+  }
+
+  // Orders each leaf by approximate minimum degree. The leaf (first, size)
+  // holds the vertices labeled first to first + size - 1.
+  void orderLeaves(const std::vector<std::pair<lno_t, lno_t>>& leaves) {
+    using host_exec = Kokkos::DefaultHostExecutionSpace;
+    auto hRowmap =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), rowmap);
+    auto hEntries =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), entries);
+    auto hLabels =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), labels);
+    Kokkos::View<lno_t*, Kokkos::HostSpace> newLabels(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "ND Labels"),
+        numVerts);
+    Kokkos::deep_copy(newLabels, hLabels);
+    std::vector<lno_t> vertexAt(numVerts);
+    for (lno_t v = 0; v < numVerts; v++) vertexAt[hLabels(v)] = v;
+    Kokkos::parallel_for(
+        "KokkosGraph::ND::orderLeaves",
+        Kokkos::RangePolicy<host_exec>(0, leaves.size()),
+        [&](const size_t l) {
+          const lno_t first = leaves[l].first;
+          const lno_t size  = leaves[l].second;
+          std::vector<std::vector<lno_t>> adj(size);
+          for (lno_t k = 0; k < size; k++) {
+            const lno_t v = vertexAt[first + k];
+            for (size_type j = hRowmap(v); j < hRowmap(v + 1); j++) {
+              const lno_t nei = hEntries(j);
+              if (nei >= numVerts || nei == v) continue;
+              const lno_t pos = hLabels(nei) - first;
+              if (pos >= 0 && pos < size) adj[k].push_back(pos);
+            }
+            std::sort(adj[k].begin(), adj[k].end());
+            adj[k].erase(std::unique(adj[k].begin(), adj[k].end()),
+                         adj[k].end());
+          }
+          const std::vector<lno_t> perm =
+              ApproximateMinimumDegree<lno_t>(std::move(adj)).order();
+          for (lno_t k = 0; k < size; k++) {
+            newLabels(vertexAt[first + perm[k]]) = first + k;
+          }
+        });
+    Kokkos::deep_copy(labels, newLabels);
+  }
+
+  labels_t order() {
+    using task_t = std::pair<lno_view_t, lno_t>;
+    lno_view_t all(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "ND vertices"),
+        numVerts);
+    KokkosKernels::Impl::sequential_fill(all);
+    // the subgraphs to dissect, with their first label
+    std::vector<task_t> tasks(1, task_t(all, 0));
+    std::vector<std::pair<lno_t, lno_t>> leaves;
+    for (lno_t stamp = 0; !tasks.empty(); stamp++) {
+      const lno_view_t verts = tasks.back().first;
+      const lno_t first      = tasks.back().second;
+      tasks.pop_back();
+      const lno_t n = verts.extent(0);
+      if (n > leafSize && n > 1) {
+        const part_view_t part = bisect(extract(verts, stamp));
+        lno_view_t side0       = select(part, 0, verts);
+        lno_view_t side1       = select(part, 1, verts);
+        const lno_t n0         = side0.extent(0);
+        const lno_t n1         = side1.extent(0);
+        // a subgraph without a proper separator (a clique) is a leaf
+        if (n0 && n1) {
+          lno_view_t sep = select(part, 2, verts);
+          Kokkos::parallel_for("KokkosGraph::ND::labelSeparator",
+                               range_pol(0, sep.extent(0)),
+                               LabelFunctor{sep, labels, first + n0 + n1});
+          tasks.emplace_back(side0, first);
+          tasks.emplace_back(side1, first + n0);
+          continue;
+        }
+      }
+      Kokkos::parallel_for("KokkosGraph::ND::labelLeaf", range_pol(0, n),
+                           LabelFunctor{verts, labels, first});
+      leaves.emplace_back(first, n);
+    }
+    orderLeaves(leaves);
+    return labels;
+  }
+};
+
+#endif
+
+}  // namespace Impl
+}  // namespace Experimental
+}  // namespace KokkosGraph
+
+#endif
@@ -0,0 +1,179 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSGRAPH_PAGERANK_IMPL_HPP
+#define _KOKKOSGRAPH_PAGERANK_IMPL_HPP
+
+#include "Kokkos_Core.hpp"
+#include "Kokkos_ArithTraits.hpp"
+#include "KokkosBlas1_nrm1.hpp"
+#include "KokkosBlas2_gemv.hpp"
+#include "KokkosSparse_spmv.hpp"
+
+namespace KokkosGraph {
+namespace Impl {
+
+// Power iteration for (personalized) PageRank, with one column of ranks per
+// teleport vector t:
+//   x' = damping * (A^T D^-1 x + m t) + (1 - damping) * t
+// where D is the diagonal of the weighted out-degrees (row sums of A), and m
+// the mass of x on the dangling vertices (zero out-degree), which is sent to
+// the teleport vector. The column-stochastic operator is never formed: the
+// update keeps y = D^-1 x next to x, and every iteration is one (multivector)
+// transpose spmv with A, one gemv for the dangling masses and one update
+// kernel, which also reduces the change of x in norm 1.
+template <typename crsMat_t, typename mv_t>
+struct PageRank {
+  using exec_space = typename crsMat_t::execution_space;
+  using mem_space  = typename crsMat_t::memory_space;
+  using lno_t      = typename crsMat_t::non_const_ordinal_type;
+  using scalar_t   = typename mv_t::non_const_value_type;
+  using range_pol  = Kokkos::RangePolicy<exec_space>;
+  using vector_t   = Kokkos::View<scalar_t*, mem_space>;
+  using work_mv_t =
+      Kokkos::View<scalar_t**, Kokkos::LayoutLeft, typename mv_t::device_type>;
+
+  crsMat_t A;
+  lno_t numVerts;
+  int numCols;
+  scalar_t damping;
+  // teleport vectors, normalized; empty for the uniform one
+  work_mv_t teleport;
+  // 1 / out-degree, or 0 for the dangling vertices
+  vector_t invDegree;
+  // 1 for the dangling vertices, 0 for the others
+  vector_t dangling;
+  vector_t danglingMass;
+  // D^-1 x and A^T D^-1 x
+  work_mv_t scaled;
+  work_mv_t product;
+
+  PageRank(const crsMat_t& A_, const work_mv_t& teleport_, int numCols_,
+           scalar_t damping_)
+      : A(A_),
+        numVerts(A_.numRows()),
+        numCols(numCols_),
+        damping(damping_),
+        teleport(teleport_),
+        invDegree(Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                                     "PageRank inverse degrees"),
+                  numVerts),
+        dangling(Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                                    "PageRank dangling"),
+                 numVerts),
+        danglingMass("PageRank dangling mass", numCols),
+        scaled(Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                                  "PageRank scaled ranks"),
+               numVerts, numCols),
+        product(Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                                   "PageRank product"),
+                numVerts, numCols) {}
+
+  struct DegreeFunctor {
+    vector_t invDegree;
+    vector_t dangling;
+
+    // invDegree holds the out-degrees on entry
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t v) const {
+      const scalar_t degree = invDegree(v);
+      if (degree > Kokkos::ArithTraits<scalar_t>::zero()) {
+        invDegree(v) = scalar_t(1) / degree;
+        dangling(v)  = scalar_t(0);
+      } else {
+        invDegree(v) = scalar_t(0);
+        dangling(v)  = scalar_t(1);
+      }
+    }
+  };
+
+  // x := t, y := D^-1 x
+  struct InitFunctor {
+    mv_t ranks;
+    work_mv_t scaled;
+    work_mv_t teleport;
+    vector_t invDegree;
+    int numCols;
+    scalar_t uniform;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t v) const {
+      for (int j = 0; j < numCols; j++) {
+        const scalar_t x = teleport.extent(0) ? teleport(v, j) : uniform;
+        ranks(v, j)      = x;
+        scaled(v, j)     = x * invDegree(v);
+      }
+    }
+  };
+
+  // x := damping * A^T y + (damping * dangling mass + 1 - damping) * t,
+  // y := D^-1 x, reducing |x' - x|_1 over all the columns
+  struct UpdateFunctor {
+    mv_t ranks;
+    work_mv_t scaled;
+    work_mv_t product;
+    work_mv_t teleport;
+    vector_t invDegree;
+    vector_t danglingMass;
+    int numCols;
+    scalar_t damping;
+    scalar_t uniform;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t v,
+                                           scalar_t& change) const {
+      for (int j = 0; j < numCols; j++) {
+        const scalar_t t = teleport.extent(0) ? teleport(v, j) : uniform;
+        const scalar_t x =
+            damping * product(v, j) +
+            (damping * danglingMass(j) + (scalar_t(1) - damping)) * t;
+        change += Kokkos::ArithTraits<scalar_t>::abs(x - ranks(v, j));
+        ranks(v, j)  = x;
+        scaled(v, j) = x * invDegree(v);
+      }
+    }
+  };
+
+  // Returns the number of iterations done.
+  int compute(const mv_t& ranks, scalar_t tolerance, int maxIters) {
+    if (!numVerts) return 0;
+    const scalar_t uniform = scalar_t(1) / scalar_t(numVerts);
+    vector_t ones("PageRank ones", numVerts);
+    Kokkos::deep_copy(ones, scalar_t(1));
+    KokkosSparse::spmv("N", scalar_t(1), A, ones, scalar_t(0), invDegree);
+    Kokkos::parallel_for("KokkosGraph::pagerank::degrees",
+                         range_pol(0, numVerts),
+                         DegreeFunctor{invDegree, dangling});
+    Kokkos::parallel_for(
+        "KokkosGraph::pagerank::init", range_pol(0, numVerts),
+        InitFunctor{ranks, scaled, teleport, invDegree, numCols, uniform});
+    for (int iter = 1; iter <= maxIters; iter++) {
+      KokkosBlas::gemv("T", scalar_t(1), ranks, dangling, scalar_t(0),
+                       danglingMass);
+      KokkosSparse::spmv("T", scalar_t(1), A, scaled, scalar_t(0), product);
+      scalar_t change = 0;
+      Kokkos::parallel_reduce(
+          "KokkosGraph::pagerank::update", range_pol(0, numVerts),
+          UpdateFunctor{ranks, scaled, product, teleport, invDegree,
+                        danglingMass, numCols, damping, uniform},
+          change);
+      if (change < tolerance) return iter;
+    }
+    return maxIters;
+  }
+};
+
+}  // namespace Impl
+}  // namespace KokkosGraph
+
+#endif
@@ -0,0 +1,566 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSGRAPH_PARTITION_IMPL_HPP
+#define _KOKKOSGRAPH_PARTITION_IMPL_HPP
+
+#include "Kokkos_Core.hpp"
+#include "KokkosGraph_CoarsenConstruct.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+// exclude from Cuda builds without lambdas enabled, like coarse_builder
+#if !defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_CUDA_LAMBDA)
+
+namespace KokkosGraph {
+namespace Experimental {
+namespace Impl {
+
+// Multilevel k-way partitioning.
+//
+// The graph is coarsened with coarse_builder, the coarsest graph is split by
+// recursive bisection on the host (graph growing from a far vertex), and the
+// partition is projected back level by level and refined on device with the
+// Jet refinement (Gilbert, Madduri, Boman and Rajamanickam):
+//  - an unconstrained label propagation step proposes for every unlocked
+//    vertex its best connected other part, even at a small loss (up to
+//    FILTER_RATIO of its connectivity to its own part);
+//  - the "afterburner" recomputes each gain assuming that the proposals with
+//    a higher gain are applied, and drops the moves that no longer pay;
+//  - the vertices moved are locked for the next step;
+//  - while a part is heavier than the limit, rebalancing steps move instead
+//    the vertices of the heavy parts to the light ones, the smallest losses
+//    first (sorted in NUM_BUCKETS logarithmic buckets).
+// The best balanced partition seen at a level is kept once PATIENCE steps
+// brought no improvement.
+//
+// The graph must be symmetric; its values are the edge weights, which must
+// be nonnegative. coarse_builder uses random matchings, so the partition is
+// not deterministic.
+template <typename crsMat_t, typename part_view_t>
+struct KWayPartitioner {
+  using matrix_t    = crsMat_t;
+  using coarsener_t = coarse_builder<matrix_t>;
+  using exec_space  = typename matrix_t::execution_space;
+  using Device      = typename matrix_t::device_type;
+  using lno_t       = typename matrix_t::non_const_ordinal_type;
+  using size_type   = typename matrix_t::non_const_size_type;
+  using scalar_t    = typename matrix_t::non_const_value_type;
+  using vtx_view_t  = typename coarsener_t::vtx_view_t;
+  using flag_view_t = Kokkos::View<int*, Device>;
+  using range_pol   = Kokkos::RangePolicy<exec_space>;
+  using rowmap_t    = typename matrix_t::row_map_type;
+  using entries_t   = typename matrix_t::index_type;
+  using values_t    = typename matrix_t::values_type;
+
+  static constexpr int MAX_CANDIDATES  = 32;
+  static constexpr int NUM_BUCKETS     = 16;
+  static constexpr int MAX_STEPS       = 100;
+  static constexpr int PATIENCE        = 12;
+  static constexpr double FILTER_RATIO = 0.25;
+
+  lno_t numParts;
+  double imbalance;
+  // total vertex weight, and largest allowed part weight
+  lno_t totalWeight;
+  lno_t maxPartWeight;
+
+  KWayPartitioner(lno_t numParts_, double imbalance_)
+      : numParts(numParts_),
+        imbalance(imbalance_),
+        totalWeight(0),
+        maxPartWeight(0) {}
+
+  // Connectivity of a vertex to its own part, and to the first
+  // MAX_CANDIDATES other parts found in its row
+  struct Connectivity {
+    lno_t parts[MAX_CANDIDATES];
+    scalar_t conns[MAX_CANDIDATES];
+    int count    = 0;
+    scalar_t own = 0;
+
+    KOKKOS_INLINE_FUNCTION void add(const lno_t p, const scalar_t w) {
+      int c = 0;
+      while (c < count && parts[c] != p) c++;
+      if (c < count) {
+        conns[c] += w;
+      } else if (count < MAX_CANDIDATES) {
+        parts[count]   = p;
+        conns[count++] = w;
+      }
+    }
+
+    // the best connected other part (smallest index on ties), or -1
+    KOKKOS_INLINE_FUNCTION int best() const {
+      int b = -1;
+      for (int c = 0; c < count; c++) {
+        if (b == -1 || conns[c] > conns[b] ||
+            (conns[c] == conns[b] && parts[c] < parts[b]))
+          b = c;
+      }
+      return b;
+    }
+  };
+
+  struct ProjectFunctor {
+    entries_t vcmap;
+    part_view_t coarsePart;
+    part_view_t finePart;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      finePart(i) = coarsePart(vcmap(i));
+    }
+  };
+
+  struct PartWeightFunctor {
+    part_view_t part;
+    vtx_view_t vtxWgts;
+    vtx_view_t partWgts;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      Kokkos::atomic_add(&partWgts(part(i)), vtxWgts(i));
+    }
+  };
+
+  // Weight of the edges between parts, counted from both ends
+  struct CutFunctor {
+    rowmap_t rowmap;
+    entries_t entries;
+    values_t values;
+    part_view_t part;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i,
+                                           scalar_t& cut) const {
+      for (size_type j = rowmap(i); j < rowmap(i + 1); j++) {
+        if (part(entries(j)) != part(i)) cut += values(j);
+      }
+    }
+  };
+
+  // Proposes for each unlocked vertex its best connected other part, if the
+  // loss is at most FILTER_RATIO of its connectivity to its own part.
+  // Only the first MAX_CANDIDATES parts met in a row are considered.
+  struct LabelPropagationFunctor {
+    rowmap_t rowmap;
+    entries_t entries;
+    values_t values;
+    part_view_t part;
+    flag_view_t locked;
+    part_view_t dest;
+    Kokkos::View<scalar_t*, Device> gains;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      const lno_t own = part(i);
+      dest(i)         = own;
+      if (locked(i)) return;
+      Connectivity conn;
+      for (size_type j = rowmap(i); j < rowmap(i + 1); j++) {
+        const lno_t u = entries(j);
+        if (u == i) continue;
+        if (part(u) == own)
+          conn.own += values(j);
+        else
+          conn.add(part(u), values(j));
+      }
+      const int best = conn.best();
+      if (best == -1) return;
+      const scalar_t gain = conn.conns[best] - conn.own;
+      if (gain >= 0 || -double(gain) <= FILTER_RATIO * double(conn.own)) {
+        dest(i)  = conn.parts[best];
+        gains(i) = gain;
+      }
+    }
+  };
+
+  // Keeps the proposals whose gain is still nonnegative when the proposals
+  // of higher gain (ties broken by index) are applied.
+  struct AfterburnerFunctor {
+    rowmap_t rowmap;
+    entries_t entries;
+    values_t values;
+    part_view_t part;
+    part_view_t dest;
+    Kokkos::View<scalar_t*, Device> gains;
+    flag_view_t moves;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      const lno_t own = part(i);
+      const lno_t to  = dest(i);
+      moves(i)        = 0;
+      if (to == own) return;
+      scalar_t connOwn = 0, connTo = 0;
+      for (size_type j = rowmap(i); j < rowmap(i + 1); j++) {
+        const lno_t u = entries(j);
+        if (u == i) continue;
+        lno_t p = part(u);
+        if (dest(u) != p &&
+            (gains(u) > gains(i) || (gains(u) == gains(i) && u < i)))
+          p = dest(u);
+        if (p == own)
+          connOwn += values(j);
+        else if (p == to)
+          connTo += values(j);
+      }
+      moves(i) = connTo >= connOwn;
+    }
+  };
+
+  // Applies the moves, and locks the vertices moved.
+  struct MoveFunctor {
+    part_view_t dest;
+    flag_view_t moves;
+    part_view_t part;
+    flag_view_t locked;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      locked(i) = moves(i);
+      if (moves(i)) part(i) = dest(i);
+    }
+  };
+
+  // For each vertex of a heavy part, the light part it is best connected to
+  // (or light(i % numLight) if none is adjacent), and its position among the
+  // vertices of its part with the same loss bucket.
+  struct RebalanceFunctor {
+    rowmap_t rowmap;
+    entries_t entries;
+    values_t values;
+    part_view_t part;
+    vtx_view_t vtxWgts;
+    // excess weight of each part (0 if not heavy)
+    vtx_view_t excess;
+    flag_view_t isLight;
+    part_view_t light;
+    part_view_t dest;
+    flag_view_t bucket;
+    vtx_view_t position;
+    vtx_view_t bucketWgts;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      const lno_t own = part(i);
+      dest(i)         = own;
+      if (excess(own) == 0) return;
+      Connectivity conn;
+      for (size_type j = rowmap(i); j < rowmap(i + 1); j++) {
+        const lno_t u = entries(j);
+        if (u == i) continue;
+        if (part(u) == own)
+          conn.own += values(j);
+        else if (isLight(part(u)))
+          conn.add(part(u), values(j));
+      }
+      const int best = conn.best();
+      const lno_t to =
+          best == -1 ? light(i % lno_t(light.extent(0))) : conn.parts[best];
+      const scalar_t connTo = best == -1 ? scalar_t(0) : conn.conns[best];
+      double loss = double(conn.own - connTo);
+      int b       = 0;
+      if (loss > 0) {
+        for (b = 1; b < NUM_BUCKETS - 1 && loss >= 2.0; b++) loss /= 2.0;
+      }
+      dest(i)     = to;
+      bucket(i)   = b;
+      position(i) = Kokkos::atomic_fetch_add(
+          &bucketWgts(own * NUM_BUCKETS + b), vtxWgts(i));
+    }
+  };
+
+  // Moves the vertices of the heavy parts in bucket order until the excess
+  // weight is gone.
+  struct EvictFunctor {
+    part_view_t dest;
+    flag_view_t bucket;
+    vtx_view_t position;
+    vtx_view_t bucketStart;
+    vtx_view_t excess;
+    part_view_t part;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      const lno_t own = part(i);
+      if (dest(i) == own) return;
+      if (bucketStart(own * NUM_BUCKETS + bucket(i)) + position(i) <
+          excess(own))
+        part(i) = dest(i);
+    }
+  };
+
+  std::vector<lno_t> partWeights(const part_view_t& part,
+                                 const vtx_view_t& vtxWgts) {
+    vtx_view_t partWgts("part weights", numParts);
+    Kokkos::parallel_for("KokkosGraph::partition::partWeights",
+                         range_pol(0, part.extent(0)),
+                         PartWeightFunctor{part, vtxWgts, partWgts});
+    auto hPartWgts =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), partWgts);
+    return std::vector<lno_t>(hPartWgts.data(), hPartWgts.data() + numParts);
+  }
+
+  scalar_t cut(const matrix_t& g, const part_view_t& part) {
+    scalar_t sum = 0;
+    Kokkos::parallel_reduce(
+        "KokkosGraph::partition::cut", range_pol(0, g.numRows()),
+        CutFunctor{g.graph.row_map, g.graph.entries, g.values, part}, sum);
+    return sum;
+  }
+
+  template <typename T>
+  Kokkos::View<T*, Device> toDevice(const std::vector<T>& v,
+                                    const char* label) {
+    Kokkos::View<T*, Device> d(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, label), v.size());
+    auto h = Kokkos::create_mirror_view(d);
+    for (size_t i = 0; i < v.size(); i++) h(i) = v[i];
+    Kokkos::deep_copy(d, h);
+    return d;
+  }
+
+  // Recursive bisection of the coarsest graph, on the host: the first side
+  // of each bisection grows breadth-first from a far vertex until it holds
+  // its share of the weight.
+  part_view_t initialPartition(const matrix_t& g, const vtx_view_t& vtxWgts) {
+    const lno_t n = g.numRows();
+    auto hRowmap  = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                       g.graph.row_map);
+    auto hEntries = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                        g.graph.entries);
+    auto hWgts =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), vtxWgts);
+    std::vector<lno_t> part(n);
+    // the vertices of the subgraph being split are marked with its stamp
+    std::vector<lno_t> member(n, -1), seen(n, -1);
+    std::vector<lno_t> queue;
+    lno_t stamp = 0, sweepStamp = 0;
+    // Visits the vertices of the subgraph verts breadth-first from seed;
+    // with restart, continues from the next unseen vertex of verts once a
+    // component is exhausted. Stops when visit returns false, and returns
+    // the last vertex visited.
+    auto sweep = [&](const std::vector<lno_t>& verts, lno_t seed, bool restart,
+                     auto&& visit) -> lno_t {
+      sweepStamp++;
+      queue.assign(1, seed);
+      seen[seed]  = sweepStamp;
+      size_t head = 0;
+      size_t next = 0;
+      lno_t last  = seed;
+      while (true) {
+        if (head == queue.size()) {
+          if (!restart) break;
+          while (next < verts.size() && seen[verts[next]] == sweepStamp) {
+            next++;
+          }
+          if (next == verts.size()) break;
+          seen[verts[next]] = sweepStamp;
+          queue.push_back(verts[next]);
+        }
+        const lno_t u = queue[head++];
+        if (!visit(u)) break;
+        last = u;
+        for (size_type j = hRowmap(u); j < hRowmap(u + 1); j++) {
+          const lno_t nei = hEntries(j);
+          if (member[nei] == stamp && seen[nei] != sweepStamp) {
+            seen[nei] = sweepStamp;
+            queue.push_back(nei);
+          }
+        }
+      }
+      return last;
+    };
+    // the subgraphs to split, with their first part and number of parts
+    std::vector<std::tuple<std::vector<lno_t>, lno_t, lno_t>> tasks;
+    std::vector<lno_t> all(n);
+    std::iota(all.begin(), all.end(), lno_t(0));
+    tasks.emplace_back(std::move(all), 0, numParts);
+    while (!tasks.empty()) {
+      std::vector<lno_t> verts = std::move(std::get<0>(tasks.back()));
+      const lno_t first        = std::get<1>(tasks.back());
+      const lno_t parts        = std::get<2>(tasks.back());
+      tasks.pop_back();
+      if (parts == 1 || verts.empty()) {
+        for (lno_t v : verts) part[v] = first;
+        continue;
+      }
+      stamp++;
+      double total = 0;
+      for (lno_t v : verts) {
+        member[v] = stamp;
+        total += hWgts(v);
+      }
+      const lno_t parts0  = parts / 2;
+      const double target = total * parts0 / parts;
+      const lno_t far =
+          sweep(verts, verts[0], false, [](lno_t) { return true; });
+      std::vector<lno_t> side0, side1;
+      double weight0 = 0;
+      sweep(verts, far, true, [&](lno_t u) {
+        if (weight0 >= target) return false;
+        side0.push_back(u);
+        weight0 += hWgts(u);
+        return true;
+      });
+      for (lno_t v : side0) member[v] = -1;
+      for (lno_t v : verts) {
+        if (member[v] == stamp) side1.push_back(v);
+      }
+      tasks.emplace_back(std::move(side0), first, parts0);
+      tasks.emplace_back(std::move(side1), first + parts0, parts - parts0);
+    }
+    return toDevice(part, "partition");
+  }
+
+  // Moves vertices out of the parts heavier than maxPartWeight, to the parts
+  // lighter than the average; wgts are the part weights.
+  void rebalance(const matrix_t& g, const vtx_view_t& vtxWgts,
+                 const part_view_t& part, const std::vector<lno_t>& wgts,
+                 const part_view_t& dest, const flag_view_t& bucket,
+                 const vtx_view_t& position) {
+    const lno_t n = g.numRows();
+    std::vector<lno_t> excess(numParts), light;
+    std::vector<int> isLight(numParts);
+    for (lno_t p = 0; p < numParts; p++) {
+      excess[p]  = std::max<lno_t>(wgts[p] - maxPartWeight, 0);
+      isLight[p] = wgts[p] * numParts < totalWeight;
+      if (isLight[p]) light.push_back(p);
+    }
+    const vtx_view_t dExcess = toDevice(excess, "partition excess");
+    vtx_view_t bucketWgts("partition bucket weights", numParts * NUM_BUCKETS);
+    Kokkos::parallel_for(
+        "KokkosGraph::partition::rebalance", range_pol(0, n),
+        RebalanceFunctor{g.graph.row_map, g.graph.entries, g.values, part,
+                         vtxWgts, dExcess,
+                         toDevice(isLight, "partition light parts"),
+                         toDevice(light, "partition light parts"), dest,
+                         bucket, position, bucketWgts});
+    // the weight in the buckets before each bucket of its part
+    auto hBucketWgts =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), bucketWgts);
+    std::vector<lno_t> bucketStart(numParts * NUM_BUCKETS);
+    for (lno_t p = 0; p < numParts; p++) {
+      lno_t sum = 0;
+      for (int b = 0; b < NUM_BUCKETS; b++) {
+        bucketStart[p * NUM_BUCKETS + b] = sum;
+        sum += hBucketWgts(p * NUM_BUCKETS + b);
+      }
+    }
+    Kokkos::parallel_for(
+        "KokkosGraph::partition::evict", range_pol(0, n),
+        EvictFunctor{dest, bucket, position,
+                     toDevice(bucketStart, "partition bucket starts"),
+                     dExcess, part});
+  }
+
+  // Jet refinement of the partition part of g, with the vertex weights
+  // vtxWgts.
+  void refine(const matrix_t& g, const vtx_view_t& vtxWgts,
+              const part_view_t& part) {
+    const lno_t n = g.numRows();
+    part_view_t dest(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "partition dest"), n);
+    Kokkos::View<scalar_t*, Device> gains(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "partition gains"),
+        n);
+    flag_view_t locked("partition locks", n);
+    flag_view_t moves(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "partition moves"),
+        n);
+    flag_view_t bucket(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "partition buckets"),
+        n);
+    vtx_view_t position(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "partition position"),
+        n);
+    part_view_t best(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "partition best"), n);
+    Kokkos::deep_copy(best, part);
+    std::vector<lno_t> wgts = partWeights(part, vtxWgts);
+    lno_t heaviest          = *std::max_element(wgts.begin(), wgts.end());
+    lno_t bestHeaviest      = heaviest;
+    scalar_t bestCut        = cut(g, part);
+    for (int step = 0, stall = 0; step < MAX_STEPS && stall < PATIENCE;
+         step++) {
+      if (heaviest > maxPartWeight) {
+        rebalance(g, vtxWgts, part, wgts, dest, bucket, position);
+        Kokkos::deep_copy(locked, 0);
+      } else {
+        Kokkos::parallel_for(
+            "KokkosGraph::partition::labelPropagation", range_pol(0, n),
+            LabelPropagationFunctor{g.graph.row_map, g.graph.entries,
+                                    g.values, part, locked, dest, gains});
+        Kokkos::parallel_for(
+            "KokkosGraph::partition::afterburner", range_pol(0, n),
+            AfterburnerFunctor{g.graph.row_map, g.graph.entries, g.values,
+                               part, dest, gains, moves});
+        Kokkos::parallel_for("KokkosGraph::partition::move", range_pol(0, n),
+                             MoveFunctor{dest, moves, part, locked});
+      }
+      wgts     = partWeights(part, vtxWgts);
+      heaviest = *std::max_element(wgts.begin(), wgts.end());
+      const scalar_t stepCut = cut(g, part);
+      const bool better =
+          heaviest <= maxPartWeight
+              ? bestHeaviest > maxPartWeight || stepCut < bestCut
+              : heaviest < bestHeaviest;
+      if (better) {
+        Kokkos::deep_copy(best, part);
+        bestHeaviest = heaviest;
+        bestCut      = stepCut;
+        stall        = 0;
+      } else {
+        stall++;
+      }
+    }
+    Kokkos::deep_copy(part, best);
+  }
+
+  part_view_t partition(const matrix_t& g) {
+    const lno_t n = g.numRows();
+    totalWeight   = n;
+    maxPartWeight =
+        static_cast<lno_t>(std::ceil((1.0 + imbalance) * n / numParts));
+    typename coarsener_t::coarsen_handle handle;
+    handle.coarse_vtx_cutoff =
+        std::max<lno_t>(handle.coarse_vtx_cutoff, 8 * numParts);
+    handle.min_allowed_vtx =
+        std::max<lno_t>(handle.min_allowed_vtx, 4 * numParts);
+    coarsener_t::generate_coarse_graphs(handle, g, false);
+    auto coarse      = handle.results.rbegin();
+    part_view_t part = initialPartition(coarse->mtx, coarse->vtx_wgts);
+    refine(coarse->mtx, coarse->vtx_wgts, part);
+    for (auto fine = std::next(coarse); fine != handle.results.rend();
+         ++coarse, ++fine) {
+      const lno_t fineN = fine->mtx.numRows();
+      part_view_t finePart(
+          Kokkos::view_alloc(Kokkos::WithoutInitializing, "partition"), fineN);
+      Kokkos::parallel_for(
+          "KokkosGraph::partition::project", range_pol(0, fineN),
+          ProjectFunctor{coarse->interp_mtx.graph.entries, part, finePart});
+      part = finePart;
+      refine(fine->mtx, fine->vtx_wgts, part);
+    }
+    return part;
+  }
+};
+
+}  // namespace Impl
+}  // namespace Experimental
+}  // namespace KokkosGraph
+
+#endif
+
+#endif
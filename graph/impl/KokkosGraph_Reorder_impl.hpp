@@ -0,0 +1,336 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSGRAPH_REORDER_IMPL_HPP
+#define _KOKKOSGRAPH_REORDER_IMPL_HPP
+
+#include "Kokkos_Core.hpp"
+#include "KokkosKernels_SimpleUtils.hpp"
+#include "KokkosKernels_Sorting.hpp"
+#include "KokkosKernels_Utils.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosGraph_CoarsenConstruct.hpp"
+#include <cstddef>
+#include <iterator>
+
+namespace KokkosGraph {
+namespace Impl {
+
+// Cache-locality orderings. Every ordering is a stable sort of the vertices
+// by an integer key, so that the vertices with equal keys keep their
+// original relative order; labels(v) is the position of v after the sort.
+template <typename device_t, typename rowmap_t, typename entries_t,
+          typename labels_t>
+struct GraphReorder {
+  using exec_space = typename device_t::execution_space;
+  using mem_space  = typename device_t::memory_space;
+  using size_type  = typename rowmap_t::non_const_value_type;
+  using lno_t      = typename entries_t::non_const_value_type;
+  using range_pol  = Kokkos::RangePolicy<exec_space>;
+  using key_view_t = Kokkos::View<size_t*, mem_space>;
+  using lno_view_t = Kokkos::View<lno_t*, mem_space>;
+  // the symmetrized graph for the community ordering
+  using matrix_t =
+      KokkosSparse::CrsMatrix<lno_t, lno_t, device_t, void, size_type>;
+  using m_rowmap_t  = typename matrix_t::row_map_type::non_const_type;
+  using m_entries_t = typename matrix_t::index_type::non_const_type;
+
+  // number of groups of the degree-based grouping
+  static constexpr int NUM_GROUPS = 8;
+
+  rowmap_t rowmap;
+  entries_t entries;
+  lno_t numVerts;
+
+  GraphReorder(const rowmap_t& rowmap_, const entries_t& entries_)
+      : rowmap(rowmap_),
+        entries(entries_),
+        numVerts(rowmap_.extent(0) ? rowmap_.extent(0) - 1 : 0) {}
+
+  // Decreasing degree
+  struct DegreeSortKeyFunctor {
+    rowmap_t rowmap;
+    key_view_t keys;
+    size_type maxDegree;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      keys(i) = maxDegree - (rowmap(i + 1) - rowmap(i));
+    }
+  };
+
+  // Hub sorting: the hubs (degree above the average) by decreasing degree,
+  // then all the other vertices
+  struct HubSortKeyFunctor {
+    rowmap_t rowmap;
+    key_view_t keys;
+    size_type maxDegree;
+    double avgDegree;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      const size_type degree = rowmap(i + 1) - rowmap(i);
+      const bool hub         = degree > avgDegree;
+      keys(i)                = hub ? maxDegree - degree : maxDegree + 1;
+    }
+  };
+
+  // Degree-based grouping: group 0 holds the degrees of at least
+  // 2^(NUM_GROUPS - 2) times the average, each next group half of that, and
+  // the last group the degrees below the average
+  struct DegreeGroupKeyFunctor {
+    rowmap_t rowmap;
+    key_view_t keys;
+    double avgDegree;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      const double degree = rowmap(i + 1) - rowmap(i);
+      double threshold    = avgDegree;
+      int group           = NUM_GROUPS - 1;
+      while (group > 0 && degree >= threshold) {
+        group--;
+        threshold *= 2;
+      }
+      keys(i) = group;
+    }
+  };
+
+  struct InvertFunctor {
+    lno_view_t perm;
+    lno_view_t positions;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t k) const {
+      positions(perm(k)) = k;
+    }
+  };
+
+  struct MaxDegreeFunctor {
+    rowmap_t rowmap;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i,
+                                           size_type& lmax) const {
+      if (lmax < rowmap(i + 1) - rowmap(i)) lmax = rowmap(i + 1) - rowmap(i);
+    }
+  };
+
+  size_type maxDegree() const {
+    size_type result = 0;
+    if (numVerts) {
+      Kokkos::parallel_reduce(
+          "KokkosGraph::reorder::maxDegree", range_pol(0, numVerts),
+          MaxDegreeFunctor{rowmap}, Kokkos::Max<size_type>(result));
+    }
+    return result;
+  }
+
+  double avgDegree() const {
+    if (!numVerts) return 0;
+    auto nnz = Kokkos::subview(rowmap, numVerts);
+    size_type hNnz;
+    Kokkos::deep_copy(hNnz, nnz);
+    return double(hNnz) / numVerts;
+  }
+
+  // Positions of the vertices after a stable sort by keys
+  lno_view_t sortedPositions(const key_view_t& keys) const {
+    const lno_t n = keys.extent(0);
+    lno_view_t perm(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "reorder perm"), n);
+    KokkosKernels::Impl::sequential_fill(perm);
+    key_view_t keysAux(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "reorder keys aux"),
+        n);
+    lno_view_t permAux(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "reorder perm aux"),
+        n);
+    KokkosKernels::radixSort2(exec_space(), keys, perm, keysAux, permAux);
+    lno_view_t positions(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "reorder positions"),
+        n);
+    Kokkos::parallel_for("KokkosGraph::reorder::invert", range_pol(0, n),
+                         InvertFunctor{perm, positions});
+    return positions;
+  }
+
+  labels_t toLabels(const key_view_t& keys) const {
+    labels_t labels(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "Reorder Labels"),
+        numVerts);
+    Kokkos::deep_copy(labels, sortedPositions(keys));
+    return labels;
+  }
+
+  key_view_t allocKeys() const {
+    return key_view_t(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "reorder keys"),
+        numVerts);
+  }
+
+  labels_t degreeSort() const {
+    key_view_t keys = allocKeys();
+    Kokkos::parallel_for("KokkosGraph::reorder::degreeSort",
+                         range_pol(0, numVerts),
+                         DegreeSortKeyFunctor{rowmap, keys, maxDegree()});
+    return toLabels(keys);
+  }
+
+  labels_t hubSort() const {
+    key_view_t keys = allocKeys();
+    Kokkos::parallel_for(
+        "KokkosGraph::reorder::hubSort", range_pol(0, numVerts),
+        HubSortKeyFunctor{rowmap, keys, maxDegree(), avgDegree()});
+    return toLabels(keys);
+  }
+
+  labels_t degreeGrouping() const {
+    key_view_t keys = allocKeys();
+    Kokkos::parallel_for("KokkosGraph::reorder::degreeGrouping",
+                         range_pol(0, numVerts),
+                         DegreeGroupKeyFunctor{rowmap, keys, avgDegree()});
+    return toLabels(keys);
+  }
+
+// coarse_builder is excluded from Cuda builds without lambdas
+#if !defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_CUDA_LAMBDA)
+  // Counts (filtered empty) or copies the entries of each row that are
+  // neither self loops nor out of range.
+  struct FilterFunctor {
+    rowmap_t rowmap;
+    entries_t entries;
+    lno_t numVerts;
+    m_rowmap_t filteredRowmap;
+    m_entries_t filtered;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      const bool fill   = filtered.extent(0);
+      size_type counter = fill ? filteredRowmap(i) : 0;
+      for (size_type j = rowmap(i); j < rowmap(i + 1); j++) {
+        const lno_t nei = entries(j);
+        if (nei >= numVerts || nei == i) continue;
+        if (fill) filtered(counter) = nei;
+        counter++;
+      }
+      if (!fill) filteredRowmap(i) = counter;
+    }
+  };
+
+  // Key of each fine vertex: the position of its coarse vertex
+  struct ProjectKeyFunctor {
+    typename matrix_t::index_type vcmap;
+    lno_view_t coarsePos;
+    key_view_t keys;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      keys(i) = coarsePos(vcmap(i));
+    }
+  };
+
+  // Community ordering, in the spirit of Rabbit Order (Arai et al.): the
+  // communities are the aggregates of a multilevel coarsening of the
+  // symmetrized graph, and the vertices are numbered so that every aggregate
+  // is contiguous, at every level. The fine vertices are stably sorted by the
+  // position of their aggregate, from the coarsest level down, so that this
+  // is the depth-first order of the aggregation hierarchy.
+  labels_t communities() const {
+    using coarsener_t = KokkosGraph::Experimental::coarse_builder<matrix_t>;
+    // the graph without self loops, symmetrized for the coarsening
+    m_rowmap_t filteredRowmap("reorder rowmap", numVerts + 1);
+    Kokkos::parallel_for("KokkosGraph::reorder::countFiltered",
+                         range_pol(0, numVerts),
+                         FilterFunctor{rowmap, entries, numVerts,
+                                       filteredRowmap, m_entries_t()});
+    size_type filteredNnz = 0;
+    KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<exec_space>(
+        numVerts + 1, filteredRowmap, filteredNnz);
+    m_entries_t filtered(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "reorder entries"),
+        filteredNnz);
+    Kokkos::parallel_for(
+        "KokkosGraph::reorder::filter", range_pol(0, numVerts),
+        FilterFunctor{rowmap, entries, numVerts, filteredRowmap, filtered});
+    m_rowmap_t symRowmap;
+    m_entries_t symEntries;
+    KokkosKernels::Impl::symmetrize_graph_symbolic_hashmap<
+        m_rowmap_t, m_entries_t, m_rowmap_t, m_entries_t, exec_space>(
+        numVerts, filteredRowmap, filtered, symRowmap, symEntries);
+    m_entries_t values("reorder values", symEntries.extent(0));
+    Kokkos::deep_copy(values, lno_t(1));
+    matrix_t g("reorder graph", numVerts, numVerts, symEntries.extent(0),
+               values, symRowmap, symEntries);
+    typename coarsener_t::coarsen_handle handle;
+    coarsener_t::generate_coarse_graphs(handle, g, true);
+    auto coarse = handle.results.rbegin();
+    lno_view_t positions(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "reorder positions"),
+        coarse->mtx.numRows());
+    KokkosKernels::Impl::sequential_fill(positions);
+    for (auto fine = std::next(coarse); fine != handle.results.rend();
+         ++coarse, ++fine) {
+      const lno_t fineN = fine->mtx.numRows();
+      key_view_t keys(
+          Kokkos::view_alloc(Kokkos::WithoutInitializing, "reorder keys"),
+          fineN);
+      Kokkos::parallel_for(
+          "KokkosGraph::reorder::projectKeys", range_pol(0, fineN),
+          ProjectKeyFunctor{coarse->interp_mtx.graph.entries, positions, keys});
+      positions = sortedPositions(keys);
+    }
+    labels_t labels(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "Reorder Labels"),
+        numVerts);
+    Kokkos::deep_copy(labels, positions);
+    return labels;
+  }
+#endif
+};
+
+// Counts the entries of the rows of P A P^T: row labels(i) is row i of A.
+template <typename lno_t, typename rowmap_t, typename labels_t,
+          typename new_rowmap_t>
+struct PermuteCountFunctor {
+  rowmap_t rowmap;
+  labels_t labels;
+  new_rowmap_t newRowmap;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+    newRowmap(labels(i)) = rowmap(i + 1) - rowmap(i);
+  }
+};
+
+// Copies row i of A to row labels(i) of P A P^T, relabeling the columns.
+template <typename lno_t, typename rowmap_t, typename entries_t,
+          typename values_t, typename labels_t, typename new_rowmap_t,
+          typename new_entries_t, typename new_values_t>
+struct PermuteFillFunctor {
+  rowmap_t rowmap;
+  entries_t entries;
+  values_t values;
+  labels_t labels;
+  new_rowmap_t newRowmap;
+  new_entries_t newEntries;
+  new_values_t newValues;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+    auto k = newRowmap(labels(i));
+    for (auto j = rowmap(i); j < rowmap(i + 1); j++, k++) {
+      newEntries(k) = labels(entries(j));
+      newValues(k)  = values(j);
+    }
+  }
+};
+
+}  // namespace Impl
+}  // namespace KokkosGraph
+
+#endif
@@ -0,0 +1,358 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSGRAPH_SAMPLING_IMPL_HPP
+#define _KOKKOSGRAPH_SAMPLING_IMPL_HPP
+
+#include "Kokkos_Core.hpp"
+#include "KokkosKernels_HashmapAccumulator.hpp"
+#include "KokkosKernels_SimpleUtils.hpp"
+#include "KokkosKernels_Utils.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace KokkosGraph {
+namespace Impl {
+
+// Batched k-hop neighborhood sampling: one team per seed.
+//
+// The vertices of a sample are numbered in the order they are first reached,
+// with a HashmapAccumulator mapping the original ids to the local ones; the
+// frontier of every hop is then the range of local ids added by the previous
+// hop. The threads of the team sample the neighbors of the frontier
+// vertices (Floyd's algorithm over the row positions, with a counter-based
+// hash as random source), then one thread inserts them in the hashmap in
+// frontier order, so the numbering does not depend on the scheduling.
+//
+// The workspace of every sample is sized for the largest possible sample,
+// 1 + f_0 + f_0 f_1 + ... vertices (at most numVerts), and the samples are
+// compacted into a single CRS graph at the end.
+template <typename device_t, typename rowmap_t, typename entries_t,
+          typename seeds_t, typename offsets_t, typename lno_view_t>
+struct KHopSampler {
+  using exec_space    = typename device_t::execution_space;
+  using mem_space     = typename device_t::memory_space;
+  using size_type     = typename rowmap_t::non_const_value_type;
+  using lno_t         = typename entries_t::non_const_value_type;
+  using offset_t      = typename offsets_t::non_const_value_type;
+  using range_pol     = Kokkos::RangePolicy<exec_space>;
+  using team_pol      = Kokkos::TeamPolicy<exec_space>;
+  using team_member_t = typename team_pol::member_type;
+  using work_view_t   = Kokkos::View<lno_t*, mem_space>;
+  using hashmap_t     = KokkosKernels::Experimental::HashmapAccumulator<
+      lno_t, lno_t, lno_t, KokkosKernels::Experimental::HashOpType::bitwiseAnd>;
+
+  lno_t numVerts;
+  rowmap_t rowmap;
+  entries_t entries;
+  seeds_t seeds;
+  lno_t numSeeds;
+  Kokkos::View<int*, mem_space> fanouts;
+  int numHops;
+  uint64_t randomSeed;
+  // workspace sizes of every sample
+  lno_t maxVerts;
+  lno_t maxEdges;
+  lno_t hashSize;
+  // per sample: vertices (the hashmap keys), hashmap lists, sampled edges
+  // (original ids, then local ids), and row of every vertex in the edges
+  work_view_t sampleVerts;
+  work_view_t hashBegins;
+  work_view_t hashNexts;
+  work_view_t sampleEdges;
+  work_view_t rowBegins;
+  work_view_t rowCounts;
+  work_view_t vertCounts;
+
+  KHopSampler(const rowmap_t& rowmap_, const entries_t& entries_,
+              const seeds_t& seeds_, const std::vector<int>& fanouts_,
+              uint64_t randomSeed_)
+      : numVerts(rowmap_.extent(0) ? rowmap_.extent(0) - 1 : 0),
+        rowmap(rowmap_),
+        entries(entries_),
+        seeds(seeds_),
+        numSeeds(seeds_.extent(0)),
+        fanouts(Kokkos::view_alloc(Kokkos::WithoutInitializing, "fanouts"),
+                fanouts_.size()),
+        numHops(fanouts_.size()),
+        randomSeed(randomSeed_) {
+    // largest frontier of every hop, capped at numVerts
+    size_t frontier = 1, verts = 1, edges = 0;
+    for (int f : fanouts_) {
+      edges += frontier * f;
+      frontier = std::min<size_t>(frontier * f, numVerts);
+      verts += frontier;
+    }
+    maxVerts = std::min<size_t>(verts, numVerts);
+    maxEdges = edges;
+    hashSize = 1;
+    while (hashSize < maxVerts) hashSize *= 2;
+    auto fanoutsHost = Kokkos::create_mirror_view(fanouts);
+    for (int h = 0; h < numHops; h++) fanoutsHost(h) = fanouts_[h];
+    Kokkos::deep_copy(fanouts, fanoutsHost);
+    const size_t n = numSeeds;
+    sampleVerts    = work_view_t(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "sample vertices"),
+        n * maxVerts);
+    hashBegins = work_view_t(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "sample hash begins"),
+        n * hashSize);
+    hashNexts = work_view_t(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "sample hash nexts"),
+        n * maxVerts);
+    sampleEdges = work_view_t(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "sample edges"),
+        n * maxEdges);
+    rowBegins = work_view_t(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "sample row begins"),
+        n * maxVerts);
+    rowCounts = work_view_t(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "sample row counts"),
+        n * maxVerts);
+    vertCounts = work_view_t("sample sizes", numSeeds);
+    Kokkos::deep_copy(hashBegins, lno_t(-1));
+  }
+
+  // splitmix64 finalizer
+  KOKKOS_INLINE_FUNCTION static uint64_t mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+  }
+
+  struct SampleFunctor {
+    rowmap_t rowmap;
+    entries_t entries;
+    seeds_t seeds;
+    Kokkos::View<int*, mem_space> fanouts;
+    int numHops;
+    uint64_t randomSeed;
+    lno_t numVerts;
+    lno_t maxVerts;
+    lno_t maxEdges;
+    lno_t hashSize;
+    work_view_t sampleVerts;
+    work_view_t hashBegins;
+    work_view_t hashNexts;
+    work_view_t sampleEdges;
+    work_view_t rowBegins;
+    work_view_t rowCounts;
+    work_view_t vertCounts;
+
+    // Writes up to f neighbors of u, chosen without replacement among the
+    // positions of its row, to out; returns how many.
+    KOKKOS_INLINE_FUNCTION lno_t sampleRow(const lno_t sample, const int hop,
+                                           const lno_t u, const int f,
+                                           lno_t* out) const {
+      const lno_t deg = rowmap(u + 1) - rowmap(u);
+      lno_t count     = 0;
+      if (deg <= f) {
+        for (lno_t j = 0; j < deg; j++) out[count++] = j;
+      } else {
+        const uint64_t key =
+            mix(mix(mix(randomSeed ^ uint64_t(sample)) ^ uint64_t(hop)) ^
+                uint64_t(u));
+        for (lno_t j = deg - f; j < deg; j++) {
+          lno_t pos = mix(key ^ uint64_t(j)) % uint64_t(j + 1);
+          for (lno_t k = 0; k < count; k++) {
+            if (out[k] == pos) {
+              pos = j;
+              break;
+            }
+          }
+          out[count++] = pos;
+        }
+      }
+      // positions to vertices, without the out-of-range columns
+      lno_t kept = 0;
+      for (lno_t k = 0; k < count; k++) {
+        const lno_t w = entries(rowmap(u) + out[k]);
+        if (w < numVerts) out[kept++] = w;
+      }
+      return kept;
+    }
+
+    // local id of a vertex inserted in the hashmap
+    KOKKOS_INLINE_FUNCTION static lno_t find(const hashmap_t& map,
+                                             const lno_t hashMask,
+                                             const lno_t v) {
+      for (lno_t i = map.hash_begins[v & hashMask]; i != -1;
+           i = map.hash_nexts[i]) {
+        if (map.keys[i] == v) return i;
+      }
+      return -1;
+    }
+
+    KOKKOS_INLINE_FUNCTION void operator()(const team_member_t t) const {
+      const lno_t sample = t.league_rank();
+      lno_t* verts       = sampleVerts.data() + size_t(sample) * maxVerts;
+      lno_t* edges       = sampleEdges.data() + size_t(sample) * maxEdges;
+      lno_t* begins      = rowBegins.data() + size_t(sample) * maxVerts;
+      lno_t* counts      = rowCounts.data() + size_t(sample) * maxVerts;
+      hashmap_t map(maxVerts, hashSize - 1,
+                    hashBegins.data() + size_t(sample) * hashSize,
+                    hashNexts.data() + size_t(sample) * maxVerts, verts,
+                    nullptr);
+      volatile lno_t* used = &vertCounts(sample);
+      Kokkos::single(Kokkos::PerTeam(t), [&]() {
+        map.vector_atomic_insert_into_hash(seeds(sample), used);
+      });
+      t.team_barrier();
+      lno_t hopBegin = 0, hopEnd = 1, edgeBase = 0;
+      for (int h = 0; h < numHops; h++) {
+        const int f = fanouts(h);
+        Kokkos::parallel_for(
+            Kokkos::TeamThreadRange(t, hopBegin, hopEnd), [&](const lno_t i) {
+              const lno_t k = edgeBase + (i - hopBegin) * f;
+              begins[i]     = k;
+              counts[i]     = sampleRow(sample, h, verts[i], f, edges + k);
+            });
+        t.team_barrier();
+        Kokkos::single(Kokkos::PerTeam(t), [&]() {
+          for (lno_t i = hopBegin; i < hopEnd; i++) {
+            for (lno_t k = begins[i]; k < begins[i] + counts[i]; k++) {
+              map.vector_atomic_insert_into_hash(edges[k], used);
+            }
+          }
+        });
+        t.team_barrier();
+        edgeBase += (hopEnd - hopBegin) * f;
+        hopBegin = hopEnd;
+        hopEnd   = *used;
+      }
+      // the last hop is not expanded
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(t, hopBegin, hopEnd),
+                           [&](const lno_t i) {
+                             begins[i] = edgeBase;
+                             counts[i] = 0;
+                           });
+      // relabel the edges
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(t, hopBegin),
+                           [&](const lno_t i) {
+                             for (lno_t k = begins[i];
+                                  k < begins[i] + counts[i]; k++) {
+                               edges[k] = find(map, hashSize - 1, edges[k]);
+                             }
+                           });
+    }
+  };
+
+  // Copies the vertices and the row lengths of every sample to their place
+  // in the output, given by sampleOffsets.
+  struct CopyVerticesFunctor {
+    offsets_t sampleOffsets;
+    work_view_t sampleVerts;
+    work_view_t rowCounts;
+    lno_t maxVerts;
+    lno_view_t vertices;
+    offsets_t subRowmap;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const team_member_t t) const {
+      const lno_t sample  = t.league_rank();
+      const offset_t base = sampleOffsets(sample);
+      const lno_t n       = sampleOffsets(sample + 1) - base;
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(t, n), [&](const lno_t i) {
+        const size_t k      = size_t(sample) * maxVerts + i;
+        vertices(base + i)  = sampleVerts(k);
+        subRowmap(base + i) = rowCounts(k);
+      });
+    }
+  };
+
+  struct CopyEdgesFunctor {
+    offsets_t sampleOffsets;
+    work_view_t sampleEdges;
+    work_view_t rowBegins;
+    work_view_t rowCounts;
+    lno_t maxVerts;
+    lno_t maxEdges;
+    offsets_t subRowmap;
+    lno_view_t subEntries;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const team_member_t t) const {
+      const lno_t sample  = t.league_rank();
+      const offset_t base = sampleOffsets(sample);
+      const lno_t n       = sampleOffsets(sample + 1) - base;
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(t, n), [&](const lno_t i) {
+        const size_t k      = size_t(sample) * maxVerts + i;
+        const size_t edges  = size_t(sample) * maxEdges + rowBegins(k);
+        const offset_t dest = subRowmap(base + i);
+        for (lno_t j = 0; j < rowCounts(k); j++) {
+          subEntries(dest + j) = sampleEdges(edges + j);
+        }
+      });
+    }
+  };
+
+  // vertCounts(i) as offsets
+  struct SizesFunctor {
+    work_view_t vertCounts;
+    offsets_t sampleOffsets;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      sampleOffsets(i) = vertCounts(i);
+    }
+  };
+
+  void compute(offsets_t& sampleOffsets, lno_view_t& vertices,
+               offsets_t& subRowmap, lno_view_t& subEntries) {
+    if (numSeeds) {
+      Kokkos::parallel_for(
+          "KokkosGraph::sample::khop", team_pol(numSeeds, Kokkos::AUTO),
+          SampleFunctor{rowmap, entries, seeds, fanouts, numHops, randomSeed,
+                        numVerts, maxVerts, maxEdges, hashSize, sampleVerts,
+                        hashBegins, hashNexts, sampleEdges, rowBegins,
+                        rowCounts, vertCounts});
+    }
+    sampleOffsets = offsets_t("Sample offsets", numSeeds + 1);
+    Kokkos::parallel_for("KokkosGraph::sample::sizes", range_pol(0, numSeeds),
+                         SizesFunctor{vertCounts, sampleOffsets});
+    offset_t totalVerts = 0;
+    KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<exec_space>(
+        numSeeds + 1, sampleOffsets, totalVerts);
+    vertices = lno_view_t(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "Sampled vertices"),
+        totalVerts);
+    subRowmap = offsets_t("Sampled rowmap", totalVerts + 1);
+    if (numSeeds) {
+      Kokkos::parallel_for(
+          "KokkosGraph::sample::vertices", team_pol(numSeeds, Kokkos::AUTO),
+          CopyVerticesFunctor{sampleOffsets, sampleVerts, rowCounts, maxVerts,
+                              vertices, subRowmap});
+    }
+    offset_t nnz = 0;
+    KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<exec_space>(
+        totalVerts + 1, subRowmap, nnz);
+    subEntries = lno_view_t(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "Sampled entries"),
+        nnz);
+    if (numSeeds) {
+      Kokkos::parallel_for(
+          "KokkosGraph::sample::edges", team_pol(numSeeds, Kokkos::AUTO),
+          CopyEdgesFunctor{sampleOffsets, sampleEdges, rowBegins, rowCounts,
+                           maxVerts, maxEdges, subRowmap, subEntries});
+    }
+  }
+};
+
+}  // namespace Impl
+}  // namespace KokkosGraph
+
+#endif
@@ -0,0 +1,456 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSGRAPH_TRAVERSAL_IMPL_HPP
+#define _KOKKOSGRAPH_TRAVERSAL_IMPL_HPP
+
+#include "Kokkos_Core.hpp"
+#include "Kokkos_Bitset.hpp"
+#include "Kokkos_ArithTraits.hpp"
+#include <cstdint>
+#include <utility>
+
+namespace KokkosGraph {
+namespace Impl {
+
+// Direction-optimizing breadth-first search (Beamer, Asanovic and Patterson).
+//
+// A top-down step expands the frontier, stored as a list of vertices: every
+// unvisited neighbor is claimed with a compare-and-swap on its parent. A
+// bottom-up step lets every unvisited vertex look for a neighbor in the
+// frontier, stored as a bitmap, and stops at the first one found: it reads
+// far fewer edges when the frontier is a large part of the graph. The search
+// switches to bottom-up when the edges out of the frontier (m_f) exceed the
+// edges out of the unvisited vertices (m_u) divided by ALPHA, and back to
+// top-down when the frontier shrinks below numVerts / BETA vertices.
+//
+// Bottom-up steps follow the edges backward, so they require a symmetric
+// graph; with directionOptimizing = false only top-down steps are done.
+template <typename device_t, typename rowmap_t, typename entries_t,
+          typename lno_view_t>
+struct BreadthFirstSearch {
+  using exec_space = typename device_t::execution_space;
+  using mem_space  = typename device_t::memory_space;
+  using bitset_t   = Kokkos::Bitset<device_t>;
+  using size_type  = typename rowmap_t::non_const_value_type;
+  using lno_t      = typename entries_t::non_const_value_type;
+  using range_pol  = Kokkos::RangePolicy<exec_space>;
+  using counter_t  = Kokkos::View<lno_t, mem_space>;
+
+  static constexpr double ALPHA = 14.0;
+  static constexpr double BETA  = 24.0;
+
+  lno_t numVerts;
+  rowmap_t rowmap;
+  entries_t entries;
+  bool directionOptimizing;
+  // level of every vertex (-1: unreached)
+  lno_view_t levels;
+  // parent of every vertex in the BFS tree (-1: unreached, source: itself)
+  lno_view_t parents;
+  // top-down frontiers
+  lno_view_t queue;
+  lno_view_t nextQueue;
+  counter_t queueTail;
+  // bottom-up frontiers
+  bitset_t frontier;
+  bitset_t next;
+
+  BreadthFirstSearch(const rowmap_t& rowmap_, const entries_t& entries_,
+                     bool directionOptimizing_)
+      : numVerts(rowmap_.extent(0) - 1),
+        rowmap(rowmap_),
+        entries(entries_),
+        directionOptimizing(directionOptimizing_),
+        levels(Kokkos::view_alloc(Kokkos::WithoutInitializing, "BFS levels"),
+               numVerts),
+        parents(Kokkos::view_alloc(Kokkos::WithoutInitializing, "BFS parents"),
+                numVerts),
+        queue(Kokkos::view_alloc(Kokkos::WithoutInitializing, "BFS queue"),
+              numVerts),
+        nextQueue(Kokkos::view_alloc(Kokkos::WithoutInitializing, "BFS queue"),
+                  numVerts),
+        queueTail("BFS queue tail"),
+        frontier(directionOptimizing_ ? numVerts : 0),
+        next(directionOptimizing_ ? numVerts : 0) {}
+
+  struct TopDownFunctor {
+    rowmap_t rowmap;
+    entries_t entries;
+    lno_view_t levels;
+    lno_view_t parents;
+    lno_view_t queue;
+    lno_view_t nextQueue;
+    counter_t queueTail;
+    lno_t numVerts;
+    lno_t depth;
+
+    // edges counts the edges out of the next frontier
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i,
+                                           size_type& edges) const {
+      const lno_t u = queue(i);
+      for (size_type j = rowmap(u); j < rowmap(u + 1); j++) {
+        const lno_t w = entries(j);
+        if (w >= numVerts || parents(w) != -1) continue;
+        if (Kokkos::atomic_compare_exchange(&parents(w), lno_t(-1), u) == -1) {
+          levels(w) = depth + 1;
+          nextQueue(Kokkos::atomic_fetch_add(&queueTail(), lno_t(1))) = w;
+          edges += rowmap(w + 1) - rowmap(w);
+        }
+      }
+    }
+  };
+
+  struct BottomUpFunctor {
+    rowmap_t rowmap;
+    entries_t entries;
+    lno_view_t levels;
+    lno_view_t parents;
+    bitset_t frontier;
+    bitset_t next;
+    lno_t numVerts;
+    lno_t depth;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t v) const {
+      if (parents(v) != -1) return;
+      for (size_type j = rowmap(v); j < rowmap(v + 1); j++) {
+        const lno_t w = entries(j);
+        if (w < numVerts && frontier.test(w)) {
+          parents(v) = w;
+          levels(v)  = depth + 1;
+          next.set(v);
+          return;
+        }
+      }
+    }
+  };
+
+  struct QueueToBitsetFunctor {
+    lno_view_t queue;
+    bitset_t bits;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      bits.set(queue(i));
+    }
+  };
+
+  struct BitsetToQueueFunctor {
+    bitset_t bits;
+    lno_view_t queue;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t v, lno_t& offset,
+                                           const bool final) const {
+      if (!bits.test(v)) return;
+      if (final) queue(offset) = v;
+      offset++;
+    }
+  };
+
+  // Sums the degrees of queue(i) (useQueue) or of the unvisited vertices.
+  struct DegreeSumFunctor {
+    rowmap_t rowmap;
+    lno_view_t queue;
+    lno_view_t parents;
+    bool useQueue;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i,
+                                           size_type& edges) const {
+      const lno_t v = useQueue ? queue(i) : i;
+      if (!useQueue && parents(v) != -1) return;
+      edges += rowmap(v + 1) - rowmap(v);
+    }
+  };
+
+  void compute(const lno_t source) {
+    exec_space exec;
+    Kokkos::deep_copy(exec, levels, lno_t(-1));
+    Kokkos::deep_copy(exec, parents, lno_t(-1));
+    Kokkos::deep_copy(exec, Kokkos::subview(levels, source), lno_t(0));
+    Kokkos::deep_copy(exec, Kokkos::subview(parents, source), source);
+    Kokkos::deep_copy(exec, Kokkos::subview(queue, 0), source);
+    size_type totalEdges = 0, sourceBegin = 0, sourceEnd = 0;
+    Kokkos::deep_copy(exec, totalEdges, Kokkos::subview(rowmap, numVerts));
+    Kokkos::deep_copy(exec, sourceBegin, Kokkos::subview(rowmap, source));
+    Kokkos::deep_copy(exec, sourceEnd, Kokkos::subview(rowmap, source + 1));
+    exec.fence();
+
+    bool topDown           = true;
+    lno_t frontierSize     = 1;
+    size_type frontierOut  = sourceEnd - sourceBegin;
+    size_type unvisitedOut = totalEdges - frontierOut;
+    for (lno_t depth = 0;; depth++) {
+      if (topDown && directionOptimizing &&
+          frontierOut > unvisitedOut / ALPHA) {
+        frontier.reset();
+        Kokkos::parallel_for("BFS::queueToBitset",
+                             range_pol(exec, 0, frontierSize),
+                             QueueToBitsetFunctor{queue, frontier});
+        topDown = false;
+      }
+      if (topDown) {
+        Kokkos::deep_copy(exec, queueTail, lno_t(0));
+        size_type nextOut = 0;
+        Kokkos::parallel_reduce(
+            "BFS::topDown", range_pol(exec, 0, frontierSize),
+            TopDownFunctor{rowmap, entries, levels, parents, queue, nextQueue,
+                           queueTail, numVerts, depth},
+            nextOut);
+        lno_t nextSize = 0;
+        Kokkos::deep_copy(exec, nextSize, queueTail);
+        exec.fence();
+        if (nextSize == 0) break;
+        std::swap(queue, nextQueue);
+        frontierSize = nextSize;
+        frontierOut  = nextOut;
+        unvisitedOut -= nextOut;
+      } else {
+        exec.fence();
+        next.reset();
+        Kokkos::parallel_for("BFS::bottomUp", range_pol(exec, 0, numVerts),
+                             BottomUpFunctor{rowmap, entries, levels, parents,
+                                             frontier, next, numVerts, depth});
+        exec.fence();
+        const lno_t nextSize = next.count();
+        if (nextSize == 0) break;
+        std::swap(frontier, next);
+        const bool shrinking = nextSize < frontierSize;
+        frontierSize         = nextSize;
+        if (shrinking && frontierSize < numVerts / BETA) {
+          Kokkos::parallel_scan("BFS::bitsetToQueue",
+                                range_pol(exec, 0, numVerts),
+                                BitsetToQueueFunctor{frontier, queue});
+          Kokkos::parallel_reduce(
+              "BFS::frontierEdges", range_pol(exec, 0, frontierSize),
+              DegreeSumFunctor{rowmap, queue, parents, true}, frontierOut);
+          Kokkos::parallel_reduce(
+              "BFS::unvisitedEdges", range_pol(exec, 0, numVerts),
+              DegreeSumFunctor{rowmap, queue, parents, false}, unvisitedOut);
+          topDown = true;
+        }
+      }
+    }
+    exec.fence();
+  }
+};
+
+// Delta-stepping single-source shortest paths (Meyer and Sanders).
+//
+// The vertices are put in buckets of width delta by tentative distance, and
+// the buckets are settled in increasing order. Settling bucket b relaxes the
+// light edges (weight <= delta) of its vertices until no distance in the
+// bucket changes, each round on a worklist of the vertices whose distance
+// just decreased; then the heavy edges of all the vertices settled in b are
+// relaxed once, since they can only reach later buckets. Distances are
+// lowered with atomic_fetch_min. The vertices whose distance decreased into
+// a later bucket are flagged pending, and the next bucket is the smallest one
+// holding a pending vertex.
+template <typename device_t, typename rowmap_t, typename entries_t,
+          typename values_t, typename dist_view_t>
+struct DeltaStepping {
+  using exec_space   = typename device_t::execution_space;
+  using mem_space    = typename device_t::memory_space;
+  using size_type    = typename rowmap_t::non_const_value_type;
+  using lno_t        = typename entries_t::non_const_value_type;
+  using dist_t       = typename dist_view_t::non_const_value_type;
+  using range_pol    = Kokkos::RangePolicy<exec_space>;
+  using lno_view_t   = Kokkos::View<lno_t*, mem_space>;
+  using stamp_view_t = Kokkos::View<int64_t*, mem_space>;
+  using flag_view_t  = Kokkos::View<int*, mem_space>;
+  using counter_t    = Kokkos::View<lno_t, mem_space>;
+
+  lno_t numVerts;
+  rowmap_t rowmap;
+  entries_t entries;
+  values_t values;
+  dist_t delta;
+  dist_view_t dist;
+  // light edge worklists
+  lno_view_t list;
+  lno_view_t nextList;
+  counter_t listTail;
+  // last round in which a vertex was put in nextList
+  stamp_view_t listStamp;
+  // the vertices settled in the current bucket
+  lno_view_t members;
+  counter_t membersTail;
+  // last bucket in which a vertex was put in members
+  stamp_view_t memberStamp;
+  // the distance of the vertex decreased into a later bucket
+  flag_view_t pending;
+
+  DeltaStepping(const rowmap_t& rowmap_, const entries_t& entries_,
+                const values_t& values_, dist_t delta_)
+      : numVerts(rowmap_.extent(0) - 1),
+        rowmap(rowmap_),
+        entries(entries_),
+        values(values_),
+        delta(delta_),
+        dist(Kokkos::view_alloc(Kokkos::WithoutInitializing, "SSSP distances"),
+             numVerts),
+        list(Kokkos::view_alloc(Kokkos::WithoutInitializing, "SSSP list"),
+             numVerts),
+        nextList(Kokkos::view_alloc(Kokkos::WithoutInitializing, "SSSP list"),
+                 numVerts),
+        listTail("SSSP list tail"),
+        listStamp(Kokkos::view_alloc(Kokkos::WithoutInitializing, "stamps"),
+                  numVerts),
+        members(Kokkos::view_alloc(Kokkos::WithoutInitializing, "members"),
+                numVerts),
+        membersTail("SSSP members tail"),
+        memberStamp(Kokkos::view_alloc(Kokkos::WithoutInitializing, "stamps"),
+                    numVerts),
+        pending("SSSP pending", numVerts) {}
+
+  KOKKOS_INLINE_FUNCTION static int64_t bucket(const dist_t d,
+                                               const dist_t delta) {
+    return int64_t(d / delta);
+  }
+
+  // Relaxes the light (or heavy) edges of list(i).
+  template <bool light>
+  struct RelaxFunctor {
+    rowmap_t rowmap;
+    entries_t entries;
+    values_t values;
+    dist_view_t dist;
+    lno_view_t list;
+    lno_view_t nextList;
+    counter_t listTail;
+    stamp_view_t listStamp;
+    lno_view_t members;
+    counter_t membersTail;
+    stamp_view_t memberStamp;
+    flag_view_t pending;
+    lno_t numVerts;
+    dist_t delta;
+    int64_t b;
+    int64_t round;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+      const lno_t u = list(i);
+      if constexpr (light) {
+        // u is in bucket b, so no relaxation can flag it again
+        pending(u) = 0;
+        if (Kokkos::atomic_exchange(&memberStamp(u), b) != b) {
+          members(Kokkos::atomic_fetch_add(&membersTail(), lno_t(1))) = u;
+        }
+      }
+      const dist_t du = dist(u);
+      for (size_type k = rowmap(u); k < rowmap(u + 1); k++) {
+        const lno_t w = entries(k);
+        if (w >= numVerts) continue;
+        const dist_t weight = values(k);
+        if (light ? weight > delta : weight <= delta) continue;
+        const dist_t dw = du + weight;
+        if (!(dw < dist(w))) continue;
+        if (!(dw < Kokkos::atomic_fetch_min(&dist(w), dw))) continue;
+        if (light && bucket(dw, delta) == b) {
+          if (Kokkos::atomic_exchange(&listStamp(w), round) != round) {
+            nextList(Kokkos::atomic_fetch_add(&listTail(), lno_t(1))) = w;
+          }
+        } else {
+          pending(w) = 1;
+        }
+      }
+    }
+  };
+
+  // Lists the pending vertices of bucket b, and clears their flag.
+  struct BucketListFunctor {
+    dist_view_t dist;
+    flag_view_t pending;
+    lno_view_t list;
+    dist_t delta;
+    int64_t b;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t v, lno_t& offset,
+                                           const bool final) const {
+      if (!pending(v) || bucket(dist(v), delta) != b) return;
+      if (final) {
+        list(offset) = v;
+        pending(v)   = 0;
+      }
+      offset++;
+    }
+  };
+
+  struct NextBucketFunctor {
+    dist_view_t dist;
+    flag_view_t pending;
+    dist_t delta;
+
+    KOKKOS_INLINE_FUNCTION void operator()(const lno_t v,
+                                           int64_t& lmin) const {
+      if (!pending(v)) return;
+      const int64_t bv = bucket(dist(v), delta);
+      if (bv < lmin) lmin = bv;
+    }
+  };
+
+  void compute(const lno_t source) {
+    exec_space exec;
+    Kokkos::deep_copy(exec, dist, Kokkos::ArithTraits<dist_t>::infinity());
+    Kokkos::deep_copy(exec, listStamp, int64_t(-1));
+    Kokkos::deep_copy(exec, memberStamp, int64_t(-1));
+    Kokkos::deep_copy(exec, Kokkos::subview(dist, source), dist_t(0));
+    Kokkos::deep_copy(exec, Kokkos::subview(pending, source), 1);
+    int64_t b     = 0;
+    int64_t round = 0;
+    while (true) {
+      lno_t listSize = 0;
+      Kokkos::parallel_scan("SSSP::bucketList", range_pol(exec, 0, numVerts),
+                            BucketListFunctor{dist, pending, list, delta, b},
+                            listSize);
+      Kokkos::deep_copy(exec, membersTail, lno_t(0));
+      // light edges, until the bucket does not change
+      while (listSize) {
+        Kokkos::deep_copy(exec, listTail, lno_t(0));
+        Kokkos::parallel_for(
+            "SSSP::relaxLight", range_pol(exec, 0, listSize),
+            RelaxFunctor<true>{rowmap, entries, values, dist, list, nextList,
+                               listTail, listStamp, members, membersTail,
+                               memberStamp, pending, numVerts, delta, b,
+                               round});
+        Kokkos::deep_copy(exec, listSize, listTail);
+        exec.fence();
+        std::swap(list, nextList);
+        round++;
+      }
+      // heavy edges, once
+      lno_t numMembers = 0;
+      Kokkos::deep_copy(exec, numMembers, membersTail);
+      exec.fence();
+      Kokkos::parallel_for(
+          "SSSP::relaxHeavy", range_pol(exec, 0, numMembers),
+          RelaxFunctor<false>{rowmap, entries, values, dist, members, nextList,
+                              listTail, listStamp, members, membersTail,
+                              memberStamp, pending, numVerts, delta, b,
+                              round});
+      int64_t nextBucket = Kokkos::ArithTraits<int64_t>::max();
+      Kokkos::parallel_reduce("SSSP::nextBucket", range_pol(exec, 0, numVerts),
+                              NextBucketFunctor{dist, pending, delta},
+                              Kokkos::Min<int64_t>(nextBucket));
+      if (nextBucket == Kokkos::ArithTraits<int64_t>::max()) break;
+      b = nextBucket;
+    }
+    exec.fence();
+  }
+};
+
+}  // namespace Impl
+}  // namespace KokkosGraph
+
+#endif
@@ -0,0 +1,158 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSGRAPH_BALANCECOLOR_HPP
+#define _KOKKOSGRAPH_BALANCECOLOR_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+
+#include "KokkosGraph_Distance1Color.hpp"
+#include "KokkosGraph_Distance2Color.hpp"
+#include "KokkosGraph_BalanceColor_impl.hpp"
+
+namespace KokkosGraph {
+namespace Impl {
+
+template <bool distance2, typename device_t, typename colors_t,
+          typename rowmap_t, typename entries_t>
+void balance_coloring(const char* name, const colors_t& colors,
+                      typename entries_t::non_const_value_type num_verts,
+                      const rowmap_t& row_map, const entries_t& entries) {
+  if ((num_verts && row_map.extent(0) < size_t(num_verts) + 1) ||
+      colors.extent(0) != size_t(num_verts)) {
+    std::ostringstream os;
+    os << "KokkosGraph::" << name << ": can't balance a coloring of "
+       << colors.extent(0) << " vertices for a graph of " << num_verts
+       << " vertices (row map of length " << row_map.extent(0) << ")";
+    throw std::invalid_argument(os.str());
+  }
+  BalanceColoring<device_t, rowmap_t, entries_t, colors_t, distance2> balancer(
+      row_map, entries, num_verts, colors);
+  balancer.run();
+}
+
+}  // namespace Impl
+
+namespace Experimental {
+
+/**
+ * Statistics of the color classes of a coloring: the number of colors, and
+ * the smallest, largest, mean size of their classes and its standard
+ * deviation. Uncolored vertices (color 0) are not counted.
+ */
+struct ColorClassStats {
+  int64_t num_colors = 0;
+  int64_t min_size   = 0;
+  int64_t max_size   = 0;
+  double mean_size   = 0;
+  double stddev_size = 0;
+};
+
+template <typename colors_t>
+ColorClassStats color_class_stats(const colors_t& colors) {
+  using exec_space  = typename colors_t::execution_space;
+  using sizes_t     = Kokkos::View<int64_t *, typename colors_t::device_type>;
+  using class_sizes = Impl::ColorClassSizes<exec_space, colors_t, sizes_t>;
+  ColorClassStats stats;
+  stats.num_colors = class_sizes::numColors(colors);
+  if (!stats.num_colors) return stats;
+  auto sizes = Kokkos::create_mirror_view_and_copy(
+      Kokkos::HostSpace(), class_sizes::count(colors, stats.num_colors));
+  stats.min_size = sizes(1);
+  double sum     = 0, sumSquares = 0;
+  for (int64_t c = 1; c <= stats.num_colors; c++) {
+    stats.min_size = std::min(stats.min_size, sizes(c));
+    stats.max_size = std::max(stats.max_size, sizes(c));
+    sum += sizes(c);
+    sumSquares += double(sizes(c)) * sizes(c);
+  }
+  const double mean = sum / stats.num_colors;
+  stats.mean_size   = mean;
+  stats.stddev_size =
+      std::sqrt(std::max(0.0, sumSquares / stats.num_colors - mean * mean));
+  return stats;
+}
+
+/**
+ * Rebalance the sizes of the color classes of a distance-1 coloring, as
+ * computed by graph_color, without changing the number of colors. Greedy
+ * colorings tend to give a few large classes and many tiny ones; in
+ * multicolor Gauss-Seidel, each class is one kernel launch. The vertices of
+ * the classes above the average size move to the smallest class they fit in
+ * (see KokkosGraph_BalanceColor_impl.hpp), so the coloring stays valid.
+ *
+ * @param[in]  handle        The Kernel Handle, after graph_color
+ * @param[in]  num_verts     Number of vertices in the graph
+ * @param[in]  row_map       Row map of the symmetric graph
+ * @param[in]  entries       Row entries of the symmetric graph
+ *
+ * \post
+ * <code>handle->get_graph_coloring_handle()->get_vertex_colors()</code>
+ *    is updated in place.
+ */
+template <class KernelHandle, typename InRowmap, typename InEntries>
+void graph_color_balance(KernelHandle *handle,
+                         typename KernelHandle::nnz_lno_t num_verts,
+                         InRowmap row_map, InEntries entries) {
+  using device_t = Kokkos::Device<typename KernelHandle::HandleExecSpace,
+                                  typename KernelHandle::HandleTempMemorySpace>;
+  auto gch = handle->get_graph_coloring_handle();
+  if (!gch || !gch->is_coloring_called()) {
+    throw std::runtime_error(
+        "KokkosGraph::graph_color_balance: the graph is not colored");
+  }
+  Kokkos::Timer timer;
+  Impl::balance_coloring<false, device_t>("graph_color_balance",
+                                          gch->get_vertex_colors(), num_verts,
+                                          row_map, entries);
+  gch->add_to_overall_coloring_time(timer.seconds());
+}
+
+/**
+ * Rebalance the sizes of the color classes of a distance-2 coloring, as
+ * computed by graph_color_distance2; same as graph_color_balance.
+ *
+ * \post
+ * <code>handle->get_distance2_graph_coloring_handle()->get_vertex_colors()</code>
+ *    is updated in place.
+ */
+template <class KernelHandle, typename InRowmap, typename InEntries>
+void graph_color_distance2_balance(KernelHandle *handle,
+                                   typename KernelHandle::nnz_lno_t num_verts,
+                                   InRowmap row_map, InEntries row_entries) {
+  using device_t = Kokkos::Device<typename KernelHandle::HandleExecSpace,
+                                  typename KernelHandle::HandleTempMemorySpace>;
+  auto gch_d2 = handle->get_distance2_graph_coloring_handle();
+  if (!gch_d2 || !gch_d2->is_coloring_called()) {
+    throw std::runtime_error(
+        "KokkosGraph::graph_color_distance2_balance: the graph is not "
+        "colored");
+  }
+  Kokkos::Timer timer;
+  Impl::balance_coloring<true, device_t>(
+      "graph_color_distance2_balance", gch_d2->get_vertex_colors(), num_verts,
+      row_map, row_entries);
+  gch_d2->add_to_overall_coloring_time(timer.seconds());
+}
+
+}  // end namespace Experimental
+}  // end namespace KokkosGraph
+
+#endif  // _KOKKOSGRAPH_BALANCECOLOR_HPP
@@ -0,0 +1,59 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSGRAPH_CONNECTEDCOMPONENTS_HPP
+#define _KOKKOSGRAPH_CONNECTEDCOMPONENTS_HPP
+
+#include "KokkosGraph_ConnectedComponents_impl.hpp"
+
+namespace KokkosGraph {
+
+// Connected components of a symmetric CRS graph, by Afforest (sampled
+// union-find). Returns the component of every vertex, and sets
+// numComponents. The components are numbered 0...numComponents-1 in the
+// order of their smallest vertex, so the labels are deterministic.
+//
+// Column indices >= num_verts are ignored.
+template <typename device_t, typename rowmap_t, typename colinds_t,
+          typename labels_t = typename colinds_t::non_const_type>
+labels_t graph_connected_components(
+    const rowmap_t& rowmap, const colinds_t& colinds,
+    typename colinds_t::non_const_value_type& numComponents) {
+  Impl::ConnectedComponents<device_t, rowmap_t, colinds_t, labels_t> algo(
+      rowmap, colinds);
+  return algo.compute(numComponents);
+}
+
+// Strongly connected components of a directed CRS graph, where the entry
+// (u, v) is the edge u -> v, by trimming, forward-backward search and
+// coloring (Multistep). Returns the component of every vertex, and sets
+// numComponents. As for graph_connected_components, the components are
+// numbered in the order of their smallest vertex.
+//
+// Self loops and column indices >= num_verts are ignored.
+template <typename device_t, typename rowmap_t, typename colinds_t,
+          typename labels_t = typename colinds_t::non_const_type>
+labels_t graph_strongly_connected_components(
+    const rowmap_t& rowmap, const colinds_t& colinds,
+    typename colinds_t::non_const_value_type& numComponents) {
+  Impl::StronglyConnectedComponents<device_t, rowmap_t, colinds_t, labels_t>
+      algo(rowmap, colinds);
+  return algo.compute(numComponents);
+}
+
+}  // namespace KokkosGraph
+
+#endif
@@ -0,0 +1,163 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSGRAPH_INCREMENTALCOLOR_HPP
+#define _KOKKOSGRAPH_INCREMENTALCOLOR_HPP
+
+#include <sstream>
+#include <stdexcept>
+
+#include "KokkosGraph_Distance1Color.hpp"
+#include "KokkosGraph_Distance2Color.hpp"
+#include "KokkosGraph_IncrementalColor_impl.hpp"
+
+namespace KokkosGraph {
+namespace Impl {
+
+// Returns the updated colors: the previous ones if the graph has as many
+// vertices, else a copy extended with uncolored vertices.
+template <bool distance2, typename device_t, typename colors_t,
+          typename rowmap_t, typename entries_t, typename edges_t>
+colors_t update_coloring(const char* name, const colors_t& prevColors,
+                         typename entries_t::non_const_value_type num_verts,
+                         const rowmap_t& row_map, const entries_t& entries,
+                         const edges_t& inserted_src,
+                         const edges_t& inserted_dst,
+                         const edges_t& removed_src,
+                         const edges_t& removed_dst) {
+  if ((num_verts && row_map.extent(0) < size_t(num_verts) + 1) ||
+      prevColors.extent(0) > size_t(num_verts) ||
+      inserted_src.extent(0) != inserted_dst.extent(0) ||
+      removed_src.extent(0) != removed_dst.extent(0)) {
+    std::ostringstream os;
+    os << "KokkosGraph::" << name << ": can't update a coloring of "
+       << prevColors.extent(0) << " vertices for a graph of " << num_verts
+       << " vertices (row map of length " << row_map.extent(0) << "), with "
+       << inserted_src.extent(0) << " / " << inserted_dst.extent(0)
+       << " inserted and " << removed_src.extent(0) << " / "
+       << removed_dst.extent(0) << " removed edge endpoints";
+    throw std::invalid_argument(os.str());
+  }
+  colors_t colors       = prevColors;
+  const size_t prevSize = prevColors.extent(0);
+  if (prevSize < size_t(num_verts)) {
+    colors = colors_t("Vertex Colors", num_verts);
+    Kokkos::deep_copy(
+        Kokkos::subview(colors, Kokkos::make_pair(size_t(0), prevSize)),
+        prevColors);
+  }
+  IncrementalColoring<device_t, rowmap_t, entries_t, colors_t, distance2>
+      coloring(row_map, entries, num_verts, colors);
+  coloring.markInserted(inserted_src, inserted_dst);
+  coloring.markRemoved(removed_src, removed_dst);
+  coloring.recolorMarked();
+  return colors;
+}
+
+}  // namespace Impl
+
+namespace Experimental {
+
+/**
+ * Update the distance-1 coloring of a symmetric graph after edges were
+ * inserted into it and removed from it, recoloring only the vertices that
+ * need it (see KokkosGraph_IncrementalColor_impl.hpp). The colors of the
+ * other vertices do not change, and the number of colors stays stable.
+ *
+ * If the graph has more vertices than the previous coloring, the new ones
+ * are colored too. The edges are given as pairs (src(i), dst(i)), in either
+ * direction; self loops and edges out of range are ignored. Without a
+ * previous coloring, this computes a full one with graph_color.
+ *
+ * @param[in]  handle        The Kernel Handle, with a graph coloring handle
+ * @param[in]  num_verts     Number of vertices in the updated graph
+ * @param[in]  row_map       Row map of the updated graph
+ * @param[in]  entries       Row entries of the updated graph
+ * @param[in]  inserted_src, inserted_dst  The inserted edges
+ * @param[in]  removed_src, removed_dst    The removed edges
+ *
+ * \post
+ * <code>handle->get_graph_coloring_handle()->get_vertex_colors()</code>
+ *    will return a view of length num_verts, containing the colors. The
+ *    previous colors view is updated in place if it has length num_verts.
+ */
+template <class KernelHandle, typename InRowmap, typename InEntries,
+          typename EdgeView>
+void graph_color_incremental(KernelHandle *handle,
+                             typename KernelHandle::nnz_lno_t num_verts,
+                             InRowmap row_map, InEntries entries,
+                             EdgeView inserted_src, EdgeView inserted_dst,
+                             EdgeView removed_src, EdgeView removed_dst) {
+  using device_t = Kokkos::Device<typename KernelHandle::HandleExecSpace,
+                                  typename KernelHandle::HandleTempMemorySpace>;
+  auto gch = handle->get_graph_coloring_handle();
+  if (!gch) {
+    throw std::runtime_error(
+        "KokkosGraph::graph_color_incremental: no graph coloring handle");
+  }
+  if (!gch->is_coloring_called()) {
+    graph_color(handle, num_verts, num_verts, row_map, entries);
+    return;
+  }
+  Kokkos::Timer timer;
+  gch->set_vertex_colors(Impl::update_coloring<false, device_t>(
+      "graph_color_incremental", gch->get_vertex_colors(), num_verts, row_map,
+      entries, inserted_src, inserted_dst, removed_src, removed_dst));
+  gch->add_to_overall_coloring_time(timer.seconds());
+  gch->set_coloring_time(timer.seconds());
+}
+
+/**
+ * Update the distance-2 coloring of a symmetric graph after edges were
+ * inserted into it and removed from it; same as graph_color_incremental for
+ * a coloring by graph_color_distance2. Without a previous coloring, this
+ * computes a full one with graph_color_distance2.
+ *
+ * \post
+ * <code>handle->get_distance2_graph_coloring_handle()->get_vertex_colors()</code>
+ *    will return a view of length num_verts, containing the colors.
+ */
+template <class KernelHandle, typename InRowmap, typename InEntries,
+          typename EdgeView>
+void graph_color_distance2_incremental(
+    KernelHandle *handle, typename KernelHandle::nnz_lno_t num_verts,
+    InRowmap row_map, InEntries row_entries, EdgeView inserted_src,
+    EdgeView inserted_dst, EdgeView removed_src, EdgeView removed_dst) {
+  using device_t = Kokkos::Device<typename KernelHandle::HandleExecSpace,
+                                  typename KernelHandle::HandleTempMemorySpace>;
+  auto gch_d2 = handle->get_distance2_graph_coloring_handle();
+  if (!gch_d2) {
+    throw std::runtime_error(
+        "KokkosGraph::graph_color_distance2_incremental: no distance-2 graph "
+        "coloring handle");
+  }
+  if (!gch_d2->is_coloring_called()) {
+    graph_color_distance2(handle, num_verts, row_map, row_entries);
+    return;
+  }
+  Kokkos::Timer timer;
+  gch_d2->set_vertex_colors(Impl::update_coloring<true, device_t>(
+      "graph_color_distance2_incremental", gch_d2->get_vertex_colors(),
+      num_verts, row_map, row_entries, inserted_src, inserted_dst, removed_src,
+      removed_dst));
+  gch_d2->add_to_overall_coloring_time(timer.seconds());
+  gch_d2->set_coloring_time(timer.seconds());
+}
+
+}  // end namespace Experimental
+}  // end namespace KokkosGraph
+
+#endif  // _KOKKOSGRAPH_INCREMENTALCOLOR_HPP
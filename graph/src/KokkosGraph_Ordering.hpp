@@ -0,0 +1,97 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSGRAPH_ORDERING_HPP
+#define _KOKKOSGRAPH_ORDERING_HPP
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "KokkosGraph_RCM.hpp"
+#include "KokkosGraph_Ordering_impl.hpp"
+
+namespace KokkosGraph {
+namespace Experimental {
+
+// Fill-reducing orderings for the sparse factorizations (graph_rcm reduces
+// the bandwidth instead). Like graph_rcm, they return the new label of each
+// vertex: labels(v) is the position of row/column v in the reordered matrix
+// P A P^T.
+
+// Compute an approximate minimum degree ordering of a graph. The ordering is
+// computed on the host, for the pattern of A + A^T (the graph does not need
+// to be symmetric), and is deterministic. Self loops and column indices
+// >= num_verts are ignored.
+template <typename device_t, typename rowmap_t, typename colinds_t,
+          typename labels_t = typename colinds_t::non_const_type>
+labels_t graph_amd(const rowmap_t& rowmap, const colinds_t& colinds) {
+  using size_type      = typename rowmap_t::non_const_value_type;
+  using lno_t          = typename colinds_t::non_const_value_type;
+  const lno_t numVerts = rowmap.extent(0) ? rowmap.extent(0) - 1 : 0;
+  auto hRowmap =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), rowmap);
+  auto hColinds =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), colinds);
+  std::vector<std::vector<lno_t>> adj(numVerts);
+  for (lno_t v = 0; v < numVerts; v++) {
+    for (size_type j = hRowmap(v); j < hRowmap(v + 1); j++) {
+      const lno_t nei = hColinds(j);
+      if (nei >= numVerts || nei == v) continue;
+      adj[v].push_back(nei);
+      adj[nei].push_back(v);
+    }
+  }
+  for (auto& row : adj) {
+    std::sort(row.begin(), row.end());
+    row.erase(std::unique(row.begin(), row.end()), row.end());
+  }
+  const std::vector<lno_t> order =
+      Impl::ApproximateMinimumDegree<lno_t>(std::move(adj)).order();
+  labels_t labels(Kokkos::view_alloc(Kokkos::WithoutInitializing, "AMD Labels"),
+                  numVerts);
+  auto hLabels = Kokkos::create_mirror_view(labels);
+  for (lno_t k = 0; k < numVerts; k++) hLabels(order[k]) = k;
+  Kokkos::deep_copy(labels, hLabels);
+  return labels;
+}
+
+// exclude from Cuda builds without lambdas enabled, like coarse_builder
+#if !defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_CUDA_LAMBDA)
+
+// Compute a nested dissection ordering of a graph. The graph must be
+// symmetric; self loops and column indices >= num_verts are ignored.
+// The separators are found on device_t's execution space with multilevel
+// bisection (see KokkosGraph_CoarsenConstruct.hpp); the subgraphs of at most
+// leafSize vertices left after the dissection are ordered by approximate
+// minimum degree. The coarsening is randomized, so two calls may return
+// different orderings.
+template <typename device_t, typename rowmap_t, typename colinds_t,
+          typename labels_t = typename colinds_t::non_const_type>
+labels_t graph_nested_dissection(
+    const rowmap_t& rowmap, const colinds_t& colinds,
+    typename colinds_t::non_const_value_type leafSize = 128) {
+  Impl::NestedDissection<device_t, rowmap_t, colinds_t, labels_t> algo(
+      rowmap, colinds, leafSize);
+  return algo.order();
+}
+
+#endif
+
+}  // namespace Experimental
+}  // namespace KokkosGraph
+
+#endif
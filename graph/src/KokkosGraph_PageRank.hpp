@@ -0,0 +1,181 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSGRAPH_PAGERANK_HPP
+#define _KOKKOSGRAPH_PAGERANK_HPP
+
+#include <sstream>
+#include <stdexcept>
+
+#include "KokkosBlas1_nrm1.hpp"
+#include "KokkosBlas1_scal.hpp"
+#include "KokkosGraph_PageRank_impl.hpp"
+
+namespace KokkosGraph {
+
+namespace Impl {
+
+template <typename crsMat_t, typename scalar_t>
+void check_pagerank_input(const char* name, const crsMat_t& A,
+                          scalar_t damping) {
+  using exec_space = typename crsMat_t::execution_space;
+  using values_t   = typename crsMat_t::values_type;
+  if (A.numRows() != A.numCols()) {
+    std::ostringstream os;
+    os << "KokkosGraph::" << name << ": the " << A.numRows() << " x "
+       << A.numCols() << " matrix is not square";
+    throw std::invalid_argument(os.str());
+  }
+  if (!(damping >= 0 && damping < 1)) {
+    std::ostringstream os;
+    os << "KokkosGraph::" << name << ": damping " << damping
+       << " is not in [0, 1)";
+    throw std::invalid_argument(os.str());
+  }
+  scalar_t minWeight = 0;
+  if (A.nnz()) {
+    const values_t values = A.values;
+    Kokkos::parallel_reduce(
+        "KokkosGraph::pagerank::weights",
+        Kokkos::RangePolicy<exec_space>(0, A.nnz()),
+        KOKKOS_LAMBDA(const size_t k, scalar_t& lmin) {
+          if (values(k) < lmin) lmin = values(k);
+        },
+        Kokkos::Min<scalar_t>(minWeight));
+  }
+  if (minWeight < 0) {
+    std::ostringstream os;
+    os << "KokkosGraph::" << name << ": negative weight";
+    throw std::invalid_argument(os.str());
+  }
+}
+
+}  // namespace Impl
+
+// PageRank of the graph of a CrsMatrix whose entry (u, v) is the weight of
+// the edge u -> v (use ones for an unweighted graph). The weights must be
+// real and nonnegative. A random surfer follows an out-edge of its vertex
+// with probability damping, chosen in proportion to the weights, and jumps
+// to a uniformly random vertex otherwise; from a dangling vertex (no
+// out-edge of nonzero weight), it always jumps. On return, ranks(v) is the
+// probability of the surfer being at v in the steady state; the ranks sum
+// to 1.
+//
+// The power iteration runs until the ranks change by less than tolerance in
+// norm 1, or for maxIters iterations. Returns the number of iterations done.
+template <typename crsMat_t,
+          typename vector_t =
+              Kokkos::View<typename crsMat_t::non_const_value_type*,
+                           typename crsMat_t::device_type>>
+int pagerank(const crsMat_t& A, vector_t& ranks,
+             typename vector_t::non_const_value_type damping   = 0.85,
+             typename vector_t::non_const_value_type tolerance = 1e-10,
+             int maxIters                                       = 100) {
+  using scalar_t = typename vector_t::non_const_value_type;
+  using mv_t     = Kokkos::View<scalar_t**, Kokkos::LayoutLeft,
+                                typename crsMat_t::device_type>;
+  static_assert(!Kokkos::ArithTraits<scalar_t>::is_complex,
+                "KokkosGraph::pagerank: the ranks must be real");
+  Impl::check_pagerank_input("pagerank", A, damping);
+  ranks = vector_t(Kokkos::view_alloc(Kokkos::WithoutInitializing, "PageRank"),
+                   A.numRows());
+  mv_t work("PageRank", A.numRows(), 1);
+  Impl::PageRank<crsMat_t, mv_t> algo(A, mv_t(), 1, damping);
+  const int iters = algo.compute(work, tolerance, maxIters);
+  Kokkos::deep_copy(ranks, Kokkos::subview(work, Kokkos::ALL(), 0));
+  return iters;
+}
+
+// Personalized PageRank for several teleport vectors at once: the surfer
+// jumps to vertex v with probability proportional to teleport(v, j) in the
+// computation of column j of ranks (which is allocated here, with the shape
+// of teleport; both are rank-2 views). The dangling vertices also send the
+// surfer to the teleport vector. The columns of teleport must be
+// nonnegative, and not all zero.
+//
+// The columns are computed together (the spmv works on multivectors), until
+// the sum of their changes in norm 1 is below tolerance, or for maxIters
+// iterations. Returns the number of iterations done.
+template <typename crsMat_t, typename teleport_t, typename mv_t>
+int personalized_pagerank(const crsMat_t& A, const teleport_t& teleport,
+                          mv_t& ranks,
+                          typename mv_t::non_const_value_type damping   = 0.85,
+                          typename mv_t::non_const_value_type tolerance = 1e-10,
+                          int maxIters                                  = 100) {
+  using scalar_t   = typename mv_t::non_const_value_type;
+  using mag_t      = typename Kokkos::ArithTraits<scalar_t>::mag_type;
+  using exec_space = typename crsMat_t::execution_space;
+  using lno_t      = typename crsMat_t::non_const_ordinal_type;
+  using work_mv_t  = Kokkos::View<scalar_t**, Kokkos::LayoutLeft,
+                                  typename crsMat_t::device_type>;
+  static_assert(!Kokkos::ArithTraits<scalar_t>::is_complex,
+                "KokkosGraph::personalized_pagerank: the ranks must be real");
+  Impl::check_pagerank_input("personalized_pagerank", A, damping);
+  const int numCols = teleport.extent(1);
+  if (teleport.extent(0) != size_t(A.numRows())) {
+    std::ostringstream os;
+    os << "KokkosGraph::personalized_pagerank: " << teleport.extent(0)
+       << " teleport weights for " << A.numRows() << " vertices";
+    throw std::invalid_argument(os.str());
+  }
+  // normalized copy of the teleport vectors
+  work_mv_t normalized(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "PageRank teleport"),
+      A.numRows(), numCols);
+  Kokkos::deep_copy(normalized, teleport);
+  scalar_t minTeleport = 0;
+  Kokkos::parallel_reduce(
+      "KokkosGraph::pagerank::teleport",
+      Kokkos::RangePolicy<exec_space>(0, A.numRows()),
+      KOKKOS_LAMBDA(const lno_t v, scalar_t& lmin) {
+        for (int j = 0; j < numCols; j++) {
+          if (normalized(v, j) < lmin) lmin = normalized(v, j);
+        }
+      },
+      Kokkos::Min<scalar_t>(minTeleport));
+  if (minTeleport < 0) {
+    throw std::invalid_argument(
+        "KokkosGraph::personalized_pagerank: negative teleport weight");
+  }
+  Kokkos::View<mag_t*, typename crsMat_t::device_type> sums(
+      "PageRank teleport sums", numCols);
+  KokkosBlas::nrm1(sums, normalized);
+  auto sumsHost =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), sums);
+  Kokkos::View<scalar_t*, typename crsMat_t::device_type> scales(
+      "PageRank teleport scales", numCols);
+  auto scalesHost = Kokkos::create_mirror_view(scales);
+  for (int j = 0; j < numCols; j++) {
+    if (!(sumsHost(j) > 0)) {
+      std::ostringstream os;
+      os << "KokkosGraph::personalized_pagerank: teleport vector " << j
+         << " is zero";
+      throw std::invalid_argument(os.str());
+    }
+    scalesHost(j) = scalar_t(1) / sumsHost(j);
+  }
+  Kokkos::deep_copy(scales, scalesHost);
+  KokkosBlas::scal(normalized, scales, normalized);
+  ranks = mv_t(Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                                  "Personalized PageRank"),
+               A.numRows(), numCols);
+  Impl::PageRank<crsMat_t, mv_t> algo(A, normalized, numCols, damping);
+  return algo.compute(ranks, tolerance, maxIters);
+}
+
+}  // namespace KokkosGraph
+
+#endif
@@ -0,0 +1,80 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSGRAPH_PARTITION_HPP
+#define _KOKKOSGRAPH_PARTITION_HPP
+
+#include <stdexcept>
+#include <type_traits>
+
+#include "Kokkos_ArithTraits.hpp"
+#include "KokkosGraph_Partition_impl.hpp"
+
+// exclude from Cuda builds without lambdas enabled, like coarse_builder
+#if !defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_CUDA_LAMBDA)
+
+namespace KokkosGraph {
+namespace Experimental {
+
+// Partition the vertices of the graph g into numParts parts of at most
+// ceil((1 + imbalance) * num_verts / numParts) vertices each, minimizing the
+// weight of the edges cut (the values of g are the edge weights).
+//
+// g must be symmetric, with nonnegative values; self loops are ignored.
+// The partitioner is multilevel: g is coarsened with coarse_builder (see
+// KokkosGraph_CoarsenConstruct.hpp), the coarsest graph is partitioned by
+// recursive bisection, and the partition is refined with the Jet refinement
+// on every level while uncoarsening. The coarsening is randomized, so two
+// calls may return different partitions.
+//
+// On return, parts(v) in [0, numParts) is the part of vertex v. Returns the
+// edge cut: the total weight of the edges between different parts, each
+// counted once.
+template <typename crsMat_t,
+          typename part_view_t =
+              Kokkos::View<typename crsMat_t::non_const_ordinal_type*,
+                           typename crsMat_t::device_type>>
+typename crsMat_t::non_const_value_type graph_partition(
+    const crsMat_t& g, typename crsMat_t::non_const_ordinal_type numParts,
+    part_view_t& parts, double imbalance = 0.03) {
+  using lno_t    = typename crsMat_t::non_const_ordinal_type;
+  using scalar_t = typename crsMat_t::non_const_value_type;
+  static_assert(!Kokkos::ArithTraits<scalar_t>::is_complex,
+                "graph_partition: the edge weights must be real");
+  if (numParts < 1) {
+    throw std::invalid_argument("graph_partition: numParts must be positive");
+  }
+  if (!(imbalance >= 0)) {
+    throw std::invalid_argument(
+        "graph_partition: imbalance must be nonnegative");
+  }
+  const lno_t n = g.numRows();
+  if (n == 0 || numParts == 1) {
+    parts = part_view_t("partition", n);
+    return scalar_t(0);
+  }
+  Impl::KWayPartitioner<crsMat_t, part_view_t> partitioner(numParts,
+                                                           imbalance);
+  parts = partitioner.partition(g);
+  return partitioner.cut(g, parts) / scalar_t(2);
+}
+
+}  // namespace Experimental
+}  // namespace KokkosGraph
+
+#endif
+
+#endif
@@ -25,6 +25,8 @@ namespace Experimental {
 // Compute the reverse Cuthill-McKee ordering of a graph.
 // The graph must be symmetric, but it may have any number of connected
 // components. This function returns a list of vertices in RCM order.
+// The ordering runs in parallel on device_t's execution space, and is
+// deterministic: ties between vertices of equal degree are broken by index.
 
 template <typename device_t, typename rowmap_t, typename colinds_t,
           typename labels_t = typename colinds_t::non_const_type>
@@ -36,7 +38,9 @@ labels_t graph_rcm(const rowmap_t& rowmap, const colinds_t& colinds) {
     if (numVerts) numVerts--;
     return labels_t("RCM Labels", numVerts);
   }
-  Impl::SerialRCM<rowmap_t, colinds_t, labels_t> algo(rowmap, colinds);
+  Impl::ParallelRCM<typename device_t::execution_space, rowmap_t, colinds_t,
+                    labels_t>
+      algo(rowmap, colinds);
   return algo.rcm();
 }
 
@@ -0,0 +1,140 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSGRAPH_REORDER_HPP
+#define _KOKKOSGRAPH_REORDER_HPP
+
+#include <sstream>
+#include <stdexcept>
+
+#include "KokkosKernels_SimpleUtils.hpp"
+#include "KokkosSparse_SortCrs.hpp"
+#include "KokkosGraph_Reorder_impl.hpp"
+
+namespace KokkosGraph {
+
+// Orderings that improve the cache locality of the accesses to the vector
+// entries (in SpMV) or to the vertex data (in graph kernels), by numbering
+// close together the vertices accessed together. On power-law graphs, most
+// accesses go to the few vertices of high degree.
+//  - REORDER_DEGREE_SORT: by decreasing degree.
+//  - REORDER_HUB_SORT: the hubs (degree above the average) first, by
+//    decreasing degree; the other vertices keep their relative order.
+//  - REORDER_DEGREE_GROUPING: the vertices are grouped by degree, with the
+//    group boundaries at the average degree times powers of two (8 groups),
+//    the highest degrees first; vertices keep their relative order within
+//    their group. Less disruptive than the sorts for the graphs that already
+//    have some locality.
+//  - REORDER_COMMUNITY: Rabbit-style: the vertices of every community found
+//    by multilevel aggregation (see KokkosGraph_CoarsenConstruct.hpp) are
+//    numbered contiguously, recursively. The aggregation is randomized, so
+//    this ordering is not deterministic. Not available in Cuda builds
+//    without lambdas enabled.
+enum Reorder_Algorithm {
+  REORDER_DEGREE_SORT,
+  REORDER_HUB_SORT,
+  REORDER_DEGREE_GROUPING,
+  REORDER_COMMUNITY
+};
+
+inline const char* reorder_algorithm_name(Reorder_Algorithm algo) {
+  switch (algo) {
+    case REORDER_DEGREE_SORT: return "REORDER_DEGREE_SORT";
+    case REORDER_HUB_SORT: return "REORDER_HUB_SORT";
+    case REORDER_DEGREE_GROUPING: return "REORDER_DEGREE_GROUPING";
+    case REORDER_COMMUNITY: return "REORDER_COMMUNITY";
+  }
+  return "*** Invalid reorder algo enum value.\n";
+}
+
+// Compute a cache-locality ordering of a graph. Like graph_rcm, returns the
+// new label of each vertex: labels(v) is the position of row/column v in the
+// reordered matrix P A P^T (see permute_symmetric). The degree of a vertex
+// is the length of its row.
+//
+// The degree-based orderings are deterministic, and ties are broken by the
+// original numbering. REORDER_COMMUNITY symmetrizes the graph, and ignores
+// self loops and column indices >= num_verts.
+template <typename device_t, typename rowmap_t, typename colinds_t,
+          typename labels_t = typename colinds_t::non_const_type>
+labels_t reorder(const rowmap_t& rowmap, const colinds_t& colinds,
+                 Reorder_Algorithm algo) {
+  Impl::GraphReorder<device_t, rowmap_t, colinds_t, labels_t> reorderer(
+      rowmap, colinds);
+  switch (algo) {
+    case REORDER_DEGREE_SORT: return reorderer.degreeSort();
+    case REORDER_HUB_SORT: return reorderer.hubSort();
+    case REORDER_DEGREE_GROUPING: return reorderer.degreeGrouping();
+    case REORDER_COMMUNITY:
+#if !defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_CUDA_LAMBDA)
+      return reorderer.communities();
+#else
+      throw std::runtime_error(
+          "KokkosGraph::reorder: REORDER_COMMUNITY requires Cuda lambdas");
+#endif
+  }
+  throw std::invalid_argument("KokkosGraph::reorder: invalid algorithm");
+}
+
+// Symmetric permutation of a square matrix: returns B = P A P^T, with
+// B(labels(i), labels(j)) = A(i, j). labels must be a permutation of
+// 0...num_rows-1, such as the result of reorder or graph_rcm. The rows of B
+// are sorted by column.
+template <typename crsMat_t, typename labels_t>
+crsMat_t permute_symmetric(const crsMat_t& A, const labels_t& labels) {
+  using exec_space = typename crsMat_t::execution_space;
+  using lno_t      = typename crsMat_t::non_const_ordinal_type;
+  using size_type  = typename crsMat_t::non_const_size_type;
+  using rowmap_t   = typename crsMat_t::row_map_type::non_const_type;
+  using entries_t  = typename crsMat_t::index_type::non_const_type;
+  using values_t   = typename crsMat_t::values_type::non_const_type;
+  using range_pol  = Kokkos::RangePolicy<exec_space>;
+  const lno_t n    = A.numRows();
+  if (A.numCols() != n || labels.extent(0) != size_t(n)) {
+    std::ostringstream os;
+    os << "KokkosGraph::permute_symmetric: can't permute a " << n << " x "
+       << A.numCols() << " matrix with " << labels.extent(0) << " labels";
+    throw std::invalid_argument(os.str());
+  }
+  rowmap_t rowmap("Permuted rowmap", n + 1);
+  Kokkos::parallel_for(
+      "KokkosGraph::permute_symmetric::count", range_pol(0, n),
+      Impl::PermuteCountFunctor<lno_t, typename crsMat_t::row_map_type,
+                                labels_t, rowmap_t>{A.graph.row_map, labels,
+                                                    rowmap});
+  size_type nnz = 0;
+  KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<exec_space>(
+      n + 1, rowmap, nnz);
+  entries_t entries(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "Permuted entries"),
+      nnz);
+  values_t values(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "Permuted values"), nnz);
+  Kokkos::parallel_for(
+      "KokkosGraph::permute_symmetric::fill", range_pol(0, n),
+      Impl::PermuteFillFunctor<lno_t, typename crsMat_t::row_map_type,
+                               typename crsMat_t::index_type,
+                               typename crsMat_t::values_type, labels_t,
+                               rowmap_t, entries_t, values_t>{
+          A.graph.row_map, A.graph.entries, A.values, labels, rowmap, entries,
+          values});
+  KokkosSparse::sort_crs_matrix<exec_space>(rowmap, entries, values);
+  return crsMat_t("Permuted", n, n, nnz, values, rowmap, entries);
+}
+
+}  // namespace KokkosGraph
+
+#endif
@@ -0,0 +1,86 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSGRAPH_SAMPLING_HPP
+#define _KOKKOSGRAPH_SAMPLING_HPP
+
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "KokkosGraph_Sampling_impl.hpp"
+
+namespace KokkosGraph {
+
+// Batched k-hop neighborhood sampling (as for GNN mini-batches): from every
+// seeds(b), hop h samples up to fanouts[h] neighbors of each vertex reached
+// by the previous hop, without replacement among the entries of its row.
+// The vertices reached by the last hop are not expanded.
+//
+// The samples are returned as one CRS graph with relabeled vertices: sample b
+// has the vertices sampleOffsets(b), ..., sampleOffsets(b + 1) - 1, and the
+// original id of its vertex i is vertices(sampleOffsets(b) + i). Vertex 0 of
+// every sample is its seed, and the other vertices are numbered in the order
+// they were first reached. Row sampleOffsets(b) + i of subRowmap/subEntries
+// lists the sampled neighbors of that vertex, by their number in the sample.
+//
+// The sampling only depends on randomSeed, not on the execution space.
+// fanouts must be positive. Column indices >= num_verts are ignored.
+template <typename device_t, typename rowmap_t, typename colinds_t,
+          typename seeds_t,
+          typename offsets_t  = typename rowmap_t::non_const_type,
+          typename lno_view_t = typename colinds_t::non_const_type>
+void sample_khop_neighborhoods(const rowmap_t& rowmap, const colinds_t& colinds,
+                               const seeds_t& seeds,
+                               const std::vector<int>& fanouts,
+                               offsets_t& sampleOffsets, lno_view_t& vertices,
+                               offsets_t& subRowmap, lno_view_t& subEntries,
+                               uint64_t randomSeed = 0) {
+  using lno_t          = typename colinds_t::non_const_value_type;
+  using exec_space     = typename device_t::execution_space;
+  const lno_t numVerts = rowmap.extent(0) ? rowmap.extent(0) - 1 : 0;
+  for (int f : fanouts) {
+    if (f <= 0) {
+      std::ostringstream os;
+      os << "KokkosGraph::sample_khop_neighborhoods: fanout " << f
+         << " is not positive";
+      throw std::invalid_argument(os.str());
+    }
+  }
+  lno_t badSeeds = 0;
+  Kokkos::parallel_reduce(
+      "KokkosGraph::sample::checkSeeds",
+      Kokkos::RangePolicy<exec_space>(0, seeds.extent(0)),
+      KOKKOS_LAMBDA(const size_t i, lno_t& lbad) {
+        if (seeds(i) < 0 || seeds(i) >= numVerts) lbad++;
+      },
+      badSeeds);
+  if (badSeeds) {
+    std::ostringstream os;
+    os << "KokkosGraph::sample_khop_neighborhoods: " << badSeeds
+       << " seeds are not vertices of the " << numVerts << "-vertex graph";
+    throw std::invalid_argument(os.str());
+  }
+  Impl::KHopSampler<device_t, rowmap_t, colinds_t, seeds_t, offsets_t,
+                    lno_view_t>
+      sampler(rowmap, colinds, seeds, fanouts, randomSeed);
+  sampler.compute(sampleOffsets, vertices, subRowmap, subEntries);
+}
+
+}  // namespace KokkosGraph
+
+#endif
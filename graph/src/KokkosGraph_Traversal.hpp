@@ -0,0 +1,133 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSGRAPH_TRAVERSAL_HPP
+#define _KOKKOSGRAPH_TRAVERSAL_HPP
+
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+
+#include "KokkosGraph_Traversal_impl.hpp"
+
+namespace KokkosGraph {
+
+enum BFS_Algorithm { BFS_TOP_DOWN, BFS_DIRECTION_OPTIMIZING };
+
+// Breadth-first search from source, given a CRS graph.
+// On return, levels(v) is the distance (number of edges) from source to v,
+// and parents(v) the vertex from which v was reached (source for source);
+// both are -1 for the vertices not reachable from source. The levels are
+// deterministic; when a vertex can be reached from several vertices of the
+// previous level, any of them may be its parent.
+//
+// BFS_DIRECTION_OPTIMIZING switches between top-down and bottom-up steps
+// depending on the size of the frontier; it requires a symmetric graph.
+// BFS_TOP_DOWN follows the edges of the rows, and works for any graph.
+//
+// Column indices >= num_verts are ignored.
+template <typename device_t, typename rowmap_t, typename colinds_t,
+          typename lno_view_t = typename colinds_t::non_const_type>
+void bfs(const rowmap_t& rowmap, const colinds_t& colinds,
+         typename colinds_t::non_const_value_type source, lno_view_t& levels,
+         lno_view_t& parents, BFS_Algorithm algo = BFS_DIRECTION_OPTIMIZING) {
+  using lno_t          = typename colinds_t::non_const_value_type;
+  const lno_t numVerts = rowmap.extent(0) ? rowmap.extent(0) - 1 : 0;
+  if (source < 0 || source >= numVerts) {
+    std::ostringstream os;
+    os << "KokkosGraph::bfs: source " << source << " is not a vertex of the "
+       << numVerts << "-vertex graph";
+    throw std::invalid_argument(os.str());
+  }
+  Impl::BreadthFirstSearch<device_t, rowmap_t, colinds_t, lno_view_t> search(
+      rowmap, colinds, algo == BFS_DIRECTION_OPTIMIZING);
+  search.compute(source);
+  levels  = search.levels;
+  parents = search.parents;
+}
+
+// Single-source shortest paths from source by delta-stepping, given a
+// CrsMatrix whose entry (u, v) is the weight of the edge u -> v. The weights
+// must be real and nonnegative. Returns the distances from source; the
+// vertices not reachable from source are at distance infinity.
+//
+// delta is the bucket width: small values do less redundant work, large
+// values more work per parallel step. If delta <= 0, it is set to the
+// largest weight divided by the average degree.
+//
+// Column indices >= num_verts are ignored.
+template <typename crsMat_t,
+          typename dist_view_t = Kokkos::View<
+              typename Kokkos::ArithTraits<
+                  typename crsMat_t::non_const_value_type>::mag_type*,
+              typename crsMat_t::device_type>>
+dist_view_t sssp(const crsMat_t& A,
+                 typename crsMat_t::non_const_ordinal_type source,
+                 typename dist_view_t::non_const_value_type delta = 0) {
+  using scalar_t   = typename crsMat_t::non_const_value_type;
+  using lno_t      = typename crsMat_t::non_const_ordinal_type;
+  using dist_t     = typename dist_view_t::non_const_value_type;
+  using device_t   = typename crsMat_t::device_type;
+  using exec_space = typename device_t::execution_space;
+  using values_t   = typename crsMat_t::values_type;
+  static_assert(!Kokkos::ArithTraits<scalar_t>::is_complex,
+                "KokkosGraph::sssp: the weights must be real");
+  const lno_t numVerts = A.numRows();
+  if (source < 0 || source >= numVerts) {
+    std::ostringstream os;
+    os << "KokkosGraph::sssp: source " << source << " is not a vertex of the "
+       << numVerts << "-vertex graph";
+    throw std::invalid_argument(os.str());
+  }
+  dist_t minWeight = 0, maxWeight = 0;
+  if (A.nnz()) {
+    const values_t values = A.values;
+    Kokkos::parallel_reduce(
+        "KokkosGraph::sssp::weights",
+        Kokkos::RangePolicy<exec_space>(0, A.nnz()),
+        KOKKOS_LAMBDA(const size_t k, dist_t& lmin, dist_t& lmax) {
+          const dist_t w = values(k);
+          if (w < lmin) lmin = w;
+          if (w > lmax) lmax = w;
+        },
+        Kokkos::Min<dist_t>(minWeight), Kokkos::Max<dist_t>(maxWeight));
+  }
+  if (minWeight < 0) {
+    throw std::invalid_argument("KokkosGraph::sssp: negative weight");
+  }
+  if (delta <= 0) {
+    const dist_t avgDegree = numVerts ? dist_t(A.nnz()) / numVerts : dist_t(1);
+    delta = maxWeight / (avgDegree > 1 ? avgDegree : dist_t(1));
+    if (!(delta > 0)) delta = 1;
+  }
+  Impl::DeltaStepping<device_t, typename crsMat_t::row_map_type,
+                      typename crsMat_t::index_type, values_t, dist_view_t>
+      algo(A.graph.row_map, A.graph.entries, A.values, delta);
+  algo.compute(source);
+  return algo.dist;
+}
+
+inline const char* bfs_algorithm_name(BFS_Algorithm algo) {
+  switch (algo) {
+    case BFS_TOP_DOWN: return "BFS_TOP_DOWN";
+    case BFS_DIRECTION_OPTIMIZING: return "BFS_DIRECTION_OPTIMIZING";
+  }
+  return "*** Invalid BFS algo enum value.\n";
+}
+
+}  // namespace KokkosGraph
+
+#endif
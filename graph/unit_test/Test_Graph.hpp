@@ -19,10 +19,19 @@
 #include "Test_Graph_graph_color_deterministic.hpp"
 #include "Test_Graph_graph_color_distance2.hpp"
 #include "Test_Graph_graph_color.hpp"
+#include "Test_Graph_graph_color_incremental.hpp"
+#include "Test_Graph_graph_color_balance.hpp"
 #include "Test_Graph_mis2.hpp"
 #if !defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_CUDA_LAMBDA)
 #include "Test_Graph_coarsen.hpp"
+#include "Test_Graph_partition.hpp"
 #endif
 #include "Test_Graph_rcm.hpp"
+#include "Test_Graph_ordering.hpp"
+#include "Test_Graph_reorder.hpp"
+#include "Test_Graph_traversal.hpp"
+#include "Test_Graph_components.hpp"
+#include "Test_Graph_sampling.hpp"
+#include "Test_Graph_pagerank.hpp"
 
 #endif  // TEST_GRAPH_HPP
@@ -0,0 +1,249 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "KokkosGraph_ConnectedComponents.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_IOUtils.hpp"
+#include "KokkosKernels_Utils.hpp"
+
+namespace Test {
+
+// Numbers the components in the order of their smallest vertex, given any
+// representative rep[v] of the component of every vertex.
+template <typename lno_t>
+std::vector<lno_t> numberComponents(const std::vector<lno_t>& rep,
+                                    lno_t& numComponents) {
+  const lno_t numVerts = rep.size();
+  std::vector<lno_t> id(numVerts, -1), labels(numVerts);
+  numComponents = 0;
+  for (lno_t v = 0; v < numVerts; v++) {
+    if (id[rep[v]] == -1) id[rep[v]] = numComponents++;
+    labels[v] = id[rep[v]];
+  }
+  return labels;
+}
+
+// Serial connected components, by union-find over the rows of the graph.
+template <typename lno_t, typename rowmap_t, typename entries_t>
+std::vector<lno_t> serialComponents(const rowmap_t& rowmap,
+                                    const entries_t& entries,
+                                    lno_t& numComponents) {
+  const lno_t numVerts = rowmap.extent(0) - 1;
+  std::vector<lno_t> parent(numVerts);
+  for (lno_t v = 0; v < numVerts; v++) parent[v] = v;
+  auto find = [&](lno_t v) {
+    while (parent[v] != v) v = parent[v] = parent[parent[v]];
+    return v;
+  };
+  for (lno_t v = 0; v < numVerts; v++) {
+    for (auto j = rowmap(v); j < rowmap(v + 1); j++) {
+      const lno_t w = entries(j);
+      if (w >= numVerts) continue;
+      parent[find(v)] = find(w);
+    }
+  }
+  std::vector<lno_t> rep(numVerts);
+  for (lno_t v = 0; v < numVerts; v++) rep[v] = find(v);
+  return numberComponents(rep, numComponents);
+}
+
+// Serial strongly connected components (Kosaraju, with explicit stacks).
+template <typename lno_t, typename rowmap_t, typename entries_t>
+std::vector<lno_t> serialStrongComponents(const rowmap_t& rowmap,
+                                          const entries_t& entries,
+                                          lno_t& numComponents) {
+  const lno_t numVerts = rowmap.extent(0) - 1;
+  std::vector<std::vector<lno_t>> out(numVerts), in(numVerts);
+  for (lno_t v = 0; v < numVerts; v++) {
+    for (auto j = rowmap(v); j < rowmap(v + 1); j++) {
+      const lno_t w = entries(j);
+      if (w >= numVerts) continue;
+      out[v].push_back(w);
+      in[w].push_back(v);
+    }
+  }
+  // vertices by increasing finishing time of a DFS along the out-edges
+  std::vector<lno_t> finished;
+  std::vector<bool> visited(numVerts, false);
+  std::vector<std::pair<lno_t, size_t>> stack;
+  for (lno_t s = 0; s < numVerts; s++) {
+    if (visited[s]) continue;
+    visited[s] = true;
+    stack.emplace_back(s, 0);
+    while (!stack.empty()) {
+      auto& [u, next] = stack.back();
+      if (next < out[u].size()) {
+        const lno_t w = out[u][next++];
+        if (!visited[w]) {
+          visited[w] = true;
+          stack.emplace_back(w, 0);
+        }
+      } else {
+        finished.push_back(u);
+        stack.pop_back();
+      }
+    }
+  }
+  // the component of every root is what it reaches along the in-edges
+  std::vector<lno_t> rep(numVerts, -1), todo;
+  for (auto it = finished.rbegin(); it != finished.rend(); it++) {
+    if (rep[*it] != -1) continue;
+    rep[*it] = *it;
+    todo.push_back(*it);
+    while (!todo.empty()) {
+      const lno_t u = todo.back();
+      todo.pop_back();
+      for (lno_t w : in[u]) {
+        if (rep[w] != -1) continue;
+        rep[w] = *it;
+        todo.push_back(w);
+      }
+    }
+  }
+  return numberComponents(rep, numComponents);
+}
+
+template <typename lno_t, typename labels_t>
+void checkComponents(const labels_t& labels, lno_t numComponents,
+                     const std::vector<lno_t>& expected,
+                     lno_t expectedComponents) {
+  auto labelsHost =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), labels);
+  EXPECT_EQ(numComponents, expectedComponents);
+  ASSERT_EQ(labelsHost.extent(0), expected.size());
+  for (size_t v = 0; v < expected.size(); v++) {
+    ASSERT_EQ(labelsHost(v), expected[v]) << "vertex " << v;
+  }
+}
+
+}  // namespace Test
+
+template <typename lno_t, typename size_type, typename device>
+void test_connected_components(lno_t numVerts, size_type nnz, lno_t bandwidth,
+                               lno_t row_size_variance) {
+  using execution_space = typename device::execution_space;
+  using crsMat =
+      KokkosSparse::CrsMatrix<double, lno_t, device, void, size_type>;
+  using c_rowmap_t  = typename crsMat::StaticCrsGraphType::row_map_type;
+  using c_entries_t = typename crsMat::StaticCrsGraphType::entries_type;
+  using rowmap_t    = typename c_rowmap_t::non_const_type;
+  using entries_t   = typename c_entries_t::non_const_type;
+  crsMat A = KokkosSparse::Impl::kk_generate_sparse_matrix<crsMat>(
+      numVerts, numVerts, nnz, row_size_variance, bandwidth);
+  rowmap_t symRowmap;
+  entries_t symEntries;
+  KokkosKernels::Impl::symmetrize_graph_symbolic_hashmap<
+      c_rowmap_t, c_entries_t, rowmap_t, entries_t, execution_space>(
+      numVerts, A.graph.row_map, A.graph.entries, symRowmap, symEntries);
+  auto rowmapHost =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), symRowmap);
+  auto entriesHost =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), symEntries);
+  lno_t expectedComponents = 0, numComponents = 0;
+  std::vector<lno_t> expected = Test::serialComponents<lno_t>(
+      rowmapHost, entriesHost, expectedComponents);
+  auto labels = KokkosGraph::graph_connected_components<device>(
+      symRowmap, symEntries, numComponents);
+  Test::checkComponents(labels, numComponents, expected, expectedComponents);
+
+  // the directed graph
+  auto aRowmapHost = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                         A.graph.row_map);
+  auto aEntriesHost = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                          A.graph.entries);
+  expected = Test::serialStrongComponents<lno_t>(aRowmapHost, aEntriesHost,
+                                                 expectedComponents);
+  labels = KokkosGraph::graph_strongly_connected_components<device>(
+      A.graph.row_map, A.graph.entries, numComponents);
+  Test::checkComponents(labels, numComponents, expected, expectedComponents);
+}
+
+template <typename lno_t, typename size_type, typename device>
+void test_connected_components_trivial() {
+  using rowmap_t  = Kokkos::View<size_type*, device>;
+  using entries_t = Kokkos::View<lno_t*, device>;
+  lno_t numComponents = -1;
+  rowmap_t rowmap("Rowmap", 1);
+  entries_t entries("Entries", 0);
+  auto labels = KokkosGraph::graph_connected_components<device>(
+      rowmap, entries, numComponents);
+  EXPECT_EQ(numComponents, 0);
+  EXPECT_EQ(labels.extent(0), size_t(0));
+  labels = KokkosGraph::graph_strongly_connected_components<device>(
+      rowmap, entries, numComponents);
+  EXPECT_EQ(numComponents, 0);
+  EXPECT_EQ(labels.extent(0), size_t(0));
+  // one vertex with a self loop
+  rowmap  = rowmap_t("Rowmap", 2);
+  entries = entries_t("Entries", 1);
+  Kokkos::deep_copy(Kokkos::subview(rowmap, 1), size_type(1));
+  std::vector<lno_t> expected(1, 0);
+  labels = KokkosGraph::graph_connected_components<device>(rowmap, entries,
+                                                           numComponents);
+  Test::checkComponents(labels, numComponents, expected, lno_t(1));
+  labels = KokkosGraph::graph_strongly_connected_components<device>(
+      rowmap, entries, numComponents);
+  Test::checkComponents(labels, numComponents, expected, lno_t(1));
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE)                        \
+  TEST_F(                                                                    \
+      TestCategory,                                                          \
+      graph##_##components##_##SCALAR##_##ORDINAL##_##OFFSET##_##DEVICE) {   \
+    test_connected_components_trivial<ORDINAL, OFFSET, DEVICE>();            \
+    test_connected_components<ORDINAL, OFFSET, DEVICE>(1000, 1000, 1000, 1); \
+    test_connected_components<ORDINAL, OFFSET, DEVICE>(5000, 5000 * 2, 5000, \
+                                                       2);                   \
+    test_connected_components<ORDINAL, OFFSET, DEVICE>(5000, 5000 * 8, 500,  \
+                                                       4);                   \
+  }
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_INT)) || \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&        \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int, int, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT64_T) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_INT)) ||     \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&            \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int64_t, int, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT) &&    \
+     defined(KOKKOSKERNELS_INST_OFFSET_SIZE_T)) || \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&           \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int, size_t, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT64_T) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_SIZE_T)) ||  \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&            \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int64_t, size_t, TestDevice)
+#endif
+
+#undef EXECUTE_TEST
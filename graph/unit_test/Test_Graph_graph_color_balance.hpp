@@ -0,0 +1,197 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "KokkosGraph_BalanceColor.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_IOUtils.hpp"
+#include "KokkosSparse_Utils.hpp"
+#include "KokkosKernels_Handle.hpp"
+
+namespace Test {
+
+// Number of uncolored vertices and of distance-1 (or distance-2) conflicts.
+template <typename lno_t, typename rowmap_t, typename entries_t,
+          typename colors_t>
+lno_t countBalancedColorConflicts(lno_t numVerts, const rowmap_t& rowmap,
+                                  const entries_t& entries,
+                                  const colors_t& colors, bool distance2) {
+  lno_t conflicts = 0;
+  for (lno_t v = 0; v < numVerts; v++) {
+    if (colors(v) == 0) conflicts++;
+    for (auto i = rowmap(v); i < rowmap(v + 1); i++) {
+      const lno_t x = entries(i);
+      if (x != v && colors(x) == colors(v)) conflicts++;
+      if (!distance2) continue;
+      for (auto j = rowmap(x); j < rowmap(x + 1); j++) {
+        const lno_t y = entries(j);
+        if (y != v && colors(y) == colors(v)) conflicts++;
+      }
+    }
+  }
+  return conflicts;
+}
+
+}  // namespace Test
+
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void test_coloring_balance(lno_t numVerts, size_type nnz, lno_t bandwidth,
+                           lno_t row_size_variance, bool distance2) {
+  using namespace KokkosGraph::Experimental;
+  using crsMat_t =
+      KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  using rowmap_t     = typename crsMat_t::row_map_type::non_const_type;
+  using entries_t    = typename crsMat_t::index_type::non_const_type;
+  using KernelHandle = KokkosKernels::Experimental::KokkosKernelsHandle<
+      size_type, lno_t, scalar_t, typename device::execution_space,
+      typename device::memory_space, typename device::memory_space>;
+  crsMat_t A = KokkosSparse::Impl::kk_generate_sparse_matrix<crsMat_t>(
+      numVerts, numVerts, nnz, row_size_variance, bandwidth);
+  rowmap_t rowmap;
+  entries_t entries;
+  KokkosKernels::Impl::symmetrize_graph_symbolic_hashmap<
+      typename crsMat_t::row_map_type, typename crsMat_t::index_type, rowmap_t,
+      entries_t, typename device::execution_space>(
+      numVerts, A.graph.row_map, A.graph.entries, rowmap, entries);
+
+  KernelHandle kh;
+  auto getColors = [&]() {
+    std::vector<int64_t> colors;
+    auto copy = [&](const auto& view) {
+      auto host =
+          Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), view);
+      colors.assign(host.data(), host.data() + host.extent(0));
+    };
+    if (distance2) {
+      copy(kh.get_distance2_graph_coloring_handle()->get_vertex_colors());
+    } else {
+      copy(kh.get_graph_coloring_handle()->get_vertex_colors());
+    }
+    return colors;
+  };
+  auto getStats = [&]() {
+    if (distance2) {
+      return color_class_stats(
+          kh.get_distance2_graph_coloring_handle()->get_vertex_colors());
+    }
+    return color_class_stats(
+        kh.get_graph_coloring_handle()->get_vertex_colors());
+  };
+  if (distance2) {
+    kh.create_distance2_graph_coloring_handle();
+    EXPECT_THROW(graph_color_distance2_balance(&kh, numVerts, rowmap, entries),
+                 std::runtime_error);
+    graph_color_distance2(&kh, numVerts, rowmap, entries);
+  } else {
+    kh.create_graph_coloring_handle(KokkosGraph::COLORING_VB);
+    EXPECT_THROW(graph_color_balance(&kh, numVerts, rowmap, entries),
+                 std::runtime_error);
+    graph_color(&kh, numVerts, numVerts, rowmap, entries);
+  }
+  const ColorClassStats before = getStats();
+  // the statistics match the class sizes
+  {
+    const std::vector<int64_t> colors = getColors();
+    std::vector<int64_t> sizes(before.num_colors + 1, 0);
+    for (int64_t c : colors) sizes[c]++;
+    EXPECT_EQ(before.num_colors,
+              *std::max_element(colors.begin(), colors.end()));
+    EXPECT_EQ(before.min_size,
+              *std::min_element(sizes.begin() + 1, sizes.end()));
+    EXPECT_EQ(before.max_size,
+              *std::max_element(sizes.begin() + 1, sizes.end()));
+    EXPECT_NEAR(before.mean_size, double(numVerts) / before.num_colors, 1e-8);
+  }
+
+  if (distance2) {
+    graph_color_distance2_balance(&kh, numVerts, rowmap, entries);
+  } else {
+    graph_color_balance(&kh, numVerts, rowmap, entries);
+  }
+  const ColorClassStats after = getStats();
+  auto rowmapHost  = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                         rowmap);
+  auto entriesHost = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                         entries);
+  const std::vector<int64_t> colors = getColors();
+  Kokkos::View<int64_t*, Kokkos::HostSpace, Kokkos::MemoryUnmanaged>
+      colorsHost(colors.data(), colors.size());
+  EXPECT_EQ(Test::countBalancedColorConflicts(numVerts, rowmapHost, entriesHost,
+                                              colorsHost, distance2),
+            0);
+  // classes above the target only shrink, and the ones below only grow. The
+  // greedy colorings have classes above the target, so some vertices move
+  // and the spread of the sizes strictly decreases.
+  const int64_t target =
+      (numVerts + before.num_colors - 1) / before.num_colors;
+  ASSERT_GT(before.max_size, target);
+  EXPECT_EQ(after.num_colors, before.num_colors);
+  EXPECT_LE(after.max_size, before.max_size);
+  EXPECT_GE(after.min_size, before.min_size);
+  EXPECT_LT(after.stddev_size, before.stddev_size);
+  EXPECT_LE(after.min_size, target);
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE)                               \
+  TEST_F(                                                                           \
+      TestCategory,                                                                 \
+      graph##_##graph_color_balance##_##SCALAR##_##ORDINAL##_##OFFSET##_##DEVICE) { \
+    test_coloring_balance<SCALAR, ORDINAL, OFFSET, DEVICE>(5000, 5000 * 20,         \
+                                                           1000, 10, false);        \
+    test_coloring_balance<SCALAR, ORDINAL, OFFSET, DEVICE>(5000, 5000 * 20, 200,    \
+                                                           10, false);              \
+    test_coloring_balance<SCALAR, ORDINAL, OFFSET, DEVICE>(2000, 2000 * 10, 200,    \
+                                                           5, true);                \
+  }
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_INT)) || \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&        \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(default_scalar, int, int, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT64_T) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_INT)) ||     \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&            \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(default_scalar, int64_t, int, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT) &&    \
+     defined(KOKKOSKERNELS_INST_OFFSET_SIZE_T)) || \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&           \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(default_scalar, int, size_t, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT64_T) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_SIZE_T)) ||  \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&            \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(default_scalar, int64_t, size_t, TestDevice)
+#endif
+
+#undef EXECUTE_TEST
@@ -0,0 +1,265 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include "KokkosGraph_IncrementalColor.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_IOUtils.hpp"
+#include "KokkosKernels_Handle.hpp"
+
+namespace Test {
+
+// Device CRS graph of host adjacency sets.
+template <typename rowmap_t, typename entries_t, typename lno_t>
+void buildIncrementalColorGraph(const std::vector<std::set<lno_t>>& adj,
+                                rowmap_t& rowmap, entries_t& entries) {
+  const size_t n  = adj.size();
+  rowmap          = rowmap_t("Rowmap", n + 1);
+  auto rowmapHost = Kokkos::create_mirror_view(rowmap);
+  rowmapHost(0)   = 0;
+  for (size_t v = 0; v < n; v++) {
+    rowmapHost(v + 1) = rowmapHost(v) + adj[v].size();
+  }
+  entries          = entries_t("Entries", rowmapHost(n));
+  auto entriesHost = Kokkos::create_mirror_view(entries);
+  for (size_t v = 0; v < n; v++) {
+    size_t j = rowmapHost(v);
+    for (lno_t w : adj[v]) entriesHost(j++) = w;
+  }
+  Kokkos::deep_copy(rowmap, rowmapHost);
+  Kokkos::deep_copy(entries, entriesHost);
+}
+
+// The distance-1 or distance-2 neighborhood of v, without v.
+template <typename lno_t>
+std::set<lno_t> incrementalColorNeighborhood(
+    const std::vector<std::set<lno_t>>& adj, lno_t v, bool distance2) {
+  std::set<lno_t> nbhd;
+  for (lno_t x : adj[v]) {
+    nbhd.insert(x);
+    if (distance2) nbhd.insert(adj[x].begin(), adj[x].end());
+  }
+  nbhd.erase(v);
+  return nbhd;
+}
+
+// Number of uncolored vertices and of conflicts (counted from both ends).
+template <typename lno_t>
+lno_t countIncrementalColorConflicts(const std::vector<std::set<lno_t>>& adj,
+                                     const std::vector<int64_t>& colors,
+                                     bool distance2) {
+  lno_t conflicts = 0;
+  for (lno_t v = 0; v < lno_t(adj.size()); v++) {
+    if (colors[v] <= 0) conflicts++;
+    for (lno_t y : incrementalColorNeighborhood(adj, v, distance2)) {
+      if (colors[y] == colors[v]) conflicts++;
+    }
+  }
+  return conflicts;
+}
+
+}  // namespace Test
+
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void test_coloring_incremental(lno_t numVerts, size_type nnz, lno_t bandwidth,
+                               lno_t row_size_variance, bool distance2) {
+  using namespace KokkosGraph::Experimental;
+  using crsMat_t =
+      KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  using rowmap_t     = typename crsMat_t::row_map_type::non_const_type;
+  using entries_t    = typename crsMat_t::index_type::non_const_type;
+  using edges_t      = Kokkos::View<lno_t*, device>;
+  using KernelHandle = KokkosKernels::Experimental::KokkosKernelsHandle<
+      size_type, lno_t, scalar_t, typename device::execution_space,
+      typename device::memory_space, typename device::memory_space>;
+  crsMat_t A = KokkosSparse::Impl::kk_generate_sparse_matrix<crsMat_t>(
+      numVerts, numVerts, nnz, row_size_variance, bandwidth);
+  auto rowmapA  = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                     A.graph.row_map);
+  auto entriesA = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                      A.graph.entries);
+  std::vector<std::set<lno_t>> adj(numVerts);
+  for (lno_t v = 0; v < numVerts; v++) {
+    for (size_type j = rowmapA(v); j < rowmapA(v + 1); j++) {
+      const lno_t w = entriesA(j);
+      if (w == v || w >= numVerts) continue;
+      adj[v].insert(w);
+      adj[w].insert(v);
+    }
+  }
+  rowmap_t rowmap;
+  entries_t entries;
+  Test::buildIncrementalColorGraph(adj, rowmap, entries);
+
+  KernelHandle kh;
+  if (distance2) {
+    kh.create_distance2_graph_coloring_handle();
+  } else {
+    kh.create_graph_coloring_handle();
+  }
+  auto update = [&](lno_t n, const edges_t& insertedSrc,
+                    const edges_t& insertedDst, const edges_t& removedSrc,
+                    const edges_t& removedDst) {
+    if (distance2) {
+      graph_color_distance2_incremental(&kh, n, rowmap, entries, insertedSrc,
+                                        insertedDst, removedSrc, removedDst);
+    } else {
+      graph_color_incremental(&kh, n, rowmap, entries, insertedSrc,
+                              insertedDst, removedSrc, removedDst);
+    }
+  };
+  auto getColors = [&]() {
+    std::vector<int64_t> colors;
+    auto copy = [&](const auto& view) {
+      auto host =
+          Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), view);
+      colors.assign(host.data(), host.data() + host.extent(0));
+    };
+    if (distance2) {
+      copy(kh.get_distance2_graph_coloring_handle()->get_vertex_colors());
+    } else {
+      copy(kh.get_graph_coloring_handle()->get_vertex_colors());
+    }
+    return colors;
+  };
+  auto toDevice = [](const std::vector<lno_t>& v) {
+    edges_t view("Edges", v.size());
+    auto host = Kokkos::create_mirror_view(view);
+    for (size_t i = 0; i < v.size(); i++) host(i) = v[i];
+    Kokkos::deep_copy(view, host);
+    return view;
+  };
+
+  // without a previous coloring, a full one is computed
+  edges_t none;
+  update(numVerts, none, none, none, none);
+  const std::vector<int64_t> prevColors = getColors();
+  ASSERT_EQ(prevColors.size(), size_t(numVerts));
+  ASSERT_EQ(Test::countIncrementalColorConflicts(adj, prevColors, distance2),
+            0);
+
+  // remove and insert random edges, and add a few vertices
+  std::mt19937 rng(numVerts);
+  const lno_t numNew = numVerts / 100 + 1;
+  const lno_t n      = numVerts + numNew;
+  std::vector<lno_t> insertedSrc, insertedDst, removedSrc, removedDst;
+  adj.resize(n);
+  for (lno_t k = 0; k < numVerts / 50 + 1; k++) {
+    const lno_t u = rng() % numVerts;
+    if (adj[u].empty()) continue;
+    auto it = adj[u].begin();
+    std::advance(it, rng() % adj[u].size());
+    const lno_t w = *it;
+    adj[u].erase(w);
+    adj[w].erase(u);
+    removedSrc.push_back(u);
+    removedDst.push_back(w);
+  }
+  for (lno_t k = 0; k < n / 50 + numNew; k++) {
+    const lno_t u = k < numNew ? numVerts + k : lno_t(rng() % n);
+    const lno_t w = rng() % (k < numNew ? numVerts : n);
+    if (u == w || adj[u].count(w)) continue;
+    adj[u].insert(w);
+    adj[w].insert(u);
+    insertedSrc.push_back(u);
+    insertedDst.push_back(w);
+  }
+  Test::buildIncrementalColorGraph(adj, rowmap, entries);
+  update(n, toDevice(insertedSrc), toDevice(insertedDst),
+         toDevice(removedSrc), toDevice(removedDst));
+  const std::vector<int64_t> colors = getColors();
+  ASSERT_EQ(colors.size(), size_t(n));
+  EXPECT_EQ(Test::countIncrementalColorConflicts(adj, colors, distance2), 0);
+
+  // only the vertices near the updated edges may change color, and a
+  // recolored vertex takes one of the first colors free in its neighborhood
+  std::vector<bool> affected(n, false);
+  for (size_t i = 0; i < removedSrc.size(); i++) {
+    affected[removedSrc[i]] = true;
+    affected[removedDst[i]] = true;
+  }
+  for (size_t i = 0; i < insertedSrc.size(); i++) {
+    for (lno_t u : {insertedSrc[i], insertedDst[i]}) {
+      affected[u] = true;
+      if (!distance2) continue;
+      for (lno_t x : adj[u]) affected[x] = true;
+    }
+  }
+  for (lno_t v = 0; v < n; v++) {
+    const auto nbhd = Test::incrementalColorNeighborhood(adj, v, distance2);
+    if (v < numVerts && !affected[v]) {
+      EXPECT_EQ(colors[v], prevColors[v]) << "vertex " << v;
+    } else if (v >= numVerts || colors[v] != prevColors[v]) {
+      EXPECT_LE(colors[v], int64_t(nbhd.size()) + 1) << "vertex " << v;
+    }
+  }
+
+  EXPECT_THROW(update(n, toDevice({0}), none, none, none),
+               std::invalid_argument);
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE)                                   \
+  TEST_F(                                                                               \
+      TestCategory,                                                                     \
+      graph##_##graph_color_incremental##_##SCALAR##_##ORDINAL##_##OFFSET##_##DEVICE) { \
+    test_coloring_incremental<SCALAR, ORDINAL, OFFSET, DEVICE>(                         \
+        2000, 2000 * 10, 200, 5, false);                                                \
+    test_coloring_incremental<SCALAR, ORDINAL, OFFSET, DEVICE>(                         \
+        2000, 2000 * 10, 2000, 5, false);                                               \
+    test_coloring_incremental<SCALAR, ORDINAL, OFFSET, DEVICE>(                         \
+        2000, 2000 * 10, 200, 5, true);                                                 \
+  }
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_INT)) || \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&        \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(default_scalar, int, int, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT64_T) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_INT)) ||     \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&            \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(default_scalar, int64_t, int, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT) &&    \
+     defined(KOKKOSKERNELS_INST_OFFSET_SIZE_T)) || \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&           \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(default_scalar, int, size_t, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT64_T) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_SIZE_T)) ||  \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&            \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(default_scalar, int64_t, size_t, TestDevice)
+#endif
+
+#undef EXECUTE_TEST
@@ -0,0 +1,227 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "KokkosGraph_Ordering.hpp"
+
+namespace Test {
+
+// Builds the device graph of the symmetric adjacency lists adj.
+template <typename rowmap_t, typename entries_t>
+void makeOrderingGraph(
+    const std::vector<std::vector<typename entries_t::value_type>>& adj,
+    rowmap_t& rowmap, entries_t& entries) {
+  using size_type = typename rowmap_t::value_type;
+  size_type nnz   = 0;
+  for (const auto& row : adj) nnz += row.size();
+  rowmap           = rowmap_t("Rowmap", adj.size() + 1);
+  entries          = entries_t("Colinds", nnz);
+  auto rowmapHost  = Kokkos::create_mirror_view(rowmap);
+  auto entriesHost = Kokkos::create_mirror_view(entries);
+  nnz              = 0;
+  for (size_t v = 0; v < adj.size(); v++) {
+    for (auto nei : adj[v]) entriesHost(nnz++) = nei;
+    rowmapHost(v + 1) = nnz;
+  }
+  Kokkos::deep_copy(rowmap, rowmapHost);
+  Kokkos::deep_copy(entries, entriesHost);
+}
+
+// The 5-point stencil on a gridX x gridY grid, followed by isolated vertices.
+template <typename lno_t>
+std::vector<std::vector<lno_t>> gridAdjacency(lno_t gridX, lno_t gridY,
+                                              lno_t isolated = 0) {
+  std::vector<std::vector<lno_t>> adj(gridX * gridY + isolated);
+  for (lno_t y = 0; y < gridY; y++) {
+    for (lno_t x = 0; x < gridX; x++) {
+      const lno_t v = x + y * gridX;
+      if (y > 0) adj[v].push_back(v - gridX);
+      if (x > 0) adj[v].push_back(v - 1);
+      if (x < gridX - 1) adj[v].push_back(v + 1);
+      if (y < gridY - 1) adj[v].push_back(v + gridX);
+    }
+  }
+  return adj;
+}
+
+// Checks that labels is a permutation, and returns the number of entries
+// below the diagonal in the Cholesky factor of the reordered matrix.
+template <typename lno_t, typename labels_t>
+size_t checkOrderingFill(const std::vector<std::vector<lno_t>>& adj,
+                         const labels_t& labels) {
+  const lno_t numVerts = adj.size();
+  auto labelsHost =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), labels);
+  EXPECT_EQ(labelsHost.extent(0), size_t(numVerts));
+  std::vector<lno_t> vertexAt(numVerts, -1);
+  for (lno_t v = 0; v < numVerts; v++) {
+    const lno_t k = labelsHost(v);
+    EXPECT_GE(k, 0);
+    EXPECT_LT(k, numVerts);
+    if (k < 0 || k >= numVerts) return 0;
+    EXPECT_EQ(vertexAt[k], -1) << "label " << k << " given twice";
+    vertexAt[k] = v;
+  }
+  // column k of the factor: the neighbors after k, and the columns of its
+  // children in the elimination tree
+  std::vector<std::set<lno_t>> columns(numVerts);
+  std::vector<std::vector<lno_t>> children(numVerts);
+  size_t fill = 0;
+  for (lno_t k = 0; k < numVerts; k++) {
+    for (lno_t nei : adj[vertexAt[k]]) {
+      if (labelsHost(nei) > k) columns[k].insert(labelsHost(nei));
+    }
+    for (lno_t c : children[k]) {
+      for (lno_t i : columns[c]) {
+        if (i > k) columns[k].insert(i);
+      }
+      columns[c].clear();
+    }
+    fill += columns[k].size();
+    if (!columns[k].empty()) children[*columns[k].begin()].push_back(k);
+  }
+  return fill;
+}
+
+}  // namespace Test
+
+// Minimum degree orders a tree without fill.
+template <typename lno_t, typename size_type, typename device>
+void test_amd_tree(lno_t numVerts) {
+  using rowmap_t  = Kokkos::View<size_type*, device>;
+  using entries_t = Kokkos::View<lno_t*, device>;
+  // a path numbered in a scrambled order, with a star hanging from vertex 0
+  const lno_t stride = 7;
+  ASSERT_NE(numVerts % stride, 0);
+  std::vector<std::vector<lno_t>> adj(2 * numVerts);
+  for (lno_t k = 0; k + 1 < numVerts; k++) {
+    const lno_t u = (k * stride) % numVerts;
+    const lno_t v = ((k + 1) * stride) % numVerts;
+    adj[u].push_back(v);
+    adj[v].push_back(u);
+  }
+  for (lno_t v = numVerts; v < 2 * numVerts; v++) {
+    adj[0].push_back(v);
+    adj[v].push_back(0);
+  }
+  rowmap_t rowmap;
+  entries_t entries;
+  Test::makeOrderingGraph(adj, rowmap, entries);
+  auto amd = KokkosGraph::Experimental::graph_amd<device>(rowmap, entries);
+  EXPECT_EQ(Test::checkOrderingFill(adj, amd), size_t(2 * numVerts - 1));
+  // deterministic
+  auto amd2 = KokkosGraph::Experimental::graph_amd<device>(rowmap, entries);
+  auto amdHost = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), amd);
+  auto amd2Host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), amd2);
+  for (lno_t v = 0; v < 2 * numVerts; v++) ASSERT_EQ(amdHost(v), amd2Host(v));
+}
+
+// The fill-reducing orderings of a grid (with a few isolated vertices) must
+// have much less fill than its natural, banded ordering.
+template <typename lno_t, typename size_type, typename device>
+void test_ordering_grid(lno_t gridX, lno_t gridY, lno_t isolated) {
+  using rowmap_t  = Kokkos::View<size_type*, device>;
+  using entries_t = Kokkos::View<lno_t*, device>;
+  const auto adj  = Test::gridAdjacency(gridX, gridY, isolated);
+  rowmap_t rowmap;
+  entries_t entries;
+  Test::makeOrderingGraph(adj, rowmap, entries);
+  const lno_t numVerts = adj.size();
+  entries_t identity("Identity", numVerts);
+  KokkosKernels::Impl::sequential_fill(identity);
+  const size_t naturalFill = Test::checkOrderingFill(adj, identity);
+
+  auto amd = KokkosGraph::Experimental::graph_amd<device>(rowmap, entries);
+  const size_t amdFill = Test::checkOrderingFill(adj, amd);
+  if (gridX * gridY > 100) EXPECT_LT(2 * amdFill, naturalFill);
+  EXPECT_LE(amdFill, naturalFill);
+#if !defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_CUDA_LAMBDA)
+  for (lno_t leafSize : {lno_t(4), lno_t(128)}) {
+    auto nd = KokkosGraph::Experimental::graph_nested_dissection<device>(
+        rowmap, entries, leafSize);
+    const size_t ndFill = Test::checkOrderingFill(adj, nd);
+    if (gridX * gridY > 100) {
+      EXPECT_LT(2 * ndFill, naturalFill) << "leaf size " << leafSize;
+    }
+  }
+#endif
+}
+
+template <typename lno_t, typename size_type, typename device>
+void test_ordering_trivial() {
+  using rowmap_t  = Kokkos::View<size_type*, device>;
+  using entries_t = Kokkos::View<lno_t*, device>;
+  for (lno_t numVerts : {0, 1}) {
+    std::vector<std::vector<lno_t>> adj(numVerts);
+    rowmap_t rowmap;
+    entries_t entries;
+    Test::makeOrderingGraph(adj, rowmap, entries);
+    auto amd = KokkosGraph::Experimental::graph_amd<device>(rowmap, entries);
+    EXPECT_EQ(Test::checkOrderingFill(adj, amd), size_t(0));
+#if !defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_CUDA_LAMBDA)
+    auto nd = KokkosGraph::Experimental::graph_nested_dissection<device>(
+        rowmap, entries, lno_t(0));
+    EXPECT_EQ(Test::checkOrderingFill(adj, nd), size_t(0));
+#endif
+  }
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE)                       \
+  TEST_F(TestCategory,                                                      \
+         graph##_##ordering##_##SCALAR##_##ORDINAL##_##OFFSET##_##DEVICE) { \
+    test_ordering_trivial<ORDINAL, OFFSET, DEVICE>();                       \
+    test_amd_tree<ORDINAL, OFFSET, DEVICE>(500);                            \
+    test_ordering_grid<ORDINAL, OFFSET, DEVICE>(10, 10, 0);                 \
+    test_ordering_grid<ORDINAL, OFFSET, DEVICE>(60, 60, 5);                 \
+    test_ordering_grid<ORDINAL, OFFSET, DEVICE>(200, 30, 0);                \
+  }
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_INT)) || \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&        \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int, int, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT64_T) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_INT)) ||     \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&            \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int64_t, int, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT) &&    \
+     defined(KOKKOSKERNELS_INST_OFFSET_SIZE_T)) || \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&           \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int, size_t, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT64_T) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_SIZE_T)) ||  \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&            \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int64_t, size_t, TestDevice)
+#endif
+
+#undef EXECUTE_TEST
@@ -0,0 +1,190 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "KokkosGraph_PageRank.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_IOUtils.hpp"
+
+namespace Test {
+
+// Serial power iteration, with the dangling mass sent to the teleport
+// vector t (normalized).
+template <typename lno_t, typename rowmap_t, typename entries_t,
+          typename values_t>
+std::vector<double> serialPageRank(const rowmap_t& rowmap,
+                                   const entries_t& entries,
+                                   const values_t& values,
+                                   std::vector<double> t, double damping) {
+  const lno_t n = t.size();
+  double sum    = 0;
+  for (double w : t) sum += w;
+  for (double& w : t) w /= sum;
+  std::vector<double> degree(n, 0), x(t), next(n);
+  for (lno_t u = 0; u < n; u++) {
+    for (auto j = rowmap(u); j < rowmap(u + 1); j++) degree[u] += values(j);
+  }
+  for (int iter = 0; iter < 1000; iter++) {
+    double dangling = 0;
+    std::fill(next.begin(), next.end(), 0.0);
+    for (lno_t u = 0; u < n; u++) {
+      if (degree[u] <= 0) {
+        dangling += x[u];
+        continue;
+      }
+      for (auto j = rowmap(u); j < rowmap(u + 1); j++) {
+        next[entries(j)] += x[u] * values(j) / degree[u];
+      }
+    }
+    double change = 0;
+    for (lno_t v = 0; v < n; v++) {
+      next[v] = damping * (next[v] + dangling * t[v]) + (1 - damping) * t[v];
+      change += std::fabs(next[v] - x[v]);
+    }
+    std::swap(x, next);
+    if (change < 1e-14) break;
+  }
+  return x;
+}
+
+}  // namespace Test
+
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void test_pagerank(lno_t numVerts, size_type nnz, lno_t bandwidth,
+                   lno_t row_size_variance, bool weighted) {
+  using crsMat_t =
+      KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  using vector_t = Kokkos::View<scalar_t*, device>;
+  using mv_t     = Kokkos::View<scalar_t**, Kokkos::LayoutLeft, device>;
+  crsMat_t A = KokkosSparse::Impl::kk_generate_sparse_matrix<crsMat_t>(
+      numVerts, numVerts, nnz, row_size_variance, bandwidth);
+  // weights from 0.5 to 5, or 1; every 10th row is dangling
+  auto rowmapHost  = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                        A.graph.row_map);
+  auto entriesHost = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                         A.graph.entries);
+  auto valuesHost  = Kokkos::create_mirror_view(A.values);
+  for (lno_t u = 0; u < numVerts; u++) {
+    for (size_type j = rowmapHost(u); j < rowmapHost(u + 1); j++) {
+      if (u % 10 == 3) {
+        valuesHost(j) = 0;
+      } else {
+        valuesHost(j) = weighted ? 0.5 * (1 + (j * 7) % 10) : 1.0;
+      }
+    }
+  }
+  Kokkos::deep_copy(A.values, valuesHost);
+
+  const double damping = 0.85;
+  vector_t ranks;
+  const int iters = KokkosGraph::pagerank(A, ranks, damping, 1e-12, 500);
+  EXPECT_LE(iters, 500);
+  auto ranksHost =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), ranks);
+  std::vector<double> expected = Test::serialPageRank<lno_t>(
+      rowmapHost, entriesHost, valuesHost, std::vector<double>(numVerts, 1.0),
+      damping);
+  double sum = 0;
+  for (lno_t v = 0; v < numVerts; v++) {
+    EXPECT_NEAR(ranksHost(v), expected[v], 1e-9) << "vertex " << v;
+    sum += ranksHost(v);
+  }
+  EXPECT_NEAR(sum, 1.0, 1e-9);
+
+  // personalized: column j teleports to vertices j and 2j + 1, with weights
+  // 2 and 1
+  const int numCols = 3;
+  mv_t teleport("Teleport", numVerts, numCols);
+  auto teleportHost = Kokkos::create_mirror_view(teleport);
+  for (int j = 0; j < numCols; j++) {
+    teleportHost(j % numVerts, j) += 2;
+    teleportHost((2 * j + 1) % numVerts, j) += 1;
+  }
+  Kokkos::deep_copy(teleport, teleportHost);
+  mv_t personalized;
+  KokkosGraph::personalized_pagerank(A, teleport, personalized, damping,
+                                     1e-12, 500);
+  ASSERT_EQ(personalized.extent(0), size_t(numVerts));
+  ASSERT_EQ(personalized.extent(1), size_t(numCols));
+  auto personalizedHost =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), personalized);
+  for (int j = 0; j < numCols; j++) {
+    std::vector<double> t(numVerts);
+    for (lno_t v = 0; v < numVerts; v++) t[v] = teleportHost(v, j);
+    expected = Test::serialPageRank<lno_t>(rowmapHost, entriesHost,
+                                           valuesHost, t, damping);
+    for (lno_t v = 0; v < numVerts; v++) {
+      EXPECT_NEAR(personalizedHost(v, j), expected[v], 1e-9)
+          << "column " << j << ", vertex " << v;
+    }
+  }
+
+  EXPECT_THROW(KokkosGraph::pagerank(A, ranks, 1.0), std::invalid_argument);
+  Kokkos::deep_copy(teleport, scalar_t(0));
+  EXPECT_THROW(KokkosGraph::personalized_pagerank(A, teleport, personalized),
+               std::invalid_argument);
+  Kokkos::deep_copy(Kokkos::subview(A.values, 0), scalar_t(-1));
+  EXPECT_THROW(KokkosGraph::pagerank(A, ranks), std::invalid_argument);
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE)                        \
+  TEST_F(TestCategory,                                                       \
+         graph##_##pagerank##_##SCALAR##_##ORDINAL##_##OFFSET##_##DEVICE) {  \
+    test_pagerank<SCALAR, ORDINAL, OFFSET, DEVICE>(1, 1, 1, 0, false);       \
+    test_pagerank<SCALAR, ORDINAL, OFFSET, DEVICE>(1000, 1000 * 8, 1000, 4,  \
+                                                   false);                   \
+    test_pagerank<SCALAR, ORDINAL, OFFSET, DEVICE>(2000, 2000 * 10, 200, 10, \
+                                                   true);                    \
+  }
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_INT)) || \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&        \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int, int, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT64_T) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_INT)) ||     \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&            \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int64_t, int, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT) &&    \
+     defined(KOKKOSKERNELS_INST_OFFSET_SIZE_T)) || \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&           \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int, size_t, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT64_T) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_SIZE_T)) ||  \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&            \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int64_t, size_t, TestDevice)
+#endif
+
+#undef EXECUTE_TEST
@@ -0,0 +1,187 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "KokkosGraph_Partition.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+
+namespace Test {
+
+// The 5-point stencil on a gridX x gridY grid, with edge weights 1 (or 2 for
+// the edges along x, if weighted).
+template <typename crsMat_t>
+crsMat_t makePartitionGrid(typename crsMat_t::ordinal_type gridX,
+                           typename crsMat_t::ordinal_type gridY,
+                           bool weighted) {
+  using lno_t     = typename crsMat_t::ordinal_type;
+  using size_type = typename crsMat_t::size_type;
+  using scalar_t  = typename crsMat_t::value_type;
+  using rowmap_t  = typename crsMat_t::row_map_type::non_const_type;
+  using entries_t = typename crsMat_t::index_type::non_const_type;
+  using values_t  = typename crsMat_t::values_type::non_const_type;
+  const lno_t n   = gridX * gridY;
+  rowmap_t rowmap("Rowmap", n + 1);
+  auto rowmapHost = Kokkos::create_mirror_view(rowmap);
+  std::vector<lno_t> entriesVec;
+  std::vector<scalar_t> valuesVec;
+  for (lno_t y = 0; y < gridY; y++) {
+    for (lno_t x = 0; x < gridX; x++) {
+      const lno_t v       = x + y * gridX;
+      const lno_t neis[4] = {y > 0 ? v - gridX : -1, x > 0 ? v - 1 : -1,
+                             x < gridX - 1 ? v + 1 : -1,
+                             y < gridY - 1 ? v + gridX : -1};
+      for (int k = 0; k < 4; k++) {
+        if (neis[k] == -1) continue;
+        entriesVec.push_back(neis[k]);
+        valuesVec.push_back(weighted && (k == 1 || k == 2) ? 2 : 1);
+      }
+      rowmapHost(v + 1) = entriesVec.size();
+    }
+  }
+  const size_type nnz = entriesVec.size();
+  entries_t entries("Colinds", nnz);
+  values_t values("Values", nnz);
+  auto entriesHost = Kokkos::create_mirror_view(entries);
+  auto valuesHost  = Kokkos::create_mirror_view(values);
+  for (size_type j = 0; j < nnz; j++) {
+    entriesHost(j) = entriesVec[j];
+    valuesHost(j)  = valuesVec[j];
+  }
+  Kokkos::deep_copy(rowmap, rowmapHost);
+  Kokkos::deep_copy(entries, entriesHost);
+  Kokkos::deep_copy(values, valuesHost);
+  return crsMat_t("Grid", n, n, nnz, values, rowmap, entries);
+}
+
+}  // namespace Test
+
+// A partition of a grid must be balanced, report its cut correctly, and cut
+// far fewer edges than a round-robin partition.
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void test_partition_grid(lno_t gridX, lno_t gridY, lno_t numParts,
+                         double imbalance, bool weighted) {
+  using crsMat_t =
+      KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  using part_view_t = Kokkos::View<lno_t*, device>;
+  crsMat_t g    = Test::makePartitionGrid<crsMat_t>(gridX, gridY, weighted);
+  const lno_t n = g.numRows();
+  part_view_t parts;
+  const scalar_t cut = KokkosGraph::Experimental::graph_partition(
+      g, numParts, parts, imbalance);
+  ASSERT_EQ(parts.extent(0), size_t(n));
+  auto rowmapHost  = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                        g.graph.row_map);
+  auto entriesHost = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                         g.graph.entries);
+  auto valuesHost =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), g.values);
+  auto partsHost =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), parts);
+  std::vector<lno_t> sizes(numParts);
+  for (lno_t v = 0; v < n; v++) {
+    ASSERT_GE(partsHost(v), 0);
+    ASSERT_LT(partsHost(v), numParts);
+    sizes[partsHost(v)]++;
+  }
+  const lno_t maxSize =
+      static_cast<lno_t>(std::ceil((1.0 + imbalance) * n / numParts));
+  for (lno_t p = 0; p < numParts; p++) {
+    EXPECT_LE(sizes[p], maxSize) << "part " << p;
+  }
+  scalar_t expectedCut = 0, roundRobinCut = 0;
+  for (lno_t v = 0; v < n; v++) {
+    for (size_type j = rowmapHost(v); j < rowmapHost(v + 1); j++) {
+      const lno_t u = entriesHost(j);
+      if (u < v) continue;
+      if (partsHost(u) != partsHost(v)) expectedCut += valuesHost(j);
+      if (u % numParts != v % numParts) roundRobinCut += valuesHost(j);
+    }
+  }
+  EXPECT_EQ(cut, expectedCut);
+  if (numParts > 1) EXPECT_LT(10 * cut, roundRobinCut);
+}
+
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void test_partition_trivial() {
+  using crsMat_t =
+      KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  using part_view_t = Kokkos::View<lno_t*, device>;
+  part_view_t parts;
+  crsMat_t empty = Test::makePartitionGrid<crsMat_t>(0, 0, false);
+  EXPECT_EQ(KokkosGraph::Experimental::graph_partition(empty, 4, parts),
+            scalar_t(0));
+  EXPECT_EQ(parts.extent(0), size_t(0));
+  crsMat_t g = Test::makePartitionGrid<crsMat_t>(5, 5, false);
+  EXPECT_EQ(KokkosGraph::Experimental::graph_partition(g, 1, parts),
+            scalar_t(0));
+  auto partsHost =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), parts);
+  for (lno_t v = 0; v < 25; v++) EXPECT_EQ(partsHost(v), 0);
+  EXPECT_THROW(KokkosGraph::Experimental::graph_partition(g, 0, parts),
+               std::invalid_argument);
+  EXPECT_THROW(KokkosGraph::Experimental::graph_partition(g, 2, parts, -0.1),
+               std::invalid_argument);
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE)                        \
+  TEST_F(TestCategory,                                                       \
+         graph##_##partition##_##SCALAR##_##ORDINAL##_##OFFSET##_##DEVICE) { \
+    test_partition_trivial<SCALAR, ORDINAL, OFFSET, DEVICE>();               \
+    test_partition_grid<SCALAR, ORDINAL, OFFSET, DEVICE>(20, 10, 2, 0.03,    \
+                                                         false);             \
+    test_partition_grid<SCALAR, ORDINAL, OFFSET, DEVICE>(100, 100, 4, 0.03,  \
+                                                         false);             \
+    test_partition_grid<SCALAR, ORDINAL, OFFSET, DEVICE>(150, 80, 7, 0.05,   \
+                                                         true);              \
+  }
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_INT)) || \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&        \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int, int, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT64_T) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_INT)) ||     \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&            \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int64_t, int, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT) &&    \
+     defined(KOKKOSKERNELS_INST_OFFSET_SIZE_T)) || \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&           \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int, size_t, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT64_T) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_SIZE_T)) ||  \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&            \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int64_t, size_t, TestDevice)
+#endif
+
+#undef EXECUTE_TEST
@@ -139,12 +139,58 @@ void test_rcm(lno_t gridX, lno_t gridY, lno_t gridZ) {
   EXPECT_LE(rcmBW, origBW);
 }
 
+// A path whose vertices are numbered in a scrambled order: from a
+// pseudo-peripheral root (an end of the path), RCM recovers bandwidth 1.
+// Two runs must give the same labels.
+template <typename lno_t, typename size_type, typename device>
+void test_rcm_path(lno_t numVerts) {
+  using rowmap_t  = Kokkos::View<size_type*, device>;
+  using entries_t = Kokkos::View<lno_t*, device>;
+  // position k of the path is the vertex (k * stride) % numVerts
+  const lno_t stride = 7;
+  ASSERT_NE(numVerts % stride, 0);
+  std::vector<lno_t> vertexAt(numVerts), positionOf(numVerts);
+  for (lno_t k = 0; k < numVerts; k++) {
+    vertexAt[k]             = (k * stride) % numVerts;
+    positionOf[vertexAt[k]] = k;
+  }
+  rowmap_t rowmap("Rowmap", numVerts + 1);
+  entries_t entries("Colinds", 2 * (numVerts - 1));
+  auto rowmapHost  = Kokkos::create_mirror_view(rowmap);
+  auto entriesHost = Kokkos::create_mirror_view(entries);
+  rowmapHost(0)    = 0;
+  for (lno_t v = 0; v < numVerts; v++) {
+    const lno_t k = positionOf[v];
+    size_type nnz = rowmapHost(v);
+    if (k > 0) entriesHost(nnz++) = vertexAt[k - 1];
+    if (k < numVerts - 1) entriesHost(nnz++) = vertexAt[k + 1];
+    rowmapHost(v + 1) = nnz;
+  }
+  Kokkos::deep_copy(rowmap, rowmapHost);
+  Kokkos::deep_copy(entries, entriesHost);
+  auto rcm = KokkosGraph::Experimental::graph_rcm<device, rowmap_t, entries_t>(
+      rowmap, entries);
+  auto rcm2 = KokkosGraph::Experimental::graph_rcm<device, rowmap_t, entries_t>(
+      rowmap, entries);
+  auto rcmHost = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), rcm);
+  auto rcm2Host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), rcm2);
+  decltype(rcmHost) rcmPermHost(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "RCMPerm"), numVerts);
+  for (lno_t i = 0; i < numVerts; i++) {
+    ASSERT_EQ(rcmHost(i), rcm2Host(i));
+    rcmPermHost(rcmHost(i)) = i;
+  }
+  EXPECT_EQ(maxBandwidth(rowmapHost, entriesHost, rcmHost, rcmPermHost), 1);
+}
+
 #define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE)                  \
   TEST_F(TestCategory,                                                 \
          graph##_##rcm##_##SCALAR##_##ORDINAL##_##OFFSET##_##DEVICE) { \
     test_rcm<ORDINAL, OFFSET, DEVICE>(6, 3, 3);                        \
     test_rcm<ORDINAL, OFFSET, DEVICE>(20, 20, 20);                     \
     test_rcm<ORDINAL, OFFSET, DEVICE>(100, 100, 1);                    \
+    test_rcm_path<ORDINAL, OFFSET, DEVICE>(1000);                      \
   }
 
 #if (defined(KOKKOSKERNELS_INST_ORDINAL_INT) && \
@@ -0,0 +1,287 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "KokkosGraph_Reorder.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_IOUtils.hpp"
+
+namespace Test {
+
+// Checks that labels is a permutation, and returns the vertex at each
+// position.
+template <typename lno_t, typename labels_t>
+std::vector<lno_t> checkReorderPermutation(const labels_t& labelsHost,
+                                           lno_t numVerts) {
+  EXPECT_EQ(labelsHost.extent(0), size_t(numVerts));
+  std::vector<lno_t> vertexAt(numVerts, -1);
+  for (lno_t v = 0; v < numVerts; v++) {
+    const lno_t k = labelsHost(v);
+    EXPECT_GE(k, 0);
+    EXPECT_LT(k, numVerts);
+    if (k < 0 || k >= numVerts) return {};
+    EXPECT_EQ(vertexAt[k], -1) << "label " << k << " given twice";
+    vertexAt[k] = v;
+  }
+  return vertexAt;
+}
+
+// Mean of |labels(i) - labels(j)| over the entries (i, j) of the graph.
+template <typename lno_t, typename rowmap_t, typename entries_t,
+          typename labels_t>
+double meanLabelDistance(lno_t numVerts, const rowmap_t& rowmapHost,
+                         const entries_t& entriesHost,
+                         const labels_t& labelsHost) {
+  double sum = 0;
+  for (lno_t i = 0; i < numVerts; i++) {
+    for (auto j = rowmapHost(i); j < rowmapHost(i + 1); j++) {
+      sum += std::abs(double(labelsHost(i)) - labelsHost(entriesHost(j)));
+    }
+  }
+  return entriesHost.extent(0) ? sum / entriesHost.extent(0) : 0.0;
+}
+
+}  // namespace Test
+
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void test_reorder(lno_t numVerts, size_type nnz, lno_t bandwidth,
+                  lno_t row_size_variance) {
+  using crsMat_t =
+      KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  using KokkosGraph::reorder_algorithm_name;
+  crsMat_t A = KokkosSparse::Impl::kk_generate_sparse_matrix<crsMat_t>(
+      numVerts, numVerts, nnz, row_size_variance, bandwidth);
+  auto rowmapHost = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                        A.graph.row_map);
+  auto degree     = [&](lno_t v) { return rowmapHost(v + 1) - rowmapHost(v); };
+
+  const double avgDegree = double(A.nnz()) / numVerts;
+  for (auto algo :
+       {KokkosGraph::REORDER_DEGREE_SORT, KokkosGraph::REORDER_HUB_SORT,
+        KokkosGraph::REORDER_DEGREE_GROUPING}) {
+    auto labels = KokkosGraph::reorder<device>(A.graph.row_map,
+                                               A.graph.entries, algo);
+    auto labelsHost =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), labels);
+    const auto vertexAt = Test::checkReorderPermutation(labelsHost, numVerts);
+    ASSERT_EQ(vertexAt.size(), size_t(numVerts));
+    // the key of the vertex at each position must not decrease, and the
+    // vertices with the same key must keep their order
+    auto key = [&](lno_t v) -> double {
+      switch (algo) {
+        case KokkosGraph::REORDER_DEGREE_SORT: return -double(degree(v));
+        case KokkosGraph::REORDER_HUB_SORT:
+          return degree(v) > avgDegree ? -double(degree(v)) : 1.0;
+        default: {
+          int group = 7;
+          for (double t = avgDegree; group > 0 && degree(v) >= t; t *= 2) {
+            group--;
+          }
+          return group;
+        }
+      }
+    };
+    for (lno_t k = 1; k < numVerts; k++) {
+      const lno_t u = vertexAt[k - 1], v = vertexAt[k];
+      ASSERT_LE(key(u), key(v)) << reorder_algorithm_name(algo) << ": " << k;
+      if (key(u) == key(v)) {
+        ASSERT_LT(u, v) << reorder_algorithm_name(algo) << ": " << k;
+      }
+    }
+  }
+#if !defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_CUDA_LAMBDA)
+  auto labels = KokkosGraph::reorder<device>(
+      A.graph.row_map, A.graph.entries, KokkosGraph::REORDER_COMMUNITY);
+  auto labelsHost =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), labels);
+  Test::checkReorderPermutation(labelsHost, numVerts);
+#endif
+}
+
+// The community ordering of a shuffled banded graph puts the neighbors of
+// every vertex close to it again.
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void test_reorder_community(lno_t numVerts, lno_t halfBand) {
+#if !defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_CUDA_LAMBDA)
+  using crsMat_t =
+      KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  using rowmap_t  = typename crsMat_t::row_map_type::non_const_type;
+  using entries_t = typename crsMat_t::index_type::non_const_type;
+  using values_t  = typename crsMat_t::values_type::non_const_type;
+  using labels_t  = Kokkos::View<lno_t*, device>;
+  rowmap_t rowmap("rowmap", numVerts + 1);
+  auto rowmapHost = Kokkos::create_mirror_view(rowmap);
+  std::vector<lno_t> band;
+  rowmapHost(0) = 0;
+  for (lno_t i = 0; i < numVerts; i++) {
+    for (lno_t j = std::max(lno_t(0), i - halfBand);
+         j <= std::min(numVerts - 1, i + halfBand); j++) {
+      if (j != i) band.push_back(j);
+    }
+    rowmapHost(i + 1) = band.size();
+  }
+  Kokkos::deep_copy(rowmap, rowmapHost);
+  entries_t entries("entries", band.size());
+  auto entriesHost = Kokkos::create_mirror_view(entries);
+  std::copy(band.begin(), band.end(), entriesHost.data());
+  Kokkos::deep_copy(entries, entriesHost);
+  values_t values("values", band.size());
+  Kokkos::deep_copy(values, scalar_t(1));
+  crsMat_t A("banded", numVerts, numVerts, band.size(), values, rowmap,
+             entries);
+
+  std::vector<lno_t> shuffle(numVerts);
+  std::iota(shuffle.begin(), shuffle.end(), lno_t(0));
+  std::shuffle(shuffle.begin(), shuffle.end(), std::mt19937(1234));
+  labels_t shuffleLabels("shuffle", numVerts);
+  auto shuffleHost = Kokkos::create_mirror_view(shuffleLabels);
+  std::copy(shuffle.begin(), shuffle.end(), shuffleHost.data());
+  Kokkos::deep_copy(shuffleLabels, shuffleHost);
+  crsMat_t B = KokkosGraph::permute_symmetric(A, shuffleLabels);
+
+  auto labels = KokkosGraph::reorder<device>(
+      B.graph.row_map, B.graph.entries, KokkosGraph::REORDER_COMMUNITY);
+  auto labelsHost =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), labels);
+  ASSERT_EQ(Test::checkReorderPermutation(labelsHost, numVerts).size(),
+            size_t(numVerts));
+  auto bRowmap  = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                     B.graph.row_map);
+  auto bEntries = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                      B.graph.entries);
+  Kokkos::View<lno_t*, Kokkos::HostSpace> identity("identity", numVerts);
+  std::iota(identity.data(), identity.data() + numVerts, lno_t(0));
+  // about numVerts / 3 for the shuffled graph, and of the order of the
+  // band width times the number of coarsening levels once reordered
+  const double shuffled =
+      Test::meanLabelDistance(numVerts, bRowmap, bEntries, identity);
+  const double reordered =
+      Test::meanLabelDistance(numVerts, bRowmap, bEntries, labelsHost);
+  EXPECT_LT(reordered, shuffled / 8) << "shuffled: " << shuffled;
+#else
+  (void)numVerts;
+  (void)halfBand;
+#endif
+}
+
+// P A P^T has the entries of A, moved to their new rows and columns.
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void test_permute_symmetric(lno_t numVerts, size_type nnz, lno_t bandwidth,
+                            lno_t row_size_variance) {
+  using crsMat_t =
+      KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  using entry_t = std::pair<lno_t, scalar_t>;
+  crsMat_t A = KokkosSparse::Impl::kk_generate_sparse_matrix<crsMat_t>(
+      numVerts, numVerts, nnz, row_size_variance, bandwidth);
+  auto labels = KokkosGraph::reorder<device>(A.graph.row_map, A.graph.entries,
+                                             KokkosGraph::REORDER_DEGREE_SORT);
+  crsMat_t B = KokkosGraph::permute_symmetric(A, labels);
+  ASSERT_EQ(B.numRows(), numVerts);
+  ASSERT_EQ(B.numCols(), numVerts);
+  ASSERT_EQ(B.nnz(), A.nnz());
+  auto labelsHost =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), labels);
+  auto aRowmap  = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                     A.graph.row_map);
+  auto aEntries = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                      A.graph.entries);
+  auto aValues =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A.values);
+  auto bRowmap  = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                     B.graph.row_map);
+  auto bEntries = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                      B.graph.entries);
+  auto bValues =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), B.values);
+  for (lno_t i = 0; i < numVerts; i++) {
+    std::vector<entry_t> expected;
+    for (size_type j = aRowmap(i); j < aRowmap(i + 1); j++) {
+      expected.emplace_back(labelsHost(aEntries(j)), aValues(j));
+    }
+    std::stable_sort(
+        expected.begin(), expected.end(),
+        [](const entry_t& a, const entry_t& b) { return a.first < b.first; });
+    const lno_t row = labelsHost(i);
+    ASSERT_EQ(size_t(bRowmap(row + 1) - bRowmap(row)), expected.size());
+    for (size_t k = 0; k < expected.size(); k++) {
+      const size_type j = bRowmap(row) + k;
+      ASSERT_EQ(bEntries(j), expected[k].first) << "row " << row;
+      // duplicate columns may come in any order
+      if (k + 1 < expected.size() &&
+          expected[k].first == expected[k + 1].first)
+        continue;
+      if (k > 0 && expected[k].first == expected[k - 1].first) continue;
+      ASSERT_EQ(bValues(j), expected[k].second) << "row " << row;
+    }
+  }
+  Kokkos::View<lno_t*, device> tooShort("Labels", numVerts / 2);
+  EXPECT_THROW(KokkosGraph::permute_symmetric(A, tooShort),
+               std::invalid_argument);
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE)                          \
+  TEST_F(TestCategory,                                                         \
+         graph##_##reorder##_##SCALAR##_##ORDINAL##_##OFFSET##_##DEVICE) {     \
+    test_reorder<SCALAR, ORDINAL, OFFSET, DEVICE>(1, 1, 1, 0);                 \
+    test_reorder<SCALAR, ORDINAL, OFFSET, DEVICE>(1000, 1000 * 8, 1000, 40);   \
+    test_reorder<SCALAR, ORDINAL, OFFSET, DEVICE>(5000, 5000 * 20, 5000, 200); \
+    test_permute_symmetric<SCALAR, ORDINAL, OFFSET, DEVICE>(1000, 1000 * 8,    \
+                                                            1000, 40);         \
+    test_reorder_community<SCALAR, ORDINAL, OFFSET, DEVICE>(10000, 4);         \
+  }
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_INT)) || \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&        \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int, int, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT64_T) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_INT)) ||     \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&            \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int64_t, int, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT) &&    \
+     defined(KOKKOSKERNELS_INST_OFFSET_SIZE_T)) || \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&           \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int, size_t, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT64_T) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_SIZE_T)) ||  \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&            \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int64_t, size_t, TestDevice)
+#endif
+
+#undef EXECUTE_TEST
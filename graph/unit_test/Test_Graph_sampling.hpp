@@ -0,0 +1,185 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "KokkosGraph_Sampling.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_IOUtils.hpp"
+
+template <typename lno_t, typename size_type, typename device>
+void test_sample_khop(lno_t numVerts, size_type nnz, lno_t bandwidth,
+                      lno_t row_size_variance, lno_t numSeeds,
+                      const std::vector<int>& fanouts) {
+  using crsMat =
+      KokkosSparse::CrsMatrix<double, lno_t, device, void, size_type>;
+  using rowmap_t  = typename crsMat::StaticCrsGraphType::row_map_type;
+  using offsets_t = typename rowmap_t::non_const_type;
+  using lno_view_t =
+      typename crsMat::StaticCrsGraphType::entries_type::non_const_type;
+  crsMat A = KokkosSparse::Impl::kk_generate_sparse_matrix<crsMat>(
+      numVerts, numVerts, nnz, row_size_variance, bandwidth);
+  auto rowmapHost  = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                        A.graph.row_map);
+  auto entriesHost = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                         A.graph.entries);
+  lno_view_t seeds("Seeds", numSeeds);
+  auto seedsHost = Kokkos::create_mirror_view(seeds);
+  for (lno_t b = 0; b < numSeeds; b++) seedsHost(b) = (b * 7919) % numVerts;
+  Kokkos::deep_copy(seeds, seedsHost);
+
+  offsets_t sampleOffsets, subRowmap;
+  lno_view_t vertices, subEntries;
+  KokkosGraph::sample_khop_neighborhoods<device>(
+      A.graph.row_map, A.graph.entries, seeds, fanouts, sampleOffsets,
+      vertices, subRowmap, subEntries, 42);
+  auto offsetsHost = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                         sampleOffsets);
+  auto verticesHost =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), vertices);
+  auto subRowmapHost =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), subRowmap);
+  auto subEntriesHost =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), subEntries);
+  ASSERT_EQ(offsetsHost.extent(0), size_t(numSeeds + 1));
+  ASSERT_EQ(offsetsHost(0), size_type(0));
+  ASSERT_EQ(verticesHost.extent(0), size_t(offsetsHost(numSeeds)));
+  ASSERT_EQ(subRowmapHost.extent(0), verticesHost.extent(0) + 1);
+  for (lno_t b = 0; b < numSeeds; b++) {
+    const size_type base = offsetsHost(b);
+    const lno_t n        = offsetsHost(b + 1) - base;
+    ASSERT_GE(n, 1);
+    EXPECT_EQ(verticesHost(base), seedsHost(b));
+    std::vector<lno_t> sorted(n);
+    for (lno_t i = 0; i < n; i++) sorted[i] = verticesHost(base + i);
+    std::sort(sorted.begin(), sorted.end());
+    EXPECT_TRUE(std::adjacent_find(sorted.begin(), sorted.end()) ==
+                sorted.end())
+        << "sample " << b << " has a vertex twice";
+    // hop of every vertex: the vertices are numbered in the order they are
+    // reached, and the edges go from a hop to itself, an earlier hop, or the
+    // next one
+    std::vector<int> hop(n, -1);
+    hop[0] = 0;
+    for (lno_t i = 0; i < n; i++) {
+      ASSERT_NE(hop[i], -1) << "sample " << b << ": vertex " << i
+                            << " not reached before it is numbered";
+      const lno_t u     = verticesHost(base + i);
+      const lno_t deg   = rowmapHost(u + 1) - rowmapHost(u);
+      const lno_t count = subRowmapHost(base + i + 1) - subRowmapHost(base + i);
+      if (hop[i] == int(fanouts.size())) {
+        EXPECT_EQ(count, 0);
+        continue;
+      }
+      EXPECT_EQ(count, std::min<lno_t>(deg, fanouts[hop[i]]));
+      std::vector<lno_t> rowLeft;
+      for (size_type j = rowmapHost(u); j < rowmapHost(u + 1); j++) {
+        rowLeft.push_back(entriesHost(j));
+      }
+      for (size_type j = subRowmapHost(base + i);
+           j < subRowmapHost(base + i + 1); j++) {
+        const lno_t w = subEntriesHost(j);
+        ASSERT_GE(w, 0);
+        ASSERT_LT(w, n);
+        if (hop[w] == -1) hop[w] = hop[i] + 1;
+        // a distinct entry of the row of u
+        auto it = std::find(rowLeft.begin(), rowLeft.end(),
+                            verticesHost(base + w));
+        ASSERT_TRUE(it != rowLeft.end())
+            << "sample " << b << ": no edge " << u << " -> "
+            << verticesHost(base + w);
+        rowLeft.erase(it);
+      }
+    }
+  }
+
+  // the same seed gives the same samples
+  offsets_t sampleOffsets2, subRowmap2;
+  lno_view_t vertices2, subEntries2;
+  KokkosGraph::sample_khop_neighborhoods<device>(
+      A.graph.row_map, A.graph.entries, seeds, fanouts, sampleOffsets2,
+      vertices2, subRowmap2, subEntries2, 42);
+  auto vertices2Host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), vertices2);
+  auto subEntries2Host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), subEntries2);
+  ASSERT_EQ(vertices2Host.extent(0), verticesHost.extent(0));
+  ASSERT_EQ(subEntries2Host.extent(0), subEntriesHost.extent(0));
+  for (size_t k = 0; k < verticesHost.extent(0); k++) {
+    ASSERT_EQ(vertices2Host(k), verticesHost(k));
+  }
+  for (size_t k = 0; k < subEntriesHost.extent(0); k++) {
+    ASSERT_EQ(subEntries2Host(k), subEntriesHost(k));
+  }
+
+  lno_view_t badSeeds("Seeds", 1);
+  Kokkos::deep_copy(badSeeds, numVerts);
+  EXPECT_THROW(KokkosGraph::sample_khop_neighborhoods<device>(
+                   A.graph.row_map, A.graph.entries, badSeeds, fanouts,
+                   sampleOffsets, vertices, subRowmap, subEntries),
+               std::invalid_argument);
+  EXPECT_THROW(KokkosGraph::sample_khop_neighborhoods<device>(
+                   A.graph.row_map, A.graph.entries, seeds,
+                   std::vector<int>{3, 0}, sampleOffsets, vertices, subRowmap,
+                   subEntries),
+               std::invalid_argument);
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE)                          \
+  TEST_F(TestCategory,                                                         \
+         graph##_##sample_khop##_##SCALAR##_##ORDINAL##_##OFFSET##_##DEVICE) { \
+    test_sample_khop<ORDINAL, OFFSET, DEVICE>(1, 1, 1, 0, 3, {2, 2});          \
+    test_sample_khop<ORDINAL, OFFSET, DEVICE>(1000, 1000 * 8, 1000, 4, 100,    \
+                                              {5, 3});                         \
+    test_sample_khop<ORDINAL, OFFSET, DEVICE>(5000, 5000 * 20, 5000, 10, 500,  \
+                                              {10, 5, 2});                     \
+    test_sample_khop<ORDINAL, OFFSET, DEVICE>(500, 500 * 4, 50, 2, 10, {});    \
+  }
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_INT)) || \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&        \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int, int, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT64_T) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_INT)) ||     \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&            \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int64_t, int, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT) &&    \
+     defined(KOKKOSKERNELS_INST_OFFSET_SIZE_T)) || \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&           \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int, size_t, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT64_T) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_SIZE_T)) ||  \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&            \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int64_t, size_t, TestDevice)
+#endif
+
+#undef EXECUTE_TEST
@@ -0,0 +1,222 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "KokkosGraph_Traversal.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_IOUtils.hpp"
+#include "KokkosKernels_Utils.hpp"
+
+namespace Test {
+
+// Serial BFS levels along the rows of the graph.
+template <typename lno_t, typename rowmap_t, typename entries_t>
+std::vector<lno_t> serialBfsLevels(const rowmap_t& rowmap,
+                                   const entries_t& entries, lno_t source) {
+  const lno_t numVerts = rowmap.extent(0) - 1;
+  std::vector<lno_t> levels(numVerts, -1);
+  std::queue<lno_t> q;
+  levels[source] = 0;
+  q.push(source);
+  while (!q.empty()) {
+    const lno_t u = q.front();
+    q.pop();
+    for (auto j = rowmap(u); j < rowmap(u + 1); j++) {
+      const lno_t w = entries(j);
+      if (w >= numVerts || levels[w] != -1) continue;
+      levels[w] = levels[u] + 1;
+      q.push(w);
+    }
+  }
+  return levels;
+}
+
+template <typename lno_t, typename size_type, typename device,
+          typename rowmap_t, typename entries_t>
+void checkBfs(const rowmap_t& rowmap, const entries_t& entries, lno_t source,
+              KokkosGraph::BFS_Algorithm algo) {
+  using lno_view_t = typename entries_t::non_const_type;
+  lno_view_t levels, parents;
+  KokkosGraph::bfs<device>(rowmap, entries, source, levels, parents, algo);
+  auto rowmapHost =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), rowmap);
+  auto entriesHost =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), entries);
+  auto levelsHost =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), levels);
+  auto parentsHost =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), parents);
+  std::vector<lno_t> expected =
+      serialBfsLevels<lno_t>(rowmapHost, entriesHost, source);
+  const lno_t numVerts = expected.size();
+  ASSERT_EQ(levelsHost.extent(0), size_t(numVerts));
+  EXPECT_EQ(parentsHost(source), source);
+  for (lno_t v = 0; v < numVerts; v++) {
+    ASSERT_EQ(levelsHost(v), expected[v])
+        << KokkosGraph::bfs_algorithm_name(algo) << ": vertex " << v;
+    if (expected[v] <= 0) {
+      if (expected[v] < 0) EXPECT_EQ(parentsHost(v), -1);
+      continue;
+    }
+    // the parent is on the previous level, with an edge to v
+    const lno_t p = parentsHost(v);
+    ASSERT_GE(p, 0);
+    ASSERT_LT(p, numVerts);
+    EXPECT_EQ(expected[p], expected[v] - 1);
+    bool edge = false;
+    for (size_type j = rowmapHost(p); j < rowmapHost(p + 1); j++) {
+      edge = edge || entriesHost(j) == v;
+    }
+    EXPECT_TRUE(edge) << "no edge " << p << " -> " << v;
+  }
+}
+
+}  // namespace Test
+
+template <typename lno_t, typename size_type, typename device>
+void test_bfs(lno_t numVerts, size_type nnz, lno_t bandwidth,
+              lno_t row_size_variance) {
+  using execution_space = typename device::execution_space;
+  using crsMat =
+      KokkosSparse::CrsMatrix<double, lno_t, device, void, size_type>;
+  using c_rowmap_t  = typename crsMat::StaticCrsGraphType::row_map_type;
+  using c_entries_t = typename crsMat::StaticCrsGraphType::entries_type;
+  using rowmap_t    = typename c_rowmap_t::non_const_type;
+  using entries_t   = typename c_entries_t::non_const_type;
+  crsMat A = KokkosSparse::Impl::kk_generate_sparse_matrix<crsMat>(
+      numVerts, numVerts, nnz, row_size_variance, bandwidth);
+  // directed graph: top-down only
+  for (lno_t source : {lno_t(0), numVerts / 2}) {
+    Test::checkBfs<lno_t, size_type, device>(A.graph.row_map, A.graph.entries,
+                                             source, KokkosGraph::BFS_TOP_DOWN);
+  }
+  rowmap_t symRowmap;
+  entries_t symEntries;
+  KokkosKernels::Impl::symmetrize_graph_symbolic_hashmap<
+      c_rowmap_t, c_entries_t, rowmap_t, entries_t, execution_space>(
+      numVerts, A.graph.row_map, A.graph.entries, symRowmap, symEntries);
+  for (auto algo :
+       {KokkosGraph::BFS_TOP_DOWN, KokkosGraph::BFS_DIRECTION_OPTIMIZING}) {
+    for (lno_t source : {lno_t(0), numVerts - 1}) {
+      Test::checkBfs<lno_t, size_type, device>(symRowmap, symEntries, source,
+                                               algo);
+    }
+  }
+}
+
+template <typename lno_t, typename size_type, typename device>
+void test_sssp(lno_t numVerts, size_type nnz, lno_t bandwidth,
+               lno_t row_size_variance) {
+  using crsMat =
+      KokkosSparse::CrsMatrix<double, lno_t, device, void, size_type>;
+  crsMat A = KokkosSparse::Impl::kk_generate_sparse_matrix<crsMat>(
+      numVerts, numVerts, nnz, row_size_variance, bandwidth);
+  auto rowmapHost  = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                        A.graph.row_map);
+  auto entriesHost = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                         A.graph.entries);
+  // weights from 0 to 9.5
+  auto valuesHost = Kokkos::create_mirror_view(A.values);
+  for (size_type k = 0; k < A.nnz(); k++) {
+    valuesHost(k) = 0.5 * ((k * 7) % 20);
+  }
+  Kokkos::deep_copy(A.values, valuesHost);
+
+  // Dijkstra from vertex 0
+  const double inf = std::numeric_limits<double>::infinity();
+  std::vector<double> expected(numVerts, inf);
+  using item_t = std::pair<double, lno_t>;
+  std::priority_queue<item_t, std::vector<item_t>, std::greater<item_t>> q;
+  expected[0] = 0;
+  q.push({0.0, lno_t(0)});
+  while (!q.empty()) {
+    const auto [d, u] = q.top();
+    q.pop();
+    if (d > expected[u]) continue;
+    for (size_type k = rowmapHost(u); k < rowmapHost(u + 1); k++) {
+      const lno_t w = entriesHost(k);
+      if (w >= numVerts || d + valuesHost(k) >= expected[w]) continue;
+      expected[w] = d + valuesHost(k);
+      q.push({expected[w], w});
+    }
+  }
+
+  for (double delta : {0.0, 0.25, 3.0, 1e6}) {
+    auto dist = KokkosGraph::sssp(A, lno_t(0), delta);
+    auto distHost =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), dist);
+    for (lno_t v = 0; v < numVerts; v++) {
+      if (expected[v] == inf) {
+        EXPECT_EQ(distHost(v), inf) << "delta " << delta << ", vertex " << v;
+      } else {
+        EXPECT_NEAR(distHost(v), expected[v], 1e-10 * (1 + expected[v]))
+            << "delta " << delta << ", vertex " << v;
+      }
+    }
+  }
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE)                       \
+  TEST_F(TestCategory,                                                      \
+         graph##_##bfs##_##SCALAR##_##ORDINAL##_##OFFSET##_##DEVICE) {      \
+    test_bfs<ORDINAL, OFFSET, DEVICE>(1, 1, 1, 0);                          \
+    test_bfs<ORDINAL, OFFSET, DEVICE>(1000, 1000 * 4, 100, 2);              \
+    test_bfs<ORDINAL, OFFSET, DEVICE>(5000, 5000 * 20, 5000, 10);           \
+  }                                                                         \
+  TEST_F(TestCategory,                                                      \
+         graph##_##sssp##_##SCALAR##_##ORDINAL##_##OFFSET##_##DEVICE) {     \
+    test_sssp<ORDINAL, OFFSET, DEVICE>(1, 1, 1, 0);                         \
+    test_sssp<ORDINAL, OFFSET, DEVICE>(1000, 1000 * 4, 100, 2);             \
+    test_sssp<ORDINAL, OFFSET, DEVICE>(3000, 3000 * 12, 3000, 6);           \
+  }
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_INT)) || \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&        \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int, int, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT64_T) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_INT)) ||     \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&            \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int64_t, int, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT) &&    \
+     defined(KOKKOSKERNELS_INST_OFFSET_SIZE_T)) || \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&           \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int, size_t, TestDevice)
+#endif
+
+#if (defined(KOKKOSKERNELS_INST_ORDINAL_INT64_T) && \
+     defined(KOKKOSKERNELS_INST_OFFSET_SIZE_T)) ||  \
+    (!defined(KOKKOSKERNELS_ETI_ONLY) &&            \
+     !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+EXECUTE_TEST(double, int64_t, size_t, TestDevice)
+#endif
+
+#undef EXECUTE_TEST
@@ -0,0 +1,140 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSSPARSE_COOASSEMBLER_IMPL_HPP
+#define _KOKKOSSPARSE_COOASSEMBLER_IMPL_HPP
+
+/// \file KokkosSparse_CooAssembler_impl.hpp
+/// \brief Kernels of the streaming COO assembly: bucketing of a batch of
+///        triples by row, and lookup of triples in an existing pattern.
+
+#include <Kokkos_Core.hpp>
+#include "KokkosKernels_LowerBound.hpp"
+
+namespace KokkosSparse {
+namespace Impl {
+
+/// \brief Counts the valid triples of every row (in rowmap(i + 1)), and the
+/// triples out of bounds. Triples with a negative row or column are ignored,
+/// as in coo2crs.
+template <typename rowmap_t, typename row_view_t, typename col_view_t>
+struct CooBatchCountFunctor {
+  using value_type = size_t;
+
+  rowmap_t rowmap;
+  row_view_t rows;
+  col_view_t cols;
+  int64_t num_rows, num_cols;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t k, size_t &num_invalid) const {
+    const int64_t i = rows(k);
+    const int64_t j = cols(k);
+    if (i < 0 || j < 0) return;
+    if (i >= num_rows || j >= num_cols) {
+      num_invalid++;
+      return;
+    }
+    Kokkos::atomic_inc(&rowmap(i + 1));
+  }
+};
+
+/// \brief Scatters the valid triples of a batch into their rows (in no
+/// particular order within a row).
+template <typename rowmap_t, typename entries_t, typename values_t,
+          typename row_view_t, typename col_view_t, typename val_view_t>
+struct CooBatchFillFunctor {
+  using lno_t    = typename entries_t::non_const_value_type;
+  using offset_t = typename rowmap_t::non_const_value_type;
+
+  rowmap_t cursor;
+  entries_t entries;
+  values_t values;
+  row_view_t rows;
+  col_view_t cols;
+  val_view_t vals;
+  int64_t num_rows, num_cols;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t k) const {
+    const int64_t i = rows(k);
+    const int64_t j = cols(k);
+    if (i < 0 || j < 0 || i >= num_rows || j >= num_cols) return;
+    const offset_t pos = Kokkos::atomic_fetch_add(&cursor(i), offset_t(1));
+    entries(pos)       = lno_t(j);
+    values(pos)        = vals(k);
+  }
+};
+
+/// \brief Finds the position of every triple in the values of a matrix with
+/// sorted rows. Triples that are ignored (negative indices) or not in the
+/// pattern get the offset invalid; the latter are counted.
+template <typename rowmap_t, typename entries_t, typename offsets_t,
+          typename row_view_t, typename col_view_t>
+struct CooPatternOffsetsFunctor {
+  using lno_t      = typename entries_t::non_const_value_type;
+  using offset_t   = typename offsets_t::non_const_value_type;
+  using value_type = size_t;
+
+  rowmap_t rowmap;
+  entries_t entries;
+  offsets_t offsets;
+  row_view_t rows;
+  col_view_t cols;
+  int64_t num_rows;
+  offset_t invalid;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t k, size_t &num_missing) const {
+    const int64_t i = rows(k);
+    const int64_t j = cols(k);
+    offsets(k)      = invalid;
+    if (i < 0 || j < 0) return;
+    if (i >= num_rows) {
+      num_missing++;
+      return;
+    }
+    const auto row = Kokkos::subview(
+        entries, Kokkos::make_pair(rowmap(i), rowmap(i + 1)));
+    const auto pos = KokkosKernels::lower_bound_thread(row, lno_t(j));
+    if (pos < row.extent(0) && row(pos) == lno_t(j)) {
+      offsets(k) = rowmap(i) + pos;
+    } else {
+      num_missing++;
+    }
+  }
+};
+
+/// \brief Adds the values of the triples into the matrix values.
+template <typename values_t, typename offsets_t, typename val_view_t>
+struct CooPatternAssembleFunctor {
+  values_t values;
+  offsets_t offsets;
+  val_view_t vals;
+  typename offsets_t::non_const_value_type invalid;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t k) const {
+    if (offsets(k) != invalid) {
+      Kokkos::atomic_add(&values(offsets(k)), vals(k));
+    }
+  }
+};
+
+}  // namespace Impl
+}  // namespace KokkosSparse
+
+#endif  // _KOKKOSSPARSE_COOASSEMBLER_IMPL_HPP
@@ -0,0 +1,238 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSSPARSE_CRSBINARY_IMPL_HPP
+#define _KOKKOSSPARSE_CRSBINARY_IMPL_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "Kokkos_Core.hpp"
+#include "Kokkos_ArithTraits.hpp"
+
+/// \file KokkosSparse_CrsBinary_impl.hpp
+/// \brief Layout of the self-describing binary CRS format (.kkb).
+///
+/// Layout of a file (integers in the byte order of the writing host, which
+/// is recorded in the header):
+///   CrsBinaryHeader (128 bytes)
+///   row map  (num_rows + 1 offsets of offset_size bytes)
+///   entries  (nnz ordinals of ordinal_size bytes)
+///   values   (nnz scalars of scalar_size bytes)
+/// with every section starting at a multiple of 64 bytes, so that the
+/// sections of a memory-mapped file can be used in place.
+///
+/// Optionally, the sections are compressed by a user-provided codec (they
+/// then have to be decompressed by copy(), and cannot be used in place), and
+/// a checksum of the stored bytes is recorded.
+
+namespace KokkosSparse {
+namespace Impl {
+
+// bump when the layout of the file changes
+constexpr uint32_t CRS_BINARY_VERSION    = 1;
+constexpr size_t CRS_BINARY_ALIGNMENT    = 64;
+constexpr uint32_t CRS_BINARY_BYTE_ORDER = 0x01020304;
+
+constexpr char CRS_BINARY_MAGIC[8] = {'K', 'K', 'C', 'R', 'S', 'B', 'I', 'N'};
+
+enum class CrsBinaryScalarKind : uint32_t {
+  REAL    = 0,
+  COMPLEX = 1,
+  INTEGER = 2
+};
+
+enum CrsBinaryFlags : uint32_t {
+  // the entries of every row are sorted, without duplicates
+  CRS_BINARY_SORTED = 1,
+  // the matrix is structurally and numerically symmetric (as declared by the
+  // writer, this is not checked)
+  CRS_BINARY_SYMMETRIC = 2,
+  // the checksum field holds crs_binary_checksum of the stored sections
+  CRS_BINARY_CHECKSUM = 4,
+  // the sections were compressed by the codec whose id is in the header
+  CRS_BINARY_COMPRESSED = 8
+};
+
+struct CrsBinaryHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint64_t num_rows;
+  uint64_t num_cols;
+  uint64_t nnz;
+  uint32_t ordinal_size;
+  uint32_t offset_size;
+  uint32_t scalar_size;
+  uint32_t scalar_kind;
+  uint32_t flags;
+  uint32_t codec;
+  uint64_t rowmap_offset;
+  uint64_t entries_offset;
+  uint64_t values_offset;
+  // stored sizes of the sections (smaller than the raw sizes if compressed)
+  uint64_t rowmap_bytes;
+  uint64_t entries_bytes;
+  uint64_t values_bytes;
+  uint64_t checksum;
+  uint64_t reserved;
+};
+static_assert(sizeof(CrsBinaryHeader) == 128,
+              "CrsBinaryHeader must stay 128 bytes");
+
+inline size_t crs_binary_align(size_t offset) {
+  return (offset + CRS_BINARY_ALIGNMENT - 1) / CRS_BINARY_ALIGNMENT *
+         CRS_BINARY_ALIGNMENT;
+}
+
+KOKKOS_INLINE_FUNCTION
+uint64_t crs_binary_mix(uint64_t x) {
+  // splitmix64 finalizer
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+/// \brief Order-dependent checksum of bytes, computed with one parallel
+/// reduction on the host: every (position, 8-byte word) pair is mixed
+/// independently and the results are summed (mod 2^64).
+inline uint64_t crs_binary_checksum(const char *data, size_t bytes) {
+  const size_t num_words = (bytes + 7) / 8;
+  uint64_t sum           = 0;
+  Kokkos::parallel_reduce(
+      "KokkosSparse::CrsBinary::checksum",
+      Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0, num_words),
+      [=](const size_t w, uint64_t &lsum) {
+        uint64_t word = 0;
+        std::memcpy(&word, data + 8 * w, std::min<size_t>(8, bytes - 8 * w));
+        lsum += crs_binary_mix(uint64_t(w) ^ crs_binary_mix(word));
+      },
+      sum);
+  return crs_binary_mix(sum ^ bytes);
+}
+
+/// \brief Compression hook for the sections of a .kkb file.
+///
+/// The codec is identified in the file by id(), which must be nonzero; the
+/// same codec has to be given to CrsBinaryFile to read the file back.
+struct CrsBinaryCodec {
+  virtual ~CrsBinaryCodec() = default;
+  virtual uint32_t id() const = 0;
+  /// Compresses bytes of src into dst (resized to the compressed size)
+  virtual void compress(const char *src, size_t bytes,
+                        std::vector<char> &dst) const = 0;
+  /// Decompresses bytes of src into exactly dst_bytes of dst
+  virtual void decompress(const char *src, size_t bytes, char *dst,
+                          size_t dst_bytes) const = 0;
+};
+
+template <typename scalar_t>
+constexpr CrsBinaryScalarKind crs_binary_scalar_kind() {
+  return Kokkos::ArithTraits<scalar_t>::is_complex
+             ? CrsBinaryScalarKind::COMPLEX
+             : (Kokkos::ArithTraits<scalar_t>::is_integer
+                    ? CrsBinaryScalarKind::INTEGER
+                    : CrsBinaryScalarKind::REAL);
+}
+
+/// \brief Builds a scalar_t from the real and imaginary parts of a stored
+/// value (the imaginary part is zero unless scalar_t is complex).
+template <typename scalar_t,
+          bool is_complex = Kokkos::ArithTraits<scalar_t>::is_complex>
+struct CrsBinaryMakeScalar {
+  static scalar_t make(double re, double) { return static_cast<scalar_t>(re); }
+};
+
+template <typename scalar_t>
+struct CrsBinaryMakeScalar<scalar_t, true> {
+  static scalar_t make(double re, double im) {
+    using mag_t = typename Kokkos::ArithTraits<scalar_t>::mag_type;
+    return scalar_t(static_cast<mag_t>(re), static_cast<mag_t>(im));
+  }
+};
+
+/// \brief Converts n stored signed integers of elem_size bytes into dst.
+template <typename dst_t>
+void crs_binary_convert_integers(const char *src, uint32_t elem_size, size_t n,
+                                 dst_t *dst) {
+  using range_t = Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>;
+  if (elem_size == 4) {
+    Kokkos::parallel_for(
+        "KokkosSparse::CrsBinary::convert", range_t(0, n), [=](size_t i) {
+          int32_t v;
+          std::memcpy(&v, src + 4 * i, 4);
+          dst[i] = static_cast<dst_t>(v);
+        });
+  } else if (elem_size == 8) {
+    Kokkos::parallel_for(
+        "KokkosSparse::CrsBinary::convert", range_t(0, n), [=](size_t i) {
+          int64_t v;
+          std::memcpy(&v, src + 8 * i, 8);
+          dst[i] = static_cast<dst_t>(v);
+        });
+  } else {
+    throw std::runtime_error("CrsBinaryFile: unsupported integer size");
+  }
+  Kokkos::DefaultHostExecutionSpace().fence();
+}
+
+/// \brief Converts n stored scalars into dst.
+template <typename dst_t>
+void crs_binary_convert_scalars(const char *src, CrsBinaryScalarKind kind,
+                                uint32_t elem_size, size_t n, dst_t *dst) {
+  using range_t = Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>;
+  using make_t  = CrsBinaryMakeScalar<dst_t>;
+  if (kind == CrsBinaryScalarKind::INTEGER) {
+    crs_binary_convert_integers(src, elem_size, n, dst);
+    return;
+  }
+  if (kind == CrsBinaryScalarKind::COMPLEX &&
+      !Kokkos::ArithTraits<dst_t>::is_complex) {
+    throw std::runtime_error(
+        "CrsBinaryFile: cannot read complex values into a real type");
+  }
+  const uint32_t num_parts = kind == CrsBinaryScalarKind::COMPLEX ? 2 : 1;
+  const uint32_t part_size = elem_size / num_parts;
+  if (part_size != 4 && part_size != 8) {
+    throw std::runtime_error("CrsBinaryFile: unsupported scalar size");
+  }
+  Kokkos::parallel_for(
+      "KokkosSparse::CrsBinary::convert", range_t(0, n), [=](size_t i) {
+        double parts[2] = {0, 0};
+        for (uint32_t p = 0; p < num_parts; p++) {
+          const char *s = src + elem_size * i + part_size * p;
+          if (part_size == 4) {
+            float v;
+            std::memcpy(&v, s, 4);
+            parts[p] = v;
+          } else {
+            std::memcpy(&parts[p], s, 8);
+          }
+        }
+        dst[i] = make_t::make(parts[0], parts[1]);
+      });
+  Kokkos::DefaultHostExecutionSpace().fence();
+}
+
+}  // namespace Impl
+}  // namespace KokkosSparse
+
+#endif  // _KOKKOSSPARSE_CRSBINARY_IMPL_HPP
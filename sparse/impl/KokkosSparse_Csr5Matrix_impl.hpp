@@ -0,0 +1,147 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSSPARSE_CSR5MATRIX_IMPL_HPP
+#define _KOKKOSSPARSE_CSR5MATRIX_IMPL_HPP
+
+/// \file KokkosSparse_Csr5Matrix_impl.hpp
+/// \brief Tile descriptors of the Csr5Matrix format, and its SpMV kernel.
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosKernels_Iota.hpp"
+#include "KokkosSparse_merge_matrix.hpp"
+
+namespace KokkosSparse {
+namespace Impl {
+
+/// \brief (segRows(s), segNnz(s)) is the position of the merge path of the
+/// row ends and the entries at the diagonal s * segLength: the rows before
+/// segRows(s) and the entries before segNnz(s) are handled by the previous
+/// segments.
+template <typename rowmap_t, typename seg_t>
+struct Csr5SegmentsFunctor {
+  using size_type = typename rowmap_t::non_const_value_type;
+  using um_row_ends_t =
+      Kokkos::View<typename rowmap_t::data_type,
+                   typename rowmap_t::device_type::memory_space,
+                   Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+  using iota_t = KokkosKernels::Impl::Iota<size_type, size_type>;
+
+  rowmap_t rowmap;
+  seg_t segRows;
+  seg_t segNnz;
+  size_type segLength;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const int64_t s) const {
+    const size_type numRows    = rowmap.extent(0) - 1;
+    const size_type nnz        = rowmap(numRows);
+    const size_type pathLength = numRows + nnz;
+
+    const size_type d = KOKKOSKERNELS_MACRO_MIN(s * segLength, pathLength);
+    // remove leading 0 from row_map
+    um_row_ends_t rowEnds(&rowmap(1), numRows);
+    auto pos   = diagonal_search(rowEnds, iota_t(nnz), d);
+    segRows(s) = pos.ai;
+    segNnz(s)  = pos.bi;
+  }
+};
+
+/// \brief Copies the entries of segment s into its slots: the m-th entry of
+/// segment s is stored in slot (s / lanes) * lanes * segLength + m * lanes +
+/// s % lanes, so that consecutive segments read consecutive slots.
+template <typename seg_t, typename entries_t, typename values_t,
+          typename tile_entries_t, typename tile_values_t>
+struct Csr5FillFunctor {
+  using size_type = typename seg_t::non_const_value_type;
+
+  seg_t segNnz;
+  entries_t entries;
+  values_t values;
+  tile_entries_t tileEntries;
+  tile_values_t tileValues;
+  size_type lanes;
+  size_type segLength;
+  bool valuesOnly;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const int64_t s) const {
+    const size_type slotBase = (s / lanes) * lanes * segLength + s % lanes;
+    size_type slot           = slotBase;
+    for (size_type k = segNnz(s); k < segNnz(s + 1); k++, slot += lanes) {
+      if (!valuesOnly) tileEntries(slot) = entries(k);
+      tileValues(slot) = values(k);
+    }
+  }
+};
+
+/// \brief y += alpha * A * x, one segment per thread. The rows that start
+/// and end in the segment belong to it; the other ones are shared with the
+/// neighboring segments and updated with atomics.
+template <typename rowmap_t, typename seg_t, typename tile_entries_t,
+          typename tile_values_t, typename x_t, typename y_t,
+          typename scalar_t, bool conj>
+struct Csr5SpmvFunctor {
+  using size_type  = typename seg_t::non_const_value_type;
+  using y_scalar_t = typename y_t::non_const_value_type;
+  using KAT =
+      Kokkos::ArithTraits<typename tile_values_t::non_const_value_type>;
+
+  rowmap_t rowmap;
+  seg_t segRows;
+  seg_t segNnz;
+  tile_entries_t tileEntries;
+  tile_values_t tileValues;
+  x_t x;
+  y_t y;
+  scalar_t alpha;
+  size_type lanes;
+  size_type segLength;
+
+  KOKKOS_INLINE_FUNCTION y_scalar_t product(const size_type slot) const {
+    const auto val = conj ? KAT::conj(tileValues(slot)) : tileValues(slot);
+    return val * x(tileEntries(slot));
+  }
+
+  KOKKOS_INLINE_FUNCTION void operator()(const int64_t s) const {
+    const size_type rowBegin = segRows(s);
+    const size_type rowEnd   = segRows(s + 1);
+    const size_type nnzEnd   = segNnz(s + 1);
+    size_type k              = segNnz(s);
+    size_type slot           = (s / lanes) * lanes * segLength + s % lanes;
+    // rows that end in this segment
+    for (size_type row = rowBegin; row < rowEnd; row++) {
+      const bool shared = row == rowBegin && k > rowmap(row);
+      y_scalar_t acc    = Kokkos::ArithTraits<y_scalar_t>::zero();
+      for (; k < rowmap(row + 1); k++, slot += lanes) acc += product(slot);
+      if (shared) {
+        Kokkos::atomic_add(&y(row), alpha * acc);
+      } else {
+        y(row) += alpha * acc;
+      }
+    }
+    // the beginning of a row that continues in the next segment
+    if (k < nnzEnd) {
+      y_scalar_t acc = Kokkos::ArithTraits<y_scalar_t>::zero();
+      for (; k < nnzEnd; k++, slot += lanes) acc += product(slot);
+      Kokkos::atomic_add(&y(rowEnd), alpha * acc);
+    }
+  }
+};
+
+}  // namespace Impl
+}  // namespace KokkosSparse
+
+#endif  // _KOKKOSSPARSE_CSR5MATRIX_IMPL_HPP
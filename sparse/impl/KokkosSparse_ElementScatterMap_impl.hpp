@@ -0,0 +1,103 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSSPARSE_ELEMENTSCATTERMAP_IMPL_HPP
+#define _KOKKOSSPARSE_ELEMENTSCATTERMAP_IMPL_HPP
+
+/// \file KokkosSparse_ElementScatterMap_impl.hpp
+/// \brief Kernels computing and applying the map from the entries of the
+///        element matrices to the values of a CrsMatrix.
+
+#include <Kokkos_Core.hpp>
+#include "KokkosSparse_findRelOffset.hpp"
+
+namespace KokkosSparse {
+namespace Impl {
+
+/// \brief offsets(e, a * n + b) is the position in the matrix values of the
+/// entry (elem_nodes(e, a), elem_nodes(e, b)), or invalid if the pattern does
+/// not contain it (counted).
+template <typename rowmap_t, typename entries_t, typename elem_nodes_t,
+          typename offsets_t>
+struct ElementScatterOffsetsFunctor {
+  using offset_t   = typename offsets_t::non_const_value_type;
+  using lno_t      = typename entries_t::non_const_value_type;
+  using value_type = size_t;
+
+  rowmap_t rowmap;
+  entries_t entries;
+  elem_nodes_t elem_nodes;
+  offsets_t offsets;
+  offset_t invalid;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const lno_t e, size_t &num_missing) const {
+    const lno_t n = elem_nodes.extent(1);
+    for (lno_t a = 0; a < n; a++) {
+      const lno_t row     = elem_nodes(e, a);
+      const offset_t base = rowmap(row);
+      const lno_t length  = rowmap(row + 1) - base;
+      for (lno_t b = 0; b < n; b++) {
+        const lno_t offset = KokkosSparse::findRelOffset(
+            entries.data() + base, length, elem_nodes(e, b), lno_t(0), false);
+        if (offset == length) {
+          offsets(e, a * n + b) = invalid;
+          num_missing++;
+        } else {
+          offsets(e, a * n + b) = base + offset;
+        }
+      }
+    }
+  }
+};
+
+/// \brief Adds the element matrices elem_mats(e, a, b) of the elements
+/// elems(first), ..., elems(first + count - 1) into the matrix values. The
+/// additions are atomic, unless no two of these elements share a node.
+template <typename values_t, typename offsets_t, typename elems_t,
+          typename elem_mats_t, bool atomic>
+struct ElementScatterAssembleFunctor {
+  using lno_t    = typename elems_t::non_const_value_type;
+  using offset_t = typename offsets_t::non_const_value_type;
+
+  values_t values;
+  offsets_t offsets;
+  elems_t elems;
+  elem_mats_t elem_mats;
+  offset_t invalid;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const lno_t i) const {
+    const lno_t e = elems(i);
+    const lno_t n = elem_mats.extent(1);
+    for (lno_t a = 0; a < n; a++) {
+      for (lno_t b = 0; b < n; b++) {
+        const offset_t offset = offsets(e, a * n + b);
+        if (offset == invalid) continue;
+        if (atomic) {
+          Kokkos::atomic_add(&values(offset), elem_mats(e, a, b));
+        } else {
+          values(offset) += elem_mats(e, a, b);
+        }
+      }
+    }
+  }
+};
+
+}  // namespace Impl
+}  // namespace KokkosSparse
+
+#endif  // _KOKKOSSPARSE_ELEMENTSCATTERMAP_IMPL_HPP
@@ -0,0 +1,178 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSSPARSE_HYBMATRIX_IMPL_HPP
+#define _KOKKOSSPARSE_HYBMATRIX_IMPL_HPP
+
+/// \file KokkosSparse_HybMatrix_impl.hpp
+/// \brief Conversion of a CrsMatrix to the hybrid ELL + COO format, and the
+///        SpMV kernels of this format.
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosKernels_SimpleUtils.hpp"
+
+namespace KokkosSparse {
+namespace Impl {
+
+// A column of the ELL part is worth storing if at least 1 / HYB_ELL_FILL_MIN
+// of the rows have an entry in it: the ELL kernel is then still faster than
+// the COO kernel for these entries, despite the padding.
+constexpr int HYB_ELL_FILL_MIN = 3;
+
+/// \brief Chooses the width of the ELL part from the histogram of the row
+/// lengths of a CRS matrix.
+template <typename execution_space, typename rowmap_t>
+int64_t hyb_ell_width(const execution_space& exec, const rowmap_t& rowmap) {
+  using size_type = typename rowmap_t::non_const_value_type;
+  using range_t   = Kokkos::RangePolicy<execution_space>;
+  using hist_t =
+      Kokkos::View<size_type*, typename rowmap_t::device_type::memory_space>;
+  const int64_t numRows = rowmap.extent(0) ? rowmap.extent(0) - 1 : 0;
+  if (numRows == 0) return 0;
+  size_type maxLength = 0;
+  Kokkos::parallel_reduce(
+      "KokkosSparse::hyb_ell_width::max_length", range_t(exec, 0, numRows),
+      KOKKOS_LAMBDA(const int64_t i, size_type& lmax) {
+        if (lmax < rowmap(i + 1) - rowmap(i)) lmax = rowmap(i + 1) - rowmap(i);
+      },
+      Kokkos::Max<size_type>(maxLength));
+  hist_t hist("HybMatrix row lengths", maxLength + 1);
+  Kokkos::parallel_for(
+      "KokkosSparse::hyb_ell_width::histogram", range_t(exec, 0, numRows),
+      KOKKOS_LAMBDA(const int64_t i) {
+        Kokkos::atomic_inc(&hist(rowmap(i + 1) - rowmap(i)));
+      });
+  auto histHost =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), hist);
+  // rowsAtLeast is the number of rows with at least width + 1 entries
+  int64_t width       = 0;
+  int64_t rowsAtLeast = numRows - histHost(0);
+  while (width < int64_t(maxLength) &&
+         rowsAtLeast * HYB_ELL_FILL_MIN >= numRows) {
+    width++;
+    rowsAtLeast -= histHost(width);
+  }
+  return width;
+}
+
+/// \brief Counts the entries of every row that do not fit in the ELL part.
+template <typename rowmap_t, typename offsets_t>
+struct HybOverflowCountFunctor {
+  rowmap_t rowmap;
+  offsets_t cooOffsets;
+  int64_t width;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const int64_t i) const {
+    const int64_t length = rowmap(i + 1) - rowmap(i);
+    cooOffsets(i)        = length > width ? length - width : 0;
+  }
+};
+
+/// \brief Copies the first width entries of every row into the ELL part
+/// (padded with the column -1 and the value 0), and the other ones into the
+/// COO part.
+template <typename rowmap_t, typename entries_t, typename values_t,
+          typename ell_entries_t, typename ell_values_t, typename offsets_t,
+          typename coo_index_t, typename coo_values_t>
+struct HybFillFunctor {
+  using size_type = typename rowmap_t::non_const_value_type;
+  using lno_t     = typename ell_entries_t::non_const_value_type;
+  using scalar_t  = typename ell_values_t::non_const_value_type;
+
+  rowmap_t rowmap;
+  entries_t entries;
+  values_t values;
+  ell_entries_t ellEntries;
+  ell_values_t ellValues;
+  offsets_t cooOffsets;
+  coo_index_t cooRows;
+  coo_index_t cooCols;
+  coo_values_t cooValues;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const int64_t i) const {
+    const size_type rowStart = rowmap(i);
+    const int64_t length     = rowmap(i + 1) - rowStart;
+    const int64_t width      = ellEntries.extent(1);
+    for (int64_t k = 0; k < width; k++) {
+      if (k < length) {
+        ellEntries(i, k) = entries(rowStart + k);
+        ellValues(i, k)  = values(rowStart + k);
+      } else {
+        ellEntries(i, k) = lno_t(-1);
+        ellValues(i, k)  = Kokkos::ArithTraits<scalar_t>::zero();
+      }
+    }
+    for (int64_t k = width; k < length; k++) {
+      const size_type pos = cooOffsets(i) + k - width;
+      cooRows(pos)        = i;
+      cooCols(pos)        = entries(rowStart + k);
+      cooValues(pos)      = values(rowStart + k);
+    }
+  }
+};
+
+/// \brief y := beta * y + alpha * A_ell * x. One thread per row: as the ELL
+/// part is column-major, consecutive threads read consecutive entries, and
+/// every row does the same number of iterations.
+template <typename ell_entries_t, typename ell_values_t, typename x_t,
+          typename y_t, typename scalar_t>
+struct HybEllSpmvFunctor {
+  using lno_t      = typename ell_entries_t::non_const_value_type;
+  using y_scalar_t = typename y_t::non_const_value_type;
+
+  ell_entries_t ellEntries;
+  ell_values_t ellValues;
+  x_t x;
+  y_t y;
+  scalar_t alpha, beta;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const int64_t i) const {
+    const int64_t width = ellEntries.extent(1);
+    y_scalar_t sum      = Kokkos::ArithTraits<y_scalar_t>::zero();
+    for (int64_t k = 0; k < width; k++) {
+      const lno_t col = ellEntries(i, k);
+      if (col != lno_t(-1)) sum += ellValues(i, k) * x(col);
+    }
+    // beta == 0 overwrites y, even if it holds NaN
+    if (beta == Kokkos::ArithTraits<scalar_t>::zero()) {
+      y(i) = alpha * sum;
+    } else {
+      y(i) = beta * y(i) + alpha * sum;
+    }
+  }
+};
+
+/// \brief y += alpha * A_coo * x, with atomics.
+template <typename coo_index_t, typename coo_values_t, typename x_t,
+          typename y_t, typename scalar_t>
+struct HybCooSpmvFunctor {
+  coo_index_t cooRows;
+  coo_index_t cooCols;
+  coo_values_t cooValues;
+  x_t x;
+  y_t y;
+  scalar_t alpha;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const int64_t k) const {
+    Kokkos::atomic_add(&y(cooRows(k)), alpha * cooValues(k) * x(cooCols(k)));
+  }
+};
+
+}  // namespace Impl
+}  // namespace KokkosSparse
+
+#endif  // _KOKKOSSPARSE_HYBMATRIX_IMPL_HPP
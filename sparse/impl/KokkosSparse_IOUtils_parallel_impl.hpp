@@ -0,0 +1,261 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSSPARSE_IOUTILS_PARALLEL_IMPL_HPP
+#define _KOKKOSSPARSE_IOUTILS_PARALLEL_IMPL_HPP
+
+/// \file KokkosSparse_IOUtils_parallel_impl.hpp
+/// \brief Chunked, multithreaded parsing of the entries of a MatrixMarket
+///        file held in memory (typically memory-mapped).
+///
+/// The data section is cut into chunks starting at line boundaries. A first
+/// pass counts the entry lines of every chunk, so that after a prefix sum
+/// each chunk knows the index of its first entry. The second pass parses the
+/// chunks independently, writing entry k at position k (general) or 2k and
+/// 2k+1 (symmetric, skew-symmetric and Hermitian: the mirrored entry, or a
+/// negative row index that the assembly skips). The COO arrays are then
+/// assembled into CRS by counting the entries of every row, a prefix sum and
+/// a scatter, with size_type offsets throughout.
+
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+#include <Kokkos_Core.hpp>
+#include "KokkosSparse_IOUtils.hpp"
+
+namespace KokkosSparse {
+namespace Impl {
+
+enum MtxParseError : int {
+  MTX_PARSE_OK = 0,
+  MTX_PARSE_BAD_ENTRY,
+  MTX_PARSE_OUT_OF_RANGE,
+  MTX_PARSE_TOO_MANY_ENTRIES
+};
+
+inline bool mtx_is_space(const char c) {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+/// \brief Returns the first position at or after pos that starts a line.
+inline size_t mtx_line_start(const char *data, size_t size, size_t pos) {
+  if (pos >= size) return size;
+  if (pos == 0 || data[pos - 1] == '\n') return pos;
+  const void *nl = std::memchr(data + pos, '\n', size - pos);
+  return nl ? static_cast<const char *>(nl) - data + 1 : size;
+}
+
+/// \brief Parses an unsigned decimal integer, advancing p.
+inline bool mtx_parse_index(const char *&p, const char *end, int64_t &value) {
+  while (p < end && mtx_is_space(*p)) p++;
+  if (p == end || *p < '0' || *p > '9') return false;
+  int64_t v = 0;
+  while (p < end && *p >= '0' && *p <= '9') v = 10 * v + (*p++ - '0');
+  value = v;
+  return true;
+}
+
+/// \brief Parses a real number, advancing p. The token is copied to a small
+/// buffer first since the mapped file is not null-terminated.
+inline bool mtx_parse_real(const char *&p, const char *end, double &value) {
+  while (p < end && mtx_is_space(*p)) p++;
+  char buf[64];
+  size_t len = 0;
+  while (p + len < end && !mtx_is_space(p[len]) && p[len] != '\n') {
+    if (len + 1 == sizeof(buf)) return false;
+    buf[len] = p[len];
+    len++;
+  }
+  if (len == 0) return false;
+  buf[len]   = '\0';
+  char *stop = nullptr;
+  value      = std::strtod(buf, &stop);
+  if (stop != buf + len) return false;
+  p += len;
+  return true;
+}
+
+template <typename scalar_t>
+struct MtxScalarParser {
+  static bool parse(const char *&p, const char *end, MM::MtxField field,
+                    scalar_t &value) {
+    if (field == MM::PATTERN) {
+      value = scalar_t(1);
+      return true;
+    }
+    double v;
+    if (!mtx_parse_real(p, end, v)) return false;
+    value = static_cast<scalar_t>(v);
+    return true;
+  }
+};
+
+template <typename real_t>
+struct MtxScalarParser<Kokkos::complex<real_t>> {
+  static bool parse(const char *&p, const char *end, MM::MtxField field,
+                    Kokkos::complex<real_t> &value) {
+    if (field == MM::PATTERN) {
+      value = Kokkos::complex<real_t>(1);
+      return true;
+    }
+    double re, im = 0;
+    if (!mtx_parse_real(p, end, re)) return false;
+    if (field == MM::COMPLEX && !mtx_parse_real(p, end, im)) return false;
+    value = Kokkos::complex<real_t>(re, im);
+    return true;
+  }
+};
+
+/// \brief Calls f(line_begin, line_end) for every entry line of
+/// [begin, end): blank lines and comments are skipped.
+template <typename F>
+inline void mtx_for_each_entry_line(const char *begin, const char *end, F &&f) {
+  const char *p = begin;
+  while (p < end) {
+    const void *nl    = std::memchr(p, '\n', end - p);
+    const char *eol   = nl ? static_cast<const char *>(nl) : end;
+    const char *first = p;
+    while (first < eol && mtx_is_space(*first)) first++;
+    if (first < eol && *first != '%') {
+      if (!f(first, eol)) return;
+    }
+    p = eol + 1;
+  }
+}
+
+/// \brief Counts the entry lines of every chunk.
+struct MtxCountFunctor {
+  const char *data;
+  Kokkos::View<size_t *, Kokkos::HostSpace> chunk_begin;
+  Kokkos::View<size_t *, Kokkos::HostSpace> chunk_count;
+
+  void operator()(const size_t c) const {
+    size_t count = 0;
+    mtx_for_each_entry_line(data + chunk_begin(c), data + chunk_begin(c + 1),
+                            [&](const char *, const char *) {
+                              count++;
+                              return true;
+                            });
+    chunk_count(c) = count;
+  }
+};
+
+/// \brief Parses the entries of every chunk into the COO arrays.
+template <typename lno_t, typename scalar_t>
+struct MtxParseFunctor {
+  using host_lno_view_t    = Kokkos::View<lno_t *, Kokkos::HostSpace>;
+  using host_scalar_view_t = Kokkos::View<scalar_t *, Kokkos::HostSpace>;
+
+  const char *data;
+  Kokkos::View<size_t *, Kokkos::HostSpace> chunk_begin;
+  Kokkos::View<size_t *, Kokkos::HostSpace> chunk_offset;
+  Kokkos::View<int *, Kokkos::HostSpace> chunk_error;
+  host_lno_view_t rows, cols;
+  host_scalar_view_t vals;
+  MM::MtxFormat format;
+  MM::MtxField field;
+  MM::MtxSym sym;
+  int64_t nrows, ncols;
+  size_t nnz;
+
+  void operator()(const size_t c) const {
+    const size_t stride = sym == MM::GENERAL ? 1 : 2;
+    size_t k            = chunk_offset(c);
+    int error           = MTX_PARSE_OK;
+    mtx_for_each_entry_line(
+        data + chunk_begin(c), data + chunk_begin(c + 1),
+        [&](const char *p, const char *eol) {
+          if (k >= nnz) {
+            error = MTX_PARSE_TOO_MANY_ENTRIES;
+            return false;
+          }
+          int64_t i, j;
+          if (format == MM::ARRAY) {
+            // column major
+            i = int64_t(k % nrows) + 1;
+            j = int64_t(k / nrows) + 1;
+          } else if (!mtx_parse_index(p, eol, i) ||
+                     !mtx_parse_index(p, eol, j)) {
+            error = MTX_PARSE_BAD_ENTRY;
+            return false;
+          }
+          if (i < 1 || i > nrows || j < 1 || j > ncols) {
+            error = MTX_PARSE_OUT_OF_RANGE;
+            return false;
+          }
+          scalar_t v;
+          if (!MtxScalarParser<scalar_t>::parse(p, eol, field, v)) {
+            error = MTX_PARSE_BAD_ENTRY;
+            return false;
+          }
+          const size_t pos = stride * k;
+          rows(pos)        = lno_t(i - 1);
+          cols(pos)        = lno_t(j - 1);
+          vals(pos)        = v;
+          if (stride == 2) {
+            // the diagonal is not mirrored
+            rows(pos + 1) = i == j ? lno_t(-1) : lno_t(j - 1);
+            cols(pos + 1) = lno_t(i - 1);
+            vals(pos + 1) = MM::symmetryFlip<scalar_t>(v, sym);
+          }
+          k++;
+          return true;
+        });
+    chunk_error(c) = error;
+  }
+};
+
+/// \brief Counts the entries of every row i into rowmap(i). The entries with
+/// a negative row (the diagonal of symmetric files, not mirrored) are skipped.
+template <typename lno_view_t, typename rowmap_t>
+struct MtxRowCountFunctor {
+  lno_view_t rows;
+  rowmap_t rowmap;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const int64_t k) const {
+    const auto i = rows(k);
+    if (i >= 0) Kokkos::atomic_increment(&rowmap(i));
+  }
+};
+
+/// \brief Moves every COO entry to the next free slot of its row; cursor
+/// starts as a copy of the row map.
+template <typename lno_view_t, typename scalar_view_t, typename rowmap_t,
+          typename entries_t, typename values_t>
+struct MtxScatterFunctor {
+  using size_type = typename rowmap_t::non_const_value_type;
+
+  lno_view_t rows;
+  lno_view_t cols;
+  scalar_view_t vals;
+  rowmap_t cursor;
+  entries_t entries;
+  values_t values;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const int64_t k) const {
+    const auto i = rows(k);
+    if (i < 0) return;
+    const size_type pos = Kokkos::atomic_fetch_add(&cursor(i), size_type(1));
+    entries(pos)        = cols(k);
+    values(pos)         = vals(k);
+  }
+};
+
+}  // namespace Impl
+}  // namespace KokkosSparse
+
+#endif  // _KOKKOSSPARSE_IOUTILS_PARALLEL_IMPL_HPP
@@ -0,0 +1,191 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSSPARSE_IOUTILS_WRITE_IMPL_HPP
+#define _KOKKOSSPARSE_IOUTILS_WRITE_IMPL_HPP
+
+/// \file KokkosSparse_IOUtils_write_impl.hpp
+/// \brief Multithreaded writers for the MatrixMarket and binary formats.
+///
+/// The entries are formatted by the host threads into per-chunk buffers, a
+/// bounded number of chunks at a time. The offset of every chunk in the file
+/// follows from a prefix sum of the buffer lengths, and the chunks are then
+/// written concurrently at their offsets (pwrite).
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosKernels_PositionedFile.hpp"
+
+namespace KokkosSparse {
+namespace Impl {
+
+// entries formatted by one chunk, and slice of a binary section written by
+// one call to pwrite
+constexpr size_t WRITE_CHUNK_ENTRIES = 1 << 16;
+constexpr size_t WRITE_SLICE_BYTES   = 1 << 23;
+
+/// \brief Formats a value as MM::writeScalar does with the stream settings
+/// of write_matrix_mtx (scientific, 17 digits).
+template <typename scalar_t,
+          bool is_complex = Kokkos::ArithTraits<scalar_t>::is_complex,
+          bool is_integer = Kokkos::ArithTraits<scalar_t>::is_integer>
+struct MtxValueFormatter {
+  // longest output, without the terminating null character
+  static constexpr int max_length = 25;
+  static int format(char *buf, size_t size, const scalar_t &v) {
+    return std::snprintf(buf, size, "%.17e", static_cast<double>(v));
+  }
+};
+
+template <typename scalar_t>
+struct MtxValueFormatter<scalar_t, true, false> {
+  static constexpr int max_length = 51;
+  static int format(char *buf, size_t size, const scalar_t &v) {
+    return std::snprintf(buf, size, "%.17e %.17e",
+                         static_cast<double>(v.real()),
+                         static_cast<double>(v.imag()));
+  }
+};
+
+template <typename scalar_t>
+struct MtxValueFormatter<scalar_t, false, true> {
+  static constexpr int max_length = 20;
+  static int format(char *buf, size_t size, const scalar_t &v) {
+    return std::snprintf(buf, size, "%lld", static_cast<long long>(v));
+  }
+};
+
+/// \brief Writes bytes at offset, in slices written concurrently.
+inline void write_bytes_parallel(KokkosKernels::Impl::PositionedFile &file,
+                                 size_t offset, const void *data,
+                                 size_t bytes) {
+  const char *src         = static_cast<const char *>(data);
+  const size_t num_slices = (bytes + WRITE_SLICE_BYTES - 1) / WRITE_SLICE_BYTES;
+  Kokkos::parallel_for(
+      "KokkosSparse::write_bytes_parallel",
+      Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0, num_slices),
+      [&](const size_t s) {
+        const size_t begin = s * WRITE_SLICE_BYTES;
+        const size_t end   = std::min(bytes, begin + WRITE_SLICE_BYTES);
+        file.write_at(offset + begin, src + begin, end - begin);
+      });
+  Kokkos::DefaultHostExecutionSpace().fence();
+}
+
+/// \brief Formats the "i j value" lines of the rows of every chunk.
+template <typename lno_t, typename size_type, typename scalar_t>
+struct MtxFormatFunctor {
+  const size_type *xadj;
+  const lno_t *adj;
+  const scalar_t *vals;
+  const lno_t *chunk_row_begin;
+  std::string *buffers;
+
+  void operator()(const size_t c) const {
+    using formatter_t = MtxValueFormatter<scalar_t>;
+    std::string &out  = buffers[c];
+    out.clear();
+    char line[64 + formatter_t::max_length];
+    for (lno_t i = chunk_row_begin[c]; i < chunk_row_begin[c + 1]; i++) {
+      for (size_type j = xadj[i]; j < xadj[i + 1]; j++) {
+        int len = std::snprintf(line, sizeof(line), "%lld %lld ",
+                                static_cast<long long>(i) + 1,
+                                static_cast<long long>(adj[j]) + 1);
+        len += formatter_t::format(line + len, sizeof(line) - len, vals[j]);
+        line[len++] = '\n';
+        out.append(line, len);
+      }
+    }
+  }
+};
+
+/// \brief Writes the entries of a host CRS matrix as MatrixMarket coordinate
+/// lines, starting at offset. Returns the offset of the end of the data.
+template <typename lno_t, typename size_type, typename scalar_t>
+size_t write_mtx_entries_parallel(KokkosKernels::Impl::PositionedFile &file,
+                                  size_t offset, lno_t nrows,
+                                  const size_type *xadj, const lno_t *adj,
+                                  const scalar_t *vals) {
+  using host_exec = Kokkos::DefaultHostExecutionSpace;
+  if (nrows <= 0) return offset;
+  const size_t nnz = xadj[nrows] - xadj[0];
+
+  // the rows are split so that the chunks have about the same number of
+  // entries
+  const size_t num_chunks = std::max<size_t>(
+      1, (nnz + WRITE_CHUNK_ENTRIES - 1) / WRITE_CHUNK_ENTRIES);
+  std::vector<lno_t> chunk_row_begin(num_chunks + 1);
+  for (size_t c = 0; c < num_chunks; c++) {
+    const size_type target = xadj[0] + c * nnz / num_chunks;
+    chunk_row_begin[c] =
+        std::lower_bound(xadj, xadj + nrows + 1, target) - xadj;
+  }
+  chunk_row_begin[0]          = 0;
+  chunk_row_begin[num_chunks] = nrows;
+
+  // bound the memory used by the buffers
+  const size_t chunks_per_round =
+      std::max<size_t>(1, 2 * host_exec().concurrency());
+  std::vector<std::string> buffers(std::min(num_chunks, chunks_per_round));
+  std::vector<size_t> buffer_offsets(buffers.size());
+  for (size_t first = 0; first < num_chunks; first += chunks_per_round) {
+    const size_t count = std::min(chunks_per_round, num_chunks - first);
+    Kokkos::parallel_for(
+        "KokkosSparse::write_mtx_parallel::format",
+        Kokkos::RangePolicy<host_exec>(0, count),
+        MtxFormatFunctor<lno_t, size_type, scalar_t>{
+            xadj, adj, vals, chunk_row_begin.data() + first, buffers.data()});
+    host_exec().fence();
+    for (size_t c = 0; c < count; c++) {
+      buffer_offsets[c] = offset;
+      offset += buffers[c].size();
+    }
+    Kokkos::parallel_for(
+        "KokkosSparse::write_mtx_parallel::write",
+        Kokkos::RangePolicy<host_exec>(0, count), [&](const size_t c) {
+          file.write_at(buffer_offsets[c], buffers[c].data(),
+                        buffers[c].size());
+        });
+    host_exec().fence();
+  }
+  return offset;
+}
+
+/// \brief Upper bound on the size of the lines written by
+/// write_mtx_entries_parallel, used to preallocate the file.
+template <typename lno_t, typename scalar_t>
+size_t mtx_entries_max_bytes(lno_t nrows, lno_t ncols, size_t nnz) {
+  auto digits = [](long long v) {
+    int d = 1;
+    while (v >= 10) {
+      v /= 10;
+      d++;
+    }
+    return d;
+  };
+  return nnz * (digits(nrows) + digits(ncols) + 3 +
+                MtxValueFormatter<scalar_t>::max_length);
+}
+
+}  // namespace Impl
+}  // namespace KokkosSparse
+
+#endif  // _KOKKOSSPARSE_IOUTILS_WRITE_IMPL_HPP
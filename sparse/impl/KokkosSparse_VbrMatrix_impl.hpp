@@ -0,0 +1,354 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSSPARSE_VBRMATRIX_IMPL_HPP
+#define _KOKKOSSPARSE_VBRMATRIX_IMPL_HPP
+
+/// \file KokkosSparse_VbrMatrix_impl.hpp
+/// \brief Conversion of a CrsMatrix to the variable block row format, and the
+///        SpMV kernels of this format.
+
+#include <type_traits>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+
+namespace KokkosSparse {
+namespace Impl {
+
+// Row and column block sizes from 1 to VBR_MAX_STATIC_BLOCK get SpMV kernels
+// with compile-time sizes; larger blocks use a generic kernel.
+constexpr int VBR_MAX_STATIC_BLOCK = 6;
+
+/// \brief Counts the block rows (or columns) I with part(I + 1) <= part(I).
+template <typename part_t>
+struct VbrCheckPartitionFunctor {
+  using lno_t = typename part_t::non_const_value_type;
+
+  part_t part;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const lno_t I, lno_t& count) const {
+    if (part(I + 1) <= part(I)) count++;
+  }
+};
+
+/// \brief Flags the rows of a CrsMatrix (with sorted rows) that start a new
+/// supervariable: row 0, and the rows whose pattern differs from the one of
+/// the previous row.
+template <typename rowmap_t, typename entries_t, typename flags_t>
+struct VbrSupervariableFunctor {
+  using size_type = typename rowmap_t::non_const_value_type;
+  using lno_t     = typename entries_t::non_const_value_type;
+
+  rowmap_t rowmap;
+  entries_t entries;
+  flags_t starts;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+    if (i == 0) {
+      starts(i) = 1;
+      return;
+    }
+    const size_type prev   = rowmap(i - 1);
+    const size_type begin  = rowmap(i);
+    const size_type length = rowmap(i + 1) - begin;
+    bool differs           = length != begin - prev;
+    for (size_type k = 0; k < length && !differs; k++) {
+      differs = entries(prev + k) != entries(begin + k);
+    }
+    starts(i) = differs;
+  }
+};
+
+/// \brief Lists the indices i with flags(i) != 0 (counts them if list is
+/// empty), and appends end.
+template <typename flags_t, typename list_t>
+struct VbrCompactFunctor {
+  using lno_t = typename list_t::non_const_value_type;
+
+  flags_t flags;
+  list_t list;
+  lno_t end;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const lno_t i, lno_t& offset,
+                                         const bool final) const {
+    if (i == lno_t(flags.extent(0))) {
+      if (final && list.extent(0)) list(offset) = end;
+      return;
+    }
+    if (!flags(i)) return;
+    if (final && list.extent(0)) list(offset) = i;
+    offset++;
+  }
+};
+
+/// \brief Splits the supervariables [svars(s), svars(s + 1)) in blocks of at
+/// most maxBlock rows: without fill, counts the blocks of s in offsets(s);
+/// with fill, writes the block starts in part from offsets(s) on.
+template <typename part_t, bool fill>
+struct VbrSplitFunctor {
+  using lno_t = typename part_t::non_const_value_type;
+
+  part_t svars;
+  part_t offsets;
+  part_t part;
+  lno_t maxBlock;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const lno_t s) const {
+    const lno_t begin = svars(s);
+    const lno_t end   = svars(s + 1);
+    if constexpr (fill) {
+      lno_t pos = offsets(s);
+      for (lno_t i = begin; i < end; i += maxBlock) part(pos++) = i;
+    } else {
+      offsets(s) = (end - begin + maxBlock - 1) / maxBlock;
+    }
+  }
+};
+
+/// \brief colToBlock(j) is the column block of the column j.
+template <typename part_t, typename map_t>
+struct VbrColumnMapFunctor {
+  using lno_t = typename part_t::non_const_value_type;
+
+  part_t colPart;
+  map_t colToBlock;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const lno_t J) const {
+    for (lno_t j = colPart(J); j < colPart(J + 1); j++) colToBlock(j) = J;
+  }
+};
+
+/// \brief Merges the sorted rows of every block row column block by column
+/// block. Counts the blocks in blockRowMap(I) (mode 0); writes their column
+/// blocks and their number of values from blockRowMap(I) on (mode 1); adds
+/// the values into the (zero-initialized, row-major) blocks (mode 2).
+template <typename rowmap_t, typename entries_t, typename values_t,
+          typename part_t, typename block_rowmap_t, typename block_entries_t,
+          typename block_values_t, int mode>
+struct VbrFillFunctor {
+  using size_type = typename rowmap_t::non_const_value_type;
+  using lno_t     = typename entries_t::non_const_value_type;
+
+  rowmap_t rowmap;
+  entries_t entries;
+  values_t values;
+  part_t rowPart;
+  part_t colPart;
+  part_t colToBlock;
+  block_rowmap_t blockRowMap;
+  block_entries_t blockEntries;
+  block_rowmap_t blockOffsets;
+  block_values_t blockValues;
+
+  // first entry of [begin, end) whose column is >= col
+  KOKKOS_INLINE_FUNCTION size_type lower_bound(size_type begin, size_type end,
+                                               const lno_t col) const {
+    while (begin < end) {
+      const size_type mid = begin + (end - begin) / 2;
+      if (entries(mid) < col) {
+        begin = mid + 1;
+      } else {
+        end = mid;
+      }
+    }
+    return begin;
+  }
+
+  KOKKOS_INLINE_FUNCTION void operator()(const lno_t I) const {
+    const lno_t rowBegin = rowPart(I);
+    const lno_t rowEnd   = rowPart(I + 1);
+    const lno_t none     = Kokkos::ArithTraits<lno_t>::max();
+    size_type pos        = mode ? size_type(blockRowMap(I)) : size_type(0);
+    // the column blocks before the one of nextCol are done
+    lno_t nextCol = 0;
+    while (true) {
+      lno_t J = none;
+      for (lno_t i = rowBegin; i < rowEnd; i++) {
+        const size_type k = lower_bound(rowmap(i), rowmap(i + 1), nextCol);
+        if (k < rowmap(i + 1) && colToBlock(entries(k)) < J) {
+          J = colToBlock(entries(k));
+        }
+      }
+      if (J == none) break;
+      const lno_t colBegin = colPart(J);
+      const lno_t colEnd   = colPart(J + 1);
+      if constexpr (mode == 1) {
+        blockEntries(pos) = J;
+        blockOffsets(pos) = size_type(rowEnd - rowBegin) * (colEnd - colBegin);
+      }
+      if constexpr (mode == 2) {
+        const size_type offset = blockOffsets(pos);
+        for (lno_t i = rowBegin; i < rowEnd; i++) {
+          for (size_type k = lower_bound(rowmap(i), rowmap(i + 1), colBegin);
+               k < rowmap(i + 1) && entries(k) < colEnd; k++) {
+            blockValues(offset + size_type(i - rowBegin) * (colEnd - colBegin) +
+                        entries(k) - colBegin) += values(k);
+          }
+        }
+      }
+      pos++;
+      nextCol = colEnd;
+    }
+    if constexpr (mode == 0) blockRowMap(I) = pos;
+  }
+};
+
+/// \brief Lists the block rows whose number of rows is R (R = 0: more than
+/// VBR_MAX_STATIC_BLOCK rows); counts them if rows is empty.
+template <typename part_t, typename rows_t>
+struct VbrSelectRowsFunctor {
+  using lno_t = typename rows_t::non_const_value_type;
+
+  part_t rowPart;
+  rows_t rows;
+  lno_t R;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const lno_t I, lno_t& offset,
+                                         const bool final) const {
+    lno_t size = rowPart(I + 1) - rowPart(I);
+    if (size > VBR_MAX_STATIC_BLOCK) size = 0;
+    if (size != R) return;
+    if (final && rows.extent(0)) rows(offset) = I;
+    offset++;
+  }
+};
+
+/// \brief acc += A_block * x(colBegin:colBegin + C), for a R x C row-major
+/// block.
+template <int R, int C, typename scalar_t, typename x_t, typename acc_t>
+KOKKOS_INLINE_FUNCTION void vbr_block_gemv(const scalar_t* block, const x_t& x,
+                                           const int64_t colBegin,
+                                           acc_t* acc) {
+  for (int r = 0; r < R; r++) {
+    for (int c = 0; c < C; c++) acc[r] += block[r * C + c] * x(colBegin + c);
+  }
+}
+
+/// \brief y := beta * y + alpha * A * x on the block rows rows(k), which
+/// all have R rows (R = 0: any number of rows). Every block row owns its
+/// rows of y, so no atomics are needed.
+template <typename part_t, typename block_rowmap_t, typename block_entries_t,
+          typename block_values_t, typename rows_t, typename x_t, typename y_t,
+          typename scalar_t, int R>
+struct VbrSpmvFunctor {
+  using size_type  = typename block_rowmap_t::non_const_value_type;
+  using lno_t      = typename part_t::non_const_value_type;
+  using y_scalar_t = typename y_t::non_const_value_type;
+  using a_scalar_t = typename block_values_t::value_type;
+
+  part_t rowPart;
+  part_t colPart;
+  block_rowmap_t blockRowMap;
+  block_entries_t blockEntries;
+  block_rowmap_t blockOffsets;
+  block_values_t blockValues;
+  rows_t rows;
+  x_t x;
+  y_t y;
+  scalar_t alpha, beta;
+
+  KOKKOS_INLINE_FUNCTION void update(const lno_t row,
+                                     const y_scalar_t& sum) const {
+    // beta == 0 overwrites y, even if it holds NaN
+    if (beta == Kokkos::ArithTraits<scalar_t>::zero()) {
+      y(row) = alpha * sum;
+    } else {
+      y(row) = beta * y(row) + alpha * sum;
+    }
+  }
+
+  template <int C>
+  KOKKOS_INLINE_FUNCTION void block_gemv(const size_type b,
+                                         y_scalar_t* acc) const {
+    const lno_t colBegin    = colPart(blockEntries(b));
+    const a_scalar_t* block = &blockValues(blockOffsets(b));
+    if constexpr (C > 0) {
+      vbr_block_gemv<R, C>(block, x, colBegin, acc);
+    } else {
+      const lno_t cols = colPart(blockEntries(b) + 1) - colBegin;
+      for (int r = 0; r < R; r++) {
+        for (lno_t c = 0; c < cols; c++) {
+          acc[r] += block[r * cols + c] * x(colBegin + c);
+        }
+      }
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION void operator()(const lno_t k) const {
+    const lno_t I        = rows(k);
+    const lno_t rowBegin = rowPart(I);
+    if constexpr (R > 0) {
+      y_scalar_t acc[R];
+      for (int r = 0; r < R; r++) {
+        acc[r] = Kokkos::ArithTraits<y_scalar_t>::zero();
+      }
+      for (size_type b = blockRowMap(I); b < blockRowMap(I + 1); b++) {
+        switch (colPart(blockEntries(b) + 1) - colPart(blockEntries(b))) {
+          case 1: block_gemv<1>(b, acc); break;
+          case 2: block_gemv<2>(b, acc); break;
+          case 3: block_gemv<3>(b, acc); break;
+          case 4: block_gemv<4>(b, acc); break;
+          case 5: block_gemv<5>(b, acc); break;
+          case 6: block_gemv<6>(b, acc); break;
+          default: block_gemv<0>(b, acc); break;
+        }
+      }
+      for (int r = 0; r < R; r++) update(rowBegin + r, acc[r]);
+    } else {
+      // one row of the block row at a time
+      const lno_t numRows = rowPart(I + 1) - rowBegin;
+      for (lno_t r = 0; r < numRows; r++) {
+        y_scalar_t sum = Kokkos::ArithTraits<y_scalar_t>::zero();
+        for (size_type b = blockRowMap(I); b < blockRowMap(I + 1); b++) {
+          const lno_t colBegin = colPart(blockEntries(b));
+          const lno_t cols     = colPart(blockEntries(b) + 1) - colBegin;
+          const a_scalar_t* block =
+              &blockValues(blockOffsets(b) + size_type(r) * cols);
+          for (lno_t c = 0; c < cols; c++) sum += block[c] * x(colBegin + c);
+        }
+        update(rowBegin + r, sum);
+      }
+    }
+  }
+};
+
+/// \brief Runs VbrSpmvFunctor<..., R> on the block rows of A with R rows
+/// (R = 0: more than VBR_MAX_STATIC_BLOCK rows).
+template <int R, typename ExecutionSpace, typename AMatrix, typename XVector,
+          typename YVector, typename scalar_t>
+void vbr_spmv_size_class(const ExecutionSpace& space, const AMatrix& A,
+                         const XVector& x, const YVector& y,
+                         const scalar_t alpha, const scalar_t beta) {
+  const auto rows = A.block_rows_of_size(R);
+  using rows_t    = std::decay_t<decltype(rows)>;
+  if (rows.extent(0) == 0) return;
+  Kokkos::parallel_for(
+      "KokkosSparse::spmv<Vbr>",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, rows.extent(0)),
+      VbrSpmvFunctor<typename AMatrix::partition_type,
+                     typename AMatrix::block_map_type,
+                     typename AMatrix::index_type,
+                     typename AMatrix::values_type, rows_t, XVector, YVector,
+                     scalar_t, R>{
+          A.row_part, A.col_part, A.block_row_map, A.block_entries,
+          A.block_offsets, A.values, rows, x, y, alpha, beta});
+}
+
+}  // namespace Impl
+}  // namespace KokkosSparse
+
+#endif  // _KOKKOSSPARSE_VBRMATRIX_IMPL_HPP
@@ -16,66 +16,22 @@
 #ifndef KOKKOSSPARSE_CRS_DETECT_BLOCK_SIZE_HPP
 #define KOKKOSSPARSE_CRS_DETECT_BLOCK_SIZE_HPP
 
-#include <map>
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 #include <Kokkos_Core.hpp>
 #include "KokkosSparse_CrsMatrix.hpp"
 #include "KokkosSparse_Utils.hpp"
+#include "KokkosSparse_crs_to_bsr_parallel_impl.hpp"
 
 /*! \file KokkosSparse_crs_detect_block_size.hpp
 
-    \brief A utility function for detecting the block size in a CrsMatrix. Not
-   for performance-sensitive use.
+    \brief A utility function for detecting the block size in a CrsMatrix.
 */
 
 namespace KokkosSparse::Impl {
 
-/**
- * \class BlockPopulations
- * \brief A class to store population counts of blocks in a CrsMatrix
- */
-class BlockPopulations {
- public:
-  /**
-   * \brief Constructor for BlockPopulations
-   * \param sz The block size
-   */
-  BlockPopulations(size_t sz) : sz_(sz) {}
-
-  /**
-   * \brief Add a point to the corresponding block
-   * \param r The row index of the point
-   * \param c The column index of the point
-   */
-  void add(size_t r, size_t c) {
-    auto key = std::make_pair(r / sz_, c / sz_);
-    auto it  = blocks_.find(key);
-    if (it == blocks_.end()) {
-      blocks_.insert(std::make_pair(key, 1));
-    } else {
-      ++(it->second);
-    }
-  }
-
-  /**
-   * \brief Check if all blocks are dense
-   * \return True if all blocks have a count equal to the block size squared
-   */
-  bool all_dense() const {
-    for (const auto &kv : blocks_) {
-      if (kv.second < sz_ * sz_) {
-        return false;
-      }
-    }
-    return true;
-  }
-
- private:
-  std::map<std::pair<size_t, size_t>, size_t>
-      blocks_; /**< A map of block coordinates to their population counts */
-  size_t sz_;  /**< The block size */
-};
-
 /**
  * @brief Detects the largest block size that yields only dense blocks in a
  CrsMatrix
@@ -93,16 +49,18 @@ class BlockPopulations {
  blocks of 2N contain blocks of N, at least one of which is already known not to
  be dense. In practice, this ends up testing only small composite factors and
  all prime factors up to the upper bound.
+ The blocks are counted on the device (see crs_count_blocks): all blocks are
+ dense if and only if there are nnz / (size * size) of them.
 */
 template <typename Crs>
 size_t detect_block_size(const Crs &crs) {
-  using ordinal_type = typename Crs::ordinal_type;
+  using ordinal_type = typename Crs::non_const_ordinal_type;
+  using bsr_rowmap_t = Kokkos::View<typename Crs::non_const_size_type *,
+                                    typename Crs::device_type>;
 
-  // copy matrix data to host
+  // copy row map to host
   auto rs = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
                                                 crs.graph.row_map);
-  auto cs = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
-                                                crs.graph.entries);
 
   // upper bound is minimum of sqrt(nnz), numRows, numCols,
   // and smallest non-empty row
@@ -118,6 +76,8 @@ size_t detect_block_size(const Crs &crs) {
 
   // trial blocks sizes that didn't work out
   std::vector<size_t> rejectedSizes;
+  // crs with sorted rows, computed on first use
+  Crs sorted;
 
   size_t largestBlockSize = 1;  // always a valid block size
   for (size_t trialSize = 2; trialSize <= upperBound; ++trialSize) {
@@ -134,17 +94,14 @@ size_t detect_block_size(const Crs &crs) {
       continue;
     }
 
-    // count the population of all blocks
-    BlockPopulations pops(trialSize);
-    for (ordinal_type row = 0; row < crs.numRows(); ++row) {
-      for (size_t ci = rs(row); ci < rs(row + 1); ++ci) {
-        ordinal_type col = cs(ci);
-        pops.add(row, col);
-      }
-    }
+    // count the blocks
+    if (!sorted.nnz()) sorted = crs_with_sorted_rows(crs);
+    bsr_rowmap_t bsrRowMap("bsrRowMap", crs.numRows() / trialSize + 1);
+    const size_t numBlocks =
+        crs_count_blocks(sorted, ordinal_type(trialSize), bsrRowMap);
 
     // if all blocks are dense, this is the largest one so far
-    if (pops.all_dense()) {
+    if (numBlocks * trialSize * trialSize == size_t(crs.nnz())) {
       largestBlockSize = trialSize;
     } else {
       rejectedSizes.push_back(trialSize);
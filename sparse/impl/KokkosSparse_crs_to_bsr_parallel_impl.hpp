@@ -0,0 +1,152 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSSPARSE_CRS_TO_BSR_PARALLEL_IMPL_HPP
+#define _KOKKOSSPARSE_CRS_TO_BSR_PARALLEL_IMPL_HPP
+
+/// \file KokkosSparse_crs_to_bsr_parallel_impl.hpp
+/// \brief Device-parallel kernels counting and filling the blocks of a
+///        CrsMatrix for a given block size.
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosKernels_SimpleUtils.hpp"
+#include "KokkosSparse_SortCrs.hpp"
+#include "KokkosSparse_Utils.hpp"
+
+namespace KokkosSparse {
+namespace Impl {
+
+/// \brief For every block row ib (rows ib * blockSize, ..., (ib + 1) *
+/// blockSize - 1, sorted), merges the rows block column by block column.
+/// Without fill, writes the number of blocks of the block row in
+/// bsrRowmap(ib). With fill, writes the block columns and adds the values
+/// into the (zero-initialized, row-major) blocks, starting at bsrRowmap(ib).
+template <typename rowmap_t, typename entries_t, typename values_t,
+          typename bsr_rowmap_t, typename bsr_entries_t, typename bsr_values_t,
+          bool fill>
+struct CrsToBsrFunctor {
+  using size_type = typename rowmap_t::non_const_value_type;
+  using lno_t     = typename entries_t::non_const_value_type;
+
+  rowmap_t rowmap;
+  entries_t entries;
+  values_t values;
+  bsr_rowmap_t bsrRowmap;
+  bsr_entries_t bsrEntries;
+  bsr_values_t bsrValues;
+  lno_t blockSize;
+
+  // first entry of [begin, end) whose column is >= col
+  KOKKOS_INLINE_FUNCTION size_type lower_bound(size_type begin, size_type end,
+                                               const lno_t col) const {
+    while (begin < end) {
+      const size_type mid = begin + (end - begin) / 2;
+      if (entries(mid) < col) {
+        begin = mid + 1;
+      } else {
+        end = mid;
+      }
+    }
+    return begin;
+  }
+
+  KOKKOS_INLINE_FUNCTION void operator()(const lno_t ib) const {
+    const lno_t rowBegin = ib * blockSize;
+    const lno_t none     = Kokkos::ArithTraits<lno_t>::max();
+    size_type pos        = fill ? size_type(bsrRowmap(ib)) : size_type(0);
+    // the block columns before nextCol / blockSize are done
+    lno_t nextCol = 0;
+    while (true) {
+      lno_t blockCol = none;
+      for (lno_t r = 0; r < blockSize; r++) {
+        const size_type end = rowmap(rowBegin + r + 1);
+        const size_type k   = lower_bound(rowmap(rowBegin + r), end, nextCol);
+        if (k < end && entries(k) / blockSize < blockCol) {
+          blockCol = entries(k) / blockSize;
+        }
+      }
+      if (blockCol == none) break;
+      if constexpr (fill) {
+        const lno_t colBegin = blockCol * blockSize;
+        bsrEntries(pos)      = blockCol;
+        for (lno_t r = 0; r < blockSize; r++) {
+          const size_type end = rowmap(rowBegin + r + 1);
+          for (size_type k = lower_bound(rowmap(rowBegin + r), end, colBegin);
+               k < end && entries(k) < colBegin + blockSize; k++) {
+            bsrValues((pos * blockSize + r) * blockSize + entries(k) -
+                      colBegin) += values(k);
+          }
+        }
+      }
+      pos++;
+      nextCol = (blockCol + 1) * blockSize;
+    }
+    if constexpr (!fill) bsrRowmap(ib) = pos;
+  }
+};
+
+/// \brief Returns A if its rows are sorted, otherwise a copy of A with sorted
+/// rows (the row map is shared).
+template <typename Crs>
+Crs crs_with_sorted_rows(const Crs& A) {
+  if (isCrsGraphSorted(A.graph.row_map, A.graph.entries)) return A;
+  using execution_space = typename Crs::execution_space;
+  typename Crs::index_type::non_const_type entries(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "sorted entries"),
+      A.graph.entries.extent(0));
+  typename Crs::values_type::non_const_type values(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "sorted values"),
+      A.values.extent(0));
+  execution_space exec;
+  Kokkos::deep_copy(exec, entries, A.graph.entries);
+  Kokkos::deep_copy(exec, values, A.values);
+  KokkosSparse::sort_crs_matrix(exec, A.graph.row_map, entries, values);
+  exec.fence();
+  return Crs("sorted", A.numRows(), A.numCols(), A.nnz(), values,
+             A.graph.row_map, entries);
+}
+
+/// \brief Computes the BSR row map of A (with sorted rows) for the block
+/// size blockSize, which must divide the dimensions of A. Returns the number
+/// of blocks.
+template <typename Crs, typename bsr_rowmap_t>
+size_t crs_count_blocks(const Crs& A,
+                        typename Crs::non_const_ordinal_type blockSize,
+                        const bsr_rowmap_t& bsrRowmap) {
+  using execution_space = typename Crs::execution_space;
+  using lno_t           = typename Crs::non_const_ordinal_type;
+
+  const lno_t numBlockRows = A.numRows() / blockSize;
+  execution_space exec;
+  Kokkos::parallel_for(
+      "KokkosSparse::crs_count_blocks",
+      Kokkos::RangePolicy<execution_space>(exec, 0, numBlockRows),
+      CrsToBsrFunctor<typename Crs::row_map_type, typename Crs::index_type,
+                      typename Crs::values_type, bsr_rowmap_t,
+                      bsr_rowmap_t, typename Crs::values_type, false>{
+          A.graph.row_map, A.graph.entries, A.values, bsrRowmap,
+          bsr_rowmap_t(), typename Crs::values_type(), blockSize});
+  typename bsr_rowmap_t::non_const_value_type numBlocks = 0;
+  KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<execution_space>(
+      exec, numBlockRows + 1, bsrRowmap, numBlocks);
+  return numBlocks;
+}
+
+}  // namespace Impl
+}  // namespace KokkosSparse
+
+#endif  // _KOKKOSSPARSE_CRS_TO_BSR_PARALLEL_IMPL_HPP
@@ -0,0 +1,184 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSSPARSE_FSAI_IMPL_HPP
+#define _KOKKOSSPARSE_FSAI_IMPL_HPP
+
+/// \file KokkosSparse_fsai_impl.hpp
+/// \brief Construction of the factored sparse approximate inverse G of a
+///        symmetric positive definite matrix A, such that G^T G ~ A^{-1}.
+///
+/// The pattern of row i of G is the lower triangle of row i of A, with the
+/// diagonal stored last. Its values are computed independently for each row
+/// from the dense system A(P_i, P_i) g = e_i, where P_i is the pattern of the
+/// row: G(i, P_i) = g / sqrt(g_i). These small systems are factored with
+/// KokkosBatched's team LU, one team (and one scratch buffer) per row.
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_LU_Decl.hpp"
+#include "KokkosBatched_SolveLU_Decl.hpp"
+
+namespace KokkosSparse {
+namespace Impl {
+
+/// \brief Counts the entries in the lower triangle of each row of A,
+/// counting the diagonal whether A stores it or not.
+template <typename a_rowmap_t, typename a_entries_t, typename g_rowmap_t>
+struct FSAICountFunctor {
+  using lno_t = typename a_entries_t::non_const_value_type;
+
+  a_rowmap_t A_rowmap;
+  a_entries_t A_entries;
+  g_rowmap_t G_rowmap;
+
+  FSAICountFunctor(const a_rowmap_t &A_rowmap_, const a_entries_t &A_entries_,
+                   const g_rowmap_t &G_rowmap_)
+      : A_rowmap(A_rowmap_), A_entries(A_entries_), G_rowmap(G_rowmap_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const lno_t i) const {
+    typename g_rowmap_t::non_const_value_type count = 1;
+    for (auto k = A_rowmap(i); k < A_rowmap(i + 1); k++) {
+      if (A_entries(k) < i) count++;
+    }
+    G_rowmap(i) = count;
+  }
+};
+
+/// \brief Fills the pattern of G: the strictly lower entries of each row of
+/// A, in the order of A, followed by the diagonal.
+template <typename a_rowmap_t, typename a_entries_t, typename g_rowmap_t,
+          typename g_entries_t>
+struct FSAIFillFunctor {
+  using lno_t = typename a_entries_t::non_const_value_type;
+
+  a_rowmap_t A_rowmap;
+  a_entries_t A_entries;
+  g_rowmap_t G_rowmap;
+  g_entries_t G_entries;
+
+  FSAIFillFunctor(const a_rowmap_t &A_rowmap_, const a_entries_t &A_entries_,
+                  const g_rowmap_t &G_rowmap_, const g_entries_t &G_entries_)
+      : A_rowmap(A_rowmap_),
+        A_entries(A_entries_),
+        G_rowmap(G_rowmap_),
+        G_entries(G_entries_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const lno_t i) const {
+    auto pos = G_rowmap(i);
+    for (auto k = A_rowmap(i); k < A_rowmap(i + 1); k++) {
+      if (A_entries(k) < i) G_entries(pos++) = A_entries(k);
+    }
+    G_entries(pos) = i;
+  }
+};
+
+/// \brief Computes the values of G, one row per team.
+template <typename execution_space, typename a_rowmap_t, typename a_entries_t,
+          typename a_values_t, typename g_rowmap_t, typename g_entries_t,
+          typename g_values_t>
+struct FSAINumericFunctor {
+  using lno_t        = typename a_entries_t::non_const_value_type;
+  using scalar_t     = typename a_values_t::non_const_value_type;
+  using ATS          = Kokkos::ArithTraits<scalar_t>;
+  using team_policy  = Kokkos::TeamPolicy<execution_space>;
+  using member_type  = typename team_policy::member_type;
+  using scratch_space = typename execution_space::scratch_memory_space;
+  using scratch_matrix_t =
+      Kokkos::View<scalar_t **, Kokkos::LayoutRight, scratch_space,
+                   Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+
+  a_rowmap_t A_rowmap;
+  a_entries_t A_entries;
+  a_values_t A_values;
+  g_rowmap_t G_rowmap;
+  g_entries_t G_entries;
+  g_values_t G_values;
+  lno_t max_row_length;
+  int scratch_level;
+
+  FSAINumericFunctor(const a_rowmap_t &A_rowmap_, const a_entries_t &A_entries_,
+                     const a_values_t &A_values_, const g_rowmap_t &G_rowmap_,
+                     const g_entries_t &G_entries_, const g_values_t &G_values_,
+                     lno_t max_row_length_, int scratch_level_)
+      : A_rowmap(A_rowmap_),
+        A_entries(A_entries_),
+        A_values(A_values_),
+        G_rowmap(G_rowmap_),
+        G_entries(G_entries_),
+        G_values(G_values_),
+        max_row_length(max_row_length_),
+        scratch_level(scratch_level_) {}
+
+  static size_t team_scratch_size(lno_t max_row_length) {
+    return scratch_matrix_t::shmem_size(max_row_length, max_row_length) +
+           scratch_matrix_t::shmem_size(max_row_length, 1);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const member_type &team) const {
+    const lno_t i     = team.league_rank();
+    const auto gbegin = G_rowmap(i);
+    const lno_t m     = G_rowmap(i + 1) - gbegin;
+
+    scratch_matrix_t Aloc(team.team_scratch(scratch_level), max_row_length,
+                          max_row_length);
+    scratch_matrix_t rhs(team.team_scratch(scratch_level), max_row_length, 1);
+    auto Ai = Kokkos::subview(Aloc, Kokkos::make_pair(lno_t(0), m),
+                              Kokkos::make_pair(lno_t(0), m));
+    auto gi = Kokkos::subview(rhs, Kokkos::make_pair(lno_t(0), m), Kokkos::ALL);
+
+    // gather A(P_i, P_i), with P_i the pattern of row i of G
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(team, m), [&](const lno_t p) {
+      const lno_t row = G_entries(gbegin + p);
+      for (lno_t q = 0; q < m; q++) Ai(p, q) = ATS::zero();
+      for (auto k = A_rowmap(row); k < A_rowmap(row + 1); k++) {
+        const lno_t col = A_entries(k);
+        for (lno_t q = 0; q < m; q++) {
+          if (G_entries(gbegin + q) == col) {
+            Ai(p, q) += A_values(k);
+            break;
+          }
+        }
+      }
+      gi(p, 0) = (p == m - 1) ? ATS::one() : ATS::zero();
+    });
+    team.team_barrier();
+
+    KokkosBatched::TeamLU<member_type, KokkosBatched::Algo::LU::Unblocked>::
+        invoke(team, Ai);
+    team.team_barrier();
+    KokkosBatched::TeamSolveLU<
+        member_type, KokkosBatched::Trans::NoTranspose,
+        KokkosBatched::Algo::SolveLU::Unblocked>::invoke(team, Ai, gi);
+    team.team_barrier();
+
+    // g_i is positive when A is SPD
+    const scalar_t scale = ATS::one() / ATS::sqrt(gi(m - 1, 0));
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(team, m), [&](const lno_t p) {
+      G_values(gbegin + p) = gi(p, 0) * scale;
+    });
+  }
+};
+
+}  // namespace Impl
+}  // namespace KokkosSparse
+
+#endif  // _KOKKOSSPARSE_FSAI_IMPL_HPP
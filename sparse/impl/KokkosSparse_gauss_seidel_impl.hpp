@@ -22,6 +22,7 @@
 #include <Kokkos_Core.hpp>
 #include <Kokkos_Bitset.hpp>
 #include "KokkosGraph_Distance1Color.hpp"
+#include "KokkosGraph_BalanceColor.hpp"
 #include "KokkosKernels_Uniform_Initialized_MemoryPool.hpp"
 #include "KokkosKernels_BitUtils.hpp"
 #include "KokkosKernels_SimpleUtils.hpp"
@@ -847,7 +848,19 @@ class PointGaussSeidel {
       HandleType coloringHandle;
       coloringHandle.create_graph_coloring_handle(
           gsHandle->get_coloring_algorithm());
-      auto gchandle = coloringHandle.get_graph_coloring_handle();
+      auto gchandle      = coloringHandle.get_graph_coloring_handle();
+      const bool balance = gsHandle->get_balance_colors();
+      row_lno_temp_work_view_t tmp_xadj;
+      nnz_lno_temp_work_view_t tmp_adj;
+      // The balancing pass needs the symmetrized graph, even with EB
+      if (!is_symmetric &&
+          (balance ||
+           gchandle->get_coloring_algo_type() != KokkosGraph::COLORING_EB)) {
+        KokkosKernels::Impl::symmetrize_graph_symbolic_hashmap<
+            const_lno_row_view_t, const_lno_nnz_view_t,
+            row_lno_temp_work_view_t, nnz_lno_temp_work_view_t, MyExecSpace>(
+            num_rows, xadj, adj, tmp_xadj, tmp_adj);
+      }
       if (!is_symmetric) {
         if (gchandle->get_coloring_algo_type() == KokkosGraph::COLORING_EB) {
           gchandle->symmetrize_and_calculate_lower_diagonal_edge_list(
@@ -856,20 +869,22 @@ class PointGaussSeidel {
               HandleType, const_lno_row_view_t, const_lno_nnz_view_t>(
               &coloringHandle, num_rows, num_rows, xadj, adj);
         } else {
-          row_lno_temp_work_view_t tmp_xadj;
-          nnz_lno_temp_work_view_t tmp_adj;
-          KokkosKernels::Impl::symmetrize_graph_symbolic_hashmap<
-              const_lno_row_view_t, const_lno_nnz_view_t,
-              row_lno_temp_work_view_t, nnz_lno_temp_work_view_t, MyExecSpace>(
-              num_rows, xadj, adj, tmp_xadj, tmp_adj);
           KokkosGraph::Experimental::graph_color_symbolic<
               HandleType, row_lno_temp_work_view_t, nnz_lno_temp_work_view_t>(
               &coloringHandle, num_rows, num_rows, tmp_xadj, tmp_adj);
         }
+        if (balance) {
+          KokkosGraph::Experimental::graph_color_balance(
+              &coloringHandle, num_rows, tmp_xadj, tmp_adj);
+        }
       } else {
         KokkosGraph::Experimental::graph_color_symbolic<
             HandleType, const_lno_row_view_t, const_lno_nnz_view_t>(
             &coloringHandle, num_rows, num_rows, xadj, adj);
+        if (balance) {
+          KokkosGraph::Experimental::graph_color_balance(&coloringHandle,
+                                                         num_rows, xadj, adj);
+        }
       }
       colors    = gchandle->get_vertex_colors();
       numColors = gchandle->get_num_colors();
@@ -147,7 +147,15 @@ struct GmresWrap {
       converged = true;
     }
 
-    while (!converged && cycle <= maxRestart && shortRelRes >= 1e-14) {
+    // The monitor records the shortcut residuals, and stops on stagnation
+    using Status =
+        typename KokkosSparse::Experimental::ConvergenceMonitor<MT>::Status;
+    auto monitor     = thandle.get_convergence_monitor();
+    bool monitorStop = false;
+    if (monitor) monitor->start(relRes);
+
+    while (!converged && !monitorStop && cycle <= maxRestart &&
+           shortRelRes >= 1e-14) {
       GVec_h(0) = trueRes;
 
       // Run Arnoldi iteration:
@@ -241,8 +249,14 @@ struct GmresWrap {
               "gmres: Relative residual is nan. Terminating solver.");
         }
 
+        const int iter = j + 1 + cycle * m;
+        if (monitor && monitor->check_now(iter)) {
+          monitorStop =
+              monitor->update(iter, shortRelRes) == Status::Stagnated;
+        }
+
         // If short residual converged, or time to restart, check true residual
-        if (shortRelRes < tol || j == m - 1) {
+        if (shortRelRes < tol || j == m - 1 || monitorStop) {
           // Compute least squares soln with Givens rotation:
           auto GLsSolnSub_h = Kokkos::subview(
               GLsSoln_h, Kokkos::ALL,
@@ -292,6 +306,13 @@ struct GmresWrap {
             Kokkos::deep_copy(
                 X, Xiter);  // Final solution is the iteration solution.
             break;          // End Arnoldi iteration.
+          } else if (monitorStop) {
+            if (verbose) {
+              std::cout << "The residual stagnated, ending the GMRES "
+                           "iteration."
+                        << std::endl;
+            }
+            break;
           } else if (shortRelRes < 1e-30) {
             if (verbose) {
               std::cout
@@ -731,6 +731,410 @@ struct MDF_compute_list_length {
   }
 };
 
+// Parallel pivot selection: a remaining row is selected if its MDF key
+// (discarded fill, deficiency, degree, index) is the smallest among all the
+// remaining rows within distance two in the graph of A + A^T. The selected
+// rows thus form a distance-2 independent set: they have no common
+// neighbors, so their eliminations update disjoint parts of A and can be
+// done concurrently. The remaining row with the globally smallest key is
+// always selected, so every step makes progress.
+template <class crs_matrix_type>
+struct MDF_select_independent_pivots {
+  using col_ind_type = typename crs_matrix_type::StaticCrsGraphType::
+      entries_type::non_const_type;
+  using ordinal_type    = typename crs_matrix_type::ordinal_type;
+  using values_mag_type = typename MDF_types<crs_matrix_type>::values_mag_type;
+
+  crs_matrix_type A, At;
+  col_ind_type permutation;
+  values_mag_type discarded_fill;
+  col_ind_type deficiency;
+  col_ind_type factored;
+  col_ind_type selected;
+
+  MDF_select_independent_pivots(crs_matrix_type A_, crs_matrix_type At_,
+                                col_ind_type permutation_,
+                                values_mag_type discarded_fill_,
+                                col_ind_type deficiency_,
+                                col_ind_type factored_, col_ind_type selected_)
+      : A(A_),
+        At(At_),
+        permutation(permutation_),
+        discarded_fill(discarded_fill_),
+        deficiency(deficiency_),
+        factored(factored_),
+        selected(selected_){};
+
+  // true if the key of row u is smaller than the key of row v
+  KOKKOS_INLINE_FUNCTION
+  bool precedes(const ordinal_type u, const ordinal_type v) const {
+    if (discarded_fill(u) != discarded_fill(v))
+      return discarded_fill(u) < discarded_fill(v);
+    if (deficiency(u) != deficiency(v)) return deficiency(u) < deficiency(v);
+    const auto degree_u = A.graph.row_map(u + 1) - A.graph.row_map(u);
+    const auto degree_v = A.graph.row_map(v + 1) - A.graph.row_map(v);
+    if (degree_u != degree_v) return degree_u < degree_v;
+    return u < v;
+  }
+
+  // true if no remaining neighbor of row v, other than row, precedes row
+  KOKKOS_INLINE_FUNCTION
+  bool is_local_min(const crs_matrix_type& M, const ordinal_type v,
+                    const ordinal_type row) const {
+    const auto view = M.rowConst(v);
+    for (ordinal_type k = 0; k < view.length; ++k) {
+      const ordinal_type w = view.colidx(k);
+      if (w == row || factored(w) == 1) continue;
+      if (precedes(w, row)) return false;
+    }
+    return true;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const ordinal_type idx) const {
+    const ordinal_type row = permutation(idx);
+    selected(row)          = 0;
+    if (!is_local_min(A, row, row) || !is_local_min(At, row, row)) return;
+    // distance two, through the remaining neighbors only: eliminated rows
+    // are not updated anymore and do not couple their neighbors.
+    for (int pass = 0; pass < 2; ++pass) {
+      const auto view = (pass == 0) ? A.rowConst(row) : At.rowConst(row);
+      for (ordinal_type k = 0; k < view.length; ++k) {
+        const ordinal_type v = view.colidx(k);
+        if (v == row || factored(v) == 1) continue;
+        if (!is_local_min(A, v, row) || !is_local_min(At, v, row)) return;
+      }
+    }
+    selected(row) = 1;
+  }
+};  // MDF_select_independent_pivots
+
+// Moves the selected rows to the front of permutation(step:numRows), keeping
+// the relative order of both the selected and the remaining rows.
+template <class col_ind_type>
+struct MDF_partition_pivots {
+  using ordinal_type = typename col_ind_type::non_const_value_type;
+  using value_type   = ordinal_type;
+
+  col_ind_type permutation, new_permutation, selected;
+  ordinal_type factorization_step, num_pivots;
+
+  MDF_partition_pivots(col_ind_type permutation_, col_ind_type new_permutation_,
+                       col_ind_type selected_, ordinal_type factorization_step_,
+                       ordinal_type num_pivots_)
+      : permutation(permutation_),
+        new_permutation(new_permutation_),
+        selected(selected_),
+        factorization_step(factorization_step_),
+        num_pivots(num_pivots_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const ordinal_type idx, ordinal_type& num_selected,
+                  const bool is_final) const {
+    const ordinal_type row = permutation(idx);
+    if (selected(row) == 1) {
+      if (is_final) new_permutation(factorization_step + num_selected) = row;
+      ++num_selected;
+    } else if (is_final) {
+      new_permutation(factorization_step + num_pivots +
+                      (idx - factorization_step) - num_selected) = row;
+    }
+  }
+};
+
+template <class col_ind_type>
+struct MDF_update_permutation {
+  using ordinal_type = typename col_ind_type::non_const_value_type;
+
+  col_ind_type permutation, permutation_inv, new_permutation;
+
+  MDF_update_permutation(col_ind_type permutation_,
+                         col_ind_type permutation_inv_,
+                         col_ind_type new_permutation_)
+      : permutation(permutation_),
+        permutation_inv(permutation_inv_),
+        new_permutation(new_permutation_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const ordinal_type idx) const {
+    const ordinal_type row = new_permutation(idx);
+    permutation(idx)       = row;
+    permutation_inv(row)   = idx;
+  }
+};
+
+// Counts the entries of the rows of U and of the columns of L of each
+// pivot; stored shifted by one in row_mapU and row_mapL, ready for a scan.
+template <class crs_matrix_type>
+struct MDF_count_pivot_entries {
+  using row_map_type = typename crs_matrix_type::StaticCrsGraphType::
+      row_map_type::non_const_type;
+  using col_ind_type = typename crs_matrix_type::StaticCrsGraphType::
+      entries_type::non_const_type;
+  using ordinal_type = typename crs_matrix_type::ordinal_type;
+  using size_type    = typename crs_matrix_type::size_type;
+
+  crs_matrix_type A, At;
+  row_map_type row_mapL, row_mapU;
+  col_ind_type permutation, factored;
+  ordinal_type factorization_step;
+
+  MDF_count_pivot_entries(crs_matrix_type A_, crs_matrix_type At_,
+                          row_map_type row_mapL_, row_map_type row_mapU_,
+                          col_ind_type permutation_, col_ind_type factored_,
+                          ordinal_type factorization_step_)
+      : A(A_),
+        At(At_),
+        row_mapL(row_mapL_),
+        row_mapU(row_mapU_),
+        permutation(permutation_),
+        factored(factored_),
+        factorization_step(factorization_step_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const ordinal_type pivotIdx) const {
+    const ordinal_type row = permutation(factorization_step + pivotIdx);
+    const auto rowView     = A.rowConst(row);
+    const auto colView     = At.rowConst(row);
+    // the diagonal is stored in both factors
+    size_type nnzU = 0, nnzL = 1;
+    for (ordinal_type k = 0; k < rowView.length; ++k) {
+      if (factored(rowView.colidx(k)) != 1) ++nnzU;
+    }
+    for (ordinal_type k = 0; k < colView.length; ++k) {
+      const ordinal_type rowInd = colView.colidx(k);
+      if ((rowInd != row) && (factored(rowInd) != 1)) ++nnzL;
+    }
+    row_mapU(factorization_step + pivotIdx + 1) = nnzU;
+    row_mapL(factorization_step + pivotIdx + 1) = nnzL;
+  }
+};
+
+// Eliminates a set of distance-2 independent pivots, one team per pivot:
+// stores the row of U and the column of L of the pivot, then applies its
+// rank-1 update to the remaining rows of A (and At).
+template <class crs_matrix_type>
+struct MDF_eliminate_pivots {
+  using execution_space = typename crs_matrix_type::execution_space;
+  using team_policy_t   = Kokkos::TeamPolicy<execution_space>;
+  using team_member_t   = typename team_policy_t::member_type;
+
+  using row_map_type = typename crs_matrix_type::StaticCrsGraphType::
+      row_map_type::non_const_type;
+  using col_ind_type = typename crs_matrix_type::StaticCrsGraphType::
+      entries_type::non_const_type;
+  using values_type  = typename crs_matrix_type::values_type::non_const_type;
+  using ordinal_type = typename crs_matrix_type::ordinal_type;
+  using size_type    = typename crs_matrix_type::size_type;
+  using value_type   = typename crs_matrix_type::value_type;
+
+  crs_matrix_type A, At;
+
+  row_map_type row_mapL;
+  col_ind_type entriesL;
+  values_type valuesL;
+
+  row_map_type row_mapU;
+  col_ind_type entriesU;
+  values_type valuesU;
+
+  col_ind_type permutation, factored;
+  ordinal_type factorization_step;
+
+  MDF_eliminate_pivots(crs_matrix_type A_, crs_matrix_type At_,
+                       row_map_type row_mapL_, col_ind_type entriesL_,
+                       values_type valuesL_, row_map_type row_mapU_,
+                       col_ind_type entriesU_, values_type valuesU_,
+                       col_ind_type permutation_, col_ind_type factored_,
+                       ordinal_type factorization_step_)
+      : A(A_),
+        At(At_),
+        row_mapL(row_mapL_),
+        entriesL(entriesL_),
+        valuesL(valuesL_),
+        row_mapU(row_mapU_),
+        entriesU(entriesU_),
+        valuesU(valuesU_),
+        permutation(permutation_),
+        factored(factored_),
+        factorization_step(factorization_step_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const team_member_t team) const {
+    const ordinal_type step = factorization_step + team.league_rank();
+    const ordinal_type row  = permutation(step);
+    const auto rowView      = A.rowConst(row);
+    const auto colView      = At.rowConst(row);
+
+    value_type diag = Kokkos::ArithTraits<value_type>::zero();
+    Kokkos::parallel_reduce(
+        Kokkos::TeamThreadRange(team, rowView.length),
+        [&](const ordinal_type alpha, value_type& running_diag) {
+          if (rowView.colidx(alpha) == row) {
+            running_diag += rowView.value(alpha);
+          }
+        },
+        diag);
+
+    // Row of U, including the diagonal
+    const size_type U_begin = row_mapU(step);
+    Kokkos::parallel_scan(
+        Kokkos::TeamThreadRange(team, rowView.length),
+        [&](const ordinal_type alpha, size_type& running_nEntr,
+            const bool is_final) {
+          const auto colInd = rowView.colidx(alpha);
+          if (factored(colInd) != 1) {
+            if (is_final) {
+              entriesU(U_begin + running_nEntr) = colInd;
+              valuesU(U_begin + running_nEntr)  = rowView.value(alpha);
+            }
+            ++running_nEntr;
+          }
+        });
+
+    // Column of L, unit diagonal first
+    const size_type L_begin = row_mapL(step);
+    Kokkos::single(Kokkos::PerTeam(team), [&] {
+      entriesL(L_begin) = row;
+      valuesL(L_begin)  = Kokkos::ArithTraits<value_type>::one();
+    });
+    Kokkos::parallel_scan(
+        Kokkos::TeamThreadRange(team, colView.length),
+        [&](const ordinal_type alpha, size_type& running_nEntr,
+            const bool is_final) {
+          const auto rowInd = colView.colidx(alpha);
+          if ((rowInd != row) && (factored(rowInd) != 1)) {
+            if (is_final) {
+              const size_type pos = L_begin + 1 + running_nEntr;
+              entriesL(pos)       = rowInd;
+              valuesL(pos)        = colView.value(alpha) / diag;
+            }
+            ++running_nEntr;
+          }
+        });
+
+    // Rank-1 update of the remaining rows, without fill
+    Kokkos::parallel_for(
+        Kokkos::TeamThreadRange(team, colView.length),
+        [&](const ordinal_type alpha) {
+          const auto rowInd = colView.colidx(alpha);
+          if ((rowInd == row) || (factored(rowInd) == 1)) return;
+          auto fillRowView = A.row(rowInd);
+          for (ordinal_type beta = 0; beta < rowView.length; ++beta) {
+            const auto colInd = rowView.colidx(beta);
+            if ((colInd == row) || (factored(colInd) == 1)) continue;
+            const auto subVal =
+                colView.value(alpha) * rowView.value(beta) / diag;
+            Kokkos::parallel_for(
+                Kokkos::ThreadVectorRange(team, fillRowView.length),
+                [&](const ordinal_type gamma) {
+                  if (colInd == fillRowView.colidx(gamma)) {
+                    Kokkos::atomic_sub(&fillRowView.value(gamma), subVal);
+                  }
+                });
+            auto fillColView = At.row(colInd);
+            Kokkos::parallel_for(
+                Kokkos::ThreadVectorRange(team, fillColView.length),
+                [&](const ordinal_type delt) {
+                  if (rowInd == fillColView.colidx(delt)) {
+                    Kokkos::atomic_sub(&fillColView.value(delt), subVal);
+                  }
+                });
+          }
+        });
+  }
+};  // MDF_eliminate_pivots
+
+// Marks the pivots as factored and lists the remaining rows whose discarded
+// fill must be recomputed (the neighbors of the pivots), by their position
+// in the permutation, as expected by MDF_discarded_fill_norm.
+template <class crs_matrix_type>
+struct MDF_finalize_pivots {
+  using device_type  = typename crs_matrix_type::device_type;
+  using col_ind_type = typename crs_matrix_type::StaticCrsGraphType::
+      entries_type::non_const_type;
+  using ordinal_type    = typename crs_matrix_type::ordinal_type;
+  using values_mag_type = typename MDF_types<crs_matrix_type>::values_mag_type;
+  using value_mag_type  = typename values_mag_type::value_type;
+  using permutation_set_type =
+      Kokkos::UnorderedMap<ordinal_type, void, device_type>;
+  using count_type = Kokkos::View<ordinal_type, device_type>;
+
+  crs_matrix_type A, At;
+  col_ind_type permutation, permutation_inv;
+  permutation_set_type permutation_set;
+  values_mag_type discarded_fill;
+  col_ind_type factored;
+  col_ind_type in_update_list;
+  col_ind_type update_list;
+  count_type update_list_len;
+  ordinal_type factorization_step;
+
+  MDF_finalize_pivots(crs_matrix_type A_, crs_matrix_type At_,
+                      col_ind_type permutation_, col_ind_type permutation_inv_,
+                      permutation_set_type permutation_set_,
+                      values_mag_type discarded_fill_, col_ind_type factored_,
+                      col_ind_type in_update_list_, col_ind_type update_list_,
+                      count_type update_list_len_,
+                      ordinal_type factorization_step_)
+      : A(A_),
+        At(At_),
+        permutation(permutation_),
+        permutation_inv(permutation_inv_),
+        permutation_set(permutation_set_),
+        discarded_fill(discarded_fill_),
+        factored(factored_),
+        in_update_list(in_update_list_),
+        update_list(update_list_),
+        update_list_len(update_list_len_),
+        factorization_step(factorization_step_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void add_to_update_list(const ordinal_type row) const {
+    if (factored(row) == 1) return;
+    if (Kokkos::atomic_exchange(&in_update_list(row), ordinal_type(1)) == 0) {
+      const ordinal_type pos =
+          Kokkos::atomic_fetch_add(&update_list_len(), ordinal_type(1));
+      update_list(pos) = permutation_inv(row);
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const ordinal_type pivotIdx) const {
+    const ordinal_type row = permutation(factorization_step + pivotIdx);
+    factored(row)          = 1;
+    discarded_fill(row)    = Kokkos::ArithTraits<value_mag_type>::max();
+    const auto res         = permutation_set.insert(row);
+    (void)res;  // avoid unused error
+    const auto rowView = A.rowConst(row);
+    for (ordinal_type k = 0; k < rowView.length; ++k) {
+      if (rowView.colidx(k) != row) add_to_update_list(rowView.colidx(k));
+    }
+    const auto colView = At.rowConst(row);
+    for (ordinal_type k = 0; k < colView.length; ++k) {
+      if (colView.colidx(k) != row) add_to_update_list(colView.colidx(k));
+    }
+  }
+};  // MDF_finalize_pivots
+
+template <class col_ind_type>
+struct MDF_reset_update_list {
+  using ordinal_type = typename col_ind_type::non_const_value_type;
+
+  col_ind_type permutation, update_list, in_update_list;
+
+  MDF_reset_update_list(col_ind_type permutation_, col_ind_type update_list_,
+                        col_ind_type in_update_list_)
+      : permutation(permutation_),
+        update_list(update_list_),
+        in_update_list(in_update_list_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const ordinal_type idx) const {
+    in_update_list(permutation(update_list(idx))) = 0;
+  }
+};
+
 template <class col_ind_type>
 struct MDF_reindex_matrix {
   col_ind_type permutation_inv;
@@ -871,6 +871,22 @@ struct IlutWrap {
     size_type itr          = 0;
     scalar_t curr_residual = std::numeric_limits<scalar_t>::max();
     scalar_t prev_residual = std::numeric_limits<scalar_t>::max();
+    bool lu_current        = false;  // LU holds the product of L and U
+
+    auto monitor = thandle.get_convergence_monitor();
+    if (monitor) {
+      // L = U = 0 is the reference, its residual is ||A||
+      typename IlutHandle::float_t A_norm = 0;
+      Kokkos::parallel_reduce(
+          "par_ilut A norm", range_policy(0, A_values.extent(0)),
+          KOKKOS_LAMBDA(const size_type nnz,
+                        typename IlutHandle::float_t& sum) {
+            sum += karith::abs(A_values(nnz)) * karith::abs(A_values(nnz));
+          },
+          A_norm);
+      monitor->start(Kokkos::ArithTraits<typename IlutHandle::float_t>::sqrt(
+          A_norm));
+    }
 
     // Set the initial L/U values for the initial approximation
     initialize_LU(thandle, A_row_map, A_entries, A_values, L_row_map, L_entries,
@@ -882,7 +898,7 @@ struct IlutWrap {
     bool stop = nrows == 0;  // Don't iterate at all if nrows=0
     while (!stop && itr < max_iter) {
       // LU = L*U
-      if (prev_residual == std::numeric_limits<scalar_t>::max()) {
+      if (!lu_current) {
         multiply_matrices(kh, thandle, L_row_map, L_entries, L_values,
                           U_row_map, U_entries, U_values, LU_row_map,
                           LU_entries, LU_values);
@@ -940,33 +956,56 @@ struct IlutWrap {
                           async_update);
 
       // Compute residual and check stop conditions
-      {
+      if (monitor == nullptr || monitor->check_now(itr + 1)) {
         curr_residual = compute_residual_norm(
             kh, thandle, A_row_map, A_entries, A_values, L_row_map, L_entries,
             L_values, U_row_map, U_entries, U_values, R_row_map, R_entries,
             R_values, LU_row_map, LU_entries, LU_values);
+        lu_current = true;
 
         if (verbose) {
           std::cout << "Completed itr " << itr
                     << ", residual is: " << curr_residual << std::endl;
         }
 
-        const auto curr_delta = karith::abs(prev_residual - curr_residual);
-        if (curr_delta <= residual_norm_delta_stop) {
-          if (verbose) {
-            std::cout << "  Itr-to-itr residual change has dropped below "
-                         "residual_norm_delta_stop, stop"
-                      << std::endl;
+        if (monitor) {
+          using Status = typename KokkosSparse::Experimental::
+              ConvergenceMonitor<typename IlutHandle::float_t>::Status;
+          if (monitor->update(itr + 1, karith::abs(curr_residual)) !=
+              Status::Running) {
+            if (verbose) {
+              std::cout << "  Convergence monitor stopped the iteration"
+                        << std::endl;
+            }
+            stop = true;
           }
-          stop = true;
         } else {
-          prev_residual = curr_residual;
+          const auto curr_delta = karith::abs(prev_residual - curr_residual);
+          if (curr_delta <= residual_norm_delta_stop) {
+            if (verbose) {
+              std::cout << "  Itr-to-itr residual change has dropped below "
+                           "residual_norm_delta_stop, stop"
+                        << std::endl;
+            }
+            stop = true;
+          } else {
+            prev_residual = curr_residual;
+          }
         }
+      } else {
+        lu_current = false;
       }
 
       ++itr;
     }
 
+    // max_iter was hit between two checks of the monitor
+    if (!lu_current && itr > 0) {
+      curr_residual = compute_residual_norm(
+          kh, thandle, A_row_map, A_entries, A_values, L_row_map, L_entries,
+          L_values, U_row_map, U_entries, U_values, R_row_map, R_entries,
+          R_values, LU_row_map, LU_entries, LU_values);
+    }
     curr_residual = nrows == 0 ? scalar_t(0.) : curr_residual;
     if (verbose) {
       std::cout << "PAR_ILUT stopped in " << itr << " iterations with residual "
@@ -0,0 +1,95 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSSPARSE_RESIDUAL_NORM_IMPL_HPP
+#define _KOKKOSSPARSE_RESIDUAL_NORM_IMPL_HPP
+
+/// \file KokkosSparse_residual_norm_impl.hpp
+/// \brief Fused computation of ||Y - A X||_F, without storing Y - A X.
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+
+namespace KokkosSparse {
+namespace Impl {
+
+/// \brief Sums |Y(i, c) - (A X)(i, c)|^2 over all rows and columns. Each team
+/// handles rows_per_team rows, each row being reduced over the vector lanes.
+template <typename execution_space, typename rowmap_t, typename entries_t,
+          typename values_t, typename x_t, typename y_t>
+struct ResidualNormFunctor {
+  using lno_t       = typename entries_t::non_const_value_type;
+  using offset_t    = typename rowmap_t::non_const_value_type;
+  using scalar_t    = typename values_t::non_const_value_type;
+  using ATS         = Kokkos::ArithTraits<scalar_t>;
+  using mag_t       = typename ATS::mag_type;
+  using team_policy = Kokkos::TeamPolicy<execution_space>;
+  using member_type = typename team_policy::member_type;
+  using value_type  = mag_t;
+
+  rowmap_t rowmap;
+  entries_t entries;
+  values_t values;
+  x_t X;
+  y_t Y;
+  lno_t num_rows;
+  lno_t rows_per_team;
+
+  ResidualNormFunctor(const rowmap_t &rowmap_, const entries_t &entries_,
+                      const values_t &values_, const x_t &X_, const y_t &Y_,
+                      lno_t num_rows_, lno_t rows_per_team_)
+      : rowmap(rowmap_),
+        entries(entries_),
+        values(values_),
+        X(X_),
+        Y(Y_),
+        num_rows(num_rows_),
+        rows_per_team(rows_per_team_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const member_type &team, mag_t &sum) const {
+    const lno_t row_begin = team.league_rank() * rows_per_team;
+    const lno_t row_end   = row_begin + rows_per_team < num_rows
+                                ? row_begin + rows_per_team
+                                : num_rows;
+    const lno_t num_vecs  = X.extent(1);
+    mag_t team_sum        = 0;
+    Kokkos::parallel_reduce(
+        Kokkos::TeamThreadRange(team, row_begin, row_end),
+        [&](const lno_t i, mag_t &row_sum) {
+          for (lno_t c = 0; c < num_vecs; c++) {
+            scalar_t Ax = ATS::zero();
+            Kokkos::parallel_reduce(
+                Kokkos::ThreadVectorRange(team, rowmap(i), rowmap(i + 1)),
+                [&](const offset_t k, scalar_t &lAx) {
+                  lAx += values(k) * X(entries(k), c);
+                },
+                Ax);
+            const scalar_t r = Y(i, c) - Ax;
+            Kokkos::single(Kokkos::PerThread(team), [&]() {
+              row_sum += ATS::real(r * ATS::conj(r));
+            });
+          }
+        },
+        team_sum);
+    Kokkos::single(Kokkos::PerTeam(team), [&]() { sum += team_sum; });
+  }
+};
+
+}  // namespace Impl
+}  // namespace KokkosSparse
+
+#endif  // _KOKKOSSPARSE_RESIDUAL_NORM_IMPL_HPP
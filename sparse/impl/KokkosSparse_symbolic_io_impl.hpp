@@ -0,0 +1,317 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSSPARSE_SYMBOLIC_IO_IMPL_HPP
+#define _KOKKOSSPARSE_SYMBOLIC_IO_IMPL_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Kokkos_Core.hpp"
+#include "KokkosKernels_MappedFile.hpp"
+
+/// \file KokkosSparse_symbolic_io_impl.hpp
+/// \brief Binary container used to save and restore the symbolic state of
+///        sparse handles (Gauss-Seidel, SPTRSV, SPILUK).
+///
+/// Layout of a file (all integers little-endian as written by the host):
+///   SymbolicFileHeader
+///   SymbolicFileSection[num_sections]
+///   section data, each section starting at a multiple of 64 bytes
+///
+/// Sections can thus be used in place when the file is memory-mapped.
+
+namespace KokkosSparse {
+namespace Impl {
+
+// bump when the layout of the file, or of a handle's sections, changes
+constexpr uint32_t SYMBOLIC_FILE_VERSION = 1;
+constexpr size_t SYMBOLIC_FILE_ALIGNMENT = 64;
+constexpr char SYMBOLIC_FILE_MAGIC[8]    = {'K', 'K', 'S', 'Y',
+                                         'M', 'B', 'O', 'L'};
+
+enum class SymbolicKind : uint32_t { GAUSS_SEIDEL = 1, SPTRSV = 2, SPILUK = 3 };
+
+struct SymbolicFileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t kind;
+  // hash of the rowmap/entries the symbolic state was computed for
+  uint64_t graph_hash;
+  // hash of the execution space name, since some of the state depends on it
+  uint64_t exec_space_hash;
+  uint64_t nrows;
+  uint64_t nnz;
+  uint32_t num_sections;
+  uint32_t num_params;
+};
+
+struct SymbolicFileSection {
+  uint64_t id;
+  uint64_t elem_size;
+  uint64_t count;
+  uint64_t offset;
+};
+
+KOKKOS_INLINE_FUNCTION
+uint64_t symbolic_hash_mix(uint64_t x) {
+  // splitmix64 finalizer
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+inline uint64_t symbolic_hash_string(const char *str) {
+  // FNV-1a
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (; *str; str++) {
+    h ^= static_cast<unsigned char>(*str);
+    h *= 0x100000001b3ULL;
+  }
+  return h;
+}
+
+/// \brief Order-dependent hash of a CRS graph, computed with one parallel
+/// reduction: every (position, value) pair is mixed independently and the
+/// results are summed (mod 2^64).
+template <typename execution_space, typename rowmap_t, typename entries_t>
+uint64_t hash_crs_graph(const rowmap_t &rowmap, const entries_t &entries) {
+  using range_t  = Kokkos::RangePolicy<execution_space>;
+  uint64_t nrows = rowmap.extent(0) ? rowmap.extent(0) - 1 : 0;
+  uint64_t nnz   = entries.extent(0);
+  uint64_t h     = 0;
+  Kokkos::parallel_reduce(
+      "KokkosSparse::hash_crs_graph::rowmap", range_t(0, rowmap.extent(0)),
+      KOKKOS_LAMBDA(const size_t i, uint64_t &lh) {
+        lh += symbolic_hash_mix((uint64_t(i) << 1) ^
+                                symbolic_hash_mix(uint64_t(rowmap(i))));
+      },
+      h);
+  uint64_t h2 = 0;
+  Kokkos::parallel_reduce(
+      "KokkosSparse::hash_crs_graph::entries", range_t(0, nnz),
+      KOKKOS_LAMBDA(const size_t k, uint64_t &lh) {
+        lh += symbolic_hash_mix(((uint64_t(k) << 1) | 1) ^
+                                symbolic_hash_mix(uint64_t(entries(k))));
+      },
+      h2);
+  return symbolic_hash_mix(h ^ symbolic_hash_mix(h2 ^ (nrows << 32) ^ nnz));
+}
+
+/// \brief Collects the sections of a symbolic state, then writes them.
+class SymbolicWriter {
+ public:
+  SymbolicWriter(SymbolicKind kind, uint64_t graph_hash,
+                 uint64_t exec_space_hash, uint64_t nrows, uint64_t nnz) {
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, SYMBOLIC_FILE_MAGIC, sizeof(header.magic));
+    header.version         = SYMBOLIC_FILE_VERSION;
+    header.kind            = static_cast<uint32_t>(kind);
+    header.graph_hash      = graph_hash;
+    header.exec_space_hash = exec_space_hash;
+    header.nrows           = nrows;
+    header.nnz             = nnz;
+  }
+
+  // Scalar parameters (number of colors, levels, ...) are kept together
+  void add_param(int64_t value) { params.push_back(value); }
+
+  // Copies the first count entries of the (rank-1) view.
+  template <typename view_t>
+  void add_section(uint64_t id, const view_t &v, size_t count) {
+    using value_type = typename view_t::non_const_value_type;
+    if (count > v.extent(0)) {
+      throw std::invalid_argument(
+          "SymbolicWriter: section is longer than its view");
+    }
+    auto sub   = Kokkos::subview(v, Kokkos::make_pair(size_t(0), count));
+    auto h_sub = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), sub);
+    SymbolicFileSection s;
+    s.id        = id;
+    s.elem_size = sizeof(value_type);
+    s.count     = count;
+    s.offset    = 0;
+    sections.push_back(s);
+    std::vector<char> bytes(count * sizeof(value_type));
+    if (count) std::memcpy(bytes.data(), h_sub.data(), bytes.size());
+    data.push_back(std::move(bytes));
+  }
+
+  template <typename view_t>
+  void add_section(uint64_t id, const view_t &v) {
+    add_section(id, v, v.extent(0));
+  }
+
+  void write(const std::string &filename) {
+    // params are stored as section 0
+    std::vector<SymbolicFileSection> all_sections;
+    SymbolicFileSection ps;
+    ps.id        = 0;
+    ps.elem_size = sizeof(int64_t);
+    ps.count     = params.size();
+    ps.offset    = 0;
+    all_sections.push_back(ps);
+    all_sections.insert(all_sections.end(), sections.begin(), sections.end());
+    header.num_sections = all_sections.size();
+    header.num_params   = params.size();
+
+    size_t offset = sizeof(SymbolicFileHeader) +
+                    all_sections.size() * sizeof(SymbolicFileSection);
+    for (auto &s : all_sections) {
+      offset   = align(offset);
+      s.offset = offset;
+      offset += s.count * s.elem_size;
+    }
+
+    std::ofstream os(filename, std::ios::out | std::ios::binary);
+    if (!os) {
+      throw std::runtime_error("SymbolicWriter: cannot open " + filename);
+    }
+    os.write((const char *)&header, sizeof(header));
+    os.write((const char *)all_sections.data(),
+             all_sections.size() * sizeof(SymbolicFileSection));
+    size_t pos = sizeof(SymbolicFileHeader) +
+                 all_sections.size() * sizeof(SymbolicFileSection);
+    for (size_t i = 0; i < all_sections.size(); i++) {
+      const char *src =
+          (i == 0 ? (const char *)params.data() : data[i - 1].data());
+      std::vector<char> pad(all_sections[i].offset - pos, 0);
+      os.write(pad.data(), pad.size());
+      os.write(src, all_sections[i].count * all_sections[i].elem_size);
+      pos = all_sections[i].offset +
+            all_sections[i].count * all_sections[i].elem_size;
+    }
+    if (!os) {
+      throw std::runtime_error("SymbolicWriter: failed to write " + filename);
+    }
+  }
+
+  static size_t align(size_t offset) {
+    return (offset + SYMBOLIC_FILE_ALIGNMENT - 1) / SYMBOLIC_FILE_ALIGNMENT *
+           SYMBOLIC_FILE_ALIGNMENT;
+  }
+
+ private:
+  SymbolicFileHeader header;
+  std::vector<int64_t> params;
+  std::vector<SymbolicFileSection> sections;
+  std::vector<std::vector<char>> data;
+};
+
+/// \brief Maps a file written by SymbolicWriter, and copies its sections
+/// into views. open() returns false if the file does not exist, was written
+/// for another graph, kind, version or execution space, or does not hold
+/// exactly num_params parameters (so param(i) cannot fail afterwards for
+/// i < num_params).
+class SymbolicReader {
+ public:
+  bool open(const std::string &filename, SymbolicKind kind,
+            uint64_t graph_hash, uint64_t exec_space_hash, uint64_t nrows,
+            uint64_t nnz, uint32_t num_params) {
+    {
+      std::ifstream probe(filename, std::ios::in | std::ios::binary);
+      if (!probe) return false;
+    }
+    file.open(filename);
+    if (file.size() < sizeof(SymbolicFileHeader)) return false;
+    const auto *header =
+        reinterpret_cast<const SymbolicFileHeader *>(file.data());
+    if (std::memcmp(header->magic, SYMBOLIC_FILE_MAGIC,
+                    sizeof(header->magic)) ||
+        header->version != SYMBOLIC_FILE_VERSION ||
+        header->kind != static_cast<uint32_t>(kind) ||
+        header->graph_hash != graph_hash ||
+        header->exec_space_hash != exec_space_hash ||
+        header->nrows != nrows || header->nnz != nnz ||
+        header->num_sections == 0 || header->num_params != num_params) {
+      return false;
+    }
+    size_t table_end = sizeof(SymbolicFileHeader) +
+                       header->num_sections * sizeof(SymbolicFileSection);
+    if (file.size() < table_end) return false;
+    sections = reinterpret_cast<const SymbolicFileSection *>(
+        file.data() + sizeof(SymbolicFileHeader));
+    num_sections = header->num_sections;
+    for (uint32_t i = 0; i < num_sections; i++) {
+      if (sections[i].offset + sections[i].count * sections[i].elem_size >
+          file.size())
+        return false;
+    }
+    // section 0 holds the params
+    if (sections[0].id != 0 || sections[0].elem_size != sizeof(int64_t) ||
+        sections[0].count != num_params)
+      return false;
+    return true;
+  }
+
+  int64_t param(size_t i) const {
+    if (i >= sections[0].count) {
+      throw std::runtime_error("SymbolicReader: missing parameter");
+    }
+    int64_t value;
+    std::memcpy(&value, file.data() + sections[0].offset + i * sizeof(value),
+                sizeof(value));
+    return value;
+  }
+
+  // number of entries stored in the section (zero if missing)
+  size_t count(uint64_t id) const {
+    const SymbolicFileSection *s = find(id);
+    return s ? s->count : 0;
+  }
+
+  // Copies the section into v, which must have exactly count(id) entries:
+  // a shorter or longer section means the file does not match.
+  template <typename view_t>
+  bool read_section(uint64_t id, const view_t &v) const {
+    using value_type = typename view_t::non_const_value_type;
+    using unmanaged_host_view_t =
+        Kokkos::View<const value_type *, Kokkos::HostSpace,
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+    const SymbolicFileSection *s = find(id);
+    if (!s || s->elem_size != sizeof(value_type) || s->count != v.extent(0))
+      return false;
+    if (s->count == 0) return true;
+    // sections are 64-byte aligned, so they can be used in place
+    unmanaged_host_view_t src(
+        reinterpret_cast<const value_type *>(file.data() + s->offset),
+        s->count);
+    Kokkos::deep_copy(v, src);
+    return true;
+  }
+
+ private:
+  const SymbolicFileSection *find(uint64_t id) const {
+    for (uint32_t i = 1; i < num_sections; i++) {
+      if (sections[i].id == id) return &sections[i];
+    }
+    return nullptr;
+  }
+
+  KokkosKernels::Impl::MappedFile file;
+  const SymbolicFileSection *sections = nullptr;
+  uint32_t num_sections               = 0;
+};
+
+}  // namespace Impl
+}  // namespace KokkosSparse
+
+#endif  // _KOKKOSSPARSE_SYMBOLIC_IO_IMPL_HPP
@@ -516,6 +516,185 @@ class TwostageGaussSeidel {
   };
   // --------------------------------------------------------- //
 
+  // tag for computing the scaled residual, T = D^{-1}*(B-A*X)
+  struct Tag_fusedResidual {};
+  // tag for one inner Jacobi-Richardson sweep
+  struct Tag_fusedSweep {};
+
+  // Fused inner Jacobi-Richardson sweeps:
+  // each call makes a single pass over the rows, applying D^{-1}*L (or
+  // D^{-1}*U), the inner damping and, at the last sweep, the outer update
+  // without storing intermediate vectors between the separate kernels.
+  template <typename x_view_t, typename b_view_t>
+  struct FusedJacobiRichardson_functor {
+    // input
+    bool compute_residual;
+    bool compact_form;
+    bool last_sweep;
+    ordinal_t nrhs;
+    scalar_t omega;
+    scalar_t gamma;
+    input_row_map_view_t rowmap_view;
+    input_entries_view_t column_view;
+    input_values_view_t values_view;
+    // scaled triangular part (D^{-1}*L or D^{-1}*U)
+    crsmat_t crsmatM;
+    values_view_t localD;
+    // vectors
+    x_view_t localX;
+    b_view_t localB;
+    internal_vector_view_t localT;
+    internal_vector_view_t localIn;
+    internal_vector_view_t localOut;
+
+    // for computing scaled residual, and initial JR iterate
+    FusedJacobiRichardson_functor(
+        bool compute_residual_, ordinal_t nrhs_, scalar_t gamma_,
+        input_row_map_view_t rowmap_view_, input_entries_view_t column_view_,
+        input_values_view_t values_view_, values_view_t localD_,
+        x_view_t localX_, b_view_t localB_, internal_vector_view_t localT_,
+        internal_vector_view_t localR_)
+        : compute_residual(compute_residual_),
+          compact_form(false),
+          last_sweep(false),
+          nrhs(nrhs_),
+          omega(ST::one()),
+          gamma(gamma_),
+          rowmap_view(rowmap_view_),
+          column_view(column_view_),
+          values_view(values_view_),
+          crsmatM(),
+          localD(localD_),
+          localX(localX_),
+          localB(localB_),
+          localT(localT_),
+          localIn(localR_),
+          localOut() {}
+
+    // for one inner sweep, Out = T - omega*M*In (with damping)
+    FusedJacobiRichardson_functor(bool compact_form_, bool last_sweep_,
+                                  ordinal_t nrhs_, scalar_t omega_,
+                                  scalar_t gamma_, crsmat_t crsmatM_,
+                                  x_view_t localX_,
+                                  internal_vector_view_t localT_,
+                                  internal_vector_view_t localIn_,
+                                  internal_vector_view_t localOut_)
+        : compute_residual(false),
+          compact_form(compact_form_),
+          last_sweep(last_sweep_),
+          nrhs(nrhs_),
+          omega(omega_),
+          gamma(gamma_),
+          crsmatM(crsmatM_),
+          localX(localX_),
+          localT(localT_),
+          localIn(localIn_),
+          localOut(localOut_) {}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const Tag_fusedResidual &, const ordinal_t i) const {
+      const scalar_t dinv = localD(i);
+      for (ordinal_t j = 0; j < nrhs; j++) {
+        scalar_t r;
+        if (compute_residual) {
+          // R(i) = B(i) - A(i,:)*X
+          r = localB(i, j);
+          for (size_type k = rowmap_view(i); k < rowmap_view(i + 1); k++) {
+            r -= values_view(k) * localX(column_view(k), j);
+          }
+        } else {
+          r = localIn(i, j);
+        }
+        const scalar_t t = dinv * r;
+        localT(i, j)     = t;
+        localIn(i, j)    = gamma * t;
+      }
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const Tag_fusedSweep &, const ordinal_t i) const {
+      const_scalar_t one = Kokkos::ArithTraits<scalar_t>::one();
+      const size_type k1 = crsmatM.graph.row_map(i);
+      const size_type k2 = crsmatM.graph.row_map(i + 1);
+      for (ordinal_t j = 0; j < nrhs; j++) {
+        // Z(i) = T(i) - omega*M(i,:)*R
+        scalar_t sum = Kokkos::ArithTraits<scalar_t>::zero();
+        for (size_type k = k1; k < k2; k++) {
+          sum += crsmatM.values(k) * localIn(crsmatM.graph.entries(k), j);
+        }
+        scalar_t z = localT(i, j) - omega * sum;
+        if (gamma != one) {
+          // Z(i) = gamma * Z(i) + (one - gamma) * R(i)
+          z = gamma * z + (one - gamma) * localIn(i, j);
+        }
+        if (last_sweep) {
+          // update solution
+          if (compact_form) {
+            localX(i, j) = omega * z;
+          } else {
+            localX(i, j) += omega * z;
+          }
+        } else {
+          localOut(i, j) = z;
+        }
+      }
+    }
+  };
+
+  /**
+   * Fused inner Jacobi-Richardson iteration, and outer update of X.
+   * Uses NumInnerSweeps+1 kernel launches, compared to the 5 vector kernels
+   * (plus SpMV) per inner sweep of the unfused version.
+   */
+  template <typename x_value_array_type, typename y_value_array_type>
+  void apply_fused_sweeps(x_value_array_type localX, y_value_array_type localB,
+                          bool compute_residual, bool forward_sweep,
+                          int NumInnerSweeps, scalar_t omega, scalar_t gamma,
+                          internal_vector_view_t localR,
+                          internal_vector_view_t localT,
+                          internal_vector_view_t localZ) {
+    auto *gsHandle    = get_gs_handle();
+    bool compact_form = gsHandle->isCompactForm();
+    int block_size    = gsHandle->getFusedBlockSize();
+    ordinal_t nrhs    = localX.extent(1);
+
+    auto localD  = gsHandle->getD();
+    auto crsmatM = (forward_sweep ? gsHandle->getL() : gsHandle->getU());
+
+    using Fused_Functor_t =
+        FusedJacobiRichardson_functor<x_value_array_type, y_value_array_type>;
+    using static_schedule_t = Kokkos::Schedule<Kokkos::Static>;
+    using residual_policy =
+        Kokkos::RangePolicy<Tag_fusedResidual, execution_space,
+                            static_schedule_t>;
+    using sweep_policy =
+        Kokkos::RangePolicy<Tag_fusedSweep, execution_space, static_schedule_t>;
+
+    // T = D^{-1}*R, and R = gamma*T (with R = B-A*X, if requested)
+    residual_policy rpolicy(0, num_rows);
+    if (block_size > 0) rpolicy.set_chunk_size(block_size);
+    Kokkos::parallel_for(
+        "fusedResidualJR", rpolicy,
+        Fused_Functor_t(compute_residual, nrhs, gamma, rowmap_view,
+                        column_view, values_view, localD, localX, localB,
+                        localT, localR));
+
+    // inner Jacobi-Richardson, swapping R and Z as input and output
+    internal_vector_view_t localIn  = localR;
+    internal_vector_view_t localOut = localZ;
+    for (int ii = 0; ii < NumInnerSweeps; ii++) {
+      bool last_sweep = (ii + 1 == NumInnerSweeps);
+      sweep_policy spolicy(0, num_rows);
+      if (block_size > 0) spolicy.set_chunk_size(block_size);
+      Kokkos::parallel_for(
+          "fusedSweepJR", spolicy,
+          Fused_Functor_t(compact_form, last_sweep, nrhs, omega, gamma,
+                          crsmatM, localX, localT, localIn, localOut));
+      std::swap(localIn, localOut);
+    }
+  }
+  // --------------------------------------------------------- //
+
  public:
   /**
    * \brief constructor
@@ -919,9 +1098,22 @@ class TwostageGaussSeidel {
       KokkosKernels::Impl::zero_vector<x_value_array_type, execution_space>(
           nrhs, localX);
     }
+    bool fused_sweeps =
+        (two_stage && gsHandle->isFusedSweeps() && NumInnerSweeps > 0);
     for (int sweep = 0; sweep < NumSweeps; ++sweep) {
       bool forward_sweep = (direction == GS_FORWARD ||
                             (direction == GS_SYMMETRIC && sweep % 2 == 0));
+      if (fused_sweeps && !compact_form) {
+        // residual is computed within the fused kernel
+        bool compute_residual = (sweep > 0 || !init_zero_x_vector);
+        if (!compute_residual) {
+          KokkosBlas::scal(localR, one, localB);
+        }
+        apply_fused_sweeps(localX, localB, compute_residual, forward_sweep,
+                           NumInnerSweeps, omega, gamma, localR, localT,
+                           localZ);
+        continue;
+      }
       // compute residual vector
       KokkosBlas::scal(localR, one, localB);
       if (sweep > 0 || !init_zero_x_vector) {
@@ -1010,6 +1202,11 @@ class TwostageGaussSeidel {
           // Y = Y + omega * Z
           KokkosBlas::axpy(one, localZ, localY);
         }
+      } else if (fused_sweeps) {
+        // ====== fused inner Jacobi-Richardson (compact form) =====
+        apply_fused_sweeps(localX, localB, false, forward_sweep,
+                           NumInnerSweeps, omega, gamma, localR, localT,
+                           localZ);
       } else {
         // ====== inner Jacobi-Richardson =====
 #ifdef KOKKOSSPARSE_IMPL_TIME_TWOSTAGE_GS
@@ -740,6 +740,14 @@ class KokkosKernelsHandle {
     auto gs2 = get_twostage_gs_handle();
     gs2->setCompactForm(compact_form);
   }
+  // ---------------------------------------- //
+  // Specify to run the inner Jacobi-Richardson sweeps of two-stage
+  // Gauss-Seidel with the fused kernel
+  void set_gs_twostage_fused_sweeps(bool fused_sweeps, int block_size = 0) {
+    auto gs2 = get_twostage_gs_handle();
+    gs2->setFusedSweeps(fused_sweeps);
+    gs2->setFusedBlockSize(block_size);
+  }
 
   // clang-format off
   /**
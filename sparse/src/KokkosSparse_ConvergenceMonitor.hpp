@@ -0,0 +1,265 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+/// @file KokkosSparse_ConvergenceMonitor.hpp
+
+#ifndef KOKKOSSPARSE_CONVERGENCE_MONITOR_HPP
+#define KOKKOSSPARSE_CONVERGENCE_MONITOR_HPP
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosKernels_helpers.hpp"
+#include "KokkosSparse_residual_norm_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+/// \class ConvergenceMonitor
+/// \brief Common stopping logic for the iterative kernels (Gauss-Seidel
+///        apply, par_ilut numeric, GMRES).
+///
+/// The monitor is given a residual norm every check_interval iterations and
+/// decides whether to stop:
+///   - Converged: residual <= max(abs_tol, rel_tol * initial residual)
+///   - Stagnated: the residual was reduced by less than a factor
+///     (1 - min_reduction) over the last stagnation_window checks
+///     (disabled when stagnation_window is 0)
+///   - MaxIterations: max_iters iterations were done
+/// Every check is recorded with the time elapsed since start(), so the
+/// history can be inspected (or exported) after the run.
+///
+/// \tparam mag_t The (real) type of the residual norms
+template <typename mag_t>
+class ConvergenceMonitor {
+ public:
+  enum class Status {
+    NotStarted,
+    Running,
+    Converged,
+    Stagnated,
+    MaxIterations
+  };
+
+  struct Record {
+    int iteration;
+    mag_t residual;
+    double seconds;
+  };
+
+ private:
+  mag_t rel_tol;
+  mag_t abs_tol;
+  int max_iters;
+  int check_interval;
+  int stagnation_window;
+  mag_t min_reduction;
+
+  Status status;
+  mag_t initial_residual;
+  std::vector<Record> history;
+  Kokkos::Timer timer;
+
+ public:
+  ConvergenceMonitor(const mag_t rel_tol_ = 1e-8, const int max_iters_ = 100,
+                     const int check_interval_ = 1)
+      : rel_tol(rel_tol_),
+        abs_tol(0),
+        max_iters(max_iters_),
+        check_interval(check_interval_),
+        stagnation_window(0),
+        min_reduction(0),
+        status(Status::NotStarted),
+        initial_residual(0) {
+    if (max_iters < 0 || check_interval <= 0) {
+      throw std::invalid_argument(
+          "ConvergenceMonitor: max_iters must be non-negative and "
+          "check_interval positive");
+    }
+  }
+
+  void set_rel_tol(const mag_t rel_tol_) { rel_tol = rel_tol_; }
+  mag_t get_rel_tol() const { return rel_tol; }
+
+  void set_abs_tol(const mag_t abs_tol_) { abs_tol = abs_tol_; }
+  mag_t get_abs_tol() const { return abs_tol; }
+
+  void set_max_iters(const int max_iters_) { max_iters = max_iters_; }
+  int get_max_iters() const { return max_iters; }
+
+  void set_check_interval(const int check_interval_) {
+    if (check_interval_ <= 0) {
+      throw std::invalid_argument(
+          "ConvergenceMonitor: check_interval must be positive");
+    }
+    check_interval = check_interval_;
+  }
+  int get_check_interval() const { return check_interval; }
+
+  /// Stop when the residual was reduced by less than (1 - min_reduction)
+  /// over the last window checks. A window of 0 disables the test.
+  void set_stagnation(const int window, const mag_t min_reduction_) {
+    stagnation_window = window;
+    min_reduction     = min_reduction_;
+  }
+
+  /// Resets the history and the timer, and records the initial residual.
+  Status start(const mag_t residual) {
+    history.clear();
+    initial_residual = residual;
+    timer.reset();
+    history.push_back(Record{0, residual, 0.0});
+    status = Status::Running;
+    if (residual <= tolerance())
+      status = Status::Converged;
+    else if (max_iters == 0)
+      status = Status::MaxIterations;
+    return status;
+  }
+
+  /// True if the residual should be computed after iteration iter
+  bool check_now(const int iter) const {
+    return iter % check_interval == 0 || iter >= max_iters;
+  }
+
+  /// Number of iterations to do before the next check, after iter iterations
+  int iterations_until_check(const int iter) const {
+    const int next = (iter / check_interval + 1) * check_interval;
+    return std::min(next, max_iters) - iter;
+  }
+
+  /// Records the residual after iteration iter, and updates the status.
+  Status update(const int iter, const mag_t residual) {
+    if (status == Status::NotStarted) {
+      throw std::runtime_error(
+          "ConvergenceMonitor: start() must be called before update()");
+    }
+    history.push_back(Record{iter, residual, timer.seconds()});
+    const size_t n = history.size();
+    if (residual <= tolerance()) {
+      status = Status::Converged;
+    } else if (stagnation_window > 0 && n > size_t(stagnation_window) &&
+               residual > (1 - min_reduction) *
+                              history[n - 1 - stagnation_window].residual) {
+      status = Status::Stagnated;
+    } else if (iter >= max_iters) {
+      status = Status::MaxIterations;
+    } else {
+      status = Status::Running;
+    }
+    return status;
+  }
+
+  bool done() const {
+    return status != Status::Running && status != Status::NotStarted;
+  }
+
+  Status get_status() const { return status; }
+  bool is_converged() const { return status == Status::Converged; }
+
+  mag_t tolerance() const {
+    return std::max(abs_tol, rel_tol * initial_residual);
+  }
+
+  mag_t get_initial_residual() const { return initial_residual; }
+
+  int get_num_iters() const {
+    return history.empty() ? 0 : history.back().iteration;
+  }
+  mag_t get_final_residual() const {
+    return history.empty() ? mag_t(0) : history.back().residual;
+  }
+  double get_elapsed_seconds() const {
+    return history.empty() ? 0.0 : history.back().seconds;
+  }
+
+  /// One record per check, the first one being the initial residual
+  const std::vector<Record> &get_history() const { return history; }
+};
+
+///
+/// @brief Computes ||Y - A X|| (Frobenius norm for multivectors) in a single
+/// kernel, without storing the residual.
+///
+/// @tparam ExecutionSpace This kernels execution space type.
+/// @param space The execution space instance this kernel will be run on.
+/// @param num_rows Number of rows in the matrix
+/// @param row_map The matrix's rowmap
+/// @param entries The matrix's entries
+/// @param values The matrix's values
+/// @param X The rank-1 or rank-2 view multiplied by A
+/// @param Y The rank-1 or rank-2 right-hand side
+///
+template <typename ExecutionSpace, typename lno_row_view_t_,
+          typename lno_nnz_view_t_, typename scalar_nnz_view_t_,
+          typename x_scalar_view_t, typename y_scalar_view_t>
+typename Kokkos::ArithTraits<
+    typename scalar_nnz_view_t_::non_const_value_type>::mag_type
+residual_norm(const ExecutionSpace &space,
+              typename lno_nnz_view_t_::non_const_value_type num_rows,
+              const lno_row_view_t_ &row_map, const lno_nnz_view_t_ &entries,
+              const scalar_nnz_view_t_ &values, const x_scalar_view_t &X,
+              const y_scalar_view_t &Y) {
+  using lno_t = typename lno_nnz_view_t_::non_const_value_type;
+  using mag_t = typename Kokkos::ArithTraits<
+      typename scalar_nnz_view_t_::non_const_value_type>::mag_type;
+
+  using x_internal_t =
+      Kokkos::View<typename x_scalar_view_t::const_value_type **,
+                   typename KokkosKernels::Impl::GetUnifiedLayout<
+                       x_scalar_view_t>::array_layout,
+                   typename x_scalar_view_t::device_type,
+                   Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+  using y_internal_t =
+      Kokkos::View<typename y_scalar_view_t::const_value_type **,
+                   typename KokkosKernels::Impl::GetUnifiedLayout<
+                       y_scalar_view_t>::array_layout,
+                   typename y_scalar_view_t::device_type,
+                   Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+  using functor_t =
+      KokkosSparse::Impl::ResidualNormFunctor<ExecutionSpace, lno_row_view_t_,
+                                              lno_nnz_view_t_,
+                                              scalar_nnz_view_t_, x_internal_t,
+                                              y_internal_t>;
+
+  if (X.extent(1) != Y.extent(1)) {
+    throw std::invalid_argument(
+        "KokkosSparse::residual_norm: X and Y have different numbers of "
+        "columns");
+  }
+  x_internal_t X_i(X.data(), X.extent(0), X.extent(1));
+  y_internal_t Y_i(Y.data(), Y.extent(0), Y.extent(1));
+
+  mag_t sum = 0;
+  if (num_rows > 0) {
+    const lno_t rows_per_team = 64;
+    const lno_t num_teams     = (num_rows + rows_per_team - 1) / rows_per_team;
+    typename functor_t::team_policy policy(space, num_teams, Kokkos::AUTO);
+    Kokkos::parallel_reduce(
+        "KokkosSparse::residual_norm", policy,
+        functor_t(row_map, entries, values, X_i, Y_i, num_rows, rows_per_team),
+        sum);
+  }
+  return Kokkos::ArithTraits<mag_t>::sqrt(sum);
+}
+
+}  // namespace Experimental
+}  // namespace KokkosSparse
+
+#endif  // KOKKOSSPARSE_CONVERGENCE_MONITOR_HPP
@@ -0,0 +1,284 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSSPARSE_COOASSEMBLER_HPP
+#define _KOKKOSSPARSE_COOASSEMBLER_HPP
+
+/// \file KokkosSparse_CooAssembler.hpp
+/// \brief Streaming assembly of a CrsMatrix from batches of (row, col, value)
+///        triples, and re-assembly of new values into a fixed pattern.
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosKernels_Handle.hpp"
+#include "KokkosKernels_SimpleUtils.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_SortCrs.hpp"
+#include "KokkosSparse_spadd.hpp"
+#include "KokkosSparse_CooAssembler_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+/// \class CooAssembler
+/// \brief Builds a CrsMatrix from triples that arrive in batches, without
+/// keeping the triples around.
+///
+/// Every batch is bucketed by row and sorted with its duplicates summed,
+/// which gives a sorted run. Runs are merged pairwise (sorted spadd) as soon
+/// as two of them hold the same number of batches, so that at most
+/// log2(number of batches) runs are alive, and every triple takes part in
+/// O(log(number of batches)) merges. finalize() merges the remaining runs.
+///
+/// The batches are bucketed and sorted on the given execution space
+/// instance. spadd does not take an instance, so the merges run on the
+/// default instance: a merge fences the given instance first, and fences the
+/// default instance before returning.
+///
+/// As in coo2crs, triples with a negative row or column index are ignored.
+/// Triples out of the bounds of the matrix are an error.
+///
+/// \tparam CrsMatrixType The type of the assembled matrix
+template <typename CrsMatrixType>
+class CooAssembler {
+ public:
+  using crsMat_t        = CrsMatrixType;
+  using execution_space = typename crsMat_t::execution_space;
+  using memory_space    = typename crsMat_t::memory_space;
+  using scalar_t        = typename crsMat_t::non_const_value_type;
+  using lno_t           = typename crsMat_t::non_const_ordinal_type;
+  using size_type       = typename crsMat_t::non_const_size_type;
+  using rowmap_t        = typename crsMat_t::row_map_type::non_const_type;
+  using entries_t       = typename crsMat_t::index_type::non_const_type;
+  using values_t        = typename crsMat_t::values_type::non_const_type;
+
+  CooAssembler(lno_t num_rows, lno_t num_cols)
+      : nrows(num_rows), ncols(num_cols) {
+    if (num_rows < 0 || num_cols < 0) {
+      throw std::invalid_argument(
+          "CooAssembler: the dimensions must be nonnegative");
+    }
+  }
+
+  /// \brief Adds a batch of triples. rows, cols and vals are rank-1 views of
+  /// the same length, accessible from execution_space.
+  template <typename RowViewType, typename ColViewType, typename ValViewType>
+  void add_batch(const execution_space &exec, const RowViewType &rows,
+                 const ColViewType &cols, const ValViewType &vals) {
+    static_assert(Kokkos::SpaceAccessibility<
+                      execution_space,
+                      typename RowViewType::memory_space>::accessible &&
+                      Kokkos::SpaceAccessibility<
+                          execution_space,
+                          typename ColViewType::memory_space>::accessible &&
+                      Kokkos::SpaceAccessibility<
+                          execution_space,
+                          typename ValViewType::memory_space>::accessible,
+                  "CooAssembler::add_batch: the triples must be accessible "
+                  "from the execution space of the matrix");
+    if (rows.extent(0) != cols.extent(0) ||
+        rows.extent(0) != vals.extent(0)) {
+      throw std::invalid_argument(
+          "CooAssembler::add_batch: rows, cols and vals must have the same "
+          "length");
+    }
+    const size_t n = rows.extent(0);
+    if (n == 0) return;
+    using policy_t = Kokkos::RangePolicy<execution_space>;
+
+    rowmap_t rowmap("CooAssembler rowmap", nrows + 1);
+    size_t num_invalid = 0;
+    Kokkos::parallel_reduce(
+        "KokkosSparse::CooAssembler::count", policy_t(exec, 0, n),
+        KokkosSparse::Impl::CooBatchCountFunctor<rowmap_t, RowViewType,
+                                                 ColViewType>{
+            rowmap, rows, cols, nrows, ncols},
+        num_invalid);
+    if (num_invalid) {
+      throw std::invalid_argument(
+          "CooAssembler::add_batch: " + std::to_string(num_invalid) +
+          " triples are out of the bounds of the matrix");
+    }
+    size_type batch_nnz = 0;
+    KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<execution_space>(
+        exec, nrows + 1, rowmap, batch_nnz);
+
+    rowmap_t cursor(
+        Kokkos::view_alloc(exec, Kokkos::WithoutInitializing,
+                           "CooAssembler cursor"),
+        nrows + 1);
+    Kokkos::deep_copy(exec, cursor, rowmap);
+    entries_t entries(Kokkos::view_alloc(exec, Kokkos::WithoutInitializing,
+                                         "CooAssembler entries"),
+                      batch_nnz);
+    values_t values(Kokkos::view_alloc(exec, Kokkos::WithoutInitializing,
+                                       "CooAssembler values"),
+                    batch_nnz);
+    Kokkos::parallel_for(
+        "KokkosSparse::CooAssembler::fill", policy_t(exec, 0, n),
+        KokkosSparse::Impl::CooBatchFillFunctor<rowmap_t, entries_t, values_t,
+                                                RowViewType, ColViewType,
+                                                ValViewType>{
+            cursor, entries, values, rows, cols, vals, nrows, ncols});
+
+    crsMat_t batch("CooAssembler batch", nrows, ncols, batch_nnz, values,
+                   rowmap, entries);
+    runs.push_back(KokkosSparse::sort_and_merge_matrix(exec, batch));
+    levels.push_back(0);
+    // binary counter: merge the two last runs while they have the same level
+    while (levels.size() > 1 &&
+           levels[levels.size() - 1] == levels[levels.size() - 2]) {
+      merge_last_two(exec);
+      levels.back()++;
+    }
+  }
+
+  template <typename RowViewType, typename ColViewType, typename ValViewType>
+  void add_batch(const RowViewType &rows, const ColViewType &cols,
+                 const ValViewType &vals) {
+    add_batch(execution_space(), rows, cols, vals);
+  }
+
+  /// \brief Number of sorted runs currently held.
+  size_t num_runs() const { return runs.size(); }
+
+  /// \brief Returns the assembled matrix, with sorted rows and no duplicate
+  /// entries, and empties the assembler. exec is the instance the batches
+  /// were added on.
+  crsMat_t finalize(const execution_space &exec) {
+    if (runs.empty()) {
+      rowmap_t rowmap(Kokkos::view_alloc(exec, "CooAssembler rowmap"),
+                      nrows + 1);
+      return crsMat_t("CooAssembler", nrows, ncols, 0, values_t(), rowmap,
+                      entries_t());
+    }
+    while (runs.size() > 1) merge_last_two(exec);
+    crsMat_t result = runs.front();
+    runs.clear();
+    levels.clear();
+    return result;
+  }
+
+  crsMat_t finalize() { return finalize(execution_space()); }
+
+ private:
+  void merge_last_two(const execution_space &exec) {
+    using handle_t = KokkosKernels::Experimental::KokkosKernelsHandle<
+        size_type, lno_t, scalar_t, execution_space, memory_space,
+        memory_space>;
+    using KAT = Kokkos::ArithTraits<scalar_t>;
+    crsMat_t B = runs.back();
+    runs.pop_back();
+    levels.pop_back();
+    crsMat_t A = runs.back();
+    crsMat_t C;
+    handle_t kh;
+    exec.fence();
+    kh.create_spadd_handle(true);
+    KokkosSparse::spadd_symbolic(&kh, A, B, C);
+    KokkosSparse::spadd_numeric(&kh, KAT::one(), A, KAT::one(), B, C);
+    kh.destroy_spadd_handle();
+    execution_space().fence();
+    runs.back() = C;
+  }
+
+  lno_t nrows, ncols;
+  std::vector<crsMat_t> runs;
+  std::vector<int> levels;
+};
+
+/// \class CooPatternMap
+/// \brief Position of a fixed list of triples in the values of a matrix, to
+/// assemble new values into it repeatedly (e.g. at every step of a
+/// simulation) without sorting the triples again.
+///
+/// The rows of the matrix must be sorted. Triples with a negative index are
+/// ignored; triples that are not in the pattern of the matrix are counted
+/// by get_num_missing(), and ignored by assemble().
+///
+/// \tparam CrsMatrixType The type of the matrix
+template <typename CrsMatrixType>
+class CooPatternMap {
+ public:
+  using crsMat_t        = CrsMatrixType;
+  using execution_space = typename crsMat_t::execution_space;
+  using size_type       = typename crsMat_t::non_const_size_type;
+
+  using offsets_t = Kokkos::View<size_type *, typename crsMat_t::device_type>;
+
+  template <typename RowViewType, typename ColViewType>
+  CooPatternMap(const crsMat_t &A_, const RowViewType &rows,
+                const ColViewType &cols)
+      : A(A_),
+        offsets(Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                                   "CooPatternMap offsets"),
+                rows.extent(0)) {
+    if (rows.extent(0) != cols.extent(0)) {
+      throw std::invalid_argument(
+          "CooPatternMap: rows and cols must have the same length");
+    }
+    num_missing = 0;
+    Kokkos::parallel_reduce(
+        "KokkosSparse::CooPatternMap::offsets",
+        Kokkos::RangePolicy<execution_space>(0, rows.extent(0)),
+        KokkosSparse::Impl::CooPatternOffsetsFunctor<
+            typename crsMat_t::row_map_type, typename crsMat_t::index_type,
+            offsets_t, RowViewType, ColViewType>{
+            A.graph.row_map, A.graph.entries, offsets, rows, cols,
+            A.numRows(), invalid()},
+        num_missing);
+  }
+
+  /// \brief Number of triples that are not in the pattern of the matrix.
+  size_t get_num_missing() const { return num_missing; }
+
+  /// \brief Sums the values of the triples into the matrix (duplicates are
+  /// added). The previous values are overwritten, unless accumulate is true.
+  template <typename ValViewType>
+  void assemble(const ValViewType &vals, bool accumulate = false) {
+    if (vals.extent(0) != offsets.extent(0)) {
+      throw std::invalid_argument(
+          "CooPatternMap::assemble: vals must have one value per triple");
+    }
+    if (!accumulate) {
+      Kokkos::deep_copy(A.values, typename crsMat_t::non_const_value_type());
+    }
+    Kokkos::parallel_for(
+        "KokkosSparse::CooPatternMap::assemble",
+        Kokkos::RangePolicy<execution_space>(0, offsets.extent(0)),
+        KokkosSparse::Impl::CooPatternAssembleFunctor<
+            typename crsMat_t::values_type, offsets_t, ValViewType>{
+            A.values, offsets, vals, invalid()});
+  }
+
+ private:
+  static size_type invalid() {
+    return Kokkos::ArithTraits<size_type>::max();
+  }
+
+  crsMat_t A;
+  offsets_t offsets;
+  size_t num_missing;
+};
+
+}  // namespace Experimental
+}  // namespace KokkosSparse
+
+#endif  // _KOKKOSSPARSE_COOASSEMBLER_HPP
@@ -0,0 +1,442 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+/// @file KokkosSparse_CrsBinary.hpp
+
+#ifndef _KOKKOSSPARSE_CRSBINARY_HPP
+#define _KOKKOSSPARSE_CRSBINARY_HPP
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Kokkos_Core.hpp"
+#include "KokkosKernels_MappedFile.hpp"
+#include "KokkosKernels_PositionedFile.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_CrsBinary_impl.hpp"
+#include "KokkosSparse_IOUtils_write_impl.hpp"
+
+namespace KokkosSparse {
+namespace Impl {
+
+/// \brief Options of write_crs_binary
+struct CrsBinaryWriteOptions {
+  /// Records that the matrix is symmetric (this is not checked)
+  bool symmetric = false;
+  /// Stores a checksum of the sections, verified by CrsBinaryFile
+  bool checksum = false;
+  /// Compresses the sections (the file can then only be read with copy())
+  const CrsBinaryCodec *codec = nullptr;
+};
+
+///
+/// @brief Writes a CrsMatrix in the self-describing binary format (.kkb).
+///
+/// The header records the dimensions, the sizes of the ordinal, offset and
+/// scalar types, whether the rows are sorted and, if declared by the caller,
+/// the symmetry of the matrix. Every section is 64-byte aligned so that
+/// CrsBinaryFile can use them in place. The file is preallocated and the
+/// sections are written concurrently by the host threads.
+///
+/// @param A The matrix to write
+/// @param filename The output file
+/// @param options Symmetry flag, checksum and compression
+///
+template <typename crsMat_t>
+void write_crs_binary(const crsMat_t &A, const std::string &filename,
+                      const CrsBinaryWriteOptions &options) {
+  using offset_t = typename crsMat_t::non_const_size_type;
+  using lno_t    = typename crsMat_t::non_const_ordinal_type;
+  using scalar_t = typename crsMat_t::non_const_value_type;
+  using range_t  = Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>;
+
+  auto rowmap =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A.graph.row_map);
+  auto entries =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A.graph.entries);
+  auto values =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A.values);
+  const uint64_t nrows = A.numRows();
+  const uint64_t nnz   = A.nnz();
+  // an empty matrix may have an empty row map
+  const offset_t zero        = 0;
+  const offset_t *rowmap_ptr = rowmap.extent(0) ? rowmap.data() : &zero;
+
+  int unsorted = 0;
+  if (rowmap.extent(0)) {
+    Kokkos::parallel_reduce(
+        "KokkosSparse::write_crs_binary::sorted", range_t(0, nrows),
+        [=](const size_t i, int &lunsorted) {
+          for (offset_t k = rowmap(i) + 1; k < rowmap(i + 1); k++) {
+            if (!(entries(k - 1) < entries(k))) lunsorted = 1;
+          }
+        },
+        unsorted);
+  }
+
+  // the stored sections, compressed if requested
+  const char *sections[3]   = {(const char *)rowmap_ptr,
+                               (const char *)entries.data(),
+                               (const char *)values.data()};
+  uint64_t section_bytes[3] = {(nrows + 1) * sizeof(offset_t),
+                               nnz * sizeof(lno_t), nnz * sizeof(scalar_t)};
+  std::vector<char> compressed[3];
+  if (options.codec) {
+    if (options.codec->id() == 0) {
+      throw std::invalid_argument(
+          "write_crs_binary: codec ids must be nonzero");
+    }
+    for (int i = 0; i < 3; i++) {
+      options.codec->compress(sections[i], section_bytes[i], compressed[i]);
+      sections[i]      = compressed[i].data();
+      section_bytes[i] = compressed[i].size();
+    }
+  }
+
+  CrsBinaryHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, CRS_BINARY_MAGIC, sizeof(header.magic));
+  header.version      = CRS_BINARY_VERSION;
+  header.byte_order   = CRS_BINARY_BYTE_ORDER;
+  header.num_rows     = nrows;
+  header.num_cols     = A.numCols();
+  header.nnz          = nnz;
+  header.ordinal_size = sizeof(lno_t);
+  header.offset_size  = sizeof(offset_t);
+  header.scalar_size  = sizeof(scalar_t);
+  header.scalar_kind =
+      static_cast<uint32_t>(crs_binary_scalar_kind<scalar_t>());
+  header.flags = (unsorted ? 0 : CRS_BINARY_SORTED) |
+                 (options.symmetric ? CRS_BINARY_SYMMETRIC : 0) |
+                 (options.checksum ? CRS_BINARY_CHECKSUM : 0) |
+                 (options.codec ? CRS_BINARY_COMPRESSED : 0);
+  header.codec          = options.codec ? options.codec->id() : 0;
+  header.rowmap_offset  = crs_binary_align(sizeof(CrsBinaryHeader));
+  header.entries_offset = crs_binary_align(header.rowmap_offset +
+                                           section_bytes[0]);
+  header.values_offset =
+      crs_binary_align(header.entries_offset + section_bytes[1]);
+  header.rowmap_bytes  = section_bytes[0];
+  header.entries_bytes = section_bytes[1];
+  header.values_bytes  = section_bytes[2];
+  if (options.checksum) {
+    header.checksum = crs_binary_checksum(sections[0], section_bytes[0]);
+    header.checksum = crs_binary_mix(
+        header.checksum ^ crs_binary_checksum(sections[1], section_bytes[1]));
+    header.checksum = crs_binary_mix(
+        header.checksum ^ crs_binary_checksum(sections[2], section_bytes[2]));
+  }
+
+  // the padding between the sections is left as a hole
+  const uint64_t end = header.values_offset + section_bytes[2];
+  KokkosKernels::Impl::PositionedFile file(filename);
+  file.preallocate(end);
+  file.write_at(0, &header, sizeof(header));
+  write_bytes_parallel(file, header.rowmap_offset, sections[0],
+                       section_bytes[0]);
+  write_bytes_parallel(file, header.entries_offset, sections[1],
+                       section_bytes[1]);
+  write_bytes_parallel(file, header.values_offset, sections[2],
+                       section_bytes[2]);
+  file.truncate(end);
+  file.close();
+}
+
+/// @brief Writes a CrsMatrix in the .kkb format, uncompressed and without
+/// checksum.
+template <typename crsMat_t>
+void write_crs_binary(const crsMat_t &A, const std::string &filename,
+                      bool symmetric = false) {
+  CrsBinaryWriteOptions options;
+  options.symmetric = symmetric;
+  write_crs_binary(A, filename, options);
+}
+
+/// \class CrsBinaryFile
+/// \brief Memory-maps a file written by write_crs_binary, and gives access
+///        to it as a CrsMatrix.
+///
+/// view() wraps the sections of the file in unmanaged views, without reading
+/// or copying anything: only the pages that are touched are loaded. This
+/// requires a host matrix type whose ordinal, offset and scalar types match
+/// the ones of the file (see can_view()). The mapping is copy-on-write, so
+/// the values can be modified without changing the file. The matrix returned
+/// by view() must not outlive the CrsBinaryFile.
+///
+/// copy() works for any matrix type: the sections are converted if needed,
+/// and copied into newly allocated views. It also verifies the checksum, if
+/// the file has one, and decompresses the sections of a compressed file
+/// (the codec must be given with set_codec()).
+class CrsBinaryFile {
+ public:
+  CrsBinaryFile() = default;
+
+  explicit CrsBinaryFile(const std::string &filename) { open(filename); }
+
+  void open(const std::string &filename) {
+    close();
+    file.open(filename, true);
+    if (file.size() < sizeof(CrsBinaryHeader)) {
+      throw std::runtime_error("CrsBinaryFile: " + filename +
+                               " is too small to be a .kkb file");
+    }
+    const auto *h = reinterpret_cast<const CrsBinaryHeader *>(file.data());
+    if (std::memcmp(h->magic, CRS_BINARY_MAGIC, sizeof(h->magic))) {
+      throw std::runtime_error("CrsBinaryFile: " + filename +
+                               " is not a .kkb file");
+    }
+    if (h->version != CRS_BINARY_VERSION) {
+      throw std::runtime_error("CrsBinaryFile: " + filename +
+                               " was written with an unsupported version");
+    }
+    if (h->byte_order != CRS_BINARY_BYTE_ORDER) {
+      throw std::runtime_error("CrsBinaryFile: " + filename +
+                               " was written with another byte order");
+    }
+    if ((h->ordinal_size != 4 && h->ordinal_size != 8) ||
+        (h->offset_size != 4 && h->offset_size != 8) ||
+        h->scalar_kind > static_cast<uint32_t>(CrsBinaryScalarKind::INTEGER)) {
+      throw std::runtime_error("CrsBinaryFile: " + filename +
+                               " has unsupported types");
+    }
+    if ((h->flags & CRS_BINARY_COMPRESSED) && h->codec == 0) {
+      throw std::runtime_error("CrsBinaryFile: " + filename +
+                               " is compressed, but has no codec id");
+    }
+    header = h;
+    if (h->rowmap_offset % CRS_BINARY_ALIGNMENT ||
+        h->entries_offset % CRS_BINARY_ALIGNMENT ||
+        h->values_offset % CRS_BINARY_ALIGNMENT ||
+        h->rowmap_offset + stored_bytes(0) > file.size() ||
+        h->entries_offset + stored_bytes(1) > file.size() ||
+        h->values_offset + stored_bytes(2) > file.size()) {
+      header = nullptr;
+      throw std::runtime_error("CrsBinaryFile: " + filename +
+                               " is truncated or corrupted");
+    }
+  }
+
+  /// Codec used to decompress the sections of a compressed file
+  void set_codec(const CrsBinaryCodec *codec_) { codec = codec_; }
+
+  void close() {
+    file.close();
+    header = nullptr;
+  }
+
+  bool is_open() const { return header != nullptr; }
+  const CrsBinaryHeader &get_header() const { return *checked_header(); }
+
+  uint64_t num_rows() const { return checked_header()->num_rows; }
+  uint64_t num_cols() const { return checked_header()->num_cols; }
+  uint64_t nnz() const { return checked_header()->nnz; }
+  bool is_sorted() const {
+    return checked_header()->flags & CRS_BINARY_SORTED;
+  }
+  bool is_symmetric() const {
+    return checked_header()->flags & CRS_BINARY_SYMMETRIC;
+  }
+  bool has_checksum() const {
+    return checked_header()->flags & CRS_BINARY_CHECKSUM;
+  }
+  bool is_compressed() const {
+    return checked_header()->flags & CRS_BINARY_COMPRESSED;
+  }
+
+  /// Recomputes the checksum of the stored sections (true if the file has
+  /// none)
+  bool verify_checksum() const {
+    const CrsBinaryHeader *h = checked_header();
+    if (!(h->flags & CRS_BINARY_CHECKSUM)) return true;
+    const uint64_t offsets[3] = {h->rowmap_offset, h->entries_offset,
+                                 h->values_offset};
+    uint64_t checksum = 0;
+    for (int i = 0; i < 3; i++) {
+      const uint64_t c =
+          crs_binary_checksum(file.data() + offsets[i], stored_bytes(i));
+      checksum = i == 0 ? c : crs_binary_mix(checksum ^ c);
+    }
+    return checksum == h->checksum;
+  }
+
+  /// True if the sections can be used in place as the views of a crsMat_t
+  template <typename crsMat_t>
+  bool can_view() const {
+    using offset_t = typename crsMat_t::non_const_size_type;
+    using lno_t    = typename crsMat_t::non_const_ordinal_type;
+    using scalar_t = typename crsMat_t::non_const_value_type;
+
+    const CrsBinaryHeader *h = checked_header();
+    return std::is_same<typename crsMat_t::memory_space,
+                        Kokkos::HostSpace>::value &&
+           !(h->flags & CRS_BINARY_COMPRESSED) &&
+           h->offset_size == sizeof(offset_t) &&
+           h->ordinal_size == sizeof(lno_t) &&
+           h->scalar_size == sizeof(scalar_t) &&
+           h->scalar_kind ==
+               static_cast<uint32_t>(crs_binary_scalar_kind<scalar_t>());
+  }
+
+  /// Wraps the sections of the file, without copying them.
+  template <typename crsMat_t>
+  crsMat_t view() {
+    using graph_t   = typename crsMat_t::StaticCrsGraphType;
+    using row_map_t = typename graph_t::row_map_type;
+    using entries_t = typename graph_t::entries_type;
+    using values_t  = typename crsMat_t::values_type;
+    using lno_t     = typename crsMat_t::non_const_ordinal_type;
+    if (!can_view<crsMat_t>()) {
+      throw std::runtime_error(
+          "CrsBinaryFile::view: the matrix type does not match the file, use "
+          "copy() instead");
+    }
+    check_dimensions<lno_t>();
+    char *base = file.mutable_data();
+    row_map_t rowmap(reinterpret_cast<typename row_map_t::value_type *>(
+                         base + header->rowmap_offset),
+                     header->num_rows + 1);
+    entries_t entries(reinterpret_cast<typename entries_t::value_type *>(
+                          base + header->entries_offset),
+                      header->nnz);
+    values_t values(reinterpret_cast<typename values_t::value_type *>(
+                        base + header->values_offset),
+                    header->nnz);
+    graph_t graph(entries, rowmap);
+    return crsMat_t("CrsMatrix", lno_t(header->num_cols), values, graph);
+  }
+
+  /// Copies (and converts if needed) the sections into new views.
+  template <typename crsMat_t>
+  crsMat_t copy() const {
+    using graph_t        = typename crsMat_t::StaticCrsGraphType;
+    using row_map_view_t = typename graph_t::row_map_type::non_const_type;
+    using cols_view_t    = typename graph_t::entries_type::non_const_type;
+    using values_view_t  = typename crsMat_t::values_type::non_const_type;
+    using lno_t          = typename crsMat_t::non_const_ordinal_type;
+
+    const CrsBinaryHeader *h = checked_header();
+    check_dimensions<lno_t>();
+    if (!verify_checksum()) {
+      throw std::runtime_error("CrsBinaryFile: checksum mismatch");
+    }
+    std::vector<char> buffers[3];
+    const char *rowmap_src  = section(0, buffers[0]);
+    const char *entries_src = section(1, buffers[1]);
+    const char *values_src  = section(2, buffers[2]);
+
+    row_map_view_t rowmap_view(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "rowmap_view"),
+        h->num_rows + 1);
+    cols_view_t columns_view(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "colsmap_view"),
+        h->nnz);
+    values_view_t values_view(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "values_view"),
+        h->nnz);
+    auto h_rowmap  = Kokkos::create_mirror_view(rowmap_view);
+    auto h_columns = Kokkos::create_mirror_view(columns_view);
+    auto h_values  = Kokkos::create_mirror_view(values_view);
+    crs_binary_convert_integers(rowmap_src, h->offset_size, h->num_rows + 1,
+                                h_rowmap.data());
+    crs_binary_convert_integers(entries_src, h->ordinal_size, h->nnz,
+                                h_columns.data());
+    crs_binary_convert_scalars(values_src,
+                               static_cast<CrsBinaryScalarKind>(h->scalar_kind),
+                               h->scalar_size, h->nnz, h_values.data());
+    Kokkos::deep_copy(rowmap_view, h_rowmap);
+    Kokkos::deep_copy(columns_view, h_columns);
+    Kokkos::deep_copy(values_view, h_values);
+
+    graph_t static_graph(columns_view, rowmap_view);
+    return crsMat_t("CrsMatrix", lno_t(h->num_cols), values_view,
+                    static_graph);
+  }
+
+  /// view() when possible, copy() otherwise
+  template <typename crsMat_t>
+  crsMat_t matrix() {
+    return can_view<crsMat_t>() ? view<crsMat_t>() : copy<crsMat_t>();
+  }
+
+ private:
+  const CrsBinaryHeader *checked_header() const {
+    if (!header) {
+      throw std::runtime_error("CrsBinaryFile: no file is open");
+    }
+    return header;
+  }
+
+  // size of section i, before compression
+  uint64_t raw_bytes(int i) const {
+    return i == 0 ? (header->num_rows + 1) * header->offset_size
+                  : header->nnz * (i == 1 ? header->ordinal_size
+                                          : header->scalar_size);
+  }
+
+  // size of section i in the file
+  uint64_t stored_bytes(int i) const {
+    if (!(header->flags & CRS_BINARY_COMPRESSED)) return raw_bytes(i);
+    return i == 0 ? header->rowmap_bytes
+                  : (i == 1 ? header->entries_bytes : header->values_bytes);
+  }
+
+  // the raw bytes of section i, decompressed into buffer if needed
+  const char *section(int i, std::vector<char> &buffer) const {
+    const uint64_t offsets[3] = {header->rowmap_offset, header->entries_offset,
+                                 header->values_offset};
+    const char *src = file.data() + offsets[i];
+    if (!(header->flags & CRS_BINARY_COMPRESSED)) return src;
+    if (!codec || codec->id() != header->codec) {
+      throw std::runtime_error(
+          "CrsBinaryFile: the file is compressed, set_codec() must be given "
+          "the codec it was written with");
+    }
+    buffer.resize(raw_bytes(i));
+    codec->decompress(src, stored_bytes(i), buffer.data(), buffer.size());
+    return buffer.data();
+  }
+
+  template <typename lno_t>
+  void check_dimensions() const {
+    if (header->num_rows > uint64_t(std::numeric_limits<lno_t>::max()) ||
+        header->num_cols > uint64_t(std::numeric_limits<lno_t>::max())) {
+      throw std::runtime_error(
+          "CrsBinaryFile: the dimensions do not fit in the ordinal type");
+    }
+  }
+
+  KokkosKernels::Impl::MappedFile file;
+  const CrsBinaryHeader *header = nullptr;
+  const CrsBinaryCodec *codec   = nullptr;
+};
+
+/// @brief Reads a .kkb file into a newly allocated CrsMatrix.
+template <typename crsMat_t>
+crsMat_t read_crs_binary(const std::string &filename,
+                         const CrsBinaryCodec *codec = nullptr) {
+  CrsBinaryFile file(filename);
+  file.set_codec(codec);
+  return file.copy<crsMat_t>();
+}
+
+}  // namespace Impl
+}  // namespace KokkosSparse
+
+#endif  // _KOKKOSSPARSE_CRSBINARY_HPP
@@ -0,0 +1,316 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+/// \file KokkosSparse_Csr5Matrix.hpp
+/// \brief Local sparse matrix interface
+///
+/// This file provides KokkosSparse::Experimental::Csr5Matrix, a tiled,
+/// load-balanced copy of a CrsMatrix for repeated sparse matrix-vector
+/// products.
+
+#ifndef KOKKOS_SPARSE_CSR5MATRIX_HPP_
+#define KOKKOS_SPARSE_CSR5MATRIX_HPP_
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Kokkos_Core.hpp"
+#include "KokkosKernels_Error.hpp"
+#include "KokkosKernels_ExecSpaceUtils.hpp"
+#include "KokkosBlas1_scal.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_Csr5Matrix_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+/// \class Csr5Matrix
+///
+/// \brief CSR5-like tiled copy of a CrsMatrix.
+///
+/// The merge path of the row ends and the entries of the matrix (see
+/// KokkosSparse_merge_matrix.hpp) is cut into segments of segmentLength()
+/// steps, so that every segment has the same amount of work whatever the
+/// row lengths. The positions of the segments on the path (the tile
+/// descriptors) are computed once by the constructor, whereas the merge-path
+/// spmv searches them on every call.
+///
+/// lanes() consecutive segments form a tile. Within a tile, the entries are
+/// stored column-major: the m-th entries of the segments of the tile are
+/// contiguous, so that the threads of a warp (on GPUs) read contiguous
+/// memory. On CPUs, a tile is a single segment and its entries are
+/// contiguous. The storage takes at most numRows() + nnz() + lanes() *
+/// segmentLength() entries.
+///
+/// spmv processes one segment per thread. The rows that start and end in a
+/// segment are written without atomics; only the rows shared by several
+/// segments use atomics.
+///
+/// \tparam ScalarType The type of scalar entries in the sparse matrix.
+/// \tparam OrdinalType The type of index entries in the sparse matrix.
+/// \tparam Device The Kokkos Device type.
+/// \tparam SizeType The type of row offsets.
+template <class ScalarType, class OrdinalType, class Device,
+          class SizeType = typename Kokkos::ViewTraits<OrdinalType*, Device,
+                                                       void, void>::size_type>
+class Csr5Matrix {
+ public:
+  //! Type of each value in the matrix
+  using scalar_type = ScalarType;
+  //! Non constant scalar type
+  using non_const_scalar_type = std::remove_const_t<scalar_type>;
+  //! Type of each index in the matrix
+  using ordinal_type = OrdinalType;
+  //! Type of the Kokkos::Device
+  using device_type = Device;
+  //! Type of the Kokkos::Device::execution_space
+  using execution_space = typename device_type::execution_space;
+  //! Type of the Kokkos::Device::memory_space
+  using memory_space = typename device_type::memory_space;
+  //! Type of row offsets
+  using size_type = SizeType;
+
+  //! The type of the row offsets (shared with the CrsMatrix)
+  using row_map_type = Kokkos::View<const size_type*, device_type>;
+  //! The type of the tile descriptors
+  using segments_type = Kokkos::View<size_type*, device_type>;
+  //! The type of the column indices, in tile order
+  using index_type = Kokkos::View<ordinal_type*, device_type>;
+  //! The type of the values, in tile order
+  using values_type = Kokkos::View<scalar_type*, device_type>;
+
+  //! Row offsets of the matrix
+  row_map_type row_map;
+  //! First row of every segment, plus numRows()
+  segments_type seg_rows;
+  //! First entry of every segment, plus nnz()
+  segments_type seg_nnz;
+  //! Column indices, in tile order
+  index_type tile_entries;
+  //! Values, in tile order
+  values_type tile_values;
+
+ private:
+  ordinal_type m_num_rows, m_num_cols;
+  size_type m_nnz, m_lanes, m_seg_length;
+
+ public:
+  /// \brief Default constructor; constructs an empty sparse matrix.
+  Csr5Matrix()
+      : m_num_rows(0), m_num_cols(0), m_nnz(0), m_lanes(1), m_seg_length(1) {}
+
+  /// \brief Constructor from a CrsMatrix (deep copy of the entries and
+  /// values; the row offsets are shared).
+  ///
+  /// \param A [in] The matrix.
+  /// \param lanes [in] The number of segments per tile. If negative, 32 on
+  ///   GPUs and 1 otherwise.
+  /// \param seg_length [in] The number of merge path steps per segment. If
+  ///   negative, 16 on GPUs, and on CPUs enough for about 8 segments per
+  ///   thread.
+  template <typename CrsMatrixType,
+            typename std::enable_if<KokkosSparse::is_crs_matrix<
+                CrsMatrixType>::value>::type* = nullptr>
+  explicit Csr5Matrix(const CrsMatrixType& A, int64_t lanes = -1,
+                      int64_t seg_length = -1)
+      : row_map(A.graph.row_map),
+        m_num_rows(A.numRows()),
+        m_num_cols(A.numCols()),
+        m_nnz(A.nnz()) {
+    using range_t = Kokkos::RangePolicy<execution_space>;
+    constexpr bool is_gpu =
+        KokkosKernels::Impl::kk_is_gpu_exec_space<execution_space>();
+    execution_space exec;
+    const size_type pathLength = size_type(m_num_rows) + m_nnz;
+    if (lanes < 0) lanes = is_gpu ? 32 : 1;
+    if (seg_length < 0) {
+      seg_length = is_gpu ? 16
+                          : std::max<int64_t>(
+                                64, (pathLength + 8 * exec.concurrency() - 1) /
+                                        (8 * exec.concurrency()));
+    }
+    if (lanes == 0 || seg_length == 0) {
+      throw std::invalid_argument(
+          "Csr5Matrix: lanes and seg_length must be positive");
+    }
+    m_lanes      = lanes;
+    m_seg_length = seg_length;
+
+    const size_type numSegs  = (pathLength + m_seg_length - 1) / m_seg_length;
+    const size_type numTiles = (numSegs + m_lanes - 1) / m_lanes;
+    seg_rows     = segments_type("Csr5Matrix segment rows", numSegs + 1);
+    seg_nnz      = segments_type("Csr5Matrix segment entries", numSegs + 1);
+    tile_entries = index_type("Csr5Matrix entries",
+                              numTiles * m_lanes * m_seg_length);
+    tile_values  = values_type("Csr5Matrix values",
+                              numTiles * m_lanes * m_seg_length);
+    if (m_num_rows == 0) return;
+    Kokkos::parallel_for(
+        "KokkosSparse::Csr5Matrix::segments", range_t(exec, 0, numSegs + 1),
+        KokkosSparse::Impl::Csr5SegmentsFunctor<row_map_type, segments_type>{
+            row_map, seg_rows, seg_nnz, m_seg_length});
+    fill(exec, A, false);
+  }
+
+  /// \brief Copies the values of A, which must have the pattern of the
+  /// matrix this was constructed from. The tile descriptors are reused.
+  template <typename CrsMatrixType,
+            typename std::enable_if<KokkosSparse::is_crs_matrix<
+                CrsMatrixType>::value>::type* = nullptr>
+  void update_values(const CrsMatrixType& A) {
+    if (A.numRows() != m_num_rows || size_type(A.nnz()) != m_nnz) {
+      throw std::invalid_argument(
+          "Csr5Matrix::update_values: A does not have the pattern of the "
+          "matrix");
+    }
+    execution_space exec;
+    fill(exec, A, true);
+  }
+
+  //! The number of rows in the sparse matrix.
+  KOKKOS_INLINE_FUNCTION ordinal_type numRows() const { return m_num_rows; }
+
+  //! The number of columns in the sparse matrix.
+  KOKKOS_INLINE_FUNCTION ordinal_type numCols() const { return m_num_cols; }
+
+  //! The number of entries in the sparse matrix.
+  KOKKOS_INLINE_FUNCTION size_type nnz() const { return m_nnz; }
+
+  //! The number of segments per tile.
+  KOKKOS_INLINE_FUNCTION size_type lanes() const { return m_lanes; }
+
+  //! The number of merge path steps per segment.
+  KOKKOS_INLINE_FUNCTION size_type segmentLength() const {
+    return m_seg_length;
+  }
+
+  //! The number of segments.
+  KOKKOS_INLINE_FUNCTION size_type numSegments() const {
+    return seg_rows.extent(0) - 1;
+  }
+
+ private:
+  template <typename CrsMatrixType>
+  void fill(const execution_space& exec, const CrsMatrixType& A,
+            bool valuesOnly) {
+    Kokkos::parallel_for(
+        "KokkosSparse::Csr5Matrix::fill",
+        Kokkos::RangePolicy<execution_space>(exec, 0, numSegments()),
+        KokkosSparse::Impl::Csr5FillFunctor<
+            segments_type, typename CrsMatrixType::index_type,
+            typename CrsMatrixType::values_type, index_type, values_type>{
+            seg_nnz, A.graph.entries, A.values, tile_entries, tile_values,
+            m_lanes, m_seg_length, valuesOnly});
+    exec.fence();
+  }
+};
+
+/// \class is_csr5_matrix
+/// \brief is_csr5_matrix<T>::value is true if T is a Csr5Matrix<...>, false
+/// otherwise
+template <typename>
+struct is_csr5_matrix : public std::false_type {};
+template <typename... P>
+struct is_csr5_matrix<Csr5Matrix<P...>> : public std::true_type {};
+template <typename... P>
+struct is_csr5_matrix<const Csr5Matrix<P...>> : public std::true_type {};
+
+/// \brief y := beta * y + alpha * op(A) * x, for a Csr5Matrix A.
+///
+/// \param space [in] The execution space instance on which to run.
+/// \param mode [in] "N" for no transpose, "C" for conjugate.
+/// \param alpha [in] Scalar multiplier for the matrix A.
+/// \param A [in] The sparse matrix A.
+/// \param x [in] A vector to multiply on the left by A.
+/// \param beta [in] Scalar multiplier for the vector y.
+/// \param y [in/out] Result vector.
+template <class ExecutionSpace, class AlphaType, class AMatrix, class XVector,
+          class BetaType, class YVector,
+          typename std::enable_if<is_csr5_matrix<AMatrix>::value>::type* =
+              nullptr>
+void spmv(const ExecutionSpace& space, const char mode[],
+          const AlphaType& alpha, const AMatrix& A, const XVector& x,
+          const BetaType& beta, const YVector& y) {
+  static_assert(Kokkos::is_view<XVector>::value && XVector::rank == 1,
+                "KokkosSparse::Experimental::spmv (Csr5Matrix): x must be a "
+                "rank-1 Kokkos::View.");
+  static_assert(Kokkos::is_view<YVector>::value && YVector::rank == 1,
+                "KokkosSparse::Experimental::spmv (Csr5Matrix): y must be a "
+                "rank-1 Kokkos::View.");
+  static_assert(
+      std::is_same<typename YVector::value_type,
+                   typename YVector::non_const_value_type>::value,
+      "KokkosSparse::Experimental::spmv (Csr5Matrix): y must be nonconst.");
+  if (mode[0] != NoTranspose[0] && mode[0] != Conjugate[0]) {
+    KokkosKernels::Impl::throw_runtime_exception(
+        "KokkosSparse::Experimental::spmv (Csr5Matrix): only modes \"N\" and "
+        "\"C\" are supported.");
+  }
+  if (x.extent(0) != size_t(A.numCols()) ||
+      y.extent(0) != size_t(A.numRows())) {
+    std::ostringstream os;
+    os << "KokkosSparse::Experimental::spmv (Csr5Matrix): Dimensions do not "
+          "match: A is "
+       << A.numRows() << " x " << A.numCols() << ", x is " << x.extent(0)
+       << ", y is " << y.extent(0) << ".";
+    KokkosKernels::Impl::throw_runtime_exception(os.str());
+  }
+  using scalar_t  = typename AMatrix::non_const_scalar_type;
+  using range_t   = Kokkos::RangePolicy<ExecutionSpace>;
+  using row_map_t = typename AMatrix::row_map_type;
+  using seg_t     = typename AMatrix::segments_type;
+  using index_t   = typename AMatrix::index_type;
+  using values_t  = typename AMatrix::values_type;
+
+  KokkosBlas::scal(space, y, scalar_t(beta), y);
+  if (A.numSegments() == 0) return;
+  range_t policy(space, 0, A.numSegments());
+  if (mode[0] == NoTranspose[0]) {
+    Kokkos::parallel_for(
+        "KokkosSparse::spmv<Csr5>", policy,
+        KokkosSparse::Impl::Csr5SpmvFunctor<row_map_t, seg_t, index_t,
+                                            values_t, XVector, YVector,
+                                            scalar_t, false>{
+            A.row_map, A.seg_rows, A.seg_nnz, A.tile_entries, A.tile_values,
+            x, y, scalar_t(alpha), A.lanes(), A.segmentLength()});
+  } else {
+    Kokkos::parallel_for(
+        "KokkosSparse::spmv<Csr5>", policy,
+        KokkosSparse::Impl::Csr5SpmvFunctor<row_map_t, seg_t, index_t,
+                                            values_t, XVector, YVector,
+                                            scalar_t, true>{
+            A.row_map, A.seg_rows, A.seg_nnz, A.tile_entries, A.tile_values,
+            x, y, scalar_t(alpha), A.lanes(), A.segmentLength()});
+  }
+}
+
+/// \brief y := beta * y + alpha * op(A) * x, for a Csr5Matrix A, on the
+/// default instance of the execution space of A.
+template <class AlphaType, class AMatrix, class XVector, class BetaType,
+          class YVector,
+          typename std::enable_if<is_csr5_matrix<AMatrix>::value>::type* =
+              nullptr>
+void spmv(const char mode[], const AlphaType& alpha, const AMatrix& A,
+          const XVector& x, const BetaType& beta, const YVector& y) {
+  spmv(typename AMatrix::execution_space{}, mode, alpha, A, x, beta, y);
+}
+
+}  // namespace Experimental
+}  // namespace KokkosSparse
+
+#endif  // KOKKOS_SPARSE_CSR5MATRIX_HPP_
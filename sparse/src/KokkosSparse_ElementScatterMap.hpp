@@ -0,0 +1,218 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSSPARSE_ELEMENTSCATTERMAP_HPP
+#define _KOKKOSSPARSE_ELEMENTSCATTERMAP_HPP
+
+/// \file KokkosSparse_ElementScatterMap.hpp
+/// \brief Assembly of element matrices into a CrsMatrix with a fixed
+///        pattern, through offsets computed once.
+
+#include <stdexcept>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosKernels_Handle.hpp"
+#include "KokkosGraph_Distance2Color.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_ElementScatterMap_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+/// \class ElementScatterMap
+/// \brief Scatter of element matrices into the values of a CrsMatrix.
+///
+/// Element e couples the nodes elem_nodes(e, 0), ..., elem_nodes(e, n - 1):
+/// its matrix elem_mats(e, a, b) is summed into the entry (elem_nodes(e, a),
+/// elem_nodes(e, b)) of the matrix. CrsMatrix::sumIntoValues searches the
+/// row for every entry; here the position of every entry in the values is
+/// computed once by the constructor, and assemble() only adds values.
+///
+/// By default the additions are atomic. After color_elements(), the elements
+/// are assembled one color at a time, and two elements of the same color
+/// never share a node, so that no atomics are needed.
+///
+/// Entries of the element matrices that are not in the pattern of the
+/// matrix are counted by get_num_missing(), and ignored by assemble().
+///
+/// \tparam CrsMatrixType The type of the matrix
+template <typename CrsMatrixType>
+class ElementScatterMap {
+ public:
+  using crsMat_t        = CrsMatrixType;
+  using execution_space = typename crsMat_t::execution_space;
+  using memory_space    = typename crsMat_t::memory_space;
+  using device_t        = typename crsMat_t::device_type;
+  using scalar_t        = typename crsMat_t::non_const_value_type;
+  using lno_t           = typename crsMat_t::non_const_ordinal_type;
+  using size_type       = typename crsMat_t::non_const_size_type;
+  using elem_nodes_t    = Kokkos::View<const lno_t **, device_t>;
+  using offsets_t       = Kokkos::View<size_type **, device_t>;
+  using elems_t         = Kokkos::View<lno_t *, device_t>;
+
+  /// \param A_ [in] The matrix; its pattern contains the couplings of the
+  ///   elements, and its rows do not need to be sorted.
+  /// \param elem_nodes_ [in] num_elems x nodes_per_elem connectivity.
+  ElementScatterMap(const crsMat_t &A_, const elem_nodes_t &elem_nodes_)
+      : A(A_),
+        elem_nodes(elem_nodes_),
+        offsets(Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                                   "ElementScatterMap offsets"),
+                elem_nodes_.extent(0),
+                elem_nodes_.extent(1) * elem_nodes_.extent(1)),
+        elems(Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                                 "ElementScatterMap elements"),
+              elem_nodes_.extent(0)) {
+    const lno_t num_elems = elem_nodes.extent(0);
+    num_missing           = 0;
+    Kokkos::parallel_reduce(
+        "KokkosSparse::ElementScatterMap::offsets",
+        Kokkos::RangePolicy<execution_space>(0, num_elems),
+        KokkosSparse::Impl::ElementScatterOffsetsFunctor<
+            typename crsMat_t::row_map_type, typename crsMat_t::index_type,
+            elem_nodes_t, offsets_t>{A.graph.row_map, A.graph.entries,
+                                     elem_nodes, offsets, invalid()},
+        num_missing);
+    elems_t elems_ = elems;
+    Kokkos::parallel_for(
+        "KokkosSparse::ElementScatterMap::identity",
+        Kokkos::RangePolicy<execution_space>(0, num_elems),
+        KOKKOS_LAMBDA(const lno_t e) { elems_(e) = e; });
+    color_begin = {0, num_elems};
+  }
+
+  /// \brief Number of entries of the element matrices that are not in the
+  /// pattern of the matrix.
+  size_t get_num_missing() const { return num_missing; }
+
+  /// \brief Number of groups of elements assembled one after the other (1
+  /// before color_elements()).
+  size_t get_num_colors() const { return color_begin.size() - 1; }
+
+  /// \brief Colors the elements so that elements sharing a node have
+  /// different colors (distance-2 coloring of the element-node graph), and
+  /// orders them by color. assemble() then uses no atomics.
+  void color_elements() {
+    using handle_t = KokkosKernels::Experimental::KokkosKernelsHandle<
+        size_type, lno_t, scalar_t, execution_space, memory_space,
+        memory_space>;
+    using rowmap_t = Kokkos::View<size_type *, device_t>;
+
+    const lno_t num_elems = elem_nodes.extent(0);
+    const lno_t n         = elem_nodes.extent(1);
+    rowmap_t rowmap(Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                                       "ElementScatterMap rowmap"),
+                    num_elems + 1);
+    elems_t entries(Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                                       "ElementScatterMap entries"),
+                    size_t(num_elems) * n);
+    elem_nodes_t elem_nodes_ = elem_nodes;
+    Kokkos::parallel_for(
+        "KokkosSparse::ElementScatterMap::element_graph",
+        Kokkos::RangePolicy<execution_space>(0, num_elems + 1),
+        KOKKOS_LAMBDA(const lno_t e) {
+          rowmap(e) = size_type(e) * n;
+          if (e == num_elems) return;
+          for (lno_t a = 0; a < n; a++) {
+            entries(size_type(e) * n + a) = elem_nodes_(e, a);
+          }
+        });
+
+    handle_t kh;
+    kh.create_distance2_graph_coloring_handle();
+    KokkosGraph::Experimental::bipartite_color_rows(&kh, num_elems, A.numRows(),
+                                                    rowmap, entries);
+    auto colors = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(),
+        kh.get_distance2_graph_coloring_handle()->get_vertex_colors());
+    const lno_t num_colors =
+        kh.get_distance2_graph_coloring_handle()->get_num_colors();
+    kh.destroy_distance2_graph_coloring_handle();
+
+    // counting sort of the elements by color (colors start at 1)
+    color_begin.assign(num_colors + 1, 0);
+    for (lno_t e = 0; e < num_elems; e++) color_begin[colors(e)]++;
+    for (lno_t c = 0; c < num_colors; c++) {
+      color_begin[c + 1] += color_begin[c];
+    }
+    auto h_elems = Kokkos::create_mirror_view(elems);
+    std::vector<lno_t> cursor(color_begin.begin(), color_begin.end() - 1);
+    for (lno_t e = 0; e < num_elems; e++) {
+      h_elems(cursor[colors(e) - 1]++) = e;
+    }
+    Kokkos::deep_copy(elems, h_elems);
+    colored = true;
+  }
+
+  /// \brief Sums the element matrices elem_mats(e, a, b), of dimensions
+  /// num_elems x nodes_per_elem x nodes_per_elem, into the matrix. The
+  /// previous values are overwritten, unless accumulate is true.
+  template <typename ElemMatsType>
+  void assemble(const ElemMatsType &elem_mats, bool accumulate = false) {
+    static_assert(ElemMatsType::rank == 3,
+                  "ElementScatterMap::assemble: elem_mats must be of rank 3");
+    if (elem_mats.extent(0) != elem_nodes.extent(0) ||
+        elem_mats.extent(1) != elem_nodes.extent(1) ||
+        elem_mats.extent(2) != elem_nodes.extent(1)) {
+      throw std::invalid_argument(
+          "ElementScatterMap::assemble: elem_mats must be num_elems x "
+          "nodes_per_elem x nodes_per_elem");
+    }
+    using values_t = typename crsMat_t::values_type;
+    using policy_t = Kokkos::RangePolicy<execution_space>;
+    if (!accumulate) Kokkos::deep_copy(A.values, scalar_t());
+    if (!colored) {
+      Kokkos::parallel_for(
+          "KokkosSparse::ElementScatterMap::assemble_atomic",
+          policy_t(0, elems.extent(0)),
+          KokkosSparse::Impl::ElementScatterAssembleFunctor<
+              values_t, offsets_t, elems_t, ElemMatsType, true>{
+              A.values, offsets, elems, elem_mats, invalid()});
+      return;
+    }
+    for (size_t c = 0; c < get_num_colors(); c++) {
+      auto color_elems = Kokkos::subview(
+          elems, Kokkos::make_pair(color_begin[c], color_begin[c + 1]));
+      Kokkos::parallel_for(
+          "KokkosSparse::ElementScatterMap::assemble_color",
+          policy_t(0, color_elems.extent(0)),
+          KokkosSparse::Impl::ElementScatterAssembleFunctor<
+              values_t, offsets_t, decltype(color_elems), ElemMatsType,
+              false>{A.values, offsets, color_elems, elem_mats, invalid()});
+    }
+  }
+
+ private:
+  static size_type invalid() {
+    return Kokkos::ArithTraits<size_type>::max();
+  }
+
+  crsMat_t A;
+  elem_nodes_t elem_nodes;
+  offsets_t offsets;
+  // elements, ordered by color once colored
+  elems_t elems;
+  std::vector<lno_t> color_begin;
+  bool colored = false;
+  size_t num_missing;
+};
+
+}  // namespace Experimental
+}  // namespace KokkosSparse
+
+#endif  // _KOKKOSSPARSE_ELEMENTSCATTERMAP_HPP
@@ -0,0 +1,190 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+/// @file KokkosSparse_FSAIPrec.hpp
+
+#ifndef KK_FSAI_PREC_HPP
+#define KK_FSAI_PREC_HPP
+
+#include <KokkosSparse_Preconditioner.hpp>
+#include <Kokkos_Core.hpp>
+#include <KokkosKernels_Error.hpp>
+#include <KokkosKernels_SimpleUtils.hpp>
+#include <KokkosSparse_spmv.hpp>
+#include <KokkosSparse_Utils.hpp>
+#include "KokkosSparse_fsai_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+/// \class FSAIPrec
+/// \brief  Factored sparse approximate inverse (FSAI) preconditioner for
+///         symmetric positive definite matrices.
+///         It computes a lower triangular G with the pattern of the lower
+///         triangle of A, such that G^T G ~ A^inv, and the apply method
+///         returns G^T G x using two spmv (no triangular solves).
+/// \tparam CRS the CRS type of A
+///
+/// FSAIPrec provides the following methods
+///   - initialize() Builds the pattern of G.
+///   - isInitialized() returns true once initialize() has been called
+///   - compute() Computes the values of G, solving one small dense system
+///     per row with KokkosBatched::TeamLU.
+///   - isComputed() returns true once compute() has been called
+///
+template <class CRS>
+class FSAIPrec : public KokkosSparse::Experimental::Preconditioner<CRS> {
+ public:
+  using ScalarType = typename std::remove_const<typename CRS::value_type>::type;
+  using EXSP       = typename CRS::execution_space;
+  using MEMSP      = typename CRS::memory_space;
+  using karith     = typename Kokkos::ArithTraits<ScalarType>;
+  using View1d = typename Kokkos::View<ScalarType *, typename CRS::device_type>;
+  using lno_t  = typename CRS::non_const_ordinal_type;
+  using size_type = typename CRS::non_const_size_type;
+  using rowmap_t  = typename CRS::row_map_type::non_const_type;
+  using entries_t = typename CRS::index_type::non_const_type;
+  using values_t  = typename CRS::values_type::non_const_type;
+  using matrix_t  = KokkosSparse::CrsMatrix<ScalarType, lno_t,
+                                           typename CRS::device_type, void,
+                                           size_type>;
+
+ private:
+  CRS _A;
+  matrix_t _G, _Gt;
+  lno_t _max_row_length;
+  View1d _tmp;
+  bool _initialized, _computed;
+
+ public:
+  //! Constructor:
+  template <class CRSArg>
+  FSAIPrec(const CRSArg &A)
+      : _A(A),
+        _max_row_length(0),
+        _tmp("FSAIPrec::_tmp", A.numRows()),
+        _initialized(false),
+        _computed(false) {
+    KK_REQUIRE_MSG(A.numRows() == A.numCols(), "FSAIPrec: A must be square");
+  }
+
+  //! Destructor.
+  virtual ~FSAIPrec() {}
+
+  ///// \brief Apply the preconditioner to X, putting the result in Y.
+  /////
+  ///// \tparam XViewType Input vector, as a 1-D Kokkos::View
+  ///// \tparam YViewType Output vector, as a nonconst 1-D Kokkos::View
+  /////
+  ///// \param transM [in] Not used, G^T G is symmetric.
+  ///// \param alpha [in] Input coefficient of M*x
+  ///// \param beta [in] Input coefficient of Y
+  /////
+  ///// It stores beta Y + alpha G^T G X in Y
+  //
+  virtual void apply(
+      const Kokkos::View<const ScalarType *, Kokkos::Device<EXSP, MEMSP>> &X,
+      const Kokkos::View<ScalarType *, Kokkos::Device<EXSP, MEMSP>> &Y,
+      const char transM[] = "N", ScalarType alpha = karith::one(),
+      ScalarType beta = karith::zero()) const {
+    (void)transM;
+    KK_REQUIRE_MSG(_computed, "FSAIPrec::apply: compute() was not called");
+    KokkosSparse::spmv("N", karith::one(), _G, X, karith::zero(), _tmp);
+    KokkosSparse::spmv("N", alpha, _Gt, _tmp, beta, Y);
+  }
+  //@}
+
+  //! Set this preconditioner's parameters.
+  void setParameters() {}
+
+  void initialize() {
+    using policy_t = Kokkos::RangePolicy<EXSP>;
+    const lno_t nrows = _A.numRows();
+
+    rowmap_t G_rowmap("FSAIPrec::G_rowmap", nrows + 1);
+    Kokkos::parallel_for(
+        "KokkosSparse::FSAIPrec::count", policy_t(0, nrows),
+        KokkosSparse::Impl::FSAICountFunctor<
+            typename CRS::row_map_type, typename CRS::index_type, rowmap_t>(
+            _A.graph.row_map, _A.graph.entries, G_rowmap));
+    size_type max_row_length = 0;
+    KokkosKernels::Impl::kk_view_reduce_max<rowmap_t, EXSP>(nrows, G_rowmap,
+                                                            max_row_length);
+    _max_row_length = max_row_length;
+    KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<EXSP>(nrows + 1,
+                                                                 G_rowmap);
+    size_type nnz = 0;
+    Kokkos::deep_copy(nnz, Kokkos::subview(G_rowmap, nrows));
+
+    entries_t G_entries(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "FSAIPrec::G_entries"),
+        nnz);
+    Kokkos::parallel_for(
+        "KokkosSparse::FSAIPrec::fill", policy_t(0, nrows),
+        KokkosSparse::Impl::FSAIFillFunctor<typename CRS::row_map_type,
+                                            typename CRS::index_type, rowmap_t,
+                                            entries_t>(
+            _A.graph.row_map, _A.graph.entries, G_rowmap, G_entries));
+    values_t G_values("FSAIPrec::G_values", nnz);
+    _G           = matrix_t("FSAIPrec::G", nrows, nrows, nnz, G_values,
+                  G_rowmap, G_entries);
+    _initialized = true;
+    _computed    = false;
+  }
+
+  //! True if the preconditioner has been successfully initialized, else false.
+  bool isInitialized() const { return _initialized; }
+
+  void compute() {
+    if (!_initialized) initialize();
+    using functor_t = KokkosSparse::Impl::FSAINumericFunctor<
+        EXSP, typename CRS::row_map_type, typename CRS::index_type,
+        typename CRS::values_type, rowmap_t, entries_t, values_t>;
+    using team_policy_t = typename functor_t::team_policy;
+
+    const lno_t nrows = _A.numRows();
+    if (nrows > 0) {
+      // level 0 scratch is small on GPUs, fall back to level 1 when the
+      // longest row does not fit in it
+      const size_t scratch = functor_t::team_scratch_size(_max_row_length);
+      const size_t max_l0  = team_policy_t::scratch_size_max(0);
+      const int level      = scratch <= max_l0 ? 0 : 1;
+      team_policy_t policy(nrows, Kokkos::AUTO);
+      policy.set_scratch_size(level, Kokkos::PerTeam(scratch));
+      Kokkos::parallel_for(
+          "KokkosSparse::FSAIPrec::compute", policy,
+          functor_t(_A.graph.row_map, _A.graph.entries, _A.values,
+                    _G.graph.row_map, _G.graph.entries, _G.values,
+                    _max_row_length, level));
+    }
+    _Gt       = KokkosSparse::Impl::transpose_matrix(_G);
+    _computed = true;
+  }
+
+  //! True if the preconditioner has been successfully computed, else false.
+  bool isComputed() const { return _computed; }
+
+  //! True if the preconditioner implements a transpose operator apply.
+  bool hasTransposeApply() const { return true; }
+
+  //! The lower triangular factor G, valid after compute().
+  matrix_t getG() const { return _G; }
+};
+
+}  // namespace Experimental
+}  // End namespace KokkosSparse
+
+#endif
@@ -0,0 +1,316 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+/// \file KokkosSparse_HybMatrix.hpp
+/// \brief Local sparse matrix interface
+///
+/// This file provides KokkosSparse::Experimental::HybMatrix. This implements
+/// a local (no MPI) sparse matrix stored in the hybrid ELL + COO ("Hyb")
+/// format.
+
+#ifndef KOKKOS_SPARSE_HYBMATRIX_HPP_
+#define KOKKOS_SPARSE_HYBMATRIX_HPP_
+
+#include <sstream>
+#include <type_traits>
+
+#include "Kokkos_Core.hpp"
+#include "KokkosKernels_Error.hpp"
+#include "KokkosKernels_SimpleUtils.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_HybMatrix_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+/// \class HybMatrix
+///
+/// \brief Hybrid ELL + COO implementation of a sparse matrix.
+///
+/// The first ellWidth() entries of every row are stored in the ELL part: two
+/// numRows() x ellWidth() column-major arrays of column indices and values.
+/// Rows with fewer entries are padded with the column index -1 and the value
+/// 0. The entries that do not fit are stored in the COO part, as (row,
+/// column, value) triples sorted by row.
+///
+/// The ELL kernel of spmv is regular (every row does ellWidth() iterations,
+/// and the accesses of consecutive rows are contiguous), and the COO part
+/// holds the few entries of the long rows.
+///
+/// \tparam ScalarType The type of scalar entries in the sparse matrix.
+/// \tparam OrdinalType The type of index entries in the sparse matrix.
+/// \tparam Device The Kokkos Device type.
+/// \tparam SizeType The type of the number of entries.
+template <class ScalarType, class OrdinalType, class Device,
+          class SizeType = typename Kokkos::ViewTraits<OrdinalType*, Device,
+                                                       void, void>::size_type>
+class HybMatrix {
+ public:
+  //! Type of each value in the matrix
+  using scalar_type = ScalarType;
+  //! Non constant scalar type
+  using non_const_scalar_type = std::remove_const_t<scalar_type>;
+  //! Type of each index in the matrix
+  using ordinal_type = OrdinalType;
+  //! Non constant ordinal type
+  using non_const_ordinal_type = std::remove_const_t<ordinal_type>;
+  //! Type of the Kokkos::Device
+  using device_type = Device;
+  //! Type of the Kokkos::Device::execution_space
+  using execution_space = typename device_type::execution_space;
+  //! Type of the Kokkos::Device::memory_space
+  using memory_space = typename device_type::memory_space;
+  //! Type of all integral class members
+  using size_type = SizeType;
+
+  static_assert(std::is_integral_v<OrdinalType>,
+                "OrdinalType must be an integral.");
+
+  //! The type of the column indices of the ELL part (column-major)
+  using ell_index_view =
+      Kokkos::View<ordinal_type**, Kokkos::LayoutLeft, device_type>;
+  //! The type of the values of the ELL part (column-major)
+  using ell_scalar_view =
+      Kokkos::View<scalar_type**, Kokkos::LayoutLeft, device_type>;
+  //! The type of the row and column indices of the COO part
+  using coo_index_view = Kokkos::View<ordinal_type*, device_type>;
+  //! The type of the values of the COO part
+  using coo_scalar_view = Kokkos::View<scalar_type*, device_type>;
+
+  //! Column indices of the ELL part; -1 for padding
+  ell_index_view ell_entries;
+  //! Values of the ELL part; 0 for padding
+  ell_scalar_view ell_values;
+  //! Row indices of the COO part
+  coo_index_view coo_rows;
+  //! Column indices of the COO part
+  coo_index_view coo_cols;
+  //! Values of the COO part
+  coo_scalar_view coo_values;
+
+ private:
+  ordinal_type m_num_rows, m_num_cols;
+  size_type m_nnz;
+
+ public:
+  /// \brief Default constructor; constructs an empty sparse matrix.
+  HybMatrix() : m_num_rows(0), m_num_cols(0), m_nnz(0) {}
+
+  /// \brief Constructor that accepts the views of both parts.
+  ///
+  /// The matrix will store and use the views directly (by view, not by deep
+  /// copy).
+  ///
+  /// \param nrows [in] The number of rows.
+  /// \param ncols [in] The number of columns.
+  /// \param nnz [in] The number of entries, not counting the padding.
+  /// \param ell_entries_ [in] nrows x width column indices of the ELL part.
+  /// \param ell_values_ [in] nrows x width values of the ELL part.
+  /// \param coo_rows_ [in] Row indices of the COO part, sorted.
+  /// \param coo_cols_ [in] Column indices of the COO part.
+  /// \param coo_values_ [in] Values of the COO part.
+  HybMatrix(ordinal_type nrows, ordinal_type ncols, size_type nnz,
+            const ell_index_view& ell_entries_,
+            const ell_scalar_view& ell_values_,
+            const coo_index_view& coo_rows_, const coo_index_view& coo_cols_,
+            const coo_scalar_view& coo_values_)
+      : ell_entries(ell_entries_),
+        ell_values(ell_values_),
+        coo_rows(coo_rows_),
+        coo_cols(coo_cols_),
+        coo_values(coo_values_),
+        m_num_rows(nrows),
+        m_num_cols(ncols),
+        m_nnz(nnz) {
+    if (ell_entries.extent(0) != size_t(nrows) ||
+        ell_values.extent(0) != size_t(nrows) ||
+        ell_entries.extent(1) != ell_values.extent(1) ||
+        coo_rows.extent(0) != coo_values.extent(0) ||
+        coo_cols.extent(0) != coo_values.extent(0)) {
+      std::ostringstream os;
+      os << "HybMatrix: inconsistent extents: ELL entries "
+         << ell_entries.extent(0) << " x " << ell_entries.extent(1)
+         << ", ELL values " << ell_values.extent(0) << " x "
+         << ell_values.extent(1) << ", COO " << coo_rows.extent(0) << ", "
+         << coo_cols.extent(0) << ", " << coo_values.extent(0) << ".";
+      KokkosKernels::Impl::throw_runtime_exception(os.str());
+    }
+  }
+
+  /// \brief Constructor from a CrsMatrix (deep copy).
+  ///
+  /// \param A [in] The matrix.
+  /// \param ell_width [in] The width of the ELL part. If negative, the width
+  ///   is chosen from the histogram of the row lengths of A: a column of the
+  ///   ELL part is stored if at least a third of the rows have an entry in
+  ///   it.
+  template <typename CrsMatrixType,
+            typename std::enable_if<KokkosSparse::is_crs_matrix<
+                CrsMatrixType>::value>::type* = nullptr>
+  explicit HybMatrix(const CrsMatrixType& A, int64_t ell_width = -1)
+      : m_num_rows(A.numRows()), m_num_cols(A.numCols()), m_nnz(A.nnz()) {
+    using range_t   = Kokkos::RangePolicy<execution_space>;
+    using offsets_t = Kokkos::View<size_type*, device_type>;
+    execution_space exec;
+    if (ell_width < 0) {
+      ell_width = KokkosSparse::Impl::hyb_ell_width(exec, A.graph.row_map);
+    }
+    ell_entries = ell_index_view(
+        Kokkos::view_alloc(exec, Kokkos::WithoutInitializing,
+                           "HybMatrix ELL entries"),
+        m_num_rows, ell_width);
+    ell_values = ell_scalar_view(
+        Kokkos::view_alloc(exec, Kokkos::WithoutInitializing,
+                           "HybMatrix ELL values"),
+        m_num_rows, ell_width);
+    offsets_t cooOffsets("HybMatrix COO offsets", m_num_rows + 1);
+    Kokkos::parallel_for(
+        "KokkosSparse::HybMatrix::overflow", range_t(exec, 0, m_num_rows),
+        KokkosSparse::Impl::HybOverflowCountFunctor<
+            typename CrsMatrixType::row_map_type, offsets_t>{
+            A.graph.row_map, cooOffsets, ell_width});
+    size_type cooNnz = 0;
+    KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<execution_space>(
+        exec, m_num_rows + 1, cooOffsets, cooNnz);
+    coo_rows = coo_index_view(
+        Kokkos::view_alloc(exec, Kokkos::WithoutInitializing,
+                           "HybMatrix COO rows"),
+        cooNnz);
+    coo_cols = coo_index_view(
+        Kokkos::view_alloc(exec, Kokkos::WithoutInitializing,
+                           "HybMatrix COO cols"),
+        cooNnz);
+    coo_values = coo_scalar_view(
+        Kokkos::view_alloc(exec, Kokkos::WithoutInitializing,
+                           "HybMatrix COO values"),
+        cooNnz);
+    Kokkos::parallel_for(
+        "KokkosSparse::HybMatrix::fill", range_t(exec, 0, m_num_rows),
+        KokkosSparse::Impl::HybFillFunctor<
+            typename CrsMatrixType::row_map_type,
+            typename CrsMatrixType::index_type,
+            typename CrsMatrixType::values_type, ell_index_view,
+            ell_scalar_view, offsets_t, coo_index_view, coo_scalar_view>{
+            A.graph.row_map, A.graph.entries, A.values, ell_entries,
+            ell_values, cooOffsets, coo_rows, coo_cols, coo_values});
+    exec.fence();
+  }
+
+  //! The number of rows in the sparse matrix.
+  KOKKOS_INLINE_FUNCTION ordinal_type numRows() const { return m_num_rows; }
+
+  //! The number of columns in the sparse matrix.
+  KOKKOS_INLINE_FUNCTION ordinal_type numCols() const { return m_num_cols; }
+
+  //! The number of entries in the sparse matrix, not counting the padding.
+  KOKKOS_INLINE_FUNCTION size_type nnz() const { return m_nnz; }
+
+  //! The number of entries stored in the ELL part of every row.
+  KOKKOS_INLINE_FUNCTION ordinal_type ellWidth() const {
+    return ell_entries.extent(1);
+  }
+
+  //! The number of entries stored in the COO part.
+  KOKKOS_INLINE_FUNCTION size_type cooNnz() const {
+    return coo_values.extent(0);
+  }
+};
+
+/// \class is_hyb_matrix
+/// \brief is_hyb_matrix<T>::value is true if T is a HybMatrix<...>, false
+/// otherwise
+template <typename>
+struct is_hyb_matrix : public std::false_type {};
+template <typename... P>
+struct is_hyb_matrix<HybMatrix<P...>> : public std::true_type {};
+template <typename... P>
+struct is_hyb_matrix<const HybMatrix<P...>> : public std::true_type {};
+
+/// \brief y := beta * y + alpha * A * x, for a HybMatrix A.
+///
+/// The ELL part is applied first, by one thread per row, then the COO part
+/// is added with atomics.
+///
+/// \param space [in] The execution space instance on which to run.
+/// \param mode [in] Only "N" (no transpose) is supported.
+/// \param alpha [in] Scalar multiplier for the matrix A.
+/// \param A [in] The sparse matrix A.
+/// \param x [in] A vector to multiply on the left by A.
+/// \param beta [in] Scalar multiplier for the vector y.
+/// \param y [in/out] Result vector.
+template <class ExecutionSpace, class AlphaType, class AMatrix, class XVector,
+          class BetaType, class YVector,
+          typename std::enable_if<is_hyb_matrix<AMatrix>::value>::type* =
+              nullptr>
+void spmv(const ExecutionSpace& space, const char mode[],
+          const AlphaType& alpha, const AMatrix& A, const XVector& x,
+          const BetaType& beta, const YVector& y) {
+  static_assert(Kokkos::is_view<XVector>::value && XVector::rank == 1,
+                "KokkosSparse::Experimental::spmv (HybMatrix): x must be a "
+                "rank-1 Kokkos::View.");
+  static_assert(Kokkos::is_view<YVector>::value && YVector::rank == 1,
+                "KokkosSparse::Experimental::spmv (HybMatrix): y must be a "
+                "rank-1 Kokkos::View.");
+  static_assert(
+      std::is_same<typename YVector::value_type,
+                   typename YVector::non_const_value_type>::value,
+      "KokkosSparse::Experimental::spmv (HybMatrix): y must be nonconst.");
+  if (mode[0] != NoTranspose[0]) {
+    KokkosKernels::Impl::throw_runtime_exception(
+        "KokkosSparse::Experimental::spmv (HybMatrix): only mode \"N\" is "
+        "supported.");
+  }
+  if (x.extent(0) != size_t(A.numCols()) ||
+      y.extent(0) != size_t(A.numRows())) {
+    std::ostringstream os;
+    os << "KokkosSparse::Experimental::spmv (HybMatrix): Dimensions do not "
+          "match: A is "
+       << A.numRows() << " x " << A.numCols() << ", x is " << x.extent(0)
+       << ", y is " << y.extent(0) << ".";
+    KokkosKernels::Impl::throw_runtime_exception(os.str());
+  }
+  using scalar_t = typename AMatrix::non_const_scalar_type;
+  using range_t  = Kokkos::RangePolicy<ExecutionSpace>;
+  Kokkos::parallel_for(
+      "KokkosSparse::spmv<Hyb>::ell", range_t(space, 0, A.numRows()),
+      KokkosSparse::Impl::HybEllSpmvFunctor<
+          typename AMatrix::ell_index_view, typename AMatrix::ell_scalar_view,
+          XVector, YVector, scalar_t>{A.ell_entries, A.ell_values, x, y,
+                                      scalar_t(alpha), scalar_t(beta)});
+  if (A.cooNnz() == 0) return;
+  Kokkos::parallel_for(
+      "KokkosSparse::spmv<Hyb>::coo", range_t(space, 0, A.cooNnz()),
+      KokkosSparse::Impl::HybCooSpmvFunctor<
+          typename AMatrix::coo_index_view, typename AMatrix::coo_scalar_view,
+          XVector, YVector, scalar_t>{A.coo_rows, A.coo_cols, A.coo_values, x,
+                                      y, scalar_t(alpha)});
+}
+
+/// \brief y := beta * y + alpha * A * x, for a HybMatrix A, on the default
+/// instance of the execution space of A.
+template <class AlphaType, class AMatrix, class XVector, class BetaType,
+          class YVector,
+          typename std::enable_if<is_hyb_matrix<AMatrix>::value>::type* =
+              nullptr>
+void spmv(const char mode[], const AlphaType& alpha, const AMatrix& A,
+          const XVector& x, const BetaType& beta, const YVector& y) {
+  spmv(typename AMatrix::execution_space{}, mode, alpha, A, x, beta, y);
+}
+
+}  // namespace Experimental
+}  // namespace KokkosSparse
+
+#endif  // KOKKOS_SPARSE_HYBMATRIX_HPP_
@@ -18,6 +18,8 @@
 
 #include "KokkosKernels_IOUtils.hpp"
 #include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_CrsBinary.hpp"
+#include "KokkosSparse_IOUtils_write_impl.hpp"
 
 namespace KokkosSparse {
 namespace Impl {
@@ -521,15 +523,20 @@ template <typename lno_t, typename size_type, typename scalar_t>
 void write_graph_bin(lno_t nv, size_type ne, const size_type *xadj,
                      const lno_t *adj, const scalar_t *ew,
                      const char *filename) {
-  std::ofstream myFile(filename, std::ios::out | std::ios::binary);
-  myFile.write((char *)&nv, sizeof(lno_t));
-  myFile.write((char *)&ne, sizeof(size_type));
-  myFile.write((char *)xadj, sizeof(size_type) * (nv + 1));
-
-  myFile.write((char *)adj, sizeof(lno_t) * (ne));
-
-  myFile.write((char *)ew, sizeof(scalar_t) * (ne));
-
+  // the sections are written concurrently, at their offsets
+  const size_t xadj_offset = sizeof(lno_t) + sizeof(size_type);
+  const size_t adj_offset  = xadj_offset + sizeof(size_type) * (nv + 1);
+  const size_t ew_offset   = adj_offset + sizeof(lno_t) * ne;
+  const size_t end_offset  = ew_offset + sizeof(scalar_t) * ne;
+
+  KokkosKernels::Impl::PositionedFile myFile(filename);
+  myFile.preallocate(end_offset);
+  myFile.write_at(0, &nv, sizeof(lno_t));
+  myFile.write_at(sizeof(lno_t), &ne, sizeof(size_type));
+  write_bytes_parallel(myFile, xadj_offset, xadj, sizeof(size_type) * (nv + 1));
+  write_bytes_parallel(myFile, adj_offset, adj, sizeof(lno_t) * ne);
+  write_bytes_parallel(myFile, ew_offset, ew, sizeof(scalar_t) * ne);
+  myFile.truncate(end_offset);
   myFile.close();
 }
 
@@ -664,31 +671,132 @@ inline Kokkos::complex<double> symmetryFlip(Kokkos::complex<double> val,
     return -val;
   return val;
 }
+
+// read_banner: parse the first line of a .mtx file ("%%MatrixMarket ...") and
+// check that scalar_t can hold the values of the file
+template <typename scalar_t>
+void read_banner(const std::string &fline, MtxObject &mtx_object,
+                 MtxFormat &mtx_format, MtxField &mtx_field, MtxSym &mtx_sym) {
+  if (fline.size() < 2 || fline[0] != '%' || fline[1] != '%') {
+    throw std::runtime_error("Invalid MM file. Line-1\n");
+  }
+
+  // make sure every required field is in the file, by initializing them to
+  // UNDEFINED_*
+  mtx_object = UNDEFINED_OBJECT;
+  mtx_format = UNDEFINED_FORMAT;
+  mtx_field  = UNDEFINED_FIELD;
+  mtx_sym    = UNDEFINED_SYMMETRY;
+
+  if (fline.find("matrix") != std::string::npos) {
+    mtx_object = MATRIX;
+  } else if (fline.find("vector") != std::string::npos) {
+    mtx_object = VECTOR;
+    throw std::runtime_error(
+        "MatrixMarket \"vector\" is not supported by KokkosKernels read_mtx()");
+  }
+
+  if (fline.find("coordinate") != std::string::npos) {
+    // sparse
+    mtx_format = COORDINATE;
+  } else if (fline.find("array") != std::string::npos) {
+    // dense
+    mtx_format = ARRAY;
+  }
+
+  if (fline.find("real") != std::string::npos ||
+      fline.find("double") != std::string::npos) {
+    if (std::is_same<scalar_t, Kokkos::Experimental::half_t>::value ||
+        std::is_same<scalar_t, Kokkos::Experimental::bhalf_t>::value)
+      mtx_field = REAL;
+    else {
+      if (!std::is_floating_point<scalar_t>::value)
+        throw std::runtime_error(
+            "scalar_t in read_mtx() incompatible with float or double typed "
+            "MatrixMarket file.");
+      else
+        mtx_field = REAL;
+    }
+  } else if (fline.find("complex") != std::string::npos) {
+    if (!(std::is_same<scalar_t, Kokkos::complex<float>>::value ||
+          std::is_same<scalar_t, Kokkos::complex<double>>::value))
+      throw std::runtime_error(
+          "scalar_t in read_mtx() incompatible with complex-typed MatrixMarket "
+          "file.");
+    else
+      mtx_field = COMPLEX;
+  } else if (fline.find("integer") != std::string::npos) {
+    if (std::is_integral<scalar_t>::value ||
+        std::is_floating_point<scalar_t>::value ||
+        std::is_same<scalar_t, Kokkos::Experimental::half_t>::value ||
+        std::is_same<scalar_t, Kokkos::Experimental::bhalf_t>::value)
+      mtx_field = INTEGER;
+    else
+      throw std::runtime_error(
+          "scalar_t in read_mtx() incompatible with integer-typed MatrixMarket "
+          "file.");
+  } else if (fline.find("pattern") != std::string::npos) {
+    mtx_field = PATTERN;
+    // any reasonable choice for scalar_t can represent "1" or "1.0 + 0i", so
+    // nothing to check here
+  }
+
+  if (fline.find("general") != std::string::npos) {
+    mtx_sym = GENERAL;
+  } else if (fline.find("skew-symmetric") != std::string::npos) {
+    mtx_sym = SKEW_SYMMETRIC;
+  } else if (fline.find("symmetric") != std::string::npos) {
+    // checking for "symmetric" after "skew-symmetric" because it's a substring
+    mtx_sym = SYMMETRIC;
+  } else if (fline.find("hermitian") != std::string::npos ||
+             fline.find("Hermitian") != std::string::npos) {
+    mtx_sym = HERMITIAN;
+  }
+  // Validate the matrix attributes
+  if (mtx_format == ARRAY) {
+    if (mtx_sym == UNDEFINED_SYMMETRY) mtx_sym = GENERAL;
+    if (mtx_sym != GENERAL)
+      throw std::runtime_error(
+          "array format MatrixMarket file must have general symmetry (optional "
+          "to include \"general\")");
+  }
+  if (mtx_object == UNDEFINED_OBJECT)
+    throw std::runtime_error(
+        "MatrixMarket file header is missing the object type.");
+  if (mtx_format == UNDEFINED_FORMAT)
+    throw std::runtime_error("MatrixMarket file header is missing the format.");
+  if (mtx_field == UNDEFINED_FIELD)
+    throw std::runtime_error(
+        "MatrixMarket file header is missing the field type.");
+  if (mtx_sym == UNDEFINED_SYMMETRY)
+    throw std::runtime_error(
+        "MatrixMarket file header is missing the symmetry type.");
+}
 }  // namespace MM
 
 template <typename lno_t, typename size_type, typename scalar_t>
 void write_matrix_mtx(lno_t nrows, lno_t ncols, size_type nentries,
                       const size_type *xadj, const lno_t *adj,
                       const scalar_t *vals, const char *filename) {
-  std::ofstream myFile(filename);
-  myFile << "%%MatrixMarket matrix coordinate ";
+  std::ostringstream banner;
+  banner << "%%MatrixMarket matrix coordinate ";
   if (std::is_same<scalar_t, Kokkos::complex<float>>::value ||
       std::is_same<scalar_t, Kokkos::complex<double>>::value)
-    myFile << "complex";
+    banner << "complex";
   else
-    myFile << "real";
-  myFile << " general\n";
-  myFile << nrows << " " << ncols << " " << nentries << '\n';
-  myFile << std::setprecision(17) << std::scientific;
-  for (lno_t i = 0; i < nrows; ++i) {
-    size_type b = xadj[i];
-    size_type e = xadj[i + 1];
-    for (size_type j = b; j < e; ++j) {
-      myFile << i + 1 << " " << adj[j] + 1 << " ";
-      MM::writeScalar<scalar_t>(myFile, vals[j]);
-      myFile << '\n';
-    }
-  }
+    banner << "real";
+  banner << " general\n";
+  banner << nrows << " " << ncols << " " << nentries << '\n';
+  const std::string header = banner.str();
+
+  // the entries are formatted and written by all the host threads
+  KokkosKernels::Impl::PositionedFile myFile(filename);
+  myFile.preallocate(header.size() + mtx_entries_max_bytes<lno_t, scalar_t>(
+                                         nrows, ncols, nentries));
+  myFile.write_at(0, header.data(), header.size());
+  const size_t end = write_mtx_entries_parallel(myFile, header.size(), nrows,
+                                                xadj, adj, vals);
+  myFile.truncate(end);
   myFile.close();
 }
 
@@ -812,9 +920,12 @@ void write_kokkos_crst_matrix(crs_matrix_t a_crsmat, const char *filename) {
         a_crsmat.numRows(), a_crsmat.numCols(), a_crsmat.nnz(), a_rowmap,
         a_entries, a_values, filename);
     return;
+  } else if (KokkosKernels::Impl::endswith(strfilename, ".kkb")) {
+    write_crs_binary(a_crsmat, strfilename);
+    return;
   } else if (a_crsmat.numRows() != a_crsmat.numCols()) {
     throw std::runtime_error(
-        "For formats other than MatrixMarket (suffix .mm or .mtx),\n"
+        "For formats other than MatrixMarket (suffix .mm or .mtx) and .kkb,\n"
         "write_kokkos_crst_matrix only supports square matrices");
   }
   if (KokkosKernels::Impl::endswith(strfilename, ".bin")) {
@@ -848,100 +959,11 @@ int read_mtx(const char *fileName, lno_t *nrows, lno_t *ncols, size_type *ne,
   std::string fline = "";
   getline(mmf, fline);
 
-  if (fline.size() < 2 || fline[0] != '%' || fline[1] != '%') {
-    throw std::runtime_error("Invalid MM file. Line-1\n");
-  }
-
-  // make sure every required field is in the file, by initializing them to
-  // UNDEFINED_*
-  MtxObject mtx_object = UNDEFINED_OBJECT;
-  MtxFormat mtx_format = UNDEFINED_FORMAT;
-  MtxField mtx_field   = UNDEFINED_FIELD;
-  MtxSym mtx_sym       = UNDEFINED_SYMMETRY;
-
-  if (fline.find("matrix") != std::string::npos) {
-    mtx_object = MATRIX;
-  } else if (fline.find("vector") != std::string::npos) {
-    mtx_object = VECTOR;
-    throw std::runtime_error(
-        "MatrixMarket \"vector\" is not supported by KokkosKernels read_mtx()");
-  }
-
-  if (fline.find("coordinate") != std::string::npos) {
-    // sparse
-    mtx_format = COORDINATE;
-  } else if (fline.find("array") != std::string::npos) {
-    // dense
-    mtx_format = ARRAY;
-  }
-
-  if (fline.find("real") != std::string::npos ||
-      fline.find("double") != std::string::npos) {
-    if (std::is_same<scalar_t, Kokkos::Experimental::half_t>::value ||
-        std::is_same<scalar_t, Kokkos::Experimental::bhalf_t>::value)
-      mtx_field = REAL;
-    else {
-      if (!std::is_floating_point<scalar_t>::value)
-        throw std::runtime_error(
-            "scalar_t in read_mtx() incompatible with float or double typed "
-            "MatrixMarket file.");
-      else
-        mtx_field = REAL;
-    }
-  } else if (fline.find("complex") != std::string::npos) {
-    if (!(std::is_same<scalar_t, Kokkos::complex<float>>::value ||
-          std::is_same<scalar_t, Kokkos::complex<double>>::value))
-      throw std::runtime_error(
-          "scalar_t in read_mtx() incompatible with complex-typed MatrixMarket "
-          "file.");
-    else
-      mtx_field = COMPLEX;
-  } else if (fline.find("integer") != std::string::npos) {
-    if (std::is_integral<scalar_t>::value ||
-        std::is_floating_point<scalar_t>::value ||
-        std::is_same<scalar_t, Kokkos::Experimental::half_t>::value ||
-        std::is_same<scalar_t, Kokkos::Experimental::bhalf_t>::value)
-      mtx_field = INTEGER;
-    else
-      throw std::runtime_error(
-          "scalar_t in read_mtx() incompatible with integer-typed MatrixMarket "
-          "file.");
-  } else if (fline.find("pattern") != std::string::npos) {
-    mtx_field = PATTERN;
-    // any reasonable choice for scalar_t can represent "1" or "1.0 + 0i", so
-    // nothing to check here
-  }
-
-  if (fline.find("general") != std::string::npos) {
-    mtx_sym = GENERAL;
-  } else if (fline.find("skew-symmetric") != std::string::npos) {
-    mtx_sym = SKEW_SYMMETRIC;
-  } else if (fline.find("symmetric") != std::string::npos) {
-    // checking for "symmetric" after "skew-symmetric" because it's a substring
-    mtx_sym = SYMMETRIC;
-  } else if (fline.find("hermitian") != std::string::npos ||
-             fline.find("Hermitian") != std::string::npos) {
-    mtx_sym = HERMITIAN;
-  }
-  // Validate the matrix attributes
-  if (mtx_format == ARRAY) {
-    if (mtx_sym == UNDEFINED_SYMMETRY) mtx_sym = GENERAL;
-    if (mtx_sym != GENERAL)
-      throw std::runtime_error(
-          "array format MatrixMarket file must have general symmetry (optional "
-          "to include \"general\")");
-  }
-  if (mtx_object == UNDEFINED_OBJECT)
-    throw std::runtime_error(
-        "MatrixMarket file header is missing the object type.");
-  if (mtx_format == UNDEFINED_FORMAT)
-    throw std::runtime_error("MatrixMarket file header is missing the format.");
-  if (mtx_field == UNDEFINED_FIELD)
-    throw std::runtime_error(
-        "MatrixMarket file header is missing the field type.");
-  if (mtx_sym == UNDEFINED_SYMMETRY)
-    throw std::runtime_error(
-        "MatrixMarket file header is missing the symmetry type.");
+  MtxObject mtx_object;
+  MtxFormat mtx_format;
+  MtxField mtx_field;
+  MtxSym mtx_sym;
+  read_banner<scalar_t>(fline, mtx_object, mtx_format, mtx_field, mtx_sym);
 
   while (1) {
     getline(mmf, fline);
@@ -1100,6 +1122,9 @@ void read_matrix(lno_t *nv, size_type *ne, size_type **xadj, lno_t **adj,
 template <typename crsMat_t>
 crsMat_t read_kokkos_crst_matrix(const char *filename_) {
   std::string strfilename(filename_);
+  if (KokkosKernels::Impl::endswith(strfilename, ".kkb")) {
+    return read_crs_binary<crsMat_t>(strfilename);
+  }
   bool isMatrixMarket = KokkosKernels::Impl::endswith(strfilename, ".mtx") ||
                         KokkosKernels::Impl::endswith(strfilename, ".mm");
 
@@ -0,0 +1,198 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+#ifndef _KOKKOSSPARSE_IOUTILS_PARALLEL_HPP
+#define _KOKKOSSPARSE_IOUTILS_PARALLEL_HPP
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "KokkosKernels_MappedFile.hpp"
+#include "KokkosKernels_SimpleUtils.hpp"
+#include "KokkosSparse_IOUtils.hpp"
+#include "KokkosSparse_SortCrs.hpp"
+#include "KokkosSparse_IOUtils_parallel_impl.hpp"
+
+namespace KokkosSparse {
+namespace Impl {
+
+///
+/// @brief Reads a MatrixMarket file into a CrsMatrix, in parallel.
+///
+/// The file is memory-mapped, split into chunks at line boundaries and the
+/// chunks are parsed concurrently on the default host execution space. The
+/// entries (including the mirrored entries of symmetric, skew-symmetric and
+/// Hermitian files) are then assembled on the device: a count of the
+/// entries of every row, a prefix sum and a scatter, in O(nnz) with size_type
+/// offsets. The rows are sorted and, unlike read_mtx, duplicate entries are
+/// summed.
+///
+/// @tparam crsMat_t A KokkosSparse::CrsMatrix, with a signed ordinal type
+/// @param filename The .mtx file (coordinate or array format)
+///
+template <typename crsMat_t>
+crsMat_t read_mtx_parallel(const char *filename) {
+  using graph_t        = typename crsMat_t::StaticCrsGraphType;
+  using row_map_view_t = typename graph_t::row_map_type::non_const_type;
+  using cols_view_t    = typename graph_t::entries_type::non_const_type;
+  using values_view_t  = typename crsMat_t::values_type::non_const_type;
+  using lno_t          = typename cols_view_t::value_type;
+  using scalar_t       = typename values_view_t::value_type;
+  using exec_space     = typename crsMat_t::execution_space;
+  using host_exec      = Kokkos::DefaultHostExecutionSpace;
+  using host_policy    = Kokkos::RangePolicy<host_exec>;
+  using parse_functor  = MtxParseFunctor<lno_t, scalar_t>;
+  static_assert(std::is_signed<lno_t>::value,
+                "read_mtx_parallel: the ordinal type must be signed");
+
+  KokkosKernels::Impl::MappedFile file(filename);
+  const char *data  = file.data();
+  const size_t size = file.size();
+
+  // banner, comments and size line
+  size_t pos     = 0;
+  auto next_line = [&]() {
+    const size_t begin = pos;
+    const void *nl     = std::memchr(data + pos, '\n', size - pos);
+    pos = nl ? static_cast<const char *>(nl) - data + 1 : size;
+    return std::string(data + begin, data + pos);
+  };
+  MM::MtxObject mtx_object;
+  MM::MtxFormat mtx_format;
+  MM::MtxField mtx_field;
+  MM::MtxSym mtx_sym;
+  MM::read_banner<scalar_t>(next_line(), mtx_object, mtx_format, mtx_field,
+                            mtx_sym);
+  std::string fline;
+  do {
+    if (pos == size) {
+      throw std::runtime_error("read_mtx_parallel: missing size line");
+    }
+    fline = next_line();
+  } while (fline.find_first_not_of(" \t\r\n") == std::string::npos ||
+           fline[fline.find_first_not_of(" \t\r\n")] == '%');
+  int64_t nr = 0, nc = 0, nnz_file = 0;
+  {
+    const char *p   = fline.data();
+    const char *end = p + fline.size();
+    if (!mtx_parse_index(p, end, nr) || !mtx_parse_index(p, end, nc) ||
+        (mtx_format == MM::COORDINATE && !mtx_parse_index(p, end, nnz_file))) {
+      throw std::runtime_error("read_mtx_parallel: invalid size line");
+    }
+  }
+  if (mtx_format == MM::ARRAY) nnz_file = nr * nc;
+  if (mtx_sym != MM::GENERAL && nr != nc) {
+    throw std::runtime_error("A non-square matrix cannot be symmetrized.");
+  }
+  const size_t nnz = nnz_file;
+
+  // cut the data section into chunks, starting at line boundaries
+  const size_t data_begin = pos;
+  const size_t data_size  = size - data_begin;
+  const size_t num_chunks = std::max<size_t>(
+      1, std::min<size_t>(data_size >> 16, 8 * host_exec().concurrency()));
+  Kokkos::View<size_t *, Kokkos::HostSpace> chunk_begin("chunk_begin",
+                                                        num_chunks + 1);
+  Kokkos::View<size_t *, Kokkos::HostSpace> chunk_offset("chunk_offset",
+                                                         num_chunks + 1);
+  Kokkos::View<int *, Kokkos::HostSpace> chunk_error("chunk_error",
+                                                     num_chunks);
+  for (size_t c = 0; c <= num_chunks; c++) {
+    chunk_begin(c) =
+        mtx_line_start(data, size, data_begin + c * data_size / num_chunks);
+  }
+  Kokkos::parallel_for("read_mtx_parallel::count",
+                       host_policy(0, num_chunks),
+                       MtxCountFunctor{data, chunk_begin, chunk_offset});
+  host_exec().fence();
+  size_t total = 0;
+  for (size_t c = 0; c < num_chunks; c++) {
+    const size_t count = chunk_offset(c);
+    chunk_offset(c)    = total;
+    total += count;
+  }
+  chunk_offset(num_chunks) = total;
+  if (total != nnz) {
+    throw std::runtime_error(
+        "read_mtx_parallel: the number of entries does not match the size "
+        "line");
+  }
+
+  // parse, one COO slot per entry (two if the file is symmetric)
+  const size_t stride = mtx_sym == MM::GENERAL ? 1 : 2;
+  typename parse_functor::host_lno_view_t rows(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "rows"), stride * nnz);
+  typename parse_functor::host_lno_view_t cols(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "cols"), stride * nnz);
+  typename parse_functor::host_scalar_view_t vals(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "vals"), stride * nnz);
+  Kokkos::parallel_for(
+      "read_mtx_parallel::parse", host_policy(0, num_chunks),
+      parse_functor{data, chunk_begin, chunk_offset, chunk_error, rows, cols,
+                    vals, mtx_format, mtx_field, mtx_sym, nr, nc, nnz});
+  host_exec().fence();
+  for (size_t c = 0; c < num_chunks; c++) {
+    if (chunk_error(c) == MTX_PARSE_OUT_OF_RANGE) {
+      throw std::runtime_error("read_mtx_parallel: entry index out of range");
+    } else if (chunk_error(c) != MTX_PARSE_OK) {
+      throw std::runtime_error("read_mtx_parallel: invalid entry");
+    }
+  }
+  file.close();
+
+  // assemble on the device
+  using memory_space = typename crsMat_t::memory_space;
+  using size_type    = typename row_map_view_t::value_type;
+  using policy       = Kokkos::RangePolicy<exec_space>;
+
+  auto rows_d = Kokkos::create_mirror_view_and_copy(memory_space(), rows);
+  auto cols_d = Kokkos::create_mirror_view_and_copy(memory_space(), cols);
+  auto vals_d = Kokkos::create_mirror_view_and_copy(memory_space(), vals);
+
+  // count the entries of every row, then scatter them at their row offsets
+  const int64_t num_slots = rows_d.extent(0);
+  row_map_view_t rowmap("rowmap_view", nr + 1);
+  Kokkos::parallel_for(
+      "read_mtx_parallel::count_rows", policy(0, num_slots),
+      MtxRowCountFunctor<decltype(rows_d), row_map_view_t>{rows_d, rowmap});
+  size_type nnzA = 0;
+  KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<exec_space>(
+      nr + 1, rowmap, nnzA);
+  row_map_view_t cursor(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "cursor"), nr + 1);
+  Kokkos::deep_copy(cursor, rowmap);
+  cols_view_t entries(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "colsmap_view"), nnzA);
+  values_view_t values(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "values_view"), nnzA);
+  Kokkos::parallel_for(
+      "read_mtx_parallel::scatter", policy(0, num_slots),
+      MtxScatterFunctor<decltype(rows_d), decltype(vals_d), row_map_view_t,
+                        cols_view_t, values_view_t>{
+          rows_d, cols_d, vals_d, cursor, entries, values});
+
+  // sort the rows and sum the duplicates
+  KokkosSparse::sort_and_merge_matrix(exec_space(), rowmap, entries, values,
+                                      rowmap, entries, values);
+  return crsMat_t("CrsMatrix", lno_t(nr), lno_t(nc), values.extent(0), values,
+                  rowmap, entries);
+}
+
+}  // namespace Impl
+}  // namespace KokkosSparse
+
+#endif  // _KOKKOSSPARSE_IOUTILS_PARALLEL_HPP
@@ -84,9 +84,12 @@ struct SortCrsMatrixFunctor {
   using values_managed_t  = Kokkos::View<typename values_t::data_type,
                                         typename values_t::device_type>;
 
+  using rows_t = Kokkos::View<lno_t*, typename entries_t::device_type>;
+
   SortCrsMatrixFunctor(bool usingRangePol, const rowmap_t& rowmap_,
-                       const entries_t& entries_, const values_t& values_)
-      : rowmap(rowmap_), entries(entries_), values(values_) {
+                       const entries_t& entries_, const values_t& values_,
+                       const rows_t& rows_)
+      : rowmap(rowmap_), entries(entries_), values(values_), rows(rows_) {
     if (usingRangePol) {
       entriesAux = entries_managed_t(
           Kokkos::view_alloc(Kokkos::WithoutInitializing, "Entries aux"),
@@ -98,7 +101,8 @@ struct SortCrsMatrixFunctor {
     // otherwise, aux arrays won't be allocated (sorting in place)
   }
 
-  KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+  KOKKOS_INLINE_FUNCTION void operator()(const lno_t k) const {
+    lno_t i            = rows(k);
     size_type rowStart = rowmap(i);
     size_type rowEnd   = rowmap(i + 1);
     lno_t rowNum       = rowEnd - rowStart;
@@ -111,7 +115,7 @@ struct SortCrsMatrixFunctor {
   }
 
   KOKKOS_INLINE_FUNCTION void operator()(const team_mem t) const {
-    size_type i        = t.league_rank();
+    lno_t i            = rows(t.league_rank());
     size_type rowStart = rowmap(i);
     size_type rowEnd   = rowmap(i + 1);
     lno_t rowNum       = rowEnd - rowStart;
@@ -124,6 +128,8 @@ struct SortCrsMatrixFunctor {
   entries_managed_t entriesAux;
   values_t values;
   values_managed_t valuesAux;
+  // the rows to sort
+  rows_t rows;
 };
 
 template <typename execution_space, typename rowmap_t, typename entries_t>
@@ -136,9 +142,11 @@ struct SortCrsGraphFunctor {
   using entries_managed_t = Kokkos::View<typename entries_t::data_type,
                                          typename entries_t::device_type>;
 
+  using rows_t = Kokkos::View<lno_t*, typename entries_t::device_type>;
+
   SortCrsGraphFunctor(bool usingRangePol, const rowmap_t& rowmap_,
-                      const entries_t& entries_)
-      : rowmap(rowmap_), entries(entries_) {
+                      const entries_t& entries_, const rows_t& rows_)
+      : rowmap(rowmap_), entries(entries_), rows(rows_) {
     if (usingRangePol) {
       entriesAux = entries_managed_t(
           Kokkos::view_alloc(Kokkos::WithoutInitializing, "Entries aux"),
@@ -147,7 +155,8 @@ struct SortCrsGraphFunctor {
     // otherwise, aux arrays won't be allocated (sorting in place)
   }
 
-  KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+  KOKKOS_INLINE_FUNCTION void operator()(const lno_t k) const {
+    lno_t i            = rows(k);
     size_type rowStart = rowmap(i);
     size_type rowEnd   = rowmap(i + 1);
     lno_t rowNum       = rowEnd - rowStart;
@@ -159,7 +168,7 @@ struct SortCrsGraphFunctor {
   }
 
   KOKKOS_INLINE_FUNCTION void operator()(const team_mem t) const {
-    size_type i        = t.league_rank();
+    lno_t i            = rows(t.league_rank());
     size_type rowStart = rowmap(i);
     size_type rowEnd   = rowmap(i + 1);
     lno_t rowNum       = rowEnd - rowStart;
@@ -170,8 +179,266 @@ struct SortCrsGraphFunctor {
   rowmap_t rowmap;
   entries_t entries;
   entries_managed_t entriesAux;
+  // the rows to sort
+  rows_t rows;
 };
 
+// Rows are sorted by a method that depends on their length: insertion sort
+// on one thread for short rows, radix sort on one thread (CPU) or bitonic
+// sort on one team (GPU) for medium rows, and radix sort on the whole
+// execution space for huge rows. Rows that are already sorted are skipped.
+enum SortCrsRowClass : char {
+  SORT_CRS_SORTED = 0,
+  SORT_CRS_SHORT  = 1,
+  SORT_CRS_MEDIUM = 2,
+  SORT_CRS_HUGE   = 3
+};
+constexpr int64_t SORT_CRS_SHORT_ROW_MAX = 16;
+constexpr int64_t SORT_CRS_HUGE_ROW_MIN  = 1 << 16;
+
+// Classifies the rows. Whether a huge row is sorted is checked separately,
+// by all the threads.
+template <typename rowmap_t, typename entries_t, typename classes_t>
+struct SortCrsClassifyFunctor {
+  using size_type = typename rowmap_t::non_const_value_type;
+  using lno_t     = typename entries_t::non_const_value_type;
+
+  rowmap_t rowmap;
+  entries_t entries;
+  classes_t classes;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const lno_t i) const {
+    size_type rowStart = rowmap(i);
+    size_type rowEnd   = rowmap(i + 1);
+    if (int64_t(rowEnd - rowStart) >= SORT_CRS_HUGE_ROW_MIN) {
+      classes(i) = SORT_CRS_HUGE;
+      return;
+    }
+    for (size_type j = rowStart + 1; j < rowEnd; j++) {
+      if (entries(j - 1) > entries(j)) {
+        classes(i) = int64_t(rowEnd - rowStart) <= SORT_CRS_SHORT_ROW_MAX
+                         ? SORT_CRS_SHORT
+                         : SORT_CRS_MEDIUM;
+        return;
+      }
+    }
+    classes(i) = SORT_CRS_SORTED;
+  }
+};
+
+// Compacts the rows of one class into a list
+template <typename classes_t, typename rows_t>
+struct SortCrsSelectRowsFunctor {
+  using lno_t = typename rows_t::non_const_value_type;
+
+  classes_t classes;
+  rows_t rows;
+  char rowClass;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const lno_t i, lno_t& offset,
+                                         const bool final) const {
+    if (classes(i) != rowClass) return;
+    // rows is empty when only counting
+    if (final && rows.extent(0)) rows(offset) = i;
+    offset++;
+  }
+};
+
+// Insertion sort of the short rows, one per thread
+template <typename rowmap_t, typename entries_t, typename values_t,
+          typename rows_t>
+struct SortCrsMatrixShortRowsFunctor {
+  using size_type = typename rowmap_t::non_const_value_type;
+  using lno_t     = typename entries_t::non_const_value_type;
+  using scalar_t  = typename values_t::non_const_value_type;
+
+  rowmap_t rowmap;
+  entries_t entries;
+  values_t values;
+  rows_t rows;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const lno_t k) const {
+    lno_t i            = rows(k);
+    size_type rowStart = rowmap(i);
+    size_type rowEnd   = rowmap(i + 1);
+    for (size_type j = rowStart + 1; j < rowEnd; j++) {
+      lno_t col    = entries(j);
+      scalar_t val = values(j);
+      size_type m  = j;
+      for (; m > rowStart && entries(m - 1) > col; m--) {
+        entries(m) = entries(m - 1);
+        values(m)  = values(m - 1);
+      }
+      entries(m) = col;
+      values(m)  = val;
+    }
+  }
+};
+
+template <typename rowmap_t, typename entries_t, typename rows_t>
+struct SortCrsGraphShortRowsFunctor {
+  using size_type = typename rowmap_t::non_const_value_type;
+  using lno_t     = typename entries_t::non_const_value_type;
+
+  rowmap_t rowmap;
+  entries_t entries;
+  rows_t rows;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const lno_t k) const {
+    lno_t i            = rows(k);
+    size_type rowStart = rowmap(i);
+    size_type rowEnd   = rowmap(i + 1);
+    for (size_type j = rowStart + 1; j < rowEnd; j++) {
+      lno_t col   = entries(j);
+      size_type m = j;
+      for (; m > rowStart && entries(m - 1) > col; m--) {
+        entries(m) = entries(m - 1);
+      }
+      entries(m) = col;
+    }
+  }
+};
+
+// Lists the unsorted short and medium rows, and the huge rows.
+template <typename execution_space, typename rowmap_t, typename entries_t,
+          typename rows_t>
+void sort_crs_select_rows(const execution_space& exec, const rowmap_t& rowmap,
+                          const entries_t& entries, rows_t& shortRows,
+                          rows_t& mediumRows, rows_t& hugeRows) {
+  using lno_t     = typename entries_t::non_const_value_type;
+  using range_t   = Kokkos::RangePolicy<execution_space>;
+  using classes_t = Kokkos::View<char*, typename entries_t::device_type>;
+  lno_t numRows   = rowmap.extent(0) ? rowmap.extent(0) - 1 : 0;
+  classes_t classes(Kokkos::view_alloc(exec, Kokkos::WithoutInitializing,
+                                       "sort_crs row classes"),
+                    numRows);
+  Kokkos::parallel_for(
+      "sort_crs::classify", range_t(exec, 0, numRows),
+      SortCrsClassifyFunctor<rowmap_t, entries_t, classes_t>{rowmap, entries,
+                                                             classes});
+  const char rowClasses[3] = {SORT_CRS_SHORT, SORT_CRS_MEDIUM, SORT_CRS_HUGE};
+  rows_t* rowLists[3]      = {&shortRows, &mediumRows, &hugeRows};
+  for (int c = 0; c < 3; c++) {
+    // first count the rows, then list them
+    lno_t count = 0;
+    Kokkos::parallel_scan(
+        "sort_crs::count_rows", range_t(exec, 0, numRows),
+        SortCrsSelectRowsFunctor<classes_t, rows_t>{classes, rows_t(),
+                                                    rowClasses[c]},
+        count);
+    *rowLists[c] = rows_t(
+        Kokkos::view_alloc(exec, Kokkos::WithoutInitializing, "sort_crs rows"),
+        count);
+    if (count == 0) continue;
+    Kokkos::parallel_scan(
+        "sort_crs::select_rows", range_t(exec, 0, numRows),
+        SortCrsSelectRowsFunctor<classes_t, rows_t>{classes, *rowLists[c],
+                                                    rowClasses[c]});
+  }
+}
+
+// Total length of the listed rows
+template <typename rowmap_t, typename rows_t>
+struct SortCrsRowsLengthFunctor {
+  using size_type = typename rowmap_t::non_const_value_type;
+  using lno_t     = typename rows_t::non_const_value_type;
+
+  rowmap_t rowmap;
+  rows_t rows;
+
+  KOKKOS_INLINE_FUNCTION void operator()(const lno_t k, size_type& sum) const {
+    const lno_t i = rows(k);
+    sum += rowmap(i + 1) - rowmap(i);
+  }
+};
+
+// Team size for the bitonic sort of the medium rows: the smallest power of 2
+// not below half their average length (bitonic's parallelism within a row),
+// capped by what funct can launch with. The average only counts the
+// medium rows, as a few huge rows would inflate it.
+template <typename execution_space, typename rowmap_t, typename rows_t,
+          typename funct_t>
+int sort_crs_medium_team_size(const execution_space& exec,
+                              const rowmap_t& rowmap, const rows_t& mediumRows,
+                              const funct_t& funct) {
+  using size_type = typename rowmap_t::non_const_value_type;
+  using lno_t     = typename rows_t::non_const_value_type;
+  using range_t   = Kokkos::RangePolicy<execution_space>;
+  using team_pol  = Kokkos::TeamPolicy<execution_space>;
+  lno_t numMedium = mediumRows.extent(0);
+  size_type total = 0;
+  Kokkos::parallel_reduce(
+      "sort_crs::medium_rows_length", range_t(exec, 0, numMedium),
+      SortCrsRowsLengthFunctor<rowmap_t, rows_t>{rowmap, mediumRows}, total);
+  size_type avgDeg   = (total + numMedium - 1) / numMedium;
+  size_type teamSize = 1;
+  while (teamSize < avgDeg / 2) {
+    teamSize *= 2;
+  }
+  team_pol temp(exec, numMedium, 1);
+  size_type maxTeamSize = temp.team_size_max(funct, Kokkos::ParallelForTag());
+  return std::min(teamSize, maxTeamSize);
+}
+
+// Sorts the huge rows one after the other, each with all the threads. The
+// rows that are already sorted are skipped. values is empty for a graph.
+template <typename execution_space, typename rowmap_t, typename entries_t,
+          typename values_t, typename rows_t>
+void sort_crs_huge_rows(const execution_space& exec, const rowmap_t& rowmap,
+                        const entries_t& entries, const values_t& values,
+                        const rows_t& hugeRows) {
+  using size_type      = typename rowmap_t::non_const_value_type;
+  using lno_t          = typename entries_t::non_const_value_type;
+  using scalar_t       = typename values_t::non_const_value_type;
+  using unsigned_lno_t = typename std::make_unsigned<lno_t>::type;
+  using device_t       = typename entries_t::device_type;
+  using unmanaged      = Kokkos::MemoryTraits<Kokkos::Unmanaged>;
+  using keys_t         = Kokkos::View<unsigned_lno_t*, device_t, unmanaged>;
+  using perm_t         = Kokkos::View<scalar_t*, device_t, unmanaged>;
+  using range_t        = Kokkos::RangePolicy<execution_space>;
+  if (hugeRows.extent(0) == 0) return;
+  auto rowsHost =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), hugeRows);
+  auto rowmapHost =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), rowmap);
+  size_type maxLength = 0;
+  for (size_t k = 0; k < rowsHost.extent(0); k++) {
+    lno_t i   = rowsHost(k);
+    maxLength = Kokkos::max(maxLength, rowmapHost(i + 1) - rowmapHost(i));
+  }
+  const bool withValues = values.extent(0);
+  Kokkos::View<unsigned_lno_t*, device_t> keysAux(
+      Kokkos::view_alloc(exec, Kokkos::WithoutInitializing, "Entries aux"),
+      maxLength);
+  Kokkos::View<scalar_t*, device_t> valuesAux(
+      Kokkos::view_alloc(exec, Kokkos::WithoutInitializing, "Values aux"),
+      withValues ? maxLength : 0);
+  for (size_t k = 0; k < rowsHost.extent(0); k++) {
+    lno_t i               = rowsHost(k);
+    size_type rowStart    = rowmapHost(i);
+    size_type rowNum      = rowmapHost(i + 1) - rowStart;
+    size_type numDescents = 0;
+    Kokkos::parallel_reduce(
+        "sort_crs::check_sorted",
+        range_t(exec, rowStart + 1, rowStart + rowNum),
+        KOKKOS_LAMBDA(const size_type j, size_type& lcount) {
+          if (entries(j - 1) > entries(j)) lcount++;
+        },
+        numDescents);
+    if (numDescents == 0) continue;
+    // Radix sort requires unsigned keys for comparison
+    keys_t keys((unsigned_lno_t*)entries.data() + rowStart, rowNum);
+    keys_t aux(keysAux.data(), rowNum);
+    if (withValues) {
+      KokkosKernels::radixSort2(exec, keys,
+                                perm_t(values.data() + rowStart, rowNum), aux,
+                                perm_t(valuesAux.data(), rowNum));
+    } else {
+      KokkosKernels::radixSort2(exec, keys, perm_t(), aux, perm_t());
+    }
+  }
+}
+
 template <typename rowmap_t, typename entries_t>
 struct MergedRowmapFunctor {
   using size_type  = typename rowmap_t::non_const_value_type;
@@ -381,31 +648,37 @@ void sort_crs_matrix(const execution_space& exec, const rowmap_t& rowmap,
                 "sort_crs_matrix: value_t must not be const-valued");
   using lno_t    = typename entries_t::non_const_value_type;
   using team_pol = Kokkos::TeamPolicy<execution_space>;
+  using range_t  = Kokkos::RangePolicy<execution_space>;
+  using funct_t  = Impl::SortCrsMatrixFunctor<execution_space, rowmap_t,
+                                             entries_t, values_t>;
+  using rows_t   = typename funct_t::rows_t;
   bool useRadix = !KokkosKernels::Impl::kk_is_gpu_exec_space<execution_space>();
   lno_t numRows = rowmap.extent(0) ? rowmap.extent(0) - 1 : 0;
   if (numRows == 0) return;
-  Impl::SortCrsMatrixFunctor<execution_space, rowmap_t, entries_t, values_t>
-      funct(useRadix, rowmap, entries, values);
-  if (useRadix) {
-    Kokkos::parallel_for("sort_crs_matrix",
-                         Kokkos::RangePolicy<execution_space>(exec, 0, numRows),
-                         funct);
-  } else {
-    // Try to get teamsize to be largest power of 2 not greater than avg entries
-    // per row
-    // TODO (probably important for performnce): add thread-level sort also, and
-    // use that for small avg degree. But this works for now.
-    lno_t idealTeamSize = 1;
-    lno_t avgDeg        = (entries.extent(0) + numRows - 1) / numRows;
-    while (idealTeamSize < avgDeg / 2) {
-      idealTeamSize *= 2;
+  rows_t shortRows, mediumRows, hugeRows;
+  Impl::sort_crs_select_rows(exec, rowmap, entries, shortRows, mediumRows,
+                             hugeRows);
+  if (shortRows.extent(0)) {
+    Kokkos::parallel_for(
+        "sort_crs_matrix::short_rows", range_t(exec, 0, shortRows.extent(0)),
+        Impl::SortCrsMatrixShortRowsFunctor<rowmap_t, entries_t, values_t,
+                                            rows_t>{rowmap, entries, values,
+                                                    shortRows});
+  }
+  lno_t numMedium = mediumRows.extent(0);
+  if (numMedium) {
+    funct_t funct(useRadix, rowmap, entries, values, mediumRows);
+    if (useRadix) {
+      Kokkos::parallel_for("sort_crs_matrix", range_t(exec, 0, numMedium),
+                           funct);
+    } else {
+      int teamSize =
+          Impl::sort_crs_medium_team_size(exec, rowmap, mediumRows, funct);
+      Kokkos::parallel_for("sort_crs_matrix",
+                           team_pol(exec, numMedium, teamSize), funct);
     }
-    team_pol temp(exec, numRows, 1);
-    lno_t maxTeamSize = temp.team_size_max(funct, Kokkos::ParallelForTag());
-    lno_t teamSize    = std::min(idealTeamSize, maxTeamSize);
-    Kokkos::parallel_for("sort_crs_matrix", team_pol(exec, numRows, teamSize),
-                         funct);
   }
+  Impl::sort_crs_huge_rows(exec, rowmap, entries, values, hugeRows);
 }
 
 template <typename execution_space, typename rowmap_t, typename entries_t,
@@ -488,6 +761,10 @@ void sort_crs_graph(const execution_space& exec, const rowmap_t& rowmap,
                     const entries_t& entries) {
   using lno_t    = typename entries_t::non_const_value_type;
   using team_pol = Kokkos::TeamPolicy<execution_space>;
+  using range_t  = Kokkos::RangePolicy<execution_space>;
+  using funct_t =
+      Impl::SortCrsGraphFunctor<execution_space, rowmap_t, entries_t>;
+  using rows_t = typename funct_t::rows_t;
   static_assert(
       Kokkos::SpaceAccessibility<execution_space,
                                  typename rowmap_t::memory_space>::accessible,
@@ -503,29 +780,29 @@ void sort_crs_graph(const execution_space& exec, const rowmap_t& rowmap,
   bool useRadix = !KokkosKernels::Impl::kk_is_gpu_exec_space<execution_space>();
   lno_t numRows = rowmap.extent(0) ? rowmap.extent(0) - 1 : 0;
   if (numRows == 0) return;
-  Impl::SortCrsGraphFunctor<execution_space, rowmap_t, entries_t> funct(
-      useRadix, rowmap, entries);
-  if (useRadix) {
-    Kokkos::parallel_for("sort_crs_graph",
-                         Kokkos::RangePolicy<execution_space>(exec, 0, numRows),
-                         funct);
-  } else {
-    // Try to get teamsize to be largest power of 2 less than or equal to
-    // half the entries per row. 0.5 * #entries is bitonic's parallelism within
-    // a row.
-    // TODO (probably important for performnce): add thread-level sort also, and
-    // use that for small avg degree. But this works for now.
-    lno_t idealTeamSize = 1;
-    lno_t avgDeg        = (entries.extent(0) + numRows - 1) / numRows;
-    while (idealTeamSize < avgDeg / 2) {
-      idealTeamSize *= 2;
+  rows_t shortRows, mediumRows, hugeRows;
+  Impl::sort_crs_select_rows(exec, rowmap, entries, shortRows, mediumRows,
+                             hugeRows);
+  if (shortRows.extent(0)) {
+    Kokkos::parallel_for(
+        "sort_crs_graph::short_rows", range_t(exec, 0, shortRows.extent(0)),
+        Impl::SortCrsGraphShortRowsFunctor<rowmap_t, entries_t, rows_t>{
+            rowmap, entries, shortRows});
+  }
+  lno_t numMedium = mediumRows.extent(0);
+  if (numMedium) {
+    funct_t funct(useRadix, rowmap, entries, mediumRows);
+    if (useRadix) {
+      Kokkos::parallel_for("sort_crs_graph", range_t(exec, 0, numMedium),
+                           funct);
+    } else {
+      int teamSize =
+          Impl::sort_crs_medium_team_size(exec, rowmap, mediumRows, funct);
+      Kokkos::parallel_for("sort_crs_graph",
+                           team_pol(exec, numMedium, teamSize), funct);
     }
-    team_pol temp(exec, numRows, 1);
-    lno_t maxTeamSize = temp.team_size_max(funct, Kokkos::ParallelForTag());
-    lno_t teamSize    = std::min(idealTeamSize, maxTeamSize);
-    Kokkos::parallel_for("sort_crs_graph", team_pol(exec, numRows, teamSize),
-                         funct);
   }
+  Impl::sort_crs_huge_rows(exec, rowmap, entries, rows_t(), hugeRows);
 }
 
 template <typename execution_space, typename rowmap_t, typename entries_t>
@@ -0,0 +1,465 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+/// \file KokkosSparse_VbrMatrix.hpp
+/// \brief Local sparse matrix interface
+///
+/// This file provides KokkosSparse::Experimental::VbrMatrix, a variable block
+/// row (VBR) copy of a CrsMatrix for sparse matrix-vector products.
+
+#ifndef KOKKOS_SPARSE_VBRMATRIX_HPP_
+#define KOKKOS_SPARSE_VBRMATRIX_HPP_
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Kokkos_Core.hpp"
+#include "KokkosKernels_Error.hpp"
+#include "KokkosKernels_SimpleUtils.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_crs_to_bsr_parallel_impl.hpp"
+#include "KokkosSparse_VbrMatrix_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+/// \class VbrMatrix
+///
+/// \brief Variable block row copy of a CrsMatrix.
+///
+/// The rows are partitioned in numBlockRows() block rows: block row I holds
+/// the rows row_part(I), ..., row_part(I + 1) - 1. The columns are
+/// partitioned the same way by col_part. Every nonzero block (I, J) is stored
+/// densely, row-major, and the blocks are stored in CRS order: the blocks of
+/// block row I are block_row_map(I), ..., block_row_map(I + 1) - 1, block b
+/// is in the column block block_entries(b) and its values start at
+/// values(block_offsets(b)).
+///
+/// Matrices coming from systems with several unknowns per node (such as
+/// mixed finite elements) have blocks of different sizes, which a BsrMatrix
+/// cannot store without padding. The partitions are either given, or
+/// detected from the supervariables of the matrix: the consecutive rows with
+/// the same pattern.
+///
+/// spmv processes one block row per thread, and sorts the block rows by
+/// number of rows: the block rows and columns with 1 to
+/// Impl::VBR_MAX_STATIC_BLOCK rows use dense kernels with compile-time
+/// sizes, the larger ones a generic kernel.
+///
+/// \tparam ScalarType The type of scalar entries in the sparse matrix.
+/// \tparam OrdinalType The type of index entries in the sparse matrix.
+/// \tparam Device The Kokkos Device type.
+/// \tparam SizeType The type of row offsets.
+template <class ScalarType, class OrdinalType, class Device,
+          class SizeType = typename Kokkos::ViewTraits<OrdinalType*, Device,
+                                                       void, void>::size_type>
+class VbrMatrix {
+ public:
+  //! Type of each value in the matrix
+  using scalar_type = ScalarType;
+  //! Non constant scalar type
+  using non_const_scalar_type = std::remove_const_t<scalar_type>;
+  //! Type of each index in the matrix
+  using ordinal_type = OrdinalType;
+  //! Type of the Kokkos::Device
+  using device_type = Device;
+  //! Type of the Kokkos::Device::execution_space
+  using execution_space = typename device_type::execution_space;
+  //! Type of the Kokkos::Device::memory_space
+  using memory_space = typename device_type::memory_space;
+  //! Type of row offsets
+  using size_type = SizeType;
+
+  //! The type of the row and column partitions
+  using partition_type = Kokkos::View<ordinal_type*, device_type>;
+  //! The type of the block row offsets and of the block value offsets
+  using block_map_type = Kokkos::View<size_type*, device_type>;
+  //! The type of the column block indices
+  using index_type = Kokkos::View<ordinal_type*, device_type>;
+  //! The type of the values
+  using values_type = Kokkos::View<scalar_type*, device_type>;
+
+  //! First row of every block row, plus numRows()
+  partition_type row_part;
+  //! First column of every block column, plus numCols()
+  partition_type col_part;
+  //! First block of every block row, plus nnz()
+  block_map_type block_row_map;
+  //! Column block of every block
+  index_type block_entries;
+  //! First value of every block, plus the number of values
+  block_map_type block_offsets;
+  //! Values of the blocks, row-major
+  values_type values;
+  //! The block rows, sorted by number of rows (see block_rows_of_size)
+  partition_type block_rows;
+
+ private:
+  ordinal_type m_num_rows, m_num_cols;
+  // block_rows of size R are block_rows(m_class_begin[R], m_class_begin[R+1])
+  std::vector<ordinal_type> m_class_begin;
+
+ public:
+  /// \brief Default constructor; constructs an empty sparse matrix.
+  VbrMatrix()
+      : m_num_rows(0),
+        m_num_cols(0),
+        m_class_begin(KokkosSparse::Impl::VBR_MAX_STATIC_BLOCK + 2, 0) {}
+
+  /// \brief Constructor from a CrsMatrix and given partitions.
+  ///
+  /// \param A [in] The matrix.
+  /// \param rowPart [in] The row partition: increasing, from 0 to
+  ///   A.numRows().
+  /// \param colPart [in] The column partition: increasing, from 0 to
+  ///   A.numCols().
+  template <typename CrsMatrixType,
+            typename std::enable_if<KokkosSparse::is_crs_matrix<
+                CrsMatrixType>::value>::type* = nullptr>
+  VbrMatrix(const CrsMatrixType& A, const partition_type& rowPart,
+            const partition_type& colPart)
+      : row_part(rowPart),
+        col_part(colPart),
+        m_num_rows(A.numRows()),
+        m_num_cols(A.numCols()) {
+    check_partition(row_part, m_num_rows, "row");
+    check_partition(col_part, m_num_cols, "column");
+    build(KokkosSparse::Impl::crs_with_sorted_rows(A));
+  }
+
+  /// \brief Constructor from a CrsMatrix, detecting the partitions (see
+  /// detect_partition). The column partition is the row partition if A is
+  /// square, and one column per block column otherwise.
+  ///
+  /// \param A [in] The matrix.
+  /// \param max_block_size [in] The largest number of rows of a block row.
+  template <typename CrsMatrixType,
+            typename std::enable_if<KokkosSparse::is_crs_matrix<
+                CrsMatrixType>::value>::type* = nullptr>
+  explicit VbrMatrix(
+      const CrsMatrixType& A,
+      ordinal_type max_block_size = KokkosSparse::Impl::VBR_MAX_STATIC_BLOCK)
+      : m_num_rows(A.numRows()), m_num_cols(A.numCols()) {
+    const CrsMatrixType sorted = KokkosSparse::Impl::crs_with_sorted_rows(A);
+    row_part = detect_partition_sorted(sorted, max_block_size);
+    if (m_num_rows == m_num_cols) {
+      col_part = row_part;
+    } else {
+      col_part = partition_type(
+          Kokkos::view_alloc(Kokkos::WithoutInitializing, "VbrMatrix col_part"),
+          m_num_cols + 1);
+      KokkosKernels::Impl::sequential_fill(col_part);
+    }
+    build(sorted);
+  }
+
+  /// \brief The row partition of A in supervariables, the maximal ranges of
+  /// consecutive rows with the same pattern, split in block rows of at most
+  /// max_block_size rows.
+  template <typename CrsMatrixType,
+            typename std::enable_if<KokkosSparse::is_crs_matrix<
+                CrsMatrixType>::value>::type* = nullptr>
+  static partition_type detect_partition(
+      const CrsMatrixType& A,
+      ordinal_type max_block_size = KokkosSparse::Impl::VBR_MAX_STATIC_BLOCK) {
+    return detect_partition_sorted(KokkosSparse::Impl::crs_with_sorted_rows(A),
+                                   max_block_size);
+  }
+
+  //! The number of rows in the sparse matrix.
+  KOKKOS_INLINE_FUNCTION ordinal_type numRows() const { return m_num_rows; }
+
+  //! The number of columns in the sparse matrix.
+  KOKKOS_INLINE_FUNCTION ordinal_type numCols() const { return m_num_cols; }
+
+  //! The number of block rows.
+  KOKKOS_INLINE_FUNCTION ordinal_type numBlockRows() const {
+    return row_part.extent(0) ? row_part.extent(0) - 1 : 0;
+  }
+
+  //! The number of block columns.
+  KOKKOS_INLINE_FUNCTION ordinal_type numBlockCols() const {
+    return col_part.extent(0) ? col_part.extent(0) - 1 : 0;
+  }
+
+  //! The number of nonzero blocks.
+  KOKKOS_INLINE_FUNCTION size_type nnz() const {
+    return block_entries.extent(0);
+  }
+
+  /// \brief The block rows with R rows, for R = 1, ...,
+  /// Impl::VBR_MAX_STATIC_BLOCK; for R = 0, the block rows with more rows.
+  auto block_rows_of_size(int R) const {
+    return Kokkos::subview(
+        block_rows, std::make_pair(m_class_begin[R], m_class_begin[R + 1]));
+  }
+
+ private:
+  static void check_partition(const partition_type& part, ordinal_type dim,
+                              const char* name) {
+    std::ostringstream os;
+    os << "VbrMatrix: the " << name << " partition ";
+    if (part.extent(0) == 0) {
+      os << "is empty";
+      throw std::invalid_argument(os.str());
+    }
+    const ordinal_type numParts = part.extent(0) - 1;
+    ordinal_type first = 0, last = 0, decreasing = 0;
+    Kokkos::parallel_reduce(
+        "KokkosSparse::VbrMatrix::check_partition",
+        Kokkos::RangePolicy<execution_space>(0, numParts),
+        KokkosSparse::Impl::VbrCheckPartitionFunctor<partition_type>{part},
+        decreasing);
+    Kokkos::deep_copy(first, Kokkos::subview(part, 0));
+    Kokkos::deep_copy(last, Kokkos::subview(part, numParts));
+    if (first != 0 || last != dim || decreasing) {
+      os << "must increase from 0 to " << dim;
+      throw std::invalid_argument(os.str());
+    }
+  }
+
+  template <typename CrsMatrixType>
+  static partition_type detect_partition_sorted(const CrsMatrixType& A,
+                                                ordinal_type maxBlock) {
+    using range_t = Kokkos::RangePolicy<execution_space>;
+    using flags_t = Kokkos::View<char*, device_type>;
+    if (maxBlock < 1) {
+      throw std::invalid_argument(
+          "VbrMatrix: max_block_size must be positive");
+    }
+    const ordinal_type n = A.numRows();
+    execution_space exec;
+    if (n == 0) return partition_type("VbrMatrix row_part", 1);
+
+    // the supervariables
+    flags_t starts(Kokkos::view_alloc(Kokkos::WithoutInitializing, "starts"),
+                   n);
+    Kokkos::parallel_for(
+        "KokkosSparse::VbrMatrix::supervariables", range_t(exec, 0, n),
+        KokkosSparse::Impl::VbrSupervariableFunctor<
+            typename CrsMatrixType::row_map_type,
+            typename CrsMatrixType::index_type, flags_t>{
+            A.graph.row_map, A.graph.entries, starts});
+    ordinal_type numSvars = 0;
+    Kokkos::parallel_scan(
+        "KokkosSparse::VbrMatrix::count_supervariables",
+        range_t(exec, 0, n + 1),
+        KokkosSparse::Impl::VbrCompactFunctor<flags_t, partition_type>{
+            starts, partition_type(), n},
+        numSvars);
+    partition_type svars(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "svars"),
+        numSvars + 1);
+    Kokkos::parallel_scan(
+        "KokkosSparse::VbrMatrix::list_supervariables",
+        range_t(exec, 0, n + 1),
+        KokkosSparse::Impl::VbrCompactFunctor<flags_t, partition_type>{
+            starts, svars, n});
+
+    // split the supervariables larger than maxBlock
+    partition_type offsets("offsets", numSvars + 1);
+    Kokkos::parallel_for(
+        "KokkosSparse::VbrMatrix::count_blocks", range_t(exec, 0, numSvars),
+        KokkosSparse::Impl::VbrSplitFunctor<partition_type, false>{
+            svars, offsets, partition_type(), maxBlock});
+    ordinal_type numBlocks = 0;
+    KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<execution_space>(
+        exec, numSvars + 1, offsets, numBlocks);
+    partition_type part(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "VbrMatrix row_part"),
+        numBlocks + 1);
+    Kokkos::parallel_for(
+        "KokkosSparse::VbrMatrix::split_blocks", range_t(exec, 0, numSvars),
+        KokkosSparse::Impl::VbrSplitFunctor<partition_type, true>{
+            svars, offsets, part, maxBlock});
+    Kokkos::deep_copy(exec, Kokkos::subview(part, numBlocks), n);
+    exec.fence();
+    return part;
+  }
+
+  template <typename CrsMatrixType>
+  void build(const CrsMatrixType& A) {
+    using range_t    = Kokkos::RangePolicy<execution_space>;
+    using rowmap_t   = typename CrsMatrixType::row_map_type;
+    using entries_t  = typename CrsMatrixType::index_type;
+    using crs_vals_t = typename CrsMatrixType::values_type;
+    using select_t =
+        KokkosSparse::Impl::VbrSelectRowsFunctor<partition_type,
+                                                 partition_type>;
+    constexpr int numClasses = KokkosSparse::Impl::VBR_MAX_STATIC_BLOCK + 1;
+
+    const ordinal_type nbr = numBlockRows();
+    const ordinal_type nbc = numBlockCols();
+    execution_space exec;
+    partition_type colToBlock(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "colToBlock"),
+        m_num_cols);
+    Kokkos::parallel_for(
+        "KokkosSparse::VbrMatrix::column_blocks", range_t(exec, 0, nbc),
+        KokkosSparse::Impl::VbrColumnMapFunctor<partition_type,
+                                                partition_type>{col_part,
+                                                                colToBlock});
+
+    // block row map: count the blocks of every block row, then scan
+    block_row_map = block_map_type("VbrMatrix block_row_map", nbr + 1);
+    Kokkos::parallel_for(
+        "KokkosSparse::VbrMatrix::count_blocks", range_t(exec, 0, nbr),
+        KokkosSparse::Impl::VbrFillFunctor<
+            rowmap_t, entries_t, crs_vals_t, partition_type, block_map_type,
+            index_type, values_type, 0>{A.graph.row_map, A.graph.entries,
+                                        A.values, row_part, col_part,
+                                        colToBlock, block_row_map,
+                                        index_type(), block_map_type(),
+                                        values_type()});
+    size_type numBlocks = 0;
+    KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<execution_space>(
+        exec, nbr + 1, block_row_map, numBlocks);
+
+    // column blocks and sizes of the blocks, then scan the sizes
+    block_entries = index_type(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "VbrMatrix entries"),
+        numBlocks);
+    block_offsets = block_map_type("VbrMatrix block_offsets", numBlocks + 1);
+    Kokkos::parallel_for(
+        "KokkosSparse::VbrMatrix::block_entries", range_t(exec, 0, nbr),
+        KokkosSparse::Impl::VbrFillFunctor<
+            rowmap_t, entries_t, crs_vals_t, partition_type, block_map_type,
+            index_type, values_type, 1>{A.graph.row_map, A.graph.entries,
+                                        A.values, row_part, col_part,
+                                        colToBlock, block_row_map,
+                                        block_entries, block_offsets,
+                                        values_type()});
+    size_type numValues = 0;
+    KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<execution_space>(
+        exec, numBlocks + 1, block_offsets, numValues);
+
+    values = values_type("VbrMatrix values", numValues);
+    Kokkos::parallel_for(
+        "KokkosSparse::VbrMatrix::block_values", range_t(exec, 0, nbr),
+        KokkosSparse::Impl::VbrFillFunctor<
+            rowmap_t, entries_t, crs_vals_t, partition_type, block_map_type,
+            index_type, values_type, 2>{A.graph.row_map, A.graph.entries,
+                                        A.values, row_part, col_part,
+                                        colToBlock, block_row_map,
+                                        block_entries, block_offsets, values});
+
+    // the block rows, by number of rows
+    m_class_begin.assign(numClasses + 1, 0);
+    for (int R = 0; R < numClasses; R++) {
+      ordinal_type count = 0;
+      Kokkos::parallel_scan("KokkosSparse::VbrMatrix::count_size_class",
+                            range_t(exec, 0, nbr),
+                            select_t{row_part, partition_type(), R}, count);
+      m_class_begin[R + 1] = m_class_begin[R] + count;
+    }
+    block_rows = partition_type(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "VbrMatrix block_rows"),
+        nbr);
+    for (int R = 0; R < numClasses; R++) {
+      if (m_class_begin[R] == m_class_begin[R + 1]) continue;
+      Kokkos::parallel_scan("KokkosSparse::VbrMatrix::list_size_class",
+                            range_t(exec, 0, nbr),
+                            select_t{row_part, block_rows_of_size(R), R});
+    }
+    exec.fence();
+  }
+};
+
+/// \class is_vbr_matrix
+/// \brief is_vbr_matrix<T>::value is true if T is a VbrMatrix<...>, false
+/// otherwise
+template <typename>
+struct is_vbr_matrix : public std::false_type {};
+template <typename... P>
+struct is_vbr_matrix<VbrMatrix<P...>> : public std::true_type {};
+template <typename... P>
+struct is_vbr_matrix<const VbrMatrix<P...>> : public std::true_type {};
+
+/// \brief y := beta * y + alpha * A * x, for a VbrMatrix A.
+///
+/// \param space [in] The execution space instance on which to run.
+/// \param mode [in] "N" for no transpose (the only supported mode).
+/// \param alpha [in] Scalar multiplier for the matrix A.
+/// \param A [in] The sparse matrix A.
+/// \param x [in] A vector to multiply on the left by A.
+/// \param beta [in] Scalar multiplier for the vector y.
+/// \param y [in/out] Result vector.
+template <class ExecutionSpace, class AlphaType, class AMatrix, class XVector,
+          class BetaType, class YVector,
+          typename std::enable_if<is_vbr_matrix<AMatrix>::value>::type* =
+              nullptr>
+void spmv(const ExecutionSpace& space, const char mode[],
+          const AlphaType& alpha, const AMatrix& A, const XVector& x,
+          const BetaType& beta, const YVector& y) {
+  static_assert(Kokkos::is_view<XVector>::value && XVector::rank == 1,
+                "KokkosSparse::Experimental::spmv (VbrMatrix): x must be a "
+                "rank-1 Kokkos::View.");
+  static_assert(Kokkos::is_view<YVector>::value && YVector::rank == 1,
+                "KokkosSparse::Experimental::spmv (VbrMatrix): y must be a "
+                "rank-1 Kokkos::View.");
+  static_assert(
+      std::is_same<typename YVector::value_type,
+                   typename YVector::non_const_value_type>::value,
+      "KokkosSparse::Experimental::spmv (VbrMatrix): y must be nonconst.");
+  if (mode[0] != NoTranspose[0]) {
+    KokkosKernels::Impl::throw_runtime_exception(
+        "KokkosSparse::Experimental::spmv (VbrMatrix): only mode \"N\" is "
+        "supported.");
+  }
+  if (x.extent(0) != size_t(A.numCols()) ||
+      y.extent(0) != size_t(A.numRows())) {
+    std::ostringstream os;
+    os << "KokkosSparse::Experimental::spmv (VbrMatrix): Dimensions do not "
+          "match: A is "
+       << A.numRows() << " x " << A.numCols() << ", x is " << x.extent(0)
+       << ", y is " << y.extent(0) << ".";
+    KokkosKernels::Impl::throw_runtime_exception(os.str());
+  }
+  using scalar_t = typename AMatrix::non_const_scalar_type;
+  using KokkosSparse::Impl::vbr_spmv_size_class;
+  static_assert(KokkosSparse::Impl::VBR_MAX_STATIC_BLOCK == 6,
+                "KokkosSparse::Experimental::spmv (VbrMatrix): one launch per "
+                "size class");
+
+  const scalar_t a(alpha), b(beta);
+  vbr_spmv_size_class<1>(space, A, x, y, a, b);
+  vbr_spmv_size_class<2>(space, A, x, y, a, b);
+  vbr_spmv_size_class<3>(space, A, x, y, a, b);
+  vbr_spmv_size_class<4>(space, A, x, y, a, b);
+  vbr_spmv_size_class<5>(space, A, x, y, a, b);
+  vbr_spmv_size_class<6>(space, A, x, y, a, b);
+  vbr_spmv_size_class<0>(space, A, x, y, a, b);
+}
+
+/// \brief y := beta * y + alpha * A * x, for a VbrMatrix A, on the default
+/// instance of the execution space of A.
+template <class AlphaType, class AMatrix, class XVector, class BetaType,
+          class YVector,
+          typename std::enable_if<is_vbr_matrix<AMatrix>::value>::type* =
+              nullptr>
+void spmv(const char mode[], const AlphaType& alpha, const AMatrix& A,
+          const XVector& x, const BetaType& beta, const YVector& y) {
+  spmv(typename AMatrix::execution_space{}, mode, alpha, A, x, beta, y);
+}
+
+}  // namespace Experimental
+}  // namespace KokkosSparse
+
+#endif  // KOKKOS_SPARSE_VBRMATRIX_HPP_
@@ -0,0 +1,178 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#ifndef _KOKKOSSPARSE_CRS_TO_BSR_HPP
+#define _KOKKOSSPARSE_CRS_TO_BSR_HPP
+
+/// \file KokkosSparse_crs_to_bsr.hpp
+/// \brief Device-parallel conversion of a CrsMatrix to a BsrMatrix, with the
+///        choice of the block size from the fill ratio.
+
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_BsrMatrix.hpp"
+#include "KokkosSparse_crs_detect_block_size.hpp"
+#include "KokkosSparse_crs_to_bsr_parallel_impl.hpp"
+
+namespace KokkosSparse {
+
+namespace Impl {
+
+// bsr_fill_ratio for a matrix with sorted rows
+template <typename Crs>
+double bsr_fill_ratio_sorted(const Crs &A,
+                             typename Crs::non_const_ordinal_type blockSize) {
+  using bsr_rowmap_t = Kokkos::View<typename Crs::non_const_size_type *,
+                                    typename Crs::device_type>;
+  if (blockSize < 1 || A.numRows() % blockSize || A.numCols() % blockSize) {
+    return std::numeric_limits<double>::infinity();
+  }
+  if (A.nnz() == 0) return 1.0;
+  bsr_rowmap_t bsrRowMap("bsrRowMap", A.numRows() / blockSize + 1);
+  const size_t numBlocks = crs_count_blocks(A, blockSize, bsrRowMap);
+  return double(numBlocks) * blockSize * blockSize / A.nnz();
+}
+
+}  // namespace Impl
+
+/// \brief The fill ratio of the BsrMatrix with blocks of size blockSize
+/// holding A: the number of values it stores (blocks * blockSize^2) divided
+/// by the number of entries of A. 1 means that all the blocks are dense.
+///
+/// Returns infinity if blockSize does not divide the dimensions of A.
+template <typename Crs>
+double bsr_fill_ratio(const Crs &A,
+                      typename Crs::non_const_ordinal_type blockSize) {
+  return Impl::bsr_fill_ratio_sorted(Impl::crs_with_sorted_rows(A), blockSize);
+}
+
+/// \brief The fill ratios of A for several candidate block sizes (see
+/// bsr_fill_ratio). The rows of A are sorted (in a copy) at most once.
+template <typename Crs>
+std::vector<double> bsr_fill_ratios(
+    const Crs &A,
+    const std::vector<typename Crs::non_const_ordinal_type> &blockSizes) {
+  const Crs sorted = Impl::crs_with_sorted_rows(A);
+  std::vector<double> ratios;
+  ratios.reserve(blockSizes.size());
+  for (auto blockSize : blockSizes) {
+    ratios.push_back(Impl::bsr_fill_ratio_sorted(sorted, blockSize));
+  }
+  return ratios;
+}
+
+/// \brief Converts A to a BsrMatrix with blocks of size blockSize, on the
+/// device. The entries of A that are not in a dense block are padded with
+/// zeros, and duplicate entries are summed.
+///
+/// \tparam Bsr The BsrMatrix type; its memory space must be the one of A.
+/// \param A [in] The matrix; its dimensions must be multiples of blockSize.
+/// \param blockSize [in] The block size.
+template <typename Bsr, typename Crs>
+Bsr crs_to_bsr(const Crs &A, typename Crs::non_const_ordinal_type blockSize) {
+  static_assert(std::is_same_v<typename Bsr::memory_space,
+                               typename Crs::memory_space>,
+                "crs_to_bsr: the BsrMatrix and the CrsMatrix must have the "
+                "same memory space");
+  using execution_space = typename Crs::execution_space;
+  using bsr_rowmap_t =
+      Kokkos::View<typename Bsr::row_map_type::non_const_data_type,
+                   typename Bsr::device_type>;
+  using bsr_entries_t = typename Bsr::index_type::non_const_type;
+  using bsr_values_t  = typename Bsr::values_type::non_const_type;
+
+  if (blockSize < 1 || A.numRows() % blockSize || A.numCols() % blockSize) {
+    std::ostringstream os;
+    os << "crs_to_bsr: the block size " << blockSize
+       << " does not divide the dimensions " << A.numRows() << " x "
+       << A.numCols() << " of the matrix";
+    throw std::invalid_argument(os.str());
+  }
+  const Crs sorted = Impl::crs_with_sorted_rows(A);
+  const typename Crs::non_const_ordinal_type numBlockRows =
+      A.numRows() / blockSize;
+  bsr_rowmap_t bsrRowMap("bsrRowMap", numBlockRows + 1);
+  const size_t numBlocks = Impl::crs_count_blocks(sorted, blockSize, bsrRowMap);
+  bsr_entries_t bsrEntries(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "bsrEntries"),
+      numBlocks);
+  bsr_values_t bsrValues("bsrValues", numBlocks * blockSize * blockSize);
+  execution_space exec;
+  Kokkos::parallel_for(
+      "KokkosSparse::crs_to_bsr",
+      Kokkos::RangePolicy<execution_space>(exec, 0, numBlockRows),
+      Impl::CrsToBsrFunctor<typename Crs::row_map_type,
+                            typename Crs::index_type, typename Crs::values_type,
+                            bsr_rowmap_t, bsr_entries_t, bsr_values_t, true>{
+          sorted.graph.row_map, sorted.graph.entries, sorted.values, bsrRowMap,
+          bsrEntries, bsrValues, blockSize});
+  exec.fence();
+  return Bsr("", numBlockRows, A.numCols() / blockSize,
+             numBlocks * blockSize * blockSize, bsrValues, bsrRowMap,
+             bsrEntries, blockSize);
+}
+
+/// \brief Converts A to a BsrMatrix, choosing the block size.
+///
+/// The block size starts from the largest one giving only dense blocks
+/// (Impl::detect_block_size). The larger block sizes up to maxBlockSize
+/// that divide the dimensions of A are then tried, and the largest one whose
+/// fill ratio is at most maxFillRatio is used: maxFillRatio caps the zero
+/// padding the caller accepts (1 accepts none).
+///
+/// \param A [in] The matrix.
+/// \param maxFillRatio [in] The largest acceptable fill ratio (>= 1).
+/// \param maxBlockSize [in] The largest block size tried.
+/// \param fillRatios [out] If not null, the (block size, fill ratio) pairs
+///   that were computed, the detected dense block size first.
+template <typename Bsr, typename Crs>
+Bsr crs_to_bsr_auto(
+    const Crs &A, double maxFillRatio = 1.0,
+    typename Crs::non_const_ordinal_type maxBlockSize = 16,
+    std::vector<std::pair<typename Crs::non_const_ordinal_type, double>>
+        *fillRatios = nullptr) {
+  using lno_t = typename Crs::non_const_ordinal_type;
+  if (maxFillRatio < 1.0) {
+    throw std::invalid_argument("crs_to_bsr_auto: maxFillRatio must be >= 1");
+  }
+  const Crs sorted = Impl::crs_with_sorted_rows(A);
+  lno_t blockSize  = Impl::detect_block_size(sorted);
+  if (fillRatios) {
+    fillRatios->clear();
+    fillRatios->emplace_back(blockSize, 1.0);
+  }
+  if (maxFillRatio > 1.0) {
+    const lno_t dense = blockSize;
+    for (lno_t trialSize = dense + 1; trialSize <= maxBlockSize; trialSize++) {
+      if (A.numRows() % trialSize || A.numCols() % trialSize) continue;
+      const double ratio = Impl::bsr_fill_ratio_sorted(sorted, trialSize);
+      if (fillRatios) fillRatios->emplace_back(trialSize, ratio);
+      if (ratio <= maxFillRatio) blockSize = trialSize;
+    }
+  }
+  return crs_to_bsr<Bsr>(sorted, blockSize);
+}
+
+}  // namespace KokkosSparse
+
+#endif  // _KOKKOSSPARSE_CRS_TO_BSR_HPP
@@ -20,6 +20,7 @@
 #include "KokkosKernels_Handle.hpp"
 #include "KokkosKernels_helpers.hpp"
 #include "KokkosKernels_Error.hpp"
+#include "KokkosSparse_ConvergenceMonitor.hpp"
 
 namespace KokkosSparse {
 
@@ -1345,5 +1346,146 @@ void backward_sweep_block_gauss_seidel_apply(
       y_rhs_input_vec, init_zero_x_vector, update_y_vector, omega, numIter);
 }
 }  // namespace Experimental
+
+namespace Impl {
+
+// Runs sweep(num_sweeps, update_y) until the monitor stops, computing the
+// residual only every monitor.get_check_interval() sweeps.
+template <typename ExecutionSpace, typename lno_row_view_t_,
+          typename lno_nnz_view_t_, typename scalar_nnz_view_t_,
+          typename x_scalar_view_t, typename y_scalar_view_t, typename mag_t,
+          typename Sweep>
+int gauss_seidel_apply_monitored(
+    const ExecutionSpace &space,
+    typename lno_nnz_view_t_::non_const_value_type num_rows,
+    lno_row_view_t_ row_map, lno_nnz_view_t_ entries, scalar_nnz_view_t_ values,
+    x_scalar_view_t x_lhs_output_vec, y_scalar_view_t y_rhs_input_vec,
+    bool init_zero_x_vector, bool update_y_vector,
+    KokkosSparse::Experimental::ConvergenceMonitor<mag_t> &monitor,
+    Sweep &&sweep) {
+  using KokkosSparse::Experimental::residual_norm;
+  if (init_zero_x_vector) {
+    Kokkos::deep_copy(
+        space, x_lhs_output_vec,
+        typename x_scalar_view_t::non_const_value_type(0));
+  }
+  monitor.start(residual_norm(space, num_rows, row_map, entries, values,
+                              x_lhs_output_vec, y_rhs_input_vec));
+  int iter = 0;
+  while (!monitor.done()) {
+    const int num_sweeps = monitor.iterations_until_check(iter);
+    sweep(num_sweeps, update_y_vector && iter == 0);
+    iter += num_sweeps;
+    monitor.update(iter,
+                   residual_norm(space, num_rows, row_map, entries, values,
+                                 x_lhs_output_vec, y_rhs_input_vec));
+  }
+  return iter;
+}
+
+}  // namespace Impl
+
+namespace Experimental {
+
+///
+/// @brief Apply symmetric Gauss-Seidel to system AX=Y until the monitor
+/// stops: convergence, stagnation or monitor.get_max_iters() iterations.
+/// The residual ||Y - AX|| is computed every monitor.get_check_interval()
+/// iterations, with a single fused kernel.
+///
+/// @tparam KernelHandle A specialization of
+/// KokkosKernels::Experimental::KokkosKernelsHandle
+/// @param handle handle A KokkosKernelsHandle instance
+/// @param num_rows Number of rows in the matrix
+/// @param num_cols Number of columns in the matrix
+/// @param row_map The matrix's rowmap
+/// @param entries The matrix's entries
+/// @param values The matrix's values
+/// @param x_lhs_output_vec The X (left-hand side, unknown) vector
+/// @param y_rhs_input_vec The Y (right-hand side) vector
+/// @param init_zero_x_vector Whether to zero out X before applying
+/// @param update_y_vector Whether Y has changed since the last call to apply
+/// @param omega The damping factor for successive over-relaxation
+/// @param monitor The stopping criteria, also recording the residual history
+/// @return The number of iterations done (forward and backward counts as 1)
+/// @remark Only CRS matrices are supported.
+///
+template <typename KernelHandle, typename lno_row_view_t_,
+          typename lno_nnz_view_t_, typename scalar_nnz_view_t_,
+          typename x_scalar_view_t, typename y_scalar_view_t, typename mag_t>
+int symmetric_gauss_seidel_apply(
+    KernelHandle *handle, typename KernelHandle::const_nnz_lno_t num_rows,
+    typename KernelHandle::const_nnz_lno_t num_cols, lno_row_view_t_ row_map,
+    lno_nnz_view_t_ entries, scalar_nnz_view_t_ values,
+    x_scalar_view_t x_lhs_output_vec, y_scalar_view_t y_rhs_input_vec,
+    bool init_zero_x_vector, bool update_y_vector,
+    typename KernelHandle::nnz_scalar_t omega,
+    ConvergenceMonitor<mag_t> &monitor) {
+  auto my_exec_space = handle->get_gs_handle()->get_execution_space();
+  return KokkosSparse::Impl::gauss_seidel_apply_monitored(
+      my_exec_space, num_rows, row_map, entries, values, x_lhs_output_vec,
+      y_rhs_input_vec, init_zero_x_vector, update_y_vector, monitor,
+      [&](int num_sweeps, bool update_y) {
+        symmetric_gauss_seidel_apply<decltype(my_exec_space)>(
+            my_exec_space, handle, num_rows, num_cols, row_map, entries,
+            values, x_lhs_output_vec, y_rhs_input_vec, false, update_y, omega,
+            num_sweeps);
+      });
+}
+
+///
+/// @brief Apply forward Gauss-Seidel to system AX=Y until the monitor stops.
+/// See the monitored symmetric_gauss_seidel_apply.
+///
+template <typename KernelHandle, typename lno_row_view_t_,
+          typename lno_nnz_view_t_, typename scalar_nnz_view_t_,
+          typename x_scalar_view_t, typename y_scalar_view_t, typename mag_t>
+int forward_sweep_gauss_seidel_apply(
+    KernelHandle *handle, typename KernelHandle::const_nnz_lno_t num_rows,
+    typename KernelHandle::const_nnz_lno_t num_cols, lno_row_view_t_ row_map,
+    lno_nnz_view_t_ entries, scalar_nnz_view_t_ values,
+    x_scalar_view_t x_lhs_output_vec, y_scalar_view_t y_rhs_input_vec,
+    bool init_zero_x_vector, bool update_y_vector,
+    typename KernelHandle::nnz_scalar_t omega,
+    ConvergenceMonitor<mag_t> &monitor) {
+  auto my_exec_space = handle->get_gs_handle()->get_execution_space();
+  return KokkosSparse::Impl::gauss_seidel_apply_monitored(
+      my_exec_space, num_rows, row_map, entries, values, x_lhs_output_vec,
+      y_rhs_input_vec, init_zero_x_vector, update_y_vector, monitor,
+      [&](int num_sweeps, bool update_y) {
+        forward_sweep_gauss_seidel_apply<decltype(my_exec_space)>(
+            my_exec_space, handle, num_rows, num_cols, row_map, entries,
+            values, x_lhs_output_vec, y_rhs_input_vec, false, update_y, omega,
+            num_sweeps);
+      });
+}
+
+///
+/// @brief Apply backward Gauss-Seidel to system AX=Y until the monitor stops.
+/// See the monitored symmetric_gauss_seidel_apply.
+///
+template <typename KernelHandle, typename lno_row_view_t_,
+          typename lno_nnz_view_t_, typename scalar_nnz_view_t_,
+          typename x_scalar_view_t, typename y_scalar_view_t, typename mag_t>
+int backward_sweep_gauss_seidel_apply(
+    KernelHandle *handle, typename KernelHandle::const_nnz_lno_t num_rows,
+    typename KernelHandle::const_nnz_lno_t num_cols, lno_row_view_t_ row_map,
+    lno_nnz_view_t_ entries, scalar_nnz_view_t_ values,
+    x_scalar_view_t x_lhs_output_vec, y_scalar_view_t y_rhs_input_vec,
+    bool init_zero_x_vector, bool update_y_vector,
+    typename KernelHandle::nnz_scalar_t omega,
+    ConvergenceMonitor<mag_t> &monitor) {
+  auto my_exec_space = handle->get_gs_handle()->get_execution_space();
+  return KokkosSparse::Impl::gauss_seidel_apply_monitored(
+      my_exec_space, num_rows, row_map, entries, values, x_lhs_output_vec,
+      y_rhs_input_vec, init_zero_x_vector, update_y_vector, monitor,
+      [&](int num_sweeps, bool update_y) {
+        backward_sweep_gauss_seidel_apply<decltype(my_exec_space)>(
+            my_exec_space, handle, num_rows, num_cols, row_map, entries,
+            values, x_lhs_output_vec, y_rhs_input_vec, false, update_y, omega,
+            num_sweeps);
+      });
+}
+}  // namespace Experimental
 }  // namespace KokkosSparse
 #endif
@@ -278,6 +278,9 @@ class PointGaussSeidelHandle
 
   // Coloring algorithm to use
   KokkosGraph::ColoringAlgorithm coloring_algo;
+  // Option set by user: rebalance the color set sizes after coloring (see
+  // KokkosGraph::Experimental::graph_color_balance), for fewer tiny color sets
+  bool balance_colors;
 
  public:
   /**
@@ -301,7 +304,8 @@ class PointGaussSeidelHandle
         level_1_mem(0),
         level_2_mem(0),
         long_row_threshold(0),
-        coloring_algo(coloring_algo_) {
+        coloring_algo(coloring_algo_),
+        balance_colors(false) {
     if (gs_handle.get_algorithm_type() == GS_DEFAULT)
       this->choose_default_algorithm();
   }
@@ -335,6 +339,9 @@ class PointGaussSeidelHandle
     this->coloring_algo = algo;
   }
 
+  bool get_balance_colors() const { return this->balance_colors; }
+  void set_balance_colors(bool balance) { this->balance_colors = balance; }
+
   ~PointGaussSeidelHandle() = default;
 
   // getters
@@ -680,7 +687,9 @@ class TwoStageGaussSeidelHandle
         two_stage(true),
         compact_form(false),
         num_inner_sweeps(1),
-        num_outer_sweeps(1) {
+        num_outer_sweeps(1),
+        fused_sweeps(false),
+        fused_block_size(0) {
     const scalar_t one(1.0);
     inner_omega = one;
   }
@@ -736,6 +745,21 @@ class TwoStageGaussSeidelHandle
   }
   scalar_t getInnerDampFactor() { return this->inner_omega; }
 
+  // specify whether to run the inner sweeps with the fused kernel
+  // (one pass over the rows per inner sweep, with the scaling, damping and
+  //  outer update applied in the same pass)
+  void setFusedSweeps(bool fused_sweeps_) {
+    this->fused_sweeps = fused_sweeps_;
+  }
+  bool isFusedSweeps() { return this->fused_sweeps; }
+
+  // Number of consecutive rows processed by a thread in the fused kernel
+  // (zero lets the execution space choose)
+  void setFusedBlockSize(int fused_block_size_) {
+    this->fused_block_size = fused_block_size_;
+  }
+  int getFusedBlockSize() { return this->fused_block_size; }
+
   // Workspaces
   // > diagonal (inverse)
   void setD(values_view_t D_) { this->D = D_; }
@@ -798,6 +822,8 @@ class TwoStageGaussSeidelHandle
   int num_inner_sweeps;
   int num_outer_sweeps;
   scalar_t inner_omega;
+  bool fused_sweeps;
+  int fused_block_size;
 };
 // -------------------------------------
 }  // namespace KokkosSparse
@@ -18,6 +18,7 @@
 
 #include <Kokkos_Core.hpp>
 #include <KokkosSparse_Preconditioner.hpp>
+#include <KokkosSparse_ConvergenceMonitor.hpp>
 #include <iostream>
 #include <string>
 
@@ -99,6 +100,7 @@ class GMRESHandle {
   size_type max_restart;  /// Maximum number of times to restart the solver
   Ortho ortho;            /// The orthogonalization type
   bool verbose;           /// Print extra info to stdout
+  ConvergenceMonitor<float_t> *monitor;  /// Optional residual history
 
   // Outputs
   int num_iters;        /// Number of iterations the sovler took
@@ -114,6 +116,7 @@ class GMRESHandle {
         max_restart(max_restart_),
         ortho(CGS2),
         verbose(false),
+        monitor(nullptr),
         num_iters(-1),
         end_rel_res(-1),
         conv_flag_val(NotRun) {
@@ -170,6 +173,16 @@ class GMRESHandle {
   KOKKOS_INLINE_FUNCTION
   void set_verbose(const bool verbose_) { this->verbose = verbose_; }
 
+  /// The monitor records the shortcut relative residual every
+  /// monitor->get_check_interval() iterations, and GMRES stops early if it
+  /// reports stagnation. Convergence is still decided by tol.
+  void set_convergence_monitor(ConvergenceMonitor<float_t> *monitor_) {
+    this->monitor = monitor_;
+  }
+  ConvergenceMonitor<float_t> *get_convergence_monitor() const {
+    return this->monitor;
+  }
+
   int get_num_iters() const {
     assert(get_conv_flag_val() != NotRun);
     return num_iters;
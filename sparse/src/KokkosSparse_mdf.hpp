@@ -77,6 +77,147 @@ void mdf_print_joined_view(
   }
 }
 
+/// \brief Numerical phase of MDF eliminating a distance-2 independent set
+/// of pivots per step, see MDF_handle::set_parallel_pivots.
+template <class crs_matrix_type, class MDF_handle>
+void mdf_numeric_parallel_pivots(const crs_matrix_type& A,
+                                 MDF_handle& handle) {
+  using col_ind_type = typename crs_matrix_type::StaticCrsGraphType::
+      entries_type::non_const_type;
+  using values_mag_type =
+      typename KokkosSparse::Impl::MDF_types<crs_matrix_type>::values_mag_type;
+  using ordinal_type   = typename crs_matrix_type::ordinal_type;
+  using value_mag_type = typename values_mag_type::value_type;
+
+  using device_type       = typename crs_matrix_type::device_type;
+  using execution_space   = typename crs_matrix_type::execution_space;
+  using range_policy_type = Kokkos::RangePolicy<ordinal_type, execution_space>;
+  using team_range_policy_type = Kokkos::TeamPolicy<execution_space>;
+
+  using permutation_set_type =
+      Kokkos::UnorderedMap<ordinal_type, void, device_type>;
+  using finalize_type =
+      KokkosSparse::Impl::MDF_finalize_pivots<crs_matrix_type>;
+
+  const int verbosity_level  = handle.verbosity;
+  const ordinal_type numRows = A.numRows();
+  crs_matrix_type Atmp       = crs_matrix_type("A fill", A);
+  crs_matrix_type At = KokkosSparse::Impl::transpose_matrix<crs_matrix_type>(A);
+  KokkosSparse::sort_crs_matrix<crs_matrix_type>(At);
+  values_mag_type discarded_fill("discarded fill", numRows);
+  col_ind_type deficiency("deficiency", numRows);
+  col_ind_type factored("factored rows", numRows);
+  col_ind_type selected("selected rows", numRows);
+  col_ind_type in_update_list("in update list", numRows);
+  col_ind_type update_list("update list", numRows);
+  col_ind_type new_permutation("new permutation", numRows);
+  typename finalize_type::count_type update_list_len_d("update list length");
+  ordinal_type update_list_len = 0;
+  Kokkos::deep_copy(discarded_fill, Kokkos::ArithTraits<value_mag_type>::max());
+  Kokkos::deep_copy(deficiency, Kokkos::ArithTraits<ordinal_type>::max());
+  permutation_set_type permutation_set(numRows);
+
+  KokkosSparse::Impl::MDF_discarded_fill_norm<crs_matrix_type, true>
+      MDF_df_norm(Atmp, At, 0, handle.permutation, permutation_set,
+                  discarded_fill, deficiency, verbosity_level);
+  Kokkos::parallel_for(
+      "MDF: initial fill computation",
+      team_range_policy_type(numRows, Kokkos::AUTO, Kokkos::AUTO),
+      MDF_df_norm);
+
+  handle.num_steps                = 0;
+  ordinal_type factorization_step = 0;
+  while (factorization_step < numRows) {
+    if (update_list_len > 0) {
+      team_range_policy_type updatePolicy(update_list_len, Kokkos::AUTO,
+                                          Kokkos::AUTO);
+      KokkosSparse::Impl::MDF_discarded_fill_norm<crs_matrix_type, false>
+          MDF_update_df_norm(Atmp, At, factorization_step, handle.permutation,
+                             permutation_set, discarded_fill, deficiency,
+                             verbosity_level, update_list);
+      Kokkos::parallel_for("MDF: updating fill norms", updatePolicy,
+                           MDF_update_df_norm);
+      Kokkos::parallel_for(
+          "MDF: reset update list", range_policy_type(0, update_list_len),
+          KokkosSparse::Impl::MDF_reset_update_list<col_ind_type>(
+              handle.permutation, update_list, in_update_list));
+    }
+
+    // Select the pivots of this step and move them to the front of the
+    // remaining rows in the permutation
+    range_policy_type remainingPolicy(factorization_step, numRows);
+    Kokkos::parallel_for(
+        "MDF: select pivots", remainingPolicy,
+        KokkosSparse::Impl::MDF_select_independent_pivots<crs_matrix_type>(
+            Atmp, At, handle.permutation, discarded_fill, deficiency, factored,
+            selected));
+    KokkosSparse::Impl::MDF_partition_pivots<col_ind_type> partition(
+        handle.permutation, new_permutation, selected, factorization_step, 0);
+    ordinal_type num_pivots = 0;
+    Kokkos::parallel_scan("MDF: count pivots", remainingPolicy, partition,
+                          num_pivots);
+    partition.num_pivots = num_pivots;
+    Kokkos::parallel_scan("MDF: partition pivots", remainingPolicy, partition);
+    Kokkos::parallel_for(
+        "MDF: update permutation", remainingPolicy,
+        KokkosSparse::Impl::MDF_update_permutation<col_ind_type>(
+            handle.permutation, handle.permutation_inv, new_permutation));
+
+    // Offsets of the pivots in L and U
+    range_policy_type pivotPolicy(0, num_pivots);
+    Kokkos::parallel_for(
+        "MDF: count pivot entries", pivotPolicy,
+        KokkosSparse::Impl::MDF_count_pivot_entries<crs_matrix_type>(
+            Atmp, At, handle.row_mapL, handle.row_mapU, handle.permutation,
+            factored, factorization_step));
+    const auto pivots = Kokkos::make_pair(factorization_step,
+                                          factorization_step + num_pivots + 1);
+    KokkosKernels::Impl::kk_inclusive_parallel_prefix_sum<execution_space>(
+        num_pivots + 1, Kokkos::subview(handle.row_mapL, pivots));
+    KokkosKernels::Impl::kk_inclusive_parallel_prefix_sum<execution_space>(
+        num_pivots + 1, Kokkos::subview(handle.row_mapU, pivots));
+
+    Kokkos::parallel_for(
+        "MDF: eliminate pivots",
+        team_range_policy_type(num_pivots, Kokkos::AUTO, Kokkos::AUTO),
+        KokkosSparse::Impl::MDF_eliminate_pivots<crs_matrix_type>(
+            Atmp, At, handle.row_mapL, handle.entriesL, handle.valuesL,
+            handle.row_mapU, handle.entriesU, handle.valuesU,
+            handle.permutation, factored, factorization_step));
+
+    Kokkos::deep_copy(update_list_len_d, ordinal_type(0));
+    Kokkos::parallel_for(
+        "MDF: finalize pivots", pivotPolicy,
+        finalize_type(Atmp, At, handle.permutation, handle.permutation_inv,
+                      permutation_set, discarded_fill, factored,
+                      in_update_list, update_list, update_list_len_d,
+                      factorization_step));
+    Kokkos::deep_copy(update_list_len, update_list_len_d);
+
+    if (verbosity_level > 0) {
+      printf("MDF step %d: eliminated %d pivots, %d fill norms to update\n",
+             static_cast<int>(handle.num_steps), static_cast<int>(num_pivots),
+             static_cast<int>(update_list_len));
+    }
+    factorization_step += num_pivots;
+    ++handle.num_steps;
+  }
+
+  KokkosSparse::Impl::MDF_reindex_matrix<col_ind_type> reindex_U(
+      handle.permutation_inv, handle.entriesU);
+  Kokkos::parallel_for("MDF: re-index U",
+                       range_policy_type(0, handle.entriesU.extent(0)),
+                       reindex_U);
+
+  KokkosSparse::Impl::MDF_reindex_matrix<col_ind_type> reindex_L(
+      handle.permutation_inv, handle.entriesL);
+  Kokkos::parallel_for("MDF: re-index L",
+                       range_policy_type(0, handle.entriesL.extent(0)),
+                       reindex_L);
+
+  handle.L = KokkosSparse::Impl::transpose_matrix<crs_matrix_type>(handle.L);
+}  // mdf_numeric_parallel_pivots
+
 template <class crs_matrix_type, class MDF_handle>
 void mdf_numeric(const crs_matrix_type& A, MDF_handle& handle) {
   using col_ind_type = typename crs_matrix_type::StaticCrsGraphType::
@@ -101,6 +242,11 @@ void mdf_numeric(const crs_matrix_type& A, MDF_handle& handle) {
   //   compute discarded fill of each row
   //   selected pivot based on MDF
   //   factorize pivot row of A
+  if (handle.parallel_pivots) {
+    mdf_numeric_parallel_pivots(A, handle);
+    return;
+  }
+
   const int verbosity_level = handle.verbosity;
   crs_matrix_type Atmp      = crs_matrix_type("A fill", A);
   crs_matrix_type At = KokkosSparse::Impl::transpose_matrix<crs_matrix_type>(A);
@@ -221,6 +367,7 @@ void mdf_numeric(const crs_matrix_type& A, MDF_handle& handle) {
                        reindex_L);
 
   handle.L = KokkosSparse::Impl::transpose_matrix<crs_matrix_type>(handle.L);
+  handle.num_steps = A.numRows();
 
   return;
 }  // mdf_numeric
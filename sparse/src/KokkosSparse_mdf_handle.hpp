@@ -60,6 +60,13 @@ struct MDF_handle {
 
   int verbosity = 0;
 
+  // Eliminate a distance-2 independent set of pivots per step
+  // instead of a single pivot, see set_parallel_pivots.
+  bool parallel_pivots = false;
+
+  // Number of elimination steps done by the last mdf_numeric
+  ordinal_type num_steps = 0;
+
   crs_matrix_type L, U;
 
   MDF_handle(const crs_matrix_type& A)
@@ -70,6 +77,16 @@ struct MDF_handle {
 
   void set_verbosity(const int verbosity_level) { verbosity = verbosity_level; }
 
+  /// \brief Select and eliminate several pivots per step.
+  ///
+  /// Each step selects the rows whose discarded fill is minimal within
+  /// distance two in the graph of A + A^T, and eliminates them concurrently.
+  /// This is much faster than the sequential MDF on large matrices, at the
+  /// cost of an ordering that is only locally, instead of globally, greedy.
+  void set_parallel_pivots(const bool parallel) { parallel_pivots = parallel; }
+
+  ordinal_type get_num_steps() const { return num_steps; }
+
   void allocate_data(const size_type nnzL, const size_type nnzU) {
     // Allocate L
     row_mapL = row_map_type("row map L", numRows + 1);
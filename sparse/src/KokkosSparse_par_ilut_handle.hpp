@@ -15,6 +15,7 @@
 //@HEADER
 
 #include <Kokkos_Core.hpp>
+#include <KokkosSparse_ConvergenceMonitor.hpp>
 #include <iostream>
 #include <string>
 
@@ -89,6 +90,8 @@ class PAR_ILUTHandle {
                       /// updates. When ON, the algorithm will usually converge
                       /// faster but it makes the algorithm non-deterministic.
   bool verbose;       /// Print information while executing par_ilut
+  ConvergenceMonitor<float_t> *monitor;  /// Optional, replaces the
+                                         /// residual_norm_delta_stop test
 
   // Stored by parent KokkosKernelsHandle
   int team_size;    /// Kokkos team size. Set by the parent handle. -1 implies
@@ -121,6 +124,7 @@ class PAR_ILUTHandle {
         fill_in_limit(fill_in_limit_),
         async_update(async_update_),
         verbose(verbose_),
+        monitor(nullptr),
         team_size(-1),
         vector_size(-1),
         nrows(0),
@@ -183,6 +187,17 @@ class PAR_ILUTHandle {
 
   bool get_async_update() const { return async_update; }
 
+  /// When a monitor is set, the A - LU residual is only computed every
+  /// monitor->get_check_interval() iterations, and the monitor decides when
+  /// to stop (relative to ||A||). It also keeps the residual history. Pass
+  /// nullptr to go back to the residual_norm_delta_stop test.
+  void set_convergence_monitor(ConvergenceMonitor<float_t> *monitor_) {
+    this->monitor = monitor_;
+  }
+  ConvergenceMonitor<float_t> *get_convergence_monitor() const {
+    return this->monitor;
+  }
+
   void set_async_update(const bool async_update_) {
     this->async_update = async_update_;
   }
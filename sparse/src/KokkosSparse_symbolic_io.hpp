@@ -0,0 +1,547 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+/// \file KokkosSparse_symbolic_io.hpp
+/// \brief Save and load the symbolic phase of Gauss-Seidel, SPTRSV and
+///        SPILUK handles.
+///
+/// The symbolic phases (graph coloring, level scheduling) only depend on the
+/// sparsity pattern, so they can be computed once for a mesh and restored on
+/// the next run. Files are keyed by a hash of the rowmap/entries: loading
+/// returns false (and leaves the handle untouched) if the file is missing or
+/// was written for a different graph, in which case the caller should run
+/// the symbolic phase as usual, and may save it afterwards. The loaders read
+/// and check the whole file before they modify the handle.
+
+#ifndef KOKKOSSPARSE_SYMBOLIC_IO_HPP_
+#define KOKKOSSPARSE_SYMBOLIC_IO_HPP_
+
+#include <stdexcept>
+#include <string>
+
+#include "KokkosKernels_Handle.hpp"
+#include "KokkosSparse_symbolic_io_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+namespace Impl {
+
+// section ids of each kind of handle (0 is reserved for parameters)
+enum GSSymbolicSection : uint64_t {
+  GS_COLOR_XADJ = 1,
+  GS_COLOR_ADJ,
+  GS_PERMUTED_XADJ,
+  GS_PERMUTED_ADJ,
+  GS_OLD_TO_NEW_MAP,
+  GS_LONG_ROWS_PER_COLOR,
+  GS_MAX_ROW_LENGTH_PER_COLOR
+};
+
+enum SptrsvSymbolicSection : uint64_t {
+  SPTRSV_LEVEL_LIST = 1,
+  SPTRSV_NODES_PER_LEVEL,
+  SPTRSV_NODES_GROUPED_BY_LEVEL,
+  SPTRSV_CHAIN_PTR
+};
+
+enum SpilukSymbolicSection : uint64_t {
+  SPILUK_LEVEL_LIST = 1,
+  SPILUK_LEVEL_IDX,
+  SPILUK_LEVEL_PTR,
+  SPILUK_LEVEL_NCHUNKS,
+  SPILUK_LEVEL_NROWSPERCHUNK,
+  SPILUK_L_ROWMAP,
+  SPILUK_L_ENTRIES,
+  SPILUK_U_ROWMAP,
+  SPILUK_U_ENTRIES
+};
+
+// number of params each kind of handle writes
+constexpr uint32_t GS_SYMBOLIC_NUM_PARAMS     = 9;
+constexpr uint32_t SPTRSV_SYMBOLIC_NUM_PARAMS = 5;
+constexpr uint32_t SPILUK_SYMBOLIC_NUM_PARAMS = 7;
+
+template <typename execution_space>
+uint64_t exec_space_hash() {
+  return KokkosSparse::Impl::symbolic_hash_string(execution_space::name());
+}
+
+}  // namespace Impl
+
+/// \brief Save the symbolic state (coloring and permuted structure) of a
+/// point-coloring Gauss-Seidel handle. gauss_seidel_symbolic must have been
+/// called with the same row_map/entries.
+template <typename KernelHandle, typename lno_row_view_t_,
+          typename lno_nnz_view_t_>
+void gauss_seidel_save_symbolic(KernelHandle *handle,
+                                const std::string &filename,
+                                lno_row_view_t_ row_map,
+                                lno_nnz_view_t_ entries) {
+  using execution_space = typename KernelHandle::HandleExecSpace;
+  auto *gsHandle        = handle->get_point_gs_handle();
+  if (!gsHandle || !gsHandle->is_symbolic_called()) {
+    throw std::runtime_error(
+        "gauss_seidel_save_symbolic: point Gauss-Seidel symbolic has not been "
+        "called.");
+  }
+  const size_t num_rows = row_map.extent(0) ? row_map.extent(0) - 1 : 0;
+  const size_t nnz      = entries.extent(0);
+  const auto num_colors = gsHandle->get_num_colors();
+  const auto lrt        = gsHandle->get_long_row_threshold();
+  const auto long_row_x = gsHandle->get_long_row_x();
+
+  KokkosSparse::Impl::SymbolicWriter writer(
+      KokkosSparse::Impl::SymbolicKind::GAUSS_SEIDEL,
+      KokkosSparse::Impl::hash_crs_graph<execution_space>(row_map, entries),
+      Impl::exec_space_hash<execution_space>(), num_rows, nnz);
+  writer.add_param(num_colors);
+  writer.add_param(gsHandle->get_block_size());
+  writer.add_param(lrt);
+  writer.add_param(gsHandle->get_level_1_mem());
+  writer.add_param(gsHandle->get_level_2_mem());
+  writer.add_param(gsHandle->get_num_values_in_l1());
+  writer.add_param(gsHandle->get_num_values_in_l2());
+  writer.add_param(gsHandle->get_num_big_rows());
+  writer.add_param(long_row_x.extent(0));
+
+  writer.add_section(Impl::GS_COLOR_XADJ, gsHandle->get_color_xadj(),
+                     num_colors + 1);
+  writer.add_section(Impl::GS_COLOR_ADJ, gsHandle->get_color_adj());
+  writer.add_section(Impl::GS_PERMUTED_XADJ, gsHandle->get_new_xadj());
+  writer.add_section(Impl::GS_PERMUTED_ADJ, gsHandle->get_new_adj());
+  writer.add_section(Impl::GS_OLD_TO_NEW_MAP, gsHandle->get_old_to_new_map());
+  if (lrt > 0) {
+    writer.add_section(Impl::GS_LONG_ROWS_PER_COLOR,
+                       gsHandle->get_long_rows_per_color());
+    writer.add_section(Impl::GS_MAX_ROW_LENGTH_PER_COLOR,
+                       gsHandle->get_max_row_length_per_color());
+  }
+  writer.write(filename);
+}
+
+/// \brief Restore the symbolic state of a point-coloring Gauss-Seidel handle
+/// saved by gauss_seidel_save_symbolic. On success, gauss_seidel_numeric can
+/// be called directly. Returns false if the file is missing, or does not
+/// match the graph or the handle's settings (block size, long row
+/// threshold).
+template <typename KernelHandle, typename lno_row_view_t_,
+          typename lno_nnz_view_t_>
+bool gauss_seidel_load_symbolic(KernelHandle *handle,
+                                const std::string &filename,
+                                lno_row_view_t_ row_map,
+                                lno_nnz_view_t_ entries) {
+  using execution_space = typename KernelHandle::HandleExecSpace;
+  auto *gsHandle        = handle->get_point_gs_handle();
+  if (!gsHandle) {
+    throw std::runtime_error(
+        "gauss_seidel_load_symbolic: point Gauss-Seidel handle has not been "
+        "created.");
+  }
+  using gs_handle_t = typename std::remove_pointer<decltype(gsHandle)>::type;
+  using nnz_lno_t   = typename gs_handle_t::nnz_lno_t;
+  using color_xadj_t =
+      typename gs_handle_t::nnz_lno_persistent_work_host_view_t;
+  using lno_view_t    = typename gs_handle_t::nnz_lno_persistent_work_view_t;
+  using row_view_t    = typename gs_handle_t::row_lno_persistent_work_view_t;
+  using scalar_view_t = typename gs_handle_t::scalar_persistent_work_view_t;
+
+  const size_t num_rows = row_map.extent(0) ? row_map.extent(0) - 1 : 0;
+  const size_t nnz      = entries.extent(0);
+  KokkosSparse::Impl::SymbolicReader reader;
+  if (!reader.open(
+          filename, KokkosSparse::Impl::SymbolicKind::GAUSS_SEIDEL,
+          KokkosSparse::Impl::hash_crs_graph<execution_space>(row_map, entries),
+          Impl::exec_space_hash<execution_space>(), num_rows, nnz,
+          Impl::GS_SYMBOLIC_NUM_PARAMS))
+    return false;
+  const int64_t num_colors  = reader.param(0);
+  const int64_t lrt         = reader.param(2);
+  const int64_t long_row_nx = reader.param(8);
+  if (reader.param(1) != gsHandle->get_block_size() ||
+      lrt != gsHandle->get_long_row_threshold() || num_colors < 0 ||
+      size_t(num_colors) > num_rows || long_row_nx < 0)
+    return false;
+
+  color_xadj_t color_xadj("color_xadj", num_colors + 1);
+  lno_view_t color_adj("color_adj", num_rows);
+  row_view_t permuted_xadj("new xadj", num_rows + 1);
+  lno_view_t permuted_adj("newadj_", nnz);
+  lno_view_t old_to_new_map("old_to_new_index_", num_rows);
+  if (!reader.read_section(Impl::GS_COLOR_XADJ, color_xadj) ||
+      !reader.read_section(Impl::GS_COLOR_ADJ, color_adj) ||
+      !reader.read_section(Impl::GS_PERMUTED_XADJ, permuted_xadj) ||
+      !reader.read_section(Impl::GS_PERMUTED_ADJ, permuted_adj) ||
+      !reader.read_section(Impl::GS_OLD_TO_NEW_MAP, old_to_new_map))
+    return false;
+  color_xadj_t long_rows_per_color, max_row_length_per_color;
+  if (lrt > 0) {
+    long_rows_per_color = color_xadj_t("long_rows_per_color", num_colors);
+    max_row_length_per_color =
+        color_xadj_t("max_row_length_per_color", num_colors);
+    if (!reader.read_section(Impl::GS_LONG_ROWS_PER_COLOR,
+                             long_rows_per_color) ||
+        !reader.read_section(Impl::GS_MAX_ROW_LENGTH_PER_COLOR,
+                             max_row_length_per_color))
+      return false;
+  }
+
+  // everything has been read: nothing below can fail
+  if (lrt > 0) {
+    gsHandle->set_long_rows_per_color(long_rows_per_color);
+    gsHandle->set_max_row_length_per_color(max_row_length_per_color);
+    gsHandle->set_long_row_x(scalar_view_t(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "long_row_x"),
+        long_row_nx));
+  }
+  gsHandle->set_level_1_mem(reader.param(3));
+  gsHandle->set_level_2_mem(reader.param(4));
+  gsHandle->set_num_values_in_l1(reader.param(5));
+  gsHandle->set_num_values_in_l2(reader.param(6));
+  gsHandle->set_num_big_rows(reader.param(7));
+
+  gsHandle->set_color_xadj(color_xadj);
+  gsHandle->set_color_adj(color_adj);
+  gsHandle->set_num_colors(nnz_lno_t(num_colors));
+  gsHandle->set_new_xadj(permuted_xadj);
+  gsHandle->set_new_adj(permuted_adj);
+  gsHandle->set_old_to_new_map(old_to_new_map);
+  gsHandle->set_call_symbolic(true);
+  gsHandle->set_call_numeric(false);
+  return true;
+}
+
+/// \brief Save the level schedule (and chains) of a SPTRSV handle.
+/// sptrsv_symbolic must have been called with the same rowmap/entries.
+template <typename KernelHandle, typename lno_row_view_t_,
+          typename lno_nnz_view_t_>
+void sptrsv_save_symbolic(KernelHandle *handle, const std::string &filename,
+                          lno_row_view_t_ rowmap, lno_nnz_view_t_ entries) {
+  using execution_space = typename KernelHandle::HandleExecSpace;
+  auto *sptrsv_handle   = handle->get_sptrsv_handle();
+  if (!sptrsv_handle || !sptrsv_handle->is_symbolic_complete()) {
+    throw std::runtime_error(
+        "sptrsv_save_symbolic: sptrsv symbolic has not been called.");
+  }
+  const auto algm = sptrsv_handle->get_algorithm();
+  if (algm != SPTRSVAlgorithm::SEQLVLSCHD_RP &&
+      algm != SPTRSVAlgorithm::SEQLVLSCHD_TP1 &&
+      algm != SPTRSVAlgorithm::SEQLVLSCHD_TP1CHAIN) {
+    throw std::runtime_error(
+        "sptrsv_save_symbolic: only the level-scheduling algorithms "
+        "(SEQLVLSCHD_RP, SEQLVLSCHD_TP1, SEQLVLSCHD_TP1CHAIN) are supported.");
+  }
+  const size_t nrows   = sptrsv_handle->get_nrows();
+  const size_t nlevels = sptrsv_handle->get_num_levels();
+  const bool chain     = sptrsv_handle->algm_requires_symb_chain();
+  const size_t nchain  = sptrsv_handle->get_num_chain_entries();
+
+  KokkosSparse::Impl::SymbolicWriter writer(
+      KokkosSparse::Impl::SymbolicKind::SPTRSV,
+      KokkosSparse::Impl::hash_crs_graph<execution_space>(rowmap, entries),
+      Impl::exec_space_hash<execution_space>(), nrows, entries.extent(0));
+  writer.add_param(nlevels);
+  writer.add_param(sptrsv_handle->is_lower_tri());
+  writer.add_param(static_cast<int64_t>(algm));
+  writer.add_param(sptrsv_handle->get_chain_threshold());
+  writer.add_param(nchain);
+
+  writer.add_section(Impl::SPTRSV_LEVEL_LIST, sptrsv_handle->get_level_list());
+  writer.add_section(Impl::SPTRSV_NODES_PER_LEVEL,
+                     sptrsv_handle->get_host_nodes_per_level(), nlevels);
+  writer.add_section(Impl::SPTRSV_NODES_GROUPED_BY_LEVEL,
+                     sptrsv_handle->get_host_nodes_grouped_by_level());
+  if (chain) {
+    writer.add_section(Impl::SPTRSV_CHAIN_PTR,
+                       sptrsv_handle->get_host_chain_ptr(), nchain + 1);
+  }
+  writer.write(filename);
+}
+
+/// \brief Restore the level schedule of a SPTRSV handle saved by
+/// sptrsv_save_symbolic. The handle must have been created with the same
+/// algorithm, triangle and chain threshold. On success, sptrsv_solve can be
+/// called directly.
+template <typename KernelHandle, typename lno_row_view_t_,
+          typename lno_nnz_view_t_>
+bool sptrsv_load_symbolic(KernelHandle *handle, const std::string &filename,
+                          lno_row_view_t_ rowmap, lno_nnz_view_t_ entries) {
+  using execution_space = typename KernelHandle::HandleExecSpace;
+  auto *sptrsv_handle   = handle->get_sptrsv_handle();
+  if (!sptrsv_handle) {
+    throw std::runtime_error(
+        "sptrsv_load_symbolic: sptrsv handle has not been created.");
+  }
+  using sptrsv_handle_t =
+      typename std::remove_pointer<decltype(sptrsv_handle)>::type;
+  using host_signed_view_t =
+      typename sptrsv_handle_t::host_signed_nnz_lno_view_t;
+  using host_lno_view_t = typename sptrsv_handle_t::hostspace_nnz_lno_view_t;
+
+  const size_t nrows = rowmap.extent(0) ? rowmap.extent(0) - 1 : 0;
+  KokkosSparse::Impl::SymbolicReader reader;
+  if (!reader.open(
+          filename, KokkosSparse::Impl::SymbolicKind::SPTRSV,
+          KokkosSparse::Impl::hash_crs_graph<execution_space>(rowmap, entries),
+          Impl::exec_space_hash<execution_space>(), nrows, entries.extent(0),
+          Impl::SPTRSV_SYMBOLIC_NUM_PARAMS))
+    return false;
+  const int64_t nlevels = reader.param(0);
+  const int64_t nchain  = reader.param(4);
+  if (reader.param(1) != sptrsv_handle->is_lower_tri() ||
+      reader.param(2) !=
+          static_cast<int64_t>(sptrsv_handle->get_algorithm()) ||
+      nlevels < 0 || size_t(nlevels) > nrows)
+    return false;
+  const bool chain = sptrsv_handle->algm_requires_symb_chain();
+  if (chain) {
+    // new_init_handle replaces an unset (-1) chain threshold by the team
+    // size, or 0 if that is unset too; the file holds the resolved value
+    const int64_t threshold = sptrsv_handle->get_chain_threshold();
+    const int64_t team_size = sptrsv_handle->get_team_size();
+    const int64_t expected =
+        threshold != -1 ? threshold : (team_size == -1 ? 0 : team_size);
+    if (reader.param(3) != expected || nchain < 0 || size_t(nchain) >= nrows)
+      return false;
+  }
+
+  host_signed_view_t level_list("level_list", nrows);
+  host_lno_view_t hnodes_per_level("host nodes_per_level", nlevels);
+  host_lno_view_t hnodes_grouped_by_lvl("host nodes_grouped_by_level", nrows);
+  host_signed_view_t hchain_ptr;
+  if (!reader.read_section(Impl::SPTRSV_LEVEL_LIST, level_list) ||
+      !reader.read_section(Impl::SPTRSV_NODES_PER_LEVEL, hnodes_per_level) ||
+      !reader.read_section(Impl::SPTRSV_NODES_GROUPED_BY_LEVEL,
+                           hnodes_grouped_by_lvl))
+    return false;
+  if (chain) {
+    hchain_ptr = host_signed_view_t("h_chain_ptr", nchain + 1);
+    if (!reader.read_section(Impl::SPTRSV_CHAIN_PTR, hchain_ptr)) return false;
+  }
+
+  // everything has been read: allocate the level-schedule views, as
+  // sptrsv_symbolic does, and fill them
+  sptrsv_handle->new_init_handle(nrows);
+  auto level_range = Kokkos::make_pair(size_t(0), size_t(nlevels));
+  Kokkos::deep_copy(sptrsv_handle->get_level_list(), level_list);
+  Kokkos::deep_copy(
+      Kokkos::subview(sptrsv_handle->get_host_nodes_per_level(), level_range),
+      hnodes_per_level);
+  Kokkos::deep_copy(sptrsv_handle->get_host_nodes_grouped_by_level(),
+                    hnodes_grouped_by_lvl);
+  Kokkos::deep_copy(sptrsv_handle->get_nodes_per_level(),
+                    sptrsv_handle->get_host_nodes_per_level());
+  Kokkos::deep_copy(sptrsv_handle->get_nodes_grouped_by_level(),
+                    hnodes_grouped_by_lvl);
+  if (chain) {
+    Kokkos::deep_copy(
+        Kokkos::subview(sptrsv_handle->get_host_chain_ptr(),
+                        Kokkos::make_pair(size_t(0), size_t(nchain + 1))),
+        hchain_ptr);
+    sptrsv_handle->set_num_chain_entries(nchain);
+  }
+  sptrsv_handle->set_num_levels(nlevels);
+  sptrsv_handle->set_symbolic_complete();
+  return true;
+}
+
+/// \brief Save the symbolic state of a SPILUK handle, together with the
+/// L and U patterns computed by spiluk_symbolic.
+template <typename KernelHandle, typename ARowMapType, typename AEntriesType,
+          typename LRowMapType, typename LEntriesType, typename URowMapType,
+          typename UEntriesType>
+void spiluk_save_symbolic(KernelHandle *handle, const std::string &filename,
+                          typename KernelHandle::const_nnz_lno_t fill_lev,
+                          const ARowMapType &A_rowmap,
+                          const AEntriesType &A_entries,
+                          const LRowMapType &L_rowmap,
+                          const LEntriesType &L_entries,
+                          const URowMapType &U_rowmap,
+                          const UEntriesType &U_entries) {
+  using execution_space = typename KernelHandle::HandleExecSpace;
+  auto *spiluk_handle   = handle->get_spiluk_handle();
+  if (!spiluk_handle || !spiluk_handle->is_symbolic_complete()) {
+    throw std::runtime_error(
+        "spiluk_save_symbolic: spiluk symbolic has not been called.");
+  }
+  const size_t nrows   = spiluk_handle->get_nrows();
+  const size_t nlevels = spiluk_handle->get_num_levels();
+  const bool tp1 =
+      (spiluk_handle->get_algorithm() == SPILUKAlgorithm::SEQLVLSCHD_TP1);
+
+  KokkosSparse::Impl::SymbolicWriter writer(
+      KokkosSparse::Impl::SymbolicKind::SPILUK,
+      KokkosSparse::Impl::hash_crs_graph<execution_space>(A_rowmap,
+                                                          A_entries),
+      Impl::exec_space_hash<execution_space>(), nrows, A_entries.extent(0));
+  writer.add_param(nlevels);
+  writer.add_param(fill_lev);
+  writer.add_param(static_cast<int64_t>(spiluk_handle->get_algorithm()));
+  writer.add_param(spiluk_handle->get_nnzL());
+  writer.add_param(spiluk_handle->get_nnzU());
+  writer.add_param(spiluk_handle->get_level_maxrows());
+  writer.add_param(spiluk_handle->get_level_maxrowsperchunk());
+
+  writer.add_section(Impl::SPILUK_LEVEL_LIST, spiluk_handle->get_level_list());
+  writer.add_section(Impl::SPILUK_LEVEL_IDX, spiluk_handle->get_level_idx());
+  writer.add_section(Impl::SPILUK_LEVEL_PTR, spiluk_handle->get_level_ptr(),
+                     nlevels + 1);
+  if (tp1) {
+    writer.add_section(Impl::SPILUK_LEVEL_NCHUNKS,
+                       spiluk_handle->get_level_nchunks());
+    writer.add_section(Impl::SPILUK_LEVEL_NROWSPERCHUNK,
+                       spiluk_handle->get_level_nrowsperchunk());
+  }
+  writer.add_section(Impl::SPILUK_L_ROWMAP, L_rowmap, nrows + 1);
+  writer.add_section(Impl::SPILUK_L_ENTRIES, L_entries,
+                     spiluk_handle->get_nnzL());
+  writer.add_section(Impl::SPILUK_U_ROWMAP, U_rowmap, nrows + 1);
+  writer.add_section(Impl::SPILUK_U_ENTRIES, U_entries,
+                     spiluk_handle->get_nnzU());
+  writer.write(filename);
+}
+
+/// \brief Restore the symbolic state of a SPILUK handle saved by
+/// spiluk_save_symbolic, and fill L_rowmap/L_entries/U_rowmap/U_entries as
+/// spiluk_symbolic would (the entries views must be large enough, and can be
+/// resized to get_nnzL()/get_nnzU() afterwards). On success, spiluk_numeric
+/// can be called directly.
+template <typename KernelHandle, typename ARowMapType, typename AEntriesType,
+          typename LRowMapType, typename LEntriesType, typename URowMapType,
+          typename UEntriesType>
+bool spiluk_load_symbolic(KernelHandle *handle, const std::string &filename,
+                          typename KernelHandle::const_nnz_lno_t fill_lev,
+                          const ARowMapType &A_rowmap,
+                          const AEntriesType &A_entries, LRowMapType &L_rowmap,
+                          LEntriesType &L_entries, URowMapType &U_rowmap,
+                          UEntriesType &U_entries) {
+  using execution_space = typename KernelHandle::HandleExecSpace;
+  auto *spiluk_handle   = handle->get_spiluk_handle();
+  if (!spiluk_handle) {
+    throw std::runtime_error(
+        "spiluk_load_symbolic: spiluk handle has not been created.");
+  }
+  using spiluk_handle_t =
+      typename std::remove_pointer<decltype(spiluk_handle)>::type;
+  using host_row_view_t = typename spiluk_handle_t::nnz_row_view_host_t;
+  using host_lno_view_t = typename spiluk_handle_t::nnz_lno_view_host_t;
+  using l_rowmap_t =
+      Kokkos::View<typename LRowMapType::non_const_value_type *,
+                   Kokkos::HostSpace>;
+  using l_entries_t =
+      Kokkos::View<typename LEntriesType::non_const_value_type *,
+                   Kokkos::HostSpace>;
+  using u_rowmap_t =
+      Kokkos::View<typename URowMapType::non_const_value_type *,
+                   Kokkos::HostSpace>;
+  using u_entries_t =
+      Kokkos::View<typename UEntriesType::non_const_value_type *,
+                   Kokkos::HostSpace>;
+
+  const size_t nrows = A_rowmap.extent(0) ? A_rowmap.extent(0) - 1 : 0;
+  KokkosSparse::Impl::SymbolicReader reader;
+  if (!reader.open(filename, KokkosSparse::Impl::SymbolicKind::SPILUK,
+                   KokkosSparse::Impl::hash_crs_graph<execution_space>(
+                       A_rowmap, A_entries),
+                   Impl::exec_space_hash<execution_space>(), nrows,
+                   A_entries.extent(0), Impl::SPILUK_SYMBOLIC_NUM_PARAMS))
+    return false;
+  const int64_t nlevels = reader.param(0);
+  const int64_t nnzL    = reader.param(3);
+  const int64_t nnzU    = reader.param(4);
+  if (reader.param(1) != fill_lev ||
+      reader.param(2) !=
+          static_cast<int64_t>(spiluk_handle->get_algorithm()) ||
+      nlevels < 0 || size_t(nlevels) > nrows || nnzL < 0 || nnzU < 0 ||
+      size_t(nnzL) > L_entries.extent(0) ||
+      size_t(nnzU) > U_entries.extent(0) ||
+      L_rowmap.extent(0) < nrows + 1 || U_rowmap.extent(0) < nrows + 1)
+    return false;
+  const bool tp1 =
+      (spiluk_handle->get_algorithm() == SPILUKAlgorithm::SEQLVLSCHD_TP1);
+
+  host_row_view_t level_list("level_list", nrows);
+  host_lno_view_t level_idx("level_idx", nrows);
+  host_lno_view_t level_ptr("level_ptr", nlevels + 1);
+  host_lno_view_t level_nchunks, level_nrowsperchunk;
+  l_rowmap_t hL_rowmap("L_rowmap", nrows + 1);
+  l_entries_t hL_entries("L_entries", nnzL);
+  u_rowmap_t hU_rowmap("U_rowmap", nrows + 1);
+  u_entries_t hU_entries("U_entries", nnzU);
+  if (!reader.read_section(Impl::SPILUK_LEVEL_LIST, level_list) ||
+      !reader.read_section(Impl::SPILUK_LEVEL_IDX, level_idx) ||
+      !reader.read_section(Impl::SPILUK_LEVEL_PTR, level_ptr) ||
+      !reader.read_section(Impl::SPILUK_L_ROWMAP, hL_rowmap) ||
+      !reader.read_section(Impl::SPILUK_L_ENTRIES, hL_entries) ||
+      !reader.read_section(Impl::SPILUK_U_ROWMAP, hU_rowmap) ||
+      !reader.read_section(Impl::SPILUK_U_ENTRIES, hU_entries))
+    return false;
+  if (tp1) {
+    level_nchunks       = host_lno_view_t("level_nchunks", nlevels);
+    level_nrowsperchunk = host_lno_view_t("level_nrowsperchunk", nlevels);
+    if (!reader.read_section(Impl::SPILUK_LEVEL_NCHUNKS, level_nchunks) ||
+        !reader.read_section(Impl::SPILUK_LEVEL_NROWSPERCHUNK,
+                             level_nrowsperchunk))
+      return false;
+  }
+
+  // everything has been read: reset the handle, as spiluk_symbolic does, and
+  // fill it and the L/U patterns
+  spiluk_handle->reset_handle(nrows, nnzL, nnzU);
+  auto level_range = Kokkos::make_pair(size_t(0), size_t(nlevels + 1));
+  Kokkos::deep_copy(spiluk_handle->get_level_list(), level_list);
+  Kokkos::deep_copy(spiluk_handle->get_level_idx(), level_idx);
+  // the handle keeps level_ptr both on device and on host; the file holds
+  // a single copy, which fills both
+  Kokkos::deep_copy(
+      Kokkos::subview(spiluk_handle->get_level_ptr(), level_range),
+      level_ptr);
+  Kokkos::deep_copy(
+      Kokkos::subview(spiluk_handle->get_host_level_ptr(), level_range),
+      level_ptr);
+  if (tp1) {
+    spiluk_handle->alloc_level_nchunks(nlevels);
+    spiluk_handle->alloc_level_nrowsperchunk(nlevels);
+    Kokkos::deep_copy(spiluk_handle->get_level_nchunks(), level_nchunks);
+    Kokkos::deep_copy(spiluk_handle->get_level_nrowsperchunk(),
+                      level_nrowsperchunk);
+  }
+  auto row_range = Kokkos::make_pair(size_t(0), nrows + 1);
+  Kokkos::deep_copy(Kokkos::subview(L_rowmap, row_range), hL_rowmap);
+  Kokkos::deep_copy(
+      Kokkos::subview(L_entries, Kokkos::make_pair(size_t(0), size_t(nnzL))),
+      hL_entries);
+  Kokkos::deep_copy(Kokkos::subview(U_rowmap, row_range), hU_rowmap);
+  Kokkos::deep_copy(
+      Kokkos::subview(U_entries, Kokkos::make_pair(size_t(0), size_t(nnzU))),
+      hU_entries);
+
+  spiluk_handle->set_num_levels(nlevels);
+  spiluk_handle->set_level_maxrows(reader.param(5));
+  spiluk_handle->set_level_maxrowsperchunk(reader.param(6));
+  if (tp1) {
+    spiluk_handle->alloc_iw(spiluk_handle->get_level_maxrowsperchunk(), nrows);
+  } else {
+    spiluk_handle->alloc_iw(spiluk_handle->get_level_maxrows(), nrows);
+  }
+  spiluk_handle->set_symbolic_complete();
+  return true;
+}
+
+}  // namespace Experimental
+}  // namespace KokkosSparse
+
+#endif  // KOKKOSSPARSE_SYMBOLIC_IO_HPP_
@@ -19,6 +19,8 @@
 #include "Test_Sparse_block_gauss_seidel.hpp"
 #include "Test_Sparse_BsrMatrix.hpp"
 #include "Test_Sparse_bspgemm.hpp"
+#include "Test_Sparse_crs_to_bsr.hpp"
 #include "Test_Sparse_spmv_bsr.hpp"
+#include "Test_Sparse_VbrMatrix.hpp"
 
 #endif  // TEST_BLOCKSPARSE_HPP
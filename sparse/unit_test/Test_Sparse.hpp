@@ -19,7 +19,13 @@
 #if KOKKOS_VERSION >= 40099
 #include "Test_Sparse_coo2crs.hpp"
 #endif  // KOKKOS_VERSION >= 40099
+#include "Test_Sparse_IOUtils_parallel.hpp"
 #include "Test_Sparse_crs2coo.hpp"
+#include "Test_Sparse_CrsBinary.hpp"
+#include "Test_Sparse_CooAssembler.hpp"
+#include "Test_Sparse_ElementScatterMap.hpp"
+#include "Test_Sparse_HybMatrix.hpp"
+#include "Test_Sparse_Csr5Matrix.hpp"
 #include "Test_Sparse_Controls.hpp"
 #include "Test_Sparse_CrsMatrix.hpp"
 #include "Test_Sparse_mdf.hpp"
@@ -35,9 +41,11 @@
 #include "Test_Sparse_spiluk.hpp"
 #include "Test_Sparse_spmv.hpp"
 #include "Test_Sparse_sptrsv.hpp"
+#include "Test_Sparse_symbolic_io.hpp"
 #include "Test_Sparse_trsv.hpp"
 #include "Test_Sparse_par_ilut.hpp"
 #include "Test_Sparse_gmres.hpp"
+#include "Test_Sparse_convergence_monitor.hpp"
 #include "Test_Sparse_Transpose.hpp"
 #include "Test_Sparse_TestUtils_RandCsMat.hpp"
 #include "Test_Sparse_ccs2crs.hpp"
@@ -0,0 +1,162 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <map>
+#include <random>
+#include <utility>
+
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_CooAssembler.hpp"
+
+namespace Test {
+
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void run_test_coo_assembler(lno_t numRows, lno_t numCols, int numBatches,
+                            size_t batchSize) {
+  using crsMat_t =
+      KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  using index_view_t = Kokkos::View<lno_t *, device>;
+  using value_view_t = Kokkos::View<scalar_t *, device>;
+  using key_t        = std::pair<lno_t, lno_t>;
+
+  std::mt19937 gen(numRows + numBatches);
+  std::uniform_int_distribution<lno_t> row_dist(0, numRows - 1);
+  std::uniform_int_distribution<lno_t> col_dist(0, numCols - 1);
+  // small integers, so that the sums are exact whatever the order
+  std::uniform_int_distribution<int> val_dist(-8, 8);
+
+  KokkosSparse::Experimental::CooAssembler<crsMat_t> assembler(numRows,
+                                                               numCols);
+  std::map<key_t, scalar_t> reference;
+  index_view_t all_rows("all rows", numBatches * batchSize);
+  index_view_t all_cols("all cols", numBatches * batchSize);
+  value_view_t all_vals("all vals", numBatches * batchSize);
+  auto h_all_rows = Kokkos::create_mirror_view(all_rows);
+  auto h_all_cols = Kokkos::create_mirror_view(all_cols);
+  auto h_all_vals = Kokkos::create_mirror_view(all_vals);
+  for (int b = 0; b < numBatches; b++) {
+    index_view_t rows("rows", batchSize);
+    index_view_t cols("cols", batchSize);
+    value_view_t vals("vals", batchSize);
+    auto h_rows = Kokkos::create_mirror_view(rows);
+    auto h_cols = Kokkos::create_mirror_view(cols);
+    auto h_vals = Kokkos::create_mirror_view(vals);
+    for (size_t k = 0; k < batchSize; k++) {
+      h_rows(k) = row_dist(gen);
+      h_cols(k) = col_dist(gen);
+      h_vals(k) = scalar_t(val_dist(gen));
+      // a few ignored triples
+      if (k % 97 == 3) h_cols(k) = -1;
+      if (h_cols(k) >= 0) reference[key_t(h_rows(k), h_cols(k))] += h_vals(k);
+      h_all_rows(b * batchSize + k) = h_rows(k);
+      h_all_cols(b * batchSize + k) = h_cols(k);
+      h_all_vals(b * batchSize + k) = scalar_t(2) * h_vals(k);
+    }
+    Kokkos::deep_copy(rows, h_rows);
+    Kokkos::deep_copy(cols, h_cols);
+    Kokkos::deep_copy(vals, h_vals);
+    assembler.add_batch(rows, cols, vals);
+    // binary counter: one run per bit of the number of batches
+    int bits = 0;
+    for (int nb = b + 1; nb; nb >>= 1) bits += nb & 1;
+    EXPECT_EQ(assembler.num_runs(), size_t(bits));
+  }
+  crsMat_t A = assembler.finalize();
+  EXPECT_EQ(assembler.num_runs(), 0u);
+
+  ASSERT_EQ(A.numRows(), numRows);
+  ASSERT_EQ(A.numCols(), numCols);
+  ASSERT_EQ(size_t(A.nnz()), reference.size());
+  auto h_rowmap =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A.graph.row_map);
+  auto h_entries =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A.graph.entries);
+  auto h_values =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A.values);
+  // std::map iterates in (row, col) order: the rows must be sorted
+  auto it = reference.begin();
+  for (lno_t i = 0; i < numRows; i++) {
+    for (size_type k = h_rowmap(i); k < h_rowmap(i + 1); k++, it++) {
+      ASSERT_EQ(it->first.first, i);
+      EXPECT_EQ(it->first.second, h_entries(k));
+      EXPECT_EQ(it->second, h_values(k));
+    }
+  }
+
+  // re-assembly of all the triples, with doubled values, into the pattern
+  Kokkos::deep_copy(all_rows, h_all_rows);
+  Kokkos::deep_copy(all_cols, h_all_cols);
+  Kokkos::deep_copy(all_vals, h_all_vals);
+  KokkosSparse::Experimental::CooPatternMap<crsMat_t> map(A, all_rows,
+                                                          all_cols);
+  EXPECT_EQ(map.get_num_missing(), 0u);
+  map.assemble(all_vals);
+  Kokkos::deep_copy(h_values, A.values);
+  it = reference.begin();
+  for (size_type k = 0; k < A.nnz(); k++, it++) {
+    EXPECT_EQ(scalar_t(2) * it->second, h_values(k));
+  }
+  map.assemble(all_vals, true);
+  Kokkos::deep_copy(h_values, A.values);
+  it = reference.begin();
+  for (size_type k = 0; k < A.nnz(); k++, it++) {
+    EXPECT_EQ(scalar_t(4) * it->second, h_values(k));
+  }
+
+  // triples out of the pattern, and out of bounds
+  h_all_rows(0) = numRows;
+  Kokkos::deep_copy(all_rows, h_all_rows);
+  KokkosSparse::Experimental::CooPatternMap<crsMat_t> map2(A, all_rows,
+                                                           all_cols);
+  EXPECT_EQ(map2.get_num_missing(), 1u);
+  EXPECT_THROW(assembler.add_batch(all_rows, all_cols, all_vals),
+               std::invalid_argument);
+
+  // no batches at all
+  crsMat_t E = assembler.finalize();
+  EXPECT_EQ(E.numRows(), numRows);
+  EXPECT_EQ(E.nnz(), 0);
+}
+
+}  // namespace Test
+
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void test_coo_assembler() {
+  Test::run_test_coo_assembler<scalar_t, lno_t, size_type, device>(100, 80, 7,
+                                                                    1000);
+  Test::run_test_coo_assembler<scalar_t, lno_t, size_type, device>(
+      2000, 2000, 12, 5000);
+  Test::run_test_coo_assembler<scalar_t, lno_t, size_type, device>(10, 10, 3,
+                                                                    500);
+}
+
+#define KOKKOSKERNELS_EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE)        \
+  TEST_F(TestCategory,                                                     \
+         sparse##_##coo_assembler##_##SCALAR##_##ORDINAL##_##OFFSET##_##DEVICE) { \
+    test_coo_assembler<SCALAR, ORDINAL, OFFSET, DEVICE>();                 \
+  }
+
+#define NO_TEST_COMPLEX
+
+#include <Test_Common_Test_All_Type_Combos.hpp>
+
+#undef KOKKOSKERNELS_EXECUTE_TEST
+#undef NO_TEST_COMPLEX
@@ -0,0 +1,241 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_CrsBinary.hpp"
+#include "KokkosSparse_IOUtils.hpp"
+#include "KokkosSparse_SortCrs.hpp"
+
+namespace Test {
+
+// Checks that B holds exactly the entries of A (possibly with other types)
+template <typename crsMatA_t, typename crsMatB_t>
+void check_crs_binary_equal(const crsMatA_t &A, const crsMatB_t &B) {
+  ASSERT_EQ(uint64_t(A.numRows()), uint64_t(B.numRows()));
+  ASSERT_EQ(uint64_t(A.numCols()), uint64_t(B.numCols()));
+  ASSERT_EQ(uint64_t(A.nnz()), uint64_t(B.nnz()));
+  auto A_rowmap =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A.graph.row_map);
+  auto A_entries =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A.graph.entries);
+  auto A_values =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A.values);
+  auto B_rowmap =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), B.graph.row_map);
+  auto B_entries =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), B.graph.entries);
+  auto B_values =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), B.values);
+  for (size_t i = 0; i < A_rowmap.extent(0); i++) {
+    EXPECT_EQ(uint64_t(A_rowmap(i)), uint64_t(B_rowmap(i)));
+  }
+  for (size_t k = 0; k < A_entries.extent(0); k++) {
+    EXPECT_EQ(int64_t(A_entries(k)), int64_t(B_entries(k)));
+    EXPECT_EQ(double(A_values(k)), double(B_values(k)));
+  }
+}
+
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void run_test_crs_binary(lno_t numRows, lno_t numCols, size_type nnz,
+                         lno_t bandwidth, lno_t row_size_variance) {
+  using crsMat_t =
+      KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  // different ordinal, offset and scalar types
+  using wideMat_t =
+      KokkosSparse::CrsMatrix<double, int64_t, device, void, size_t>;
+  using namespace KokkosSparse::Impl;
+  const std::string filename = "kk_test_crs_binary.kkb";
+
+  crsMat_t A = kk_generate_sparse_matrix<crsMat_t>(numRows, numCols, nnz,
+                                                   row_size_variance, bandwidth);
+  KokkosSparse::sort_crs_matrix(A);
+  write_crs_binary(A, filename, true);
+
+  {
+    CrsBinaryFile file(filename);
+    EXPECT_EQ(file.num_rows(), uint64_t(numRows));
+    EXPECT_EQ(file.num_cols(), uint64_t(numCols));
+    EXPECT_EQ(file.nnz(), uint64_t(A.nnz()));
+    EXPECT_TRUE(file.is_sorted());
+    EXPECT_TRUE(file.is_symmetric());
+    EXPECT_EQ(file.get_header().rowmap_offset % 64, 0u);
+    EXPECT_EQ(file.get_header().entries_offset % 64, 0u);
+    EXPECT_EQ(file.get_header().values_offset % 64, 0u);
+
+    crsMat_t B = file.matrix<crsMat_t>();
+    check_crs_binary_equal(A, B);
+    EXPECT_EQ(file.can_view<crsMat_t>(),
+              (std::is_same<typename crsMat_t::memory_space,
+                            Kokkos::HostSpace>::value));
+    if (file.can_view<crsMat_t>()) {
+      // the views point into the mapping
+      const char *begin = reinterpret_cast<const char *>(&file.get_header());
+      const char *ptr   = reinterpret_cast<const char *>(B.values.data());
+      EXPECT_EQ(ptr, begin + file.get_header().values_offset);
+      // writes are private to the mapping
+      if (B.nnz()) B.values(0) = scalar_t(12345);
+    }
+
+    wideMat_t C = file.copy<wideMat_t>();
+    check_crs_binary_equal(A, C);
+  }
+  // the file was not modified through the view
+  check_crs_binary_equal(A, read_crs_binary<crsMat_t>(filename));
+  std::remove(filename.c_str());
+
+  // through the generic readers and writers, unsorted
+  crsMat_t D = kk_generate_sparse_matrix<crsMat_t>(numRows, numCols, nnz,
+                                                   row_size_variance, bandwidth);
+  write_kokkos_crst_matrix(D, filename.c_str());
+  check_crs_binary_equal(D,
+                         read_kokkos_crst_matrix<crsMat_t>(filename.c_str()));
+  std::remove(filename.c_str());
+}
+
+// Not a compression, but enough to check that the hook is used: the bytes
+// are scrambled, and the stored size differs from the raw one
+struct CrsBinaryTestCodec : public KokkosSparse::Impl::CrsBinaryCodec {
+  uint32_t id() const override { return 42; }
+  void compress(const char *src, size_t bytes,
+                std::vector<char> &dst) const override {
+    dst.resize(bytes + 1);
+    for (size_t i = 0; i < bytes; i++) dst[i] = src[i] ^ 0x5a;
+    dst[bytes] = 0x11;
+  }
+  void decompress(const char *src, size_t bytes, char *dst,
+                  size_t dst_bytes) const override {
+    ASSERT_EQ(bytes, dst_bytes + 1);
+    for (size_t i = 0; i < dst_bytes; i++) dst[i] = src[i] ^ 0x5a;
+  }
+};
+
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void run_test_crs_binary_checksum_codec(lno_t numRows, size_type nnz,
+                                        lno_t bandwidth,
+                                        lno_t row_size_variance) {
+  using crsMat_t =
+      KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  using namespace KokkosSparse::Impl;
+  const std::string filename = "kk_test_crs_binary_codec.kkb";
+
+  crsMat_t A = kk_generate_sparse_matrix<crsMat_t>(numRows, numRows, nnz,
+                                                   row_size_variance, bandwidth);
+  CrsBinaryTestCodec codec;
+  CrsBinaryWriteOptions options;
+  options.checksum = true;
+  options.codec    = &codec;
+  write_crs_binary(A, filename, options);
+  {
+    CrsBinaryFile file(filename);
+    EXPECT_TRUE(file.has_checksum());
+    EXPECT_TRUE(file.is_compressed());
+    EXPECT_TRUE(file.verify_checksum());
+    EXPECT_FALSE(file.can_view<crsMat_t>());
+    EXPECT_THROW(file.copy<crsMat_t>(), std::runtime_error);
+    file.set_codec(&codec);
+    check_crs_binary_equal(A, file.matrix<crsMat_t>());
+  }
+
+  // checksum, without compression
+  options.codec = nullptr;
+  write_crs_binary(A, filename, options);
+  check_crs_binary_equal(A, read_crs_binary<crsMat_t>(filename));
+  {
+    // flip a bit of the last value
+    std::fstream f(filename, std::ios::in | std::ios::out | std::ios::binary);
+    f.seekg(-1, std::ios::end);
+    char c;
+    f.read(&c, 1);
+    c ^= 1;
+    f.seekp(-1, std::ios::end);
+    f.write(&c, 1);
+  }
+  {
+    CrsBinaryFile file(filename);
+    EXPECT_FALSE(file.verify_checksum());
+    EXPECT_THROW(file.copy<crsMat_t>(), std::runtime_error);
+  }
+  std::remove(filename.c_str());
+}
+
+inline void run_test_crs_binary_errors() {
+  using namespace KokkosSparse::Impl;
+  const std::string filename = "kk_test_crs_binary_bad.kkb";
+  {
+    std::ofstream out(filename, std::ios::out | std::ios::binary);
+    out << "not a kkb file";
+  }
+  EXPECT_THROW(CrsBinaryFile file(filename), std::runtime_error);
+  {
+    // a valid header, but no sections
+    CrsBinaryHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, CRS_BINARY_MAGIC, sizeof(header.magic));
+    header.version        = CRS_BINARY_VERSION;
+    header.byte_order     = CRS_BINARY_BYTE_ORDER;
+    header.num_rows       = 10;
+    header.num_cols       = 10;
+    header.nnz            = 10;
+    header.ordinal_size   = 4;
+    header.offset_size    = 4;
+    header.scalar_size    = 8;
+    header.rowmap_offset  = 128;
+    header.entries_offset = 192;
+    header.values_offset  = 256;
+    std::ofstream out(filename, std::ios::out | std::ios::binary);
+    out.write((const char *)&header, sizeof(header));
+  }
+  EXPECT_THROW(CrsBinaryFile file(filename), std::runtime_error);
+  std::remove(filename.c_str());
+}
+
+}  // namespace Test
+
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void test_crs_binary() {
+  Test::run_test_crs_binary<scalar_t, lno_t, size_type, device>(1000, 1000,
+                                                                 10000, 100, 5);
+  Test::run_test_crs_binary<scalar_t, lno_t, size_type, device>(500, 800, 5000,
+                                                                 200, 10);
+  Test::run_test_crs_binary_checksum_codec<scalar_t, lno_t, size_type,
+                                           device>(1000, 10000, 100, 5);
+  Test::run_test_crs_binary_errors();
+}
+
+#define KOKKOSKERNELS_EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE)        \
+  TEST_F(TestCategory,                                                     \
+         sparse##_##crs_binary##_##SCALAR##_##ORDINAL##_##OFFSET##_##DEVICE) { \
+    test_crs_binary<SCALAR, ORDINAL, OFFSET, DEVICE>();                    \
+  }
+
+#define NO_TEST_COMPLEX
+
+#include <Test_Common_Test_All_Type_Combos.hpp>
+
+#undef KOKKOSKERNELS_EXECUTE_TEST
+#undef NO_TEST_COMPLEX
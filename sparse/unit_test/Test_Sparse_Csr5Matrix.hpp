@@ -0,0 +1,173 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_Csr5Matrix.hpp"
+#include "KokkosSparse_IOUtils.hpp"
+#include "KokkosSparse_spmv.hpp"
+
+namespace Test {
+
+// Compares the Csr5Matrix spmv with the CRS spmv, for the default tiles and
+// for small tiles, so that many rows are shared by several segments.
+template <typename crsMat_t>
+void check_csr5_matrix(const crsMat_t &A) {
+  using scalar_t  = typename crsMat_t::non_const_value_type;
+  using lno_t     = typename crsMat_t::non_const_ordinal_type;
+  using size_type = typename crsMat_t::non_const_size_type;
+  using device    = typename crsMat_t::device_type;
+  using csr5Mat_t =
+      KokkosSparse::Experimental::Csr5Matrix<scalar_t, lno_t, device,
+                                             size_type>;
+  using vector_t = Kokkos::View<scalar_t *, device>;
+  using mag_t    = typename Kokkos::ArithTraits<scalar_t>::mag_type;
+  const lno_t numRows = A.numRows();
+  const lno_t numCols = A.numCols();
+
+  auto h_rowmap = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                      A.graph.row_map);
+  auto h_values =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A.values);
+  lno_t maxLength = 0;
+  mag_t maxValue  = 0;
+  for (lno_t i = 0; i < numRows; i++) {
+    maxLength = std::max<lno_t>(maxLength, h_rowmap(i + 1) - h_rowmap(i));
+  }
+  for (size_t k = 0; k < h_values.extent(0); k++) {
+    maxValue =
+        std::max(maxValue, Kokkos::ArithTraits<scalar_t>::abs(h_values(k)));
+  }
+
+  vector_t x("x", numCols), y_ref("y_ref", numRows), y("y", numRows);
+  auto h_x = Kokkos::create_mirror_view(x);
+  for (lno_t j = 0; j < numCols; j++) h_x(j) = scalar_t((j % 13) - 6);
+  Kokkos::deep_copy(x, h_x);
+  auto h_y0 = Kokkos::create_mirror_view(y);
+  for (lno_t i = 0; i < numRows; i++) h_y0(i) = scalar_t(i % 5);
+
+  auto check = [&](const csr5Mat_t &C, scalar_t alpha, scalar_t beta) {
+    EXPECT_EQ(C.numRows(), numRows);
+    EXPECT_EQ(C.numCols(), numCols);
+    EXPECT_EQ(C.nnz(), A.nnz());
+    Kokkos::deep_copy(y_ref, h_y0);
+    Kokkos::deep_copy(y, h_y0);
+    KokkosSparse::spmv("N", alpha, A, x, beta, y_ref);
+    KokkosSparse::Experimental::spmv("N", alpha, C, x, beta, y);
+    auto h_y_ref =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), y_ref);
+    auto h_y = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), y);
+    // the entries are summed in a different order
+    const mag_t tol = 10 * Kokkos::ArithTraits<mag_t>::epsilon() *
+                      (maxLength + 1) * (maxValue * 12 + 10);
+    for (lno_t i = 0; i < numRows; i++) {
+      EXPECT_NEAR(h_y_ref(i), h_y(i), tol) << "row " << i;
+    }
+  };
+
+  csr5Mat_t C(A);
+  check(C, scalar_t(1), scalar_t(0));
+  check(C, scalar_t(2), scalar_t(-1));
+  for (int lanes : {1, 4}) {
+    for (int seg_length : {1, 3, 16}) {
+      csr5Mat_t D(A, lanes, seg_length);
+      EXPECT_EQ(D.numSegments(),
+                (size_type(numRows) + A.nnz() + seg_length - 1) / seg_length);
+      check(D, scalar_t(2), scalar_t(-1));
+    }
+  }
+
+  // new values, same pattern
+  Kokkos::deep_copy(A.values, scalar_t(-1));
+  maxValue = 1;
+  C.update_values(A);
+  check(C, scalar_t(1), scalar_t(0));
+}
+
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void run_test_csr5_matrix(lno_t numRows, lno_t numCols, size_type nnz,
+                          lno_t row_size_variance) {
+  using crsMat_t =
+      KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  crsMat_t A = KokkosSparse::Impl::kk_generate_sparse_matrix<crsMat_t>(
+      numRows, numCols, nnz, row_size_variance, numCols);
+  check_csr5_matrix(A);
+}
+
+// Empty rows, and a row much longer than the segments.
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void run_test_csr5_matrix_empty_rows() {
+  using crsMat_t =
+      KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  const lno_t numRows = 50, numCols = 200;
+  typename crsMat_t::row_map_type::non_const_type rowmap("rowmap",
+                                                         numRows + 1);
+  auto h_rowmap = Kokkos::create_mirror_view(rowmap);
+  h_rowmap(0)   = 0;
+  for (lno_t i = 0; i < numRows; i++) {
+    lno_t length = (i % 3 == 0) ? 0 : 1 + i % 4;
+    if (i == 20) length = numCols;
+    h_rowmap(i + 1) = h_rowmap(i) + length;
+  }
+  const size_type nnz = h_rowmap(numRows);
+  typename crsMat_t::index_type::non_const_type entries("entries", nnz);
+  typename crsMat_t::values_type::non_const_type values("values", nnz);
+  auto h_entries = Kokkos::create_mirror_view(entries);
+  auto h_values  = Kokkos::create_mirror_view(values);
+  for (lno_t i = 0; i < numRows; i++) {
+    for (size_type k = h_rowmap(i); k < h_rowmap(i + 1); k++) {
+      h_entries(k) = (i + 7 * (k - h_rowmap(i))) % numCols;
+      h_values(k)  = scalar_t(1 + (k % 9));
+    }
+  }
+  Kokkos::deep_copy(rowmap, h_rowmap);
+  Kokkos::deep_copy(entries, h_entries);
+  Kokkos::deep_copy(values, h_values);
+  crsMat_t A("A", numRows, numCols, nnz, values, rowmap, entries);
+  check_csr5_matrix(A);
+}
+
+}  // namespace Test
+
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void test_csr5_matrix() {
+  Test::run_test_csr5_matrix<scalar_t, lno_t, size_type, device>(1, 1, 1, 0);
+  Test::run_test_csr5_matrix<scalar_t, lno_t, size_type, device>(100, 100,
+                                                                  500, 4);
+  Test::run_test_csr5_matrix<scalar_t, lno_t, size_type, device>(2000, 1500,
+                                                                  20000, 80);
+  Test::run_test_csr5_matrix_empty_rows<scalar_t, lno_t, size_type, device>();
+}
+
+#define KOKKOSKERNELS_EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE)          \
+  TEST_F(TestCategory,                                                       \
+         sparse##_##csr5_matrix##_##SCALAR##_##ORDINAL##_##OFFSET##_##DEVICE) { \
+    test_csr5_matrix<SCALAR, ORDINAL, OFFSET, DEVICE>();                     \
+  }
+
+#define NO_TEST_COMPLEX
+
+#include <Test_Common_Test_All_Type_Combos.hpp>
+
+#undef KOKKOSKERNELS_EXECUTE_TEST
+#undef NO_TEST_COMPLEX
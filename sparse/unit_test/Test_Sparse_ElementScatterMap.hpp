@@ -0,0 +1,163 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <vector>
+
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_ElementScatterMap.hpp"
+
+namespace Test {
+
+// Bilinear quadrilaterals on a nx x ny grid: the matrix has the 9-point
+// stencil pattern, each element matrix is summed with sumIntoValues as a
+// reference.
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void run_test_element_scatter_map(lno_t nx, lno_t ny) {
+  using crsMat_t =
+      KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  using host_crsMat_t = typename crsMat_t::HostMirror;
+  const lno_t num_nodes = (nx + 1) * (ny + 1);
+  const lno_t num_elems = nx * ny;
+
+  // 9-point stencil pattern
+  std::vector<size_type> rowmap(num_nodes + 1, 0);
+  std::vector<lno_t> entries;
+  for (lno_t j = 0; j <= ny; j++) {
+    for (lno_t i = 0; i <= nx; i++) {
+      for (lno_t dj = -1; dj <= 1; dj++) {
+        for (lno_t di = -1; di <= 1; di++) {
+          if (i + di < 0 || i + di > nx || j + dj < 0 || j + dj > ny) continue;
+          entries.push_back((j + dj) * (nx + 1) + i + di);
+        }
+      }
+      rowmap[j * (nx + 1) + i + 1] = entries.size();
+    }
+  }
+  typename crsMat_t::row_map_type::non_const_type d_rowmap("rowmap",
+                                                           num_nodes + 1);
+  typename crsMat_t::index_type::non_const_type d_entries("entries",
+                                                          entries.size());
+  typename crsMat_t::values_type::non_const_type d_values("values",
+                                                          entries.size());
+  auto h_rowmap  = Kokkos::create_mirror_view(d_rowmap);
+  auto h_entries = Kokkos::create_mirror_view(d_entries);
+  for (lno_t r = 0; r <= num_nodes; r++) h_rowmap(r) = rowmap[r];
+  for (size_t k = 0; k < entries.size(); k++) h_entries(k) = entries[k];
+  Kokkos::deep_copy(d_rowmap, h_rowmap);
+  Kokkos::deep_copy(d_entries, h_entries);
+  crsMat_t A("A", num_nodes, num_nodes, entries.size(), d_values, d_rowmap,
+             d_entries);
+
+  Kokkos::View<lno_t **, device> elem_nodes("elem_nodes", num_elems, 4);
+  Kokkos::View<scalar_t ***, device> elem_mats("elem_mats", num_elems, 4, 4);
+  auto h_elem_nodes = Kokkos::create_mirror_view(elem_nodes);
+  auto h_elem_mats  = Kokkos::create_mirror_view(elem_mats);
+  for (lno_t j = 0; j < ny; j++) {
+    for (lno_t i = 0; i < nx; i++) {
+      const lno_t e      = j * nx + i;
+      h_elem_nodes(e, 0) = j * (nx + 1) + i;
+      h_elem_nodes(e, 1) = j * (nx + 1) + i + 1;
+      h_elem_nodes(e, 2) = (j + 1) * (nx + 1) + i + 1;
+      h_elem_nodes(e, 3) = (j + 1) * (nx + 1) + i;
+      for (int a = 0; a < 4; a++) {
+        for (int b = 0; b < 4; b++) {
+          h_elem_mats(e, a, b) = scalar_t((e % 7) + 4 * a + b);
+        }
+      }
+    }
+  }
+  Kokkos::deep_copy(elem_nodes, h_elem_nodes);
+  Kokkos::deep_copy(elem_mats, h_elem_mats);
+
+  // reference
+  host_crsMat_t R("R", num_nodes, num_nodes, entries.size(),
+                  typename host_crsMat_t::values_type::non_const_type(
+                      "R values", entries.size()),
+                  h_rowmap, h_entries);
+  for (lno_t e = 0; e < num_elems; e++) {
+    for (int a = 0; a < 4; a++) {
+      lno_t cols[4];
+      scalar_t vals[4];
+      for (int b = 0; b < 4; b++) {
+        cols[b] = h_elem_nodes(e, b);
+        vals[b] = h_elem_mats(e, a, b);
+      }
+      R.sumIntoValues(h_elem_nodes(e, a), cols, 4, vals);
+    }
+  }
+  auto check = [&](scalar_t factor) {
+    auto h_values =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A.values);
+    for (size_t k = 0; k < entries.size(); k++) {
+      EXPECT_EQ(factor * R.values(k), h_values(k));
+    }
+  };
+
+  KokkosSparse::Experimental::ElementScatterMap<crsMat_t> map(A, elem_nodes);
+  EXPECT_EQ(map.get_num_missing(), 0u);
+  EXPECT_EQ(map.get_num_colors(), 1u);
+  map.assemble(elem_mats);
+  check(scalar_t(1));
+  map.assemble(elem_mats, true);
+  check(scalar_t(2));
+
+  map.color_elements();
+  if (num_elems > 1) EXPECT_GT(map.get_num_colors(), 1u);
+  map.assemble(elem_mats);
+  check(scalar_t(1));
+  map.assemble(elem_mats, true);
+  check(scalar_t(2));
+
+  // a coupling that is not in the pattern
+  if (nx > 2) {
+    h_elem_nodes(0, 1) = 3;
+    Kokkos::deep_copy(elem_nodes, h_elem_nodes);
+    KokkosSparse::Experimental::ElementScatterMap<crsMat_t> map2(A,
+                                                                 elem_nodes);
+    // node 3 is not a neighbor of the nodes 0, nx + 1 and nx + 2
+    EXPECT_EQ(map2.get_num_missing(), 6u);
+  }
+}
+
+}  // namespace Test
+
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void test_element_scatter_map() {
+  Test::run_test_element_scatter_map<scalar_t, lno_t, size_type, device>(1, 1);
+  Test::run_test_element_scatter_map<scalar_t, lno_t, size_type, device>(10,
+                                                                          7);
+  Test::run_test_element_scatter_map<scalar_t, lno_t, size_type, device>(100,
+                                                                          80);
+}
+
+#define KOKKOSKERNELS_EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE)        \
+  TEST_F(                                                                  \
+      TestCategory,                                                        \
+      sparse##_##element_scatter_map##_##SCALAR##_##ORDINAL##_##OFFSET##_##DEVICE) { \
+    test_element_scatter_map<SCALAR, ORDINAL, OFFSET, DEVICE>();           \
+  }
+
+#define NO_TEST_COMPLEX
+
+#include <Test_Common_Test_All_Type_Combos.hpp>
+
+#undef KOKKOSKERNELS_EXECUTE_TEST
+#undef NO_TEST_COMPLEX
@@ -0,0 +1,132 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_HybMatrix.hpp"
+#include "KokkosSparse_IOUtils.hpp"
+#include "KokkosSparse_spmv.hpp"
+
+namespace Test {
+
+// Compares the Hyb spmv with the CRS spmv, for the automatic ELL width and
+// for the extreme widths (everything in COO, everything in ELL).
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void run_test_hyb_matrix(lno_t numRows, lno_t numCols, size_type nnz,
+                         lno_t row_size_variance) {
+  using crsMat_t =
+      KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  using hybMat_t =
+      KokkosSparse::Experimental::HybMatrix<scalar_t, lno_t, device,
+                                            size_type>;
+  using vector_t = Kokkos::View<scalar_t *, device>;
+  using mag_t    = typename Kokkos::ArithTraits<scalar_t>::mag_type;
+
+  crsMat_t A = KokkosSparse::Impl::kk_generate_sparse_matrix<crsMat_t>(
+      numRows, numCols, nnz, row_size_variance, numCols);
+  auto h_rowmap = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                      A.graph.row_map);
+  auto h_values =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A.values);
+  lno_t maxLength = 0;
+  mag_t maxValue  = 0;
+  for (lno_t i = 0; i < numRows; i++) {
+    maxLength = std::max<lno_t>(maxLength, h_rowmap(i + 1) - h_rowmap(i));
+  }
+  for (size_t k = 0; k < h_values.extent(0); k++) {
+    maxValue =
+        std::max(maxValue, Kokkos::ArithTraits<scalar_t>::abs(h_values(k)));
+  }
+
+  vector_t x("x", numCols), y_ref("y_ref", numRows), y("y", numRows);
+  auto h_x = Kokkos::create_mirror_view(x);
+  for (lno_t j = 0; j < numCols; j++) h_x(j) = scalar_t((j % 13) - 6);
+  Kokkos::deep_copy(x, h_x);
+  auto h_y0 = Kokkos::create_mirror_view(y);
+  for (lno_t i = 0; i < numRows; i++) h_y0(i) = scalar_t(i % 5);
+
+  auto check = [&](const hybMat_t &H, scalar_t alpha, scalar_t beta) {
+    EXPECT_EQ(H.numRows(), numRows);
+    EXPECT_EQ(H.numCols(), numCols);
+    EXPECT_EQ(H.nnz(), A.nnz());
+    Kokkos::deep_copy(y_ref, h_y0);
+    Kokkos::deep_copy(y, h_y0);
+    KokkosSparse::spmv("N", alpha, A, x, beta, y_ref);
+    KokkosSparse::Experimental::spmv("N", alpha, H, x, beta, y);
+    auto h_y_ref =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), y_ref);
+    auto h_y = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), y);
+    // the entries are summed in a different order
+    const mag_t tol = 10 * Kokkos::ArithTraits<mag_t>::epsilon() *
+                      (maxLength + 1) * (maxValue * 12 + 10);
+    for (lno_t i = 0; i < numRows; i++) {
+      EXPECT_NEAR(h_y_ref(i), h_y(i), tol) << "row " << i;
+    }
+  };
+
+  hybMat_t H(A);
+  EXPECT_LE(H.ellWidth(), maxLength);
+  size_t cooNnz = 0;
+  for (lno_t i = 0; i < numRows; i++) {
+    const lno_t length = h_rowmap(i + 1) - h_rowmap(i);
+    if (length > H.ellWidth()) cooNnz += length - H.ellWidth();
+  }
+  EXPECT_EQ(size_t(H.cooNnz()), cooNnz);
+  check(H, scalar_t(1), scalar_t(0));
+  check(H, scalar_t(2), scalar_t(-1));
+
+  hybMat_t H_coo(A, 0);
+  EXPECT_EQ(H_coo.ellWidth(), 0);
+  EXPECT_EQ(H_coo.cooNnz(), A.nnz());
+  check(H_coo, scalar_t(1), scalar_t(0));
+  check(H_coo, scalar_t(2), scalar_t(-1));
+
+  hybMat_t H_ell(A, maxLength);
+  EXPECT_EQ(H_ell.cooNnz(), 0u);
+  check(H_ell, scalar_t(1), scalar_t(0));
+  check(H_ell, scalar_t(2), scalar_t(-1));
+}
+
+}  // namespace Test
+
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void test_hyb_matrix() {
+  Test::run_test_hyb_matrix<scalar_t, lno_t, size_type, device>(1, 1, 1, 0);
+  Test::run_test_hyb_matrix<scalar_t, lno_t, size_type, device>(100, 100, 500,
+                                                                 4);
+  // a few rows are much longer than the others
+  Test::run_test_hyb_matrix<scalar_t, lno_t, size_type, device>(2000, 1500,
+                                                                 20000, 80);
+}
+
+#define KOKKOSKERNELS_EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE)         \
+  TEST_F(TestCategory,                                                      \
+         sparse##_##hyb_matrix##_##SCALAR##_##ORDINAL##_##OFFSET##_##DEVICE) { \
+    test_hyb_matrix<SCALAR, ORDINAL, OFFSET, DEVICE>();                     \
+  }
+
+#define NO_TEST_COMPLEX
+
+#include <Test_Common_Test_All_Type_Combos.hpp>
+
+#undef KOKKOSKERNELS_EXECUTE_TEST
+#undef NO_TEST_COMPLEX
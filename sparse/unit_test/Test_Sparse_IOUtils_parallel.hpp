@@ -0,0 +1,332 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Random.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_IOUtils.hpp"
+#include "KokkosSparse_IOUtils_parallel.hpp"
+#include "KokkosSparse_spmv.hpp"
+
+namespace Test {
+
+inline void write_test_mtx(const std::string &filename,
+                           const std::string &contents) {
+  std::ofstream out(filename);
+  out << contents;
+}
+
+// Compares A with a dense, row-major matrix
+template <typename crsMat_t>
+void check_mtx_dense(const crsMat_t &A, int nrows, int ncols,
+                     const std::vector<double> &dense) {
+  using size_type = typename crsMat_t::non_const_size_type;
+  using lno_t     = typename crsMat_t::non_const_ordinal_type;
+  ASSERT_EQ(A.numRows(), nrows);
+  ASSERT_EQ(A.numCols(), ncols);
+  auto rowmap =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A.graph.row_map);
+  auto entries =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A.graph.entries);
+  auto values =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A.values);
+  std::vector<double> A_dense(nrows * ncols, 0.0);
+  size_type nnz = 0;
+  for (lno_t i = 0; i < nrows; i++) {
+    for (size_type k = rowmap(i); k < rowmap(i + 1); k++) {
+      // rows are sorted, without duplicates
+      if (k > rowmap(i)) EXPECT_LT(entries(k - 1), entries(k));
+      A_dense[i * ncols + entries(k)] = values(k);
+      nnz++;
+    }
+  }
+  EXPECT_EQ(nnz, A.nnz());
+  for (int k = 0; k < nrows * ncols; k++) {
+    EXPECT_EQ(A_dense[k], dense[k]) << "at " << k / ncols << ", " << k % ncols;
+  }
+}
+
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void run_test_read_mtx_parallel_small() {
+  using crsMat_t =
+      KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  const std::string filename = "kk_test_read_mtx_parallel.mtx";
+
+  // symmetric, with comments and blank lines
+  write_test_mtx(filename,
+                 "%%MatrixMarket matrix coordinate real symmetric\n"
+                 "% a comment\n"
+                 "%\n"
+                 "3 3 4\n"
+                 "1 1 4.0\n"
+                 "\n"
+                 "2 1 -1.5e0\n"
+                 "% another comment\n"
+                 "3 2 2\n"
+                 "3 3 1.0\n");
+  check_mtx_dense(KokkosSparse::Impl::read_mtx_parallel<crsMat_t>(
+                      filename.c_str()),
+                  3, 3, {4, -1.5, 0, -1.5, 0, 2, 0, 2, 1});
+
+  // skew-symmetric
+  write_test_mtx(filename,
+                 "%%MatrixMarket matrix coordinate real skew-symmetric\n"
+                 "2 2 1\n"
+                 "2 1 3\n");
+  check_mtx_dense(KokkosSparse::Impl::read_mtx_parallel<crsMat_t>(
+                      filename.c_str()),
+                  2, 2, {0, -3, 3, 0});
+
+  // pattern, rectangular, duplicates are summed
+  write_test_mtx(filename,
+                 "%%MatrixMarket matrix coordinate pattern general\n"
+                 "2 3 4\n"
+                 "1 3\n"
+                 "2 1\n"
+                 "1 3\n"
+                 "1 1\n");
+  check_mtx_dense(KokkosSparse::Impl::read_mtx_parallel<crsMat_t>(
+                      filename.c_str()),
+                  2, 3, {1, 0, 2, 1, 0, 0});
+
+  // array format is column major
+  write_test_mtx(filename,
+                 "%%MatrixMarket matrix array real general\n"
+                 "2 3\n"
+                 "1\n2\n3\n4\n5\n6\n");
+  check_mtx_dense(KokkosSparse::Impl::read_mtx_parallel<crsMat_t>(
+                      filename.c_str()),
+                  2, 3, {1, 3, 5, 2, 4, 6});
+
+  // errors
+  write_test_mtx(filename,
+                 "%%MatrixMarket matrix coordinate real general\n"
+                 "2 2 3\n"
+                 "1 1 1\n"
+                 "2 2 1\n");
+  EXPECT_THROW(
+      KokkosSparse::Impl::read_mtx_parallel<crsMat_t>(filename.c_str()),
+      std::runtime_error);
+  write_test_mtx(filename,
+                 "%%MatrixMarket matrix coordinate real general\n"
+                 "2 2 2\n"
+                 "1 1 1\n"
+                 "3 2 1\n");
+  EXPECT_THROW(
+      KokkosSparse::Impl::read_mtx_parallel<crsMat_t>(filename.c_str()),
+      std::runtime_error);
+  write_test_mtx(filename,
+                 "%%MatrixMarket matrix coordinate real general\n"
+                 "2 2 2\n"
+                 "1 1 1\n"
+                 "2 2 x\n");
+  EXPECT_THROW(
+      KokkosSparse::Impl::read_mtx_parallel<crsMat_t>(filename.c_str()),
+      std::runtime_error);
+  std::remove(filename.c_str());
+}
+
+// A file large enough to be split into several chunks, compared with the
+// serial reader through a product with a random vector
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void run_test_read_mtx_parallel_large(lno_t numRows, size_type nnz,
+                                      lno_t bandwidth,
+                                      lno_t row_size_variance) {
+  using crsMat_t =
+      KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  using vector_t  = Kokkos::View<scalar_t *, device>;
+  using exe_space = typename device::execution_space;
+  using mag_t     = typename Kokkos::ArithTraits<scalar_t>::mag_type;
+  const std::string filename = "kk_test_read_mtx_parallel_large.mtx";
+
+  crsMat_t A = KokkosSparse::Impl::kk_generate_sparse_matrix<crsMat_t>(
+      numRows, numRows, nnz, row_size_variance, bandwidth);
+  KokkosSparse::Impl::write_kokkos_crst_matrix(A, filename.c_str());
+
+  crsMat_t B =
+      KokkosSparse::Impl::read_kokkos_crst_matrix<crsMat_t>(filename.c_str());
+  crsMat_t C =
+      KokkosSparse::Impl::read_mtx_parallel<crsMat_t>(filename.c_str());
+  std::remove(filename.c_str());
+  EXPECT_EQ(C.numRows(), B.numRows());
+  EXPECT_EQ(C.numCols(), B.numCols());
+
+  vector_t x("x", numRows), yB("yB", numRows), yC("yC", numRows);
+  Kokkos::Random_XorShift64_Pool<exe_space> rand_pool(13718);
+  Kokkos::fill_random(x, rand_pool, scalar_t(1));
+  KokkosSparse::spmv("N", scalar_t(1), B, x, scalar_t(0), yB);
+  KokkosSparse::spmv("N", scalar_t(1), C, x, scalar_t(0), yC);
+  auto yB_h = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), yB);
+  auto yC_h = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), yC);
+  const mag_t tol = 1e3 * Kokkos::ArithTraits<mag_t>::eps();
+  for (lno_t i = 0; i < numRows; i++) {
+    EXPECT_NEAR(Kokkos::ArithTraits<scalar_t>::abs(yB_h(i) - yC_h(i)), 0,
+                tol * (1 + Kokkos::ArithTraits<scalar_t>::abs(yB_h(i))));
+  }
+}
+
+// Few entries per row but many columns, with duplicates: the assembly must
+// not depend on the number of columns
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void run_test_read_mtx_parallel_wide(lno_t numRows, lno_t numCols,
+                                     int entriesPerRow) {
+  using crsMat_t =
+      KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  const std::string filename = "kk_test_read_mtx_parallel_wide.mtx";
+
+  std::mt19937 rng(numCols);
+  std::vector<std::map<lno_t, double>> expected(numRows);
+  std::ostringstream contents;
+  contents << "%%MatrixMarket matrix coordinate integer general\n";
+  contents << numRows << " " << numCols << " " << numRows * entriesPerRow
+           << '\n';
+  for (lno_t i = 0; i < numRows; i++) {
+    lno_t j = 0;
+    for (int k = 0; k < entriesPerRow; k++) {
+      // every other entry repeats the previous column
+      if (k % 2 == 0) j = rng() % numCols;
+      const int v = 1 + k;
+      expected[i][j] += v;
+      contents << i + 1 << " " << j + 1 << " " << v << '\n';
+    }
+  }
+  write_test_mtx(filename, contents.str());
+  crsMat_t A =
+      KokkosSparse::Impl::read_mtx_parallel<crsMat_t>(filename.c_str());
+  std::remove(filename.c_str());
+  ASSERT_EQ(A.numRows(), numRows);
+  ASSERT_EQ(A.numCols(), numCols);
+  auto rowmap =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A.graph.row_map);
+  auto entries =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A.graph.entries);
+  auto values =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A.values);
+  for (lno_t i = 0; i < numRows; i++) {
+    ASSERT_EQ(size_t(rowmap(i + 1) - rowmap(i)), expected[i].size());
+    size_type k = rowmap(i);
+    for (const auto &entry : expected[i]) {
+      EXPECT_EQ(entries(k), entry.first) << "row " << i;
+      EXPECT_EQ(values(k), scalar_t(entry.second)) << "row " << i;
+      k++;
+    }
+  }
+}
+
+// The parallel writers produce exactly the output of the former serial
+// ostream loops
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void run_test_write_parallel(lno_t numRows, size_type nnz, lno_t bandwidth,
+                             lno_t row_size_variance) {
+  using crsMat_t =
+      KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  const std::string mtx_filename = "kk_test_write_parallel.mtx";
+  const std::string bin_filename = "kk_test_write_parallel.bin";
+
+  crsMat_t A = KokkosSparse::Impl::kk_generate_sparse_matrix<crsMat_t>(
+      numRows, numRows, nnz, row_size_variance, bandwidth);
+  auto rowmap =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A.graph.row_map);
+  auto entries =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A.graph.entries);
+  auto values =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A.values);
+
+  std::ostringstream expected;
+  expected << "%%MatrixMarket matrix coordinate real general\n";
+  expected << numRows << " " << numRows << " " << A.nnz() << '\n';
+  expected << std::setprecision(17) << std::scientific;
+  for (lno_t i = 0; i < numRows; ++i) {
+    for (size_type j = rowmap(i); j < rowmap(i + 1); ++j) {
+      expected << i + 1 << " " << entries(j) + 1 << " ";
+      KokkosSparse::Impl::MM::writeScalar<scalar_t>(expected, values(j));
+      expected << '\n';
+    }
+  }
+  KokkosSparse::Impl::write_kokkos_crst_matrix(A, mtx_filename.c_str());
+  {
+    std::ifstream in(mtx_filename, std::ios::in | std::ios::binary);
+    std::stringstream written;
+    written << in.rdbuf();
+    EXPECT_TRUE(written.str() == expected.str());
+  }
+  std::remove(mtx_filename.c_str());
+
+  // the binary file holds the header and the three arrays, in order
+  KokkosSparse::Impl::write_kokkos_crst_matrix(A, bin_filename.c_str());
+  lno_t nv;
+  size_type ne, *xadj;
+  lno_t *adj;
+  scalar_t *ew;
+  KokkosSparse::Impl::read_graph_bin(&nv, &ne, &xadj, &adj, &ew,
+                                     bin_filename.c_str());
+  std::remove(bin_filename.c_str());
+  ASSERT_EQ(nv, numRows);
+  ASSERT_EQ(ne, A.nnz());
+  for (lno_t i = 0; i <= nv; i++) EXPECT_EQ(xadj[i], rowmap(i));
+  for (size_type j = 0; j < ne; j++) {
+    EXPECT_EQ(adj[j], entries(j));
+    EXPECT_EQ(ew[j], values(j));
+  }
+  delete[] xadj;
+  delete[] adj;
+  delete[] ew;
+}
+
+}  // namespace Test
+
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void test_read_mtx_parallel() {
+  Test::run_test_read_mtx_parallel_small<scalar_t, lno_t, size_type, device>();
+  Test::run_test_read_mtx_parallel_large<scalar_t, lno_t, size_type, device>(
+      20000, 20000 * 15, 2000, 10);
+  Test::run_test_read_mtx_parallel_wide<scalar_t, lno_t, size_type, device>(
+      200, 50000000, 4);
+  Test::run_test_write_parallel<scalar_t, lno_t, size_type, device>(
+      20000, 20000 * 15, 2000, 10);
+  Test::run_test_write_parallel<scalar_t, lno_t, size_type, device>(10, 30, 5,
+                                                                    2);
+}
+
+#define KOKKOSKERNELS_EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE)       \
+  TEST_F(                                                                 \
+      TestCategory,                                                       \
+      sparse##_##read_mtx_parallel##_##SCALAR##_##ORDINAL##_##OFFSET##_##DEVICE) { \
+    test_read_mtx_parallel<SCALAR, ORDINAL, OFFSET, DEVICE>();            \
+  }
+
+#define NO_TEST_COMPLEX
+
+#include <Test_Common_Test_All_Type_Combos.hpp>
+
+#undef KOKKOSKERNELS_EXECUTE_TEST
+#undef NO_TEST_COMPLEX
@@ -31,6 +31,7 @@
 #include <Kokkos_ArithTraits.hpp>
 #include <Kokkos_Complex.hpp>
 #include <cstdlib>
+#include <random>
 
 namespace SortCrsTest {
 enum : int {
@@ -499,6 +500,75 @@ void testSortAndMerge(bool justGraph, int howExecSpecified,
   }
 }
 
+// Power-law like row lengths: mostly short rows, some medium rows, and a few
+// rows long enough to be sorted by the whole device. Some rows of every kind
+// are already sorted. value(i, j) = i + 2 j, so that the permutation of the
+// values can be checked.
+template <typename device_t>
+void testSortCRSPowerLaw(bool doValues) {
+  using scalar_t  = default_scalar;
+  using lno_t     = default_lno_t;
+  using size_type = default_size_type;
+  using crsMat_t =
+      KokkosSparse::CrsMatrix<scalar_t, lno_t, device_t, void, size_type>;
+  const lno_t numRows = 3000;
+  const lno_t numCols = 200000;
+  std::mt19937 gen(4242);
+  std::vector<size_type> rowmap(numRows + 1, 0);
+  std::vector<lno_t> entries;
+  for (lno_t i = 0; i < numRows; i++) {
+    lno_t length = gen() % 12;
+    if (i % 10 == 0) length = 20 + gen() % 500;
+    if (i == 7 || i == 100 || i == 1500) length = 150000;
+    // distinct columns: one in each of length buckets
+    std::vector<lno_t> row(length);
+    for (lno_t j = 0; j < length; j++) {
+      lno_t bucket = numCols / length;
+      row[j]       = j * bucket + gen() % bucket;
+    }
+    if (i % 3 != 0) std::shuffle(row.begin(), row.end(), gen);
+    entries.insert(entries.end(), row.begin(), row.end());
+    rowmap[i + 1] = entries.size();
+  }
+  crsMat_t A("A", numRows, numCols, entries.size(),
+             typename crsMat_t::values_type::non_const_type("values",
+                                                            entries.size()),
+             typename crsMat_t::row_map_type::non_const_type("rowmap",
+                                                             numRows + 1),
+             typename crsMat_t::index_type::non_const_type("entries",
+                                                           entries.size()));
+  auto rowmapHost  = Kokkos::create_mirror_view(A.graph.row_map);
+  auto entriesHost = Kokkos::create_mirror_view(A.graph.entries);
+  auto valuesHost  = Kokkos::create_mirror_view(A.values);
+  for (lno_t i = 0; i <= numRows; i++) rowmapHost(i) = rowmap[i];
+  for (lno_t i = 0; i < numRows; i++) {
+    for (size_type k = rowmap[i]; k < rowmap[i + 1]; k++) {
+      entriesHost(k) = entries[k];
+      valuesHost(k)  = scalar_t(i + 2 * entries[k]);
+    }
+  }
+  Kokkos::deep_copy(A.graph.row_map, rowmapHost);
+  Kokkos::deep_copy(A.graph.entries, entriesHost);
+  Kokkos::deep_copy(A.values, valuesHost);
+  if (doValues)
+    KokkosSparse::sort_crs_matrix(A);
+  else
+    KokkosSparse::sort_crs_graph(A.graph);
+  Kokkos::deep_copy(entriesHost, A.graph.entries);
+  Kokkos::deep_copy(valuesHost, A.values);
+  for (lno_t i = 0; i < numRows; i++) {
+    std::vector<lno_t> gold(entries.begin() + rowmap[i],
+                            entries.begin() + rowmap[i + 1]);
+    std::sort(gold.begin(), gold.end());
+    for (size_type k = rowmap[i]; k < rowmap[i + 1]; k++) {
+      ASSERT_EQ(gold[k - rowmap[i]], entriesHost(k)) << "row " << i;
+      if (doValues) {
+        ASSERT_EQ(scalar_t(i + 2 * entriesHost(k)), valuesHost(k));
+      }
+    }
+  }
+}
+
 TEST_F(TestCategory, common_sort_crsgraph) {
   for (int doStructInterface = 0; doStructInterface < 2; doStructInterface++) {
     for (int howExecSpecified = 0; howExecSpecified < 3; howExecSpecified++) {
@@ -545,6 +615,11 @@ TEST_F(TestCategory, common_sort_crs_longrows) {
                           SortCrsTest::ImplicitType);
 }
 
+TEST_F(TestCategory, common_sort_crs_powerlaw) {
+  testSortCRSPowerLaw<TestDevice>(false);
+  testSortCRSPowerLaw<TestDevice>(true);
+}
+
 TEST_F(TestCategory, common_sort_merge_crsmatrix) {
   for (int testCase = 0; testCase < 5; testCase++) {
     for (int doStructInterface = 0; doStructInterface < 2;
@@ -0,0 +1,226 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_VbrMatrix.hpp"
+#include "KokkosSparse_IOUtils.hpp"
+#include "KokkosSparse_spmv.hpp"
+
+namespace Test {
+
+// Compares the VbrMatrix spmv with the CRS spmv.
+template <typename crsMat_t, typename vbrMat_t>
+void check_vbr_spmv(const crsMat_t &A, const vbrMat_t &V) {
+  using scalar_t = typename crsMat_t::non_const_value_type;
+  using lno_t    = typename crsMat_t::non_const_ordinal_type;
+  using device   = typename crsMat_t::device_type;
+  using vector_t = Kokkos::View<scalar_t *, device>;
+  using mag_t    = typename Kokkos::ArithTraits<scalar_t>::mag_type;
+  const lno_t numRows = A.numRows();
+  const lno_t numCols = A.numCols();
+  EXPECT_EQ(V.numRows(), numRows);
+  EXPECT_EQ(V.numCols(), numCols);
+
+  auto h_rowmap = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                      A.graph.row_map);
+  auto h_values =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A.values);
+  lno_t maxLength = 0;
+  mag_t maxValue  = 0;
+  for (lno_t i = 0; i < numRows; i++) {
+    maxLength = std::max<lno_t>(maxLength, h_rowmap(i + 1) - h_rowmap(i));
+  }
+  for (size_t k = 0; k < h_values.extent(0); k++) {
+    maxValue =
+        std::max(maxValue, Kokkos::ArithTraits<scalar_t>::abs(h_values(k)));
+  }
+  // every entry is in a block, and the blocks hold no more than their size
+  auto h_offsets = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                       V.block_offsets);
+  EXPECT_EQ(size_t(h_offsets(V.nnz())), V.values.extent(0));
+  EXPECT_GE(V.values.extent(0), size_t(A.nnz()));
+
+  vector_t x("x", numCols), y_ref("y_ref", numRows), y("y", numRows);
+  auto h_x = Kokkos::create_mirror_view(x);
+  for (lno_t j = 0; j < numCols; j++) h_x(j) = scalar_t((j % 13) - 6);
+  Kokkos::deep_copy(x, h_x);
+  auto h_y0 = Kokkos::create_mirror_view(y);
+  for (lno_t i = 0; i < numRows; i++) h_y0(i) = scalar_t(i % 5);
+
+  for (scalar_t beta : {scalar_t(0), scalar_t(-1)}) {
+    Kokkos::deep_copy(y_ref, h_y0);
+    Kokkos::deep_copy(y, h_y0);
+    KokkosSparse::spmv("N", scalar_t(2), A, x, beta, y_ref);
+    KokkosSparse::Experimental::spmv("N", scalar_t(2), V, x, beta, y);
+    auto h_y_ref =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), y_ref);
+    auto h_y = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), y);
+    // the entries are summed in a different order
+    const mag_t tol = 10 * Kokkos::ArithTraits<mag_t>::epsilon() *
+                      (maxLength + 1) * (maxValue * 12 + 10);
+    for (lno_t i = 0; i < numRows; i++) {
+      EXPECT_NEAR(h_y_ref(i), h_y(i), tol) << "row " << i;
+    }
+  }
+}
+
+// A nodal matrix whose nodes have 1, 3, 6 or 9 unknowns; node i is coupled
+// with the nodes i - 1, i + 1 and i + 7 (modulo the number of nodes).
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void run_test_vbr_matrix_nodal(lno_t numNodes) {
+  using crsMat_t =
+      KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  using vbrMat_t =
+      KokkosSparse::Experimental::VbrMatrix<scalar_t, lno_t, device,
+                                            size_type>;
+  using part_t = typename vbrMat_t::partition_type;
+
+  std::vector<lno_t> nodeBegin(numNodes + 1, 0);
+  for (lno_t n = 0; n < numNodes; n++) {
+    const lno_t dofs[] = {1, 3, 6, 9};
+    nodeBegin[n + 1]   = nodeBegin[n] + dofs[n % 4];
+  }
+  const lno_t numRows = nodeBegin[numNodes];
+  std::vector<lno_t> h_entries;
+  std::vector<size_type> h_rowmap(1, 0);
+  for (lno_t n = 0; n < numNodes; n++) {
+    std::vector<lno_t> nodes = {n, (n + 1) % numNodes,
+                                (n + numNodes - 1) % numNodes,
+                                (n + 7) % numNodes};
+    std::sort(nodes.begin(), nodes.end());
+    nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+    for (lno_t i = nodeBegin[n]; i < nodeBegin[n + 1]; i++) {
+      for (lno_t m : nodes) {
+        // unsorted within the row
+        for (lno_t j = nodeBegin[m + 1] - 1; j >= nodeBegin[m]; j--) {
+          h_entries.push_back(j);
+        }
+      }
+      h_rowmap.push_back(h_entries.size());
+    }
+  }
+  const size_type nnz = h_entries.size();
+  typename crsMat_t::row_map_type::non_const_type rowmap("rowmap",
+                                                         numRows + 1);
+  typename crsMat_t::index_type::non_const_type entries("entries", nnz);
+  typename crsMat_t::values_type::non_const_type values("values", nnz);
+  auto hv_rowmap  = Kokkos::create_mirror_view(rowmap);
+  auto hv_entries = Kokkos::create_mirror_view(entries);
+  auto hv_values  = Kokkos::create_mirror_view(values);
+  for (lno_t i = 0; i <= numRows; i++) hv_rowmap(i) = h_rowmap[i];
+  for (size_type k = 0; k < nnz; k++) {
+    hv_entries(k) = h_entries[k];
+    hv_values(k)  = scalar_t(1 + (k % 7));
+  }
+  Kokkos::deep_copy(rowmap, hv_rowmap);
+  Kokkos::deep_copy(entries, hv_entries);
+  Kokkos::deep_copy(values, hv_values);
+  crsMat_t A("A", numRows, numRows, nnz, values, rowmap, entries);
+
+  // the detected partition: the nodes, split in blocks of at most maxBlock
+  for (lno_t maxBlock : {6, 16}) {
+    std::vector<lno_t> expected;
+    for (lno_t n = 0; n < numNodes; n++) {
+      for (lno_t i = nodeBegin[n]; i < nodeBegin[n + 1]; i += maxBlock) {
+        expected.push_back(i);
+      }
+    }
+    expected.push_back(numRows);
+    vbrMat_t V(A, maxBlock);
+    auto h_part =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), V.row_part);
+    ASSERT_EQ(h_part.extent(0), expected.size());
+    for (size_t I = 0; I < expected.size(); I++) {
+      EXPECT_EQ(h_part(I), expected[I]) << "block row " << I;
+    }
+    EXPECT_EQ(V.numBlockCols(), V.numBlockRows());
+    // the blocks of the nodes are dense
+    EXPECT_EQ(V.values.extent(0), size_t(nnz));
+    check_vbr_spmv(A, V);
+  }
+
+  // given partitions: the nodes for the rows, pairs of columns
+  part_t rowPart("rowPart", numNodes + 1);
+  part_t colPart("colPart", (numRows + 1) / 2 + 1);
+  auto h_rowPart = Kokkos::create_mirror_view(rowPart);
+  auto h_colPart = Kokkos::create_mirror_view(colPart);
+  for (lno_t n = 0; n <= numNodes; n++) h_rowPart(n) = nodeBegin[n];
+  for (lno_t J = 0; J < lno_t(colPart.extent(0)); J++) {
+    h_colPart(J) = std::min(2 * J, numRows);
+  }
+  Kokkos::deep_copy(rowPart, h_rowPart);
+  Kokkos::deep_copy(colPart, h_colPart);
+  vbrMat_t W(A, rowPart, colPart);
+  EXPECT_EQ(W.numBlockRows(), numNodes);
+  check_vbr_spmv(A, W);
+
+  // invalid partitions: too short, not increasing
+  part_t shortPart =
+      Kokkos::subview(rowPart, std::make_pair(lno_t(0), numNodes));
+  EXPECT_THROW(vbrMat_t V(A, shortPart, colPart), std::invalid_argument);
+  Kokkos::deep_copy(Kokkos::subview(rowPart, 1), nodeBegin[2]);
+  EXPECT_THROW(vbrMat_t V(A, rowPart, colPart), std::invalid_argument);
+}
+
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void run_test_vbr_matrix_random(lno_t numRows, lno_t numCols, size_type nnz,
+                                lno_t row_size_variance) {
+  using crsMat_t =
+      KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  using vbrMat_t =
+      KokkosSparse::Experimental::VbrMatrix<scalar_t, lno_t, device,
+                                            size_type>;
+  crsMat_t A = KokkosSparse::Impl::kk_generate_sparse_matrix<crsMat_t>(
+      numRows, numCols, nnz, row_size_variance, numCols);
+  vbrMat_t V(A);
+  EXPECT_EQ(V.numBlockCols(), numRows == numCols ? V.numBlockRows() : numCols);
+  check_vbr_spmv(A, V);
+}
+
+}  // namespace Test
+
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void test_vbr_matrix() {
+  Test::run_test_vbr_matrix_nodal<scalar_t, lno_t, size_type, device>(40);
+  Test::run_test_vbr_matrix_random<scalar_t, lno_t, size_type, device>(
+      1, 1, 1, 0);
+  Test::run_test_vbr_matrix_random<scalar_t, lno_t, size_type, device>(
+      500, 300, 4000, 20);
+}
+
+#define KOKKOSKERNELS_EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE)          \
+  TEST_F(TestCategory,                                                       \
+         sparse##_##vbr_matrix##_##SCALAR##_##ORDINAL##_##OFFSET##_##DEVICE) { \
+    test_vbr_matrix<SCALAR, ORDINAL, OFFSET, DEVICE>();                      \
+  }
+
+#define NO_TEST_COMPLEX
+
+#include <Test_Common_Test_All_Type_Combos.hpp>
+
+#undef KOKKOSKERNELS_EXECUTE_TEST
+#undef NO_TEST_COMPLEX
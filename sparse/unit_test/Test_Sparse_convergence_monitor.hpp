@@ -0,0 +1,223 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_ConvergenceMonitor.hpp"
+#include "KokkosSparse_gauss_seidel.hpp"
+#include "KokkosSparse_par_ilut.hpp"
+#include "KokkosSparse_gmres.hpp"
+#include "KokkosSparse_spmv.hpp"
+#include "KokkosBlas1_nrm2.hpp"
+#include "KokkosBlas1_axpby.hpp"
+#include "KokkosKernels_Test_Structured_Matrix.hpp"
+
+namespace Test {
+
+template <typename mag_t>
+void run_test_convergence_monitor_logic() {
+  using monitor_t = KokkosSparse::Experimental::ConvergenceMonitor<mag_t>;
+  using Status    = typename monitor_t::Status;
+
+  {
+    monitor_t monitor(0.01, 10, 4);
+    EXPECT_EQ(monitor.get_status(), Status::NotStarted);
+    EXPECT_EQ(monitor.start(1), Status::Running);
+    EXPECT_EQ(monitor.iterations_until_check(0), 4);
+    EXPECT_EQ(monitor.iterations_until_check(8), 2);
+    EXPECT_FALSE(monitor.check_now(3));
+    EXPECT_TRUE(monitor.check_now(4));
+    EXPECT_TRUE(monitor.check_now(10));
+    EXPECT_EQ(monitor.update(4, 0.5), Status::Running);
+    EXPECT_EQ(monitor.update(8, 0.005), Status::Converged);
+    EXPECT_TRUE(monitor.done());
+    EXPECT_EQ(monitor.get_num_iters(), 8);
+    EXPECT_EQ(monitor.get_history().size(), size_t(3));
+    EXPECT_EQ(monitor.get_final_residual(), mag_t(0.005));
+  }
+  {
+    // less than 10% reduction over 2 checks
+    monitor_t monitor(1e-6, 100, 1);
+    monitor.set_stagnation(2, 0.1);
+    monitor.start(1);
+    EXPECT_EQ(monitor.update(1, 0.5), Status::Running);
+    EXPECT_EQ(monitor.update(2, 0.48), Status::Running);
+    EXPECT_EQ(monitor.update(3, 0.47), Status::Stagnated);
+  }
+  {
+    monitor_t monitor(1e-6, 3, 2);
+    monitor.start(1);
+    EXPECT_EQ(monitor.update(2, 0.5), Status::Running);
+    EXPECT_EQ(monitor.iterations_until_check(2), 1);
+    EXPECT_EQ(monitor.update(3, 0.25), Status::MaxIterations);
+  }
+  {
+    monitor_t monitor(1e-6, 3, 1);
+    monitor.set_abs_tol(0.1);
+    EXPECT_EQ(monitor.start(0.05), Status::Converged);
+  }
+}
+
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void run_test_convergence_monitor_gauss_seidel() {
+  using exe_space = typename device::execution_space;
+  using mem_space = typename device::memory_space;
+  using crsMat_t =
+      KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  using KernelHandle = KokkosKernels::Experimental::KokkosKernelsHandle<
+      size_type, lno_t, scalar_t, exe_space, mem_space, mem_space>;
+  using mag_t    = typename Kokkos::ArithTraits<scalar_t>::mag_type;
+  using vector_t = Kokkos::View<scalar_t *, device>;
+  using Status =
+      typename KokkosSparse::Experimental::ConvergenceMonitor<mag_t>::Status;
+
+  Kokkos::View<lno_t * [3], Kokkos::HostSpace> mat_structure("Matrix Structure",
+                                                             2);
+  mat_structure(0, 0) = 10;
+  mat_structure(1, 0) = 10;
+  auto A = Test::generate_structured_matrix2D<crsMat_t>("FD", mat_structure);
+  const lno_t n = A.numRows();
+
+  vector_t x("x", n), y("y", n), Ax("Ax", n);
+  Kokkos::deep_copy(y, scalar_t(1));
+
+  KernelHandle kh;
+  kh.create_gs_handle(KokkosSparse::GS_DEFAULT);
+  KokkosSparse::Experimental::gauss_seidel_symbolic(
+      &kh, n, n, A.graph.row_map, A.graph.entries, true);
+  KokkosSparse::Experimental::gauss_seidel_numeric(
+      &kh, n, n, A.graph.row_map, A.graph.entries, A.values, true);
+
+  KokkosSparse::Experimental::ConvergenceMonitor<mag_t> monitor(1e-4, 2000, 4);
+  const int iters = KokkosSparse::Experimental::symmetric_gauss_seidel_apply(
+      &kh, n, n, A.graph.row_map, A.graph.entries, A.values, x, y, true, true,
+      scalar_t(1), monitor);
+
+  EXPECT_EQ(monitor.get_status(), Status::Converged);
+  EXPECT_EQ(iters, monitor.get_num_iters());
+  EXPECT_LT(iters, 2000);
+  EXPECT_EQ(iters % 4, 0);
+  EXPECT_EQ(monitor.get_history().size(), size_t(iters / 4 + 1));
+
+  // The fused residual matches y - A x computed with spmv
+  KokkosSparse::spmv("N", scalar_t(1), A, x, scalar_t(0), Ax);
+  KokkosBlas::axpby(scalar_t(1), y, scalar_t(-1), Ax);
+  const mag_t res = KokkosBlas::nrm2(Ax);
+  EXPECT_NEAR(res, monitor.get_final_residual(),
+              10 * Kokkos::ArithTraits<mag_t>::eps() * n *
+                  monitor.get_initial_residual());
+  EXPECT_LE(res, 1.01 * monitor.tolerance());
+
+  kh.destroy_gs_handle();
+}
+
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void run_test_convergence_monitor_par_ilut_gmres() {
+  using exe_space = typename device::execution_space;
+  using mem_space = typename device::memory_space;
+  using sp_matrix_type =
+      KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  using KernelHandle = KokkosKernels::Experimental::KokkosKernelsHandle<
+      size_type, lno_t, scalar_t, exe_space, mem_space, mem_space>;
+  using mag_t = typename Kokkos::ArithTraits<scalar_t>::mag_type;
+  using monitor_t = KokkosSparse::Experimental::ConvergenceMonitor<mag_t>;
+  using RowMapType  = Kokkos::View<size_type *, device>;
+  using EntriesType = Kokkos::View<lno_t *, device>;
+  using ValuesType  = Kokkos::View<scalar_t *, device>;
+
+  Kokkos::View<lno_t * [3], Kokkos::HostSpace> mat_structure("Matrix Structure",
+                                                             2);
+  mat_structure(0, 0) = 20;
+  mat_structure(1, 0) = 20;
+  auto A =
+      Test::generate_structured_matrix2D<sp_matrix_type>("FD", mat_structure);
+  const lno_t n = A.numRows();
+
+  KernelHandle kh;
+
+  // par_ilut: the residual is only computed every other iteration
+  kh.create_par_ilut_handle(20);
+  auto par_ilut_handle = kh.get_par_ilut_handle();
+  monitor_t ilut_monitor(1e-2, 20, 2);
+  par_ilut_handle->set_convergence_monitor(&ilut_monitor);
+
+  RowMapType L_row_map("L_row_map", n + 1);
+  RowMapType U_row_map("U_row_map", n + 1);
+  KokkosSparse::Experimental::par_ilut_symbolic(
+      &kh, A.graph.row_map, A.graph.entries, L_row_map, U_row_map);
+  EntriesType L_entries("L_entries", par_ilut_handle->get_nnzL());
+  ValuesType L_values("L_values", par_ilut_handle->get_nnzL());
+  EntriesType U_entries("U_entries", par_ilut_handle->get_nnzU());
+  ValuesType U_values("U_values", par_ilut_handle->get_nnzU());
+  KokkosSparse::Experimental::par_ilut_numeric(
+      &kh, A.graph.row_map, A.graph.entries, A.values, L_row_map, L_entries,
+      L_values, U_row_map, U_entries, U_values);
+
+  EXPECT_TRUE(ilut_monitor.done());
+  EXPECT_EQ(ilut_monitor.get_num_iters(), par_ilut_handle->get_num_iters());
+  EXPECT_EQ(ilut_monitor.get_num_iters() % 2, 0);
+  for (const auto &record : ilut_monitor.get_history()) {
+    EXPECT_EQ(record.iteration % 2, 0);
+  }
+
+  // gmres: one record per iteration
+  kh.create_gmres_handle(50, 1e-5);
+  auto gmres_handle = kh.get_gmres_handle();
+  using GMRESHandle =
+      typename std::remove_reference<decltype(*gmres_handle)>::type;
+  monitor_t gmres_monitor(0, 1000, 1);
+  gmres_handle->set_convergence_monitor(&gmres_monitor);
+
+  ValuesType X("X", n), B("B", n);
+  Kokkos::deep_copy(B, scalar_t(1));
+  KokkosSparse::Experimental::gmres(&kh, A, B, X);
+
+  EXPECT_EQ(gmres_handle->get_conv_flag_val(), GMRESHandle::Flag::Conv);
+  EXPECT_EQ(gmres_monitor.get_num_iters(), gmres_handle->get_num_iters());
+  EXPECT_EQ(gmres_monitor.get_history().size(),
+            size_t(gmres_handle->get_num_iters() + 1));
+}
+
+}  // namespace Test
+
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void test_convergence_monitor() {
+  using mag_t = typename Kokkos::ArithTraits<scalar_t>::mag_type;
+  Test::run_test_convergence_monitor_logic<mag_t>();
+  Test::run_test_convergence_monitor_gauss_seidel<scalar_t, lno_t, size_type,
+                                                  device>();
+  Test::run_test_convergence_monitor_par_ilut_gmres<scalar_t, lno_t, size_type,
+                                                    device>();
+}
+
+#define KOKKOSKERNELS_EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE)       \
+  TEST_F(                                                                 \
+      TestCategory,                                                       \
+      sparse##_##convergence_monitor##_##SCALAR##_##ORDINAL##_##OFFSET##_##DEVICE) { \
+    test_convergence_monitor<SCALAR, ORDINAL, OFFSET, DEVICE>();          \
+  }
+
+#define NO_TEST_COMPLEX
+
+#include <Test_Common_Test_All_Type_Combos.hpp>
+
+#undef KOKKOSKERNELS_EXECUTE_TEST
+#undef NO_TEST_COMPLEX
@@ -0,0 +1,159 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "KokkosSparse_BsrMatrix.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_IOUtils.hpp"
+#include "KokkosSparse_crs_to_bsr.hpp"
+
+namespace Test {
+
+// Compares the device conversion with the BsrMatrix constructor.
+template <typename bsrMat_t, typename crsMat_t>
+void check_crs_to_bsr(const bsrMat_t &B, const crsMat_t &A, int blockSize) {
+  bsrMat_t R(A, blockSize);
+  ASSERT_EQ(B.blockDim(), blockSize);
+  ASSERT_EQ(B.numRows(), R.numRows());
+  ASSERT_EQ(B.numCols(), R.numCols());
+  ASSERT_EQ(B.nnz(), R.nnz());
+  auto to_host = [](const auto &v) {
+    return Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), v);
+  };
+  auto rowmap   = to_host(B.graph.row_map);
+  auto entries  = to_host(B.graph.entries);
+  auto values   = to_host(B.values);
+  auto rrowmap  = to_host(R.graph.row_map);
+  auto rentries = to_host(R.graph.entries);
+  auto rvalues  = to_host(R.values);
+  for (size_t i = 0; i < rrowmap.extent(0); i++) {
+    EXPECT_EQ(rowmap(i), rrowmap(i));
+  }
+  for (size_t k = 0; k < rentries.extent(0); k++) {
+    EXPECT_EQ(entries(k), rentries(k));
+  }
+  for (size_t k = 0; k < rentries.extent(0) * blockSize * blockSize; k++) {
+    EXPECT_EQ(values(k), rvalues(k));
+  }
+}
+
+// A matrix made of dense 3 x 3 blocks, with shuffled rows.
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void run_test_crs_to_bsr(lno_t numBlockRows, size_type numBlocks) {
+  using crsMat_t =
+      KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  using bsrMat_t =
+      KokkosSparse::Experimental::BsrMatrix<scalar_t, lno_t, device, void,
+                                            size_type>;
+  constexpr lno_t b = 3;
+
+  crsMat_t P = KokkosSparse::Impl::kk_generate_sparse_matrix<crsMat_t>(
+      numBlockRows, numBlockRows, numBlocks, 2, numBlockRows);
+  auto prowmap = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                     P.graph.row_map);
+  auto pentries = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                      P.graph.entries);
+  const lno_t numRows = numBlockRows * b;
+  const size_type nnz = P.nnz() * b * b;
+  typename crsMat_t::row_map_type::non_const_type rowmap("rowmap",
+                                                         numRows + 1);
+  typename crsMat_t::index_type::non_const_type entries("entries", nnz);
+  typename crsMat_t::values_type::non_const_type values("values", nnz);
+  auto h_rowmap  = Kokkos::create_mirror_view(rowmap);
+  auto h_entries = Kokkos::create_mirror_view(entries);
+  auto h_values  = Kokkos::create_mirror_view(values);
+  size_type k    = 0;
+  h_rowmap(0)    = 0;
+  for (lno_t ib = 0; ib < numBlockRows; ib++) {
+    for (lno_t r = 0; r < b; r++) {
+      const size_type rowBegin = k;
+      for (size_type pk = prowmap(ib); pk < prowmap(ib + 1); pk++) {
+        for (lno_t c = 0; c < b; c++) {
+          h_entries(k) = pentries(pk) * b + c;
+          h_values(k)  = scalar_t(1 + (k % 11));
+          k++;
+        }
+      }
+      // unsorted rows
+      std::reverse(h_entries.data() + rowBegin, h_entries.data() + k);
+      h_rowmap(ib * b + r + 1) = k;
+    }
+  }
+  Kokkos::deep_copy(rowmap, h_rowmap);
+  Kokkos::deep_copy(entries, h_entries);
+  Kokkos::deep_copy(values, h_values);
+  crsMat_t A("A", numRows, numRows, nnz, values, rowmap, entries);
+
+  EXPECT_EQ(KokkosSparse::Impl::detect_block_size(A), size_t(b));
+  EXPECT_EQ(KokkosSparse::bsr_fill_ratio(A, 1), 1.0);
+  EXPECT_EQ(KokkosSparse::bsr_fill_ratio(A, b), 1.0);
+  EXPECT_TRUE(std::isinf(KokkosSparse::bsr_fill_ratio(A, numRows + 1)));
+  auto ratios = KokkosSparse::bsr_fill_ratios(A, std::vector<lno_t>{b, 2 * b});
+  ASSERT_EQ(ratios.size(), 2u);
+  EXPECT_EQ(ratios[0], 1.0);
+  EXPECT_GE(ratios[1], 1.0);
+
+  check_crs_to_bsr(KokkosSparse::crs_to_bsr<bsrMat_t>(A, b), A, b);
+  check_crs_to_bsr(KokkosSparse::crs_to_bsr<bsrMat_t>(A, 1), A, 1);
+  EXPECT_THROW(KokkosSparse::crs_to_bsr<bsrMat_t>(A, numRows + 1),
+               std::invalid_argument);
+
+  // no padding accepted: the dense block size
+  std::vector<std::pair<lno_t, double>> report;
+  bsrMat_t B = KokkosSparse::crs_to_bsr_auto<bsrMat_t>(A, 1.0, 16, &report);
+  EXPECT_EQ(B.blockDim(), b);
+  ASSERT_EQ(report.size(), 1u);
+  EXPECT_EQ(report[0].first, b);
+  // any padding accepted: the largest block size dividing the dimensions
+  lno_t largest = b;
+  for (lno_t s = b + 1; s <= 2 * b; s++) {
+    if (numRows % s == 0) largest = s;
+  }
+  B = KokkosSparse::crs_to_bsr_auto<bsrMat_t>(A, 1e9, 2 * b, &report);
+  EXPECT_EQ(B.blockDim(), largest);
+  EXPECT_GE(report.size(), 2u);
+  check_crs_to_bsr(B, A, largest);
+}
+
+}  // namespace Test
+
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void test_crs_to_bsr() {
+  Test::run_test_crs_to_bsr<scalar_t, lno_t, size_type, device>(2, 3);
+  Test::run_test_crs_to_bsr<scalar_t, lno_t, size_type, device>(50, 300);
+  Test::run_test_crs_to_bsr<scalar_t, lno_t, size_type, device>(400, 4000);
+}
+
+#define KOKKOSKERNELS_EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE)         \
+  TEST_F(TestCategory,                                                      \
+         sparse##_##crs_to_bsr##_##SCALAR##_##ORDINAL##_##OFFSET##_##DEVICE) { \
+    test_crs_to_bsr<SCALAR, ORDINAL, OFFSET, DEVICE>();                     \
+  }
+
+#define NO_TEST_COMPLEX
+
+#include <Test_Common_Test_All_Type_Combos.hpp>
+
+#undef KOKKOSKERNELS_EXECUTE_TEST
+#undef NO_TEST_COMPLEX
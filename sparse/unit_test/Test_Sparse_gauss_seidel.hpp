@@ -280,6 +280,43 @@ void test_gauss_seidel_rank1(lno_t numRows, size_type nnz, lno_t bandwidth,
     mag_t result_norm_res = KokkosBlas::nrm2(x_vector);
     EXPECT_LT(result_norm_res, initial_norm_res);
   }
+  //*** Two-stage version (fused inner sweeps) ****
+  // the fused kernel should match the unfused one up to rounding
+  {
+    typedef KokkosKernelsHandle<
+        size_type, lno_t, scalar_t, typename device::execution_space,
+        typename device::memory_space, typename device::memory_space>
+        KernelHandle;
+    scalar_t omega(0.9);
+    scalar_view_t x_ref(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "x ref"), nv);
+    mag_t tol = 1000 * Kokkos::ArithTraits<mag_t>::epsilon() * initial_norm_res;
+    for (int compact_form = 0; compact_form < 2; compact_form++) {
+      for (int apply_type = 0; apply_type < apply_count; ++apply_type) {
+        for (int fused = 0; fused < 2; fused++) {
+          Kokkos::deep_copy(x_vector, zero);
+          KernelHandle kh;
+          kh.create_gs_handle(GS_TWOSTAGE);
+          kh.set_gs_set_num_inner_sweeps(2);
+          kh.set_gs_twostage_compact_form(compact_form);
+          kh.set_gs_twostage_fused_sweeps(fused, fused ? 64 : 0);
+          run_gauss_seidel(kh, input_mat, x_vector, y_vector, symmetric, omega,
+                           apply_type);
+          kh.destroy_gs_handle();
+          if (!fused) {
+            Kokkos::deep_copy(x_ref, x_vector);
+          } else {
+            // x_ref = x_vector - x_ref
+            KokkosBlas::axpby(one, x_vector, -one, x_ref);
+            EXPECT_LE(KokkosBlas::nrm2(x_ref), tol);
+          }
+          KokkosBlas::axpby(one, solution_x, -one, x_vector);
+          mag_t result_norm_res = KokkosBlas::nrm2(x_vector);
+          EXPECT_LT(result_norm_res, initial_norm_res);
+        }
+      }
+    }
+  }
 }
 
 template <typename scalar_t, typename lno_t, typename size_type,
@@ -703,16 +740,20 @@ void test_gauss_seidel_custom_coloring(lno_t numRows, lno_t nnzPerRow) {
       typename device::memory_space, typename device::memory_space>
       KernelHandle;
 
-  KernelHandle kh;
-  kh.create_gs_handle(GS_DEFAULT, KokkosGraph::COLORING_VBBIT);
-  EXPECT_EQ(kh.get_point_gs_handle()->get_coloring_algorithm(),
-            KokkosGraph::COLORING_VBBIT);
-  // Reset x vector to 0
-  Kokkos::deep_copy(x_vector, scalar_t());
-  run_gauss_seidel(kh, input_mat, x_vector, y_vector, true, 0.9, 0);
-  KokkosBlas::axpby(one, solution_x, -one, x_vector);
-  mag_t result_norm_res = KokkosBlas::nrm2(x_vector);
-  EXPECT_LT(result_norm_res, 0.25 * initial_norm_res);
+  // also with the color set sizes rebalanced
+  for (bool balance : {false, true}) {
+    KernelHandle kh;
+    kh.create_gs_handle(GS_DEFAULT, KokkosGraph::COLORING_VBBIT);
+    EXPECT_EQ(kh.get_point_gs_handle()->get_coloring_algorithm(),
+              KokkosGraph::COLORING_VBBIT);
+    kh.get_point_gs_handle()->set_balance_colors(balance);
+    // Reset x vector to 0
+    Kokkos::deep_copy(x_vector, scalar_t());
+    run_gauss_seidel(kh, input_mat, x_vector, y_vector, true, 0.9, 0);
+    KokkosBlas::axpby(one, solution_x, -one, x_vector);
+    mag_t result_norm_res = KokkosBlas::nrm2(x_vector);
+    EXPECT_LT(result_norm_res, 0.25 * initial_norm_res);
+  }
 }
 
 template <typename scalar_t, typename lno_t, typename size_type,
@@ -28,6 +28,8 @@
 #include "KokkosSparse_spmv.hpp"
 #include "KokkosSparse_gmres.hpp"
 #include "KokkosSparse_MatrixPrec.hpp"
+#include "KokkosSparse_FSAIPrec.hpp"
+#include "KokkosKernels_Test_Structured_Matrix.hpp"
 
 #include <gtest/gtest.h>
 
@@ -156,12 +158,72 @@ void run_test_gmres() {
   }
 }
 
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void run_test_gmres_fsai() {
+  using exe_space = typename device::execution_space;
+  using mem_space = typename device::memory_space;
+  using sp_matrix_type =
+      KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  using KernelHandle = KokkosKernels::Experimental::KokkosKernelsHandle<
+      size_type, lno_t, scalar_t, exe_space, mem_space, mem_space>;
+  using float_t = typename Kokkos::ArithTraits<scalar_t>::mag_type;
+
+  // FSAI needs an SPD matrix: 2D Laplacian
+  constexpr auto m   = 50;
+  constexpr auto tol = TolMeta<float_t>::value;
+  constexpr lno_t nx = 40, ny = 40;
+  Kokkos::View<lno_t * [3], Kokkos::HostSpace> mat_structure("Matrix Structure",
+                                                             2);
+  mat_structure(0, 0) = nx;
+  mat_structure(1, 0) = ny;
+  auto A =
+      Test::generate_structured_matrix2D<sp_matrix_type>("FD", mat_structure);
+  const lno_t n = A.numRows();
+
+  KernelHandle kh;
+  kh.create_gmres_handle(m, tol);
+  auto gmres_handle = kh.get_gmres_handle();
+  using GMRESHandle =
+      typename std::remove_reference<decltype(*gmres_handle)>::type;
+  using ViewVectorType = typename GMRESHandle::nnz_value_view_t;
+
+  ViewVectorType X("X", n);
+  ViewVectorType Wj("Wj", n);
+  ViewVectorType B(Kokkos::view_alloc(Kokkos::WithoutInitializing, "B"), n);
+  Kokkos::deep_copy(B, 1.0);
+
+  gmres(&kh, A, B, X);
+  const int iters_noprec = gmres_handle->get_num_iters();
+
+  gmres_handle->reset_handle(m, tol);
+  KokkosSparse::Experimental::FSAIPrec<sp_matrix_type> myPrec(A);
+  myPrec.initialize();
+  myPrec.compute();
+  EXPECT_TRUE(myPrec.isComputed());
+  // G has the pattern of the lower triangle of A
+  EXPECT_EQ(myPrec.getG().nnz(), (A.nnz() + n) / 2);
+
+  Kokkos::deep_copy(X, 0.0);
+  gmres(&kh, A, B, X, &myPrec);
+
+  float_t nrmB = KokkosBlas::nrm2(B);
+  KokkosSparse::spmv("N", 1.0, A, X, 0.0, Wj);  // wj = Ax
+  KokkosBlas::axpy(-1.0, Wj, B);                // b = b-Ax.
+  float_t endRes = KokkosBlas::nrm2(B) / nrmB;
+
+  EXPECT_LT(endRes, gmres_handle->get_tol());
+  EXPECT_EQ(gmres_handle->get_conv_flag_val(), GMRESHandle::Flag::Conv);
+  EXPECT_LT(gmres_handle->get_num_iters(), iters_noprec);
+}
+
 }  // namespace Test
 
 template <typename scalar_t, typename lno_t, typename size_type,
           typename device>
 void test_gmres() {
   Test::run_test_gmres<scalar_t, lno_t, size_type, device>();
+  Test::run_test_gmres_fsai<scalar_t, lno_t, size_type, device>();
 }
 
 #define KOKKOSKERNELS_EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE)       \
@@ -15,6 +15,7 @@
 //@HEADER
 
 #include <gtest/gtest.h>
+#include <vector>
 #include <Kokkos_Core.hpp>
 #include "KokkosSparse_mdf.hpp"
 #include "KokkosSparse_CrsMatrix.hpp"
@@ -178,12 +179,137 @@ void run_test_mdf() {
   }
 }
 
+template <typename scalar_type, typename ordinal_type, typename size_type,
+          typename device>
+void run_test_mdf_parallel() {
+  using crs_matrix_type = KokkosSparse::CrsMatrix<scalar_type, ordinal_type,
+                                                  device, void, size_type>;
+  using crs_graph_type  = typename crs_matrix_type::StaticCrsGraphType;
+  using row_map_type    = typename crs_graph_type::row_map_type::non_const_type;
+  using col_ind_type    = typename crs_graph_type::entries_type::non_const_type;
+  using values_type     = typename crs_matrix_type::values_type::non_const_type;
+  using value_type      = typename crs_matrix_type::value_type;
+  using KAT             = Kokkos::ArithTraits<scalar_type>;
+
+  // 2D Laplacian on a 4x4 grid, see run_test_mdf
+  constexpr ordinal_type numRows  = 16;
+  constexpr size_type numNonZeros = 64;
+  row_map_type row_map("row map", numRows + 1);
+  col_ind_type col_ind("column indices", numNonZeros);
+  values_type values("values", numNonZeros);
+  auto row_map_h = Kokkos::create_mirror_view(row_map);
+  auto col_ind_h = Kokkos::create_mirror_view(col_ind);
+  auto values_h  = Kokkos::create_mirror_view(values);
+  size_type nnz  = 0;
+  for (ordinal_type i = 0; i < 4; ++i) {
+    for (ordinal_type j = 0; j < 4; ++j) {
+      const ordinal_type row = 4 * i + j;
+      row_map_h(row)         = nnz;
+      if (i > 0) {
+        col_ind_h(nnz)  = row - 4;
+        values_h(nnz++) = static_cast<value_type>(-1.0);
+      }
+      if (j > 0) {
+        col_ind_h(nnz)  = row - 1;
+        values_h(nnz++) = static_cast<value_type>(-1.0);
+      }
+      col_ind_h(nnz)  = row;
+      values_h(nnz++) = static_cast<value_type>(4.0);
+      if (j < 3) {
+        col_ind_h(nnz)  = row + 1;
+        values_h(nnz++) = static_cast<value_type>(-1.0);
+      }
+      if (i < 3) {
+        col_ind_h(nnz)  = row + 4;
+        values_h(nnz++) = static_cast<value_type>(-1.0);
+      }
+    }
+  }
+  row_map_h(numRows) = nnz;
+  Kokkos::deep_copy(row_map, row_map_h);
+  Kokkos::deep_copy(col_ind, col_ind_h);
+  Kokkos::deep_copy(values, values_h);
+
+  crs_matrix_type A = crs_matrix_type("A", numRows, numRows, numNonZeros,
+                                      values, row_map, col_ind);
+
+  KokkosSparse::Experimental::MDF_handle<crs_matrix_type> handle(A);
+  handle.set_verbosity(0);
+  handle.set_parallel_pivots(true);
+  KokkosSparse::Experimental::mdf_symbolic(A, handle);
+  KokkosSparse::Experimental::mdf_numeric(A, handle);
+
+  // The four corners are distance-2 independent and eliminated first
+  EXPECT_LT(handle.get_num_steps(), numRows);
+  auto permutation_h = Kokkos::create_mirror_view_and_copy(
+      Kokkos::HostSpace(), handle.get_permutation());
+  std::vector<int> seen(numRows, 0);
+  for (ordinal_type idx = 0; idx < numRows; ++idx) {
+    ASSERT_TRUE(permutation_h(idx) >= 0 && permutation_h(idx) < numRows);
+    seen[permutation_h(idx)]++;
+  }
+  for (ordinal_type idx = 0; idx < numRows; ++idx) {
+    EXPECT_EQ(seen[idx], 1) << "row " << idx << " is not pivoted exactly once";
+  }
+  const ordinal_type first_pivots[] = {0, 3, 12, 15};
+  for (ordinal_type idx = 0; idx < 4; ++idx) {
+    EXPECT_EQ(permutation_h(idx), first_pivots[idx]);
+  }
+
+  handle.sort_factors();
+  crs_matrix_type U = handle.getU();
+  crs_matrix_type L = handle.getL();
+  EXPECT_EQ(U.nnz(), 40);
+  EXPECT_EQ(L.nnz(), 40);
+
+  // Without fill, L*U matches the permuted A on the pattern of A
+  auto U_row_map = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                       U.graph.row_map);
+  auto U_entries = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                       U.graph.entries);
+  auto U_values =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), U.values);
+  auto L_row_map = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                       L.graph.row_map);
+  auto L_entries = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                       L.graph.entries);
+  auto L_values =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), L.values);
+  std::vector<scalar_type> Ld(numRows * numRows, KAT::zero());
+  std::vector<scalar_type> Ud(numRows * numRows, KAT::zero());
+  for (ordinal_type i = 0; i < numRows; ++i) {
+    for (size_type k = L_row_map(i); k < L_row_map(i + 1); ++k) {
+      Ld[i * numRows + L_entries(k)] = L_values(k);
+    }
+    for (size_type k = U_row_map(i); k < U_row_map(i + 1); ++k) {
+      Ud[i * numRows + U_entries(k)] = U_values(k);
+    }
+  }
+  std::vector<ordinal_type> permutation_inv(numRows);
+  for (ordinal_type idx = 0; idx < numRows; ++idx) {
+    permutation_inv[permutation_h(idx)] = idx;
+  }
+  for (ordinal_type row = 0; row < numRows; ++row) {
+    for (size_type k = row_map_h(row); k < row_map_h(row + 1); ++k) {
+      const ordinal_type i = permutation_inv[row];
+      const ordinal_type j = permutation_inv[col_ind_h(k)];
+      scalar_type LU       = KAT::zero();
+      for (ordinal_type p = 0; p < numRows; ++p) {
+        LU += Ld[i * numRows + p] * Ud[p * numRows + j];
+      }
+      EXPECT_NEAR_KK(values_h(k), LU, 100 * KAT::eps(),
+                     "(L*U)(i, j) differs from A(perm(i), perm(j))");
+    }
+  }
+}
+
 }  // namespace Test
 
 template <typename scalar_t, typename lno_t, typename size_type,
           typename device>
 void test_mdf() {
   Test::run_test_mdf<scalar_t, lno_t, size_type, device>();
+  Test::run_test_mdf_parallel<scalar_t, lno_t, size_type, device>();
 }
 
 #define KOKKOSKERNELS_EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE)     \
@@ -0,0 +1,280 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 4.0
+//       Copyright (2022) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Part of Kokkos, under the Apache License v2.0 with LLVM Exceptions.
+// See https://kokkos.org/LICENSE for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//@HEADER
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Random.hpp>
+
+#include <cstdio>
+#include <string>
+
+#include "KokkosKernels_Handle.hpp"
+#include "KokkosSparse_IOUtils.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_gauss_seidel.hpp"
+#include "KokkosSparse_sptrsv.hpp"
+#include "KokkosSparse_spiluk.hpp"
+#include "KokkosSparse_symbolic_io.hpp"
+
+namespace Test {
+
+// Saves the symbolic phase of point GS, restores it in a new handle, and
+// checks that both handles give the same result. Also checks that the file
+// is rejected for another graph.
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void run_test_gauss_seidel_symbolic_io(lno_t numRows, size_type nnz,
+                                       lno_t bandwidth,
+                                       lno_t row_size_variance) {
+  using namespace KokkosSparse;
+  using namespace KokkosSparse::Experimental;
+  using crsMat_t = CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  using vec_t    = typename crsMat_t::values_type::non_const_type;
+  using KernelHandle = KokkosKernels::Experimental::KokkosKernelsHandle<
+      size_type, lno_t, scalar_t, typename device::execution_space,
+      typename device::memory_space, typename device::memory_space>;
+  const std::string filename = "kk_test_gs_symbolic.bin";
+
+  crsMat_t A =
+      KokkosSparse::Impl::kk_generate_diagonally_dominant_sparse_matrix<
+          crsMat_t>(numRows, numRows, nnz, row_size_variance, bandwidth);
+  auto rowmap  = A.graph.row_map;
+  auto entries = A.graph.entries;
+  vec_t b("b", numRows);
+  Kokkos::Random_XorShift64_Pool<typename device::execution_space> rand_pool(
+      13718);
+  Kokkos::fill_random(b, rand_pool, scalar_t(10));
+  vec_t x_ref("x_ref", numRows);
+  vec_t x("x", numRows);
+
+  {
+    KernelHandle kh;
+    kh.create_gs_handle(GS_DEFAULT);
+    gauss_seidel_symbolic(&kh, numRows, numRows, rowmap, entries, false);
+    gauss_seidel_save_symbolic(&kh, filename, rowmap, entries);
+    gauss_seidel_numeric(&kh, numRows, numRows, rowmap, entries, A.values,
+                         false);
+    symmetric_gauss_seidel_apply(&kh, numRows, numRows, rowmap, entries,
+                                 A.values, x_ref, b, true, true, 1.0, 3);
+    kh.destroy_gs_handle();
+  }
+  {
+    KernelHandle kh;
+    kh.create_gs_handle(GS_DEFAULT);
+    EXPECT_TRUE(gauss_seidel_load_symbolic(&kh, filename, rowmap, entries));
+    EXPECT_EQ(kh.get_point_gs_handle()->is_symbolic_called(), true);
+    gauss_seidel_numeric(&kh, numRows, numRows, rowmap, entries, A.values,
+                         false);
+    symmetric_gauss_seidel_apply(&kh, numRows, numRows, rowmap, entries,
+                                 A.values, x, b, true, true, 1.0, 3);
+    kh.destroy_gs_handle();
+  }
+  auto h_x_ref =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), x_ref);
+  auto h_x = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), x);
+  for (lno_t i = 0; i < numRows; i++) {
+    EXPECT_EQ(h_x_ref(i), h_x(i));
+  }
+
+  // another graph with the same dimensions must not match
+  {
+    size_type nnz2 = nnz;
+    crsMat_t A2 =
+        KokkosSparse::Impl::kk_generate_diagonally_dominant_sparse_matrix<
+            crsMat_t>(numRows, numRows, nnz2, row_size_variance, bandwidth);
+    KernelHandle kh;
+    kh.create_gs_handle(GS_DEFAULT);
+    if (nnz2 == A.nnz()) {
+      EXPECT_FALSE(gauss_seidel_load_symbolic(&kh, filename, A2.graph.row_map,
+                                              A2.graph.entries));
+    }
+    EXPECT_FALSE(gauss_seidel_load_symbolic(&kh, "kk_test_missing.bin",
+                                            rowmap, entries));
+    kh.destroy_gs_handle();
+  }
+  std::remove(filename.c_str());
+}
+
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void run_test_sptrsv_symbolic_io(
+    KokkosSparse::Experimental::SPTRSVAlgorithm algo, lno_t numRows,
+    lno_t bandwidth, lno_t row_size_variance) {
+  using namespace KokkosSparse;
+  using namespace KokkosSparse::Experimental;
+  using crsMat_t = CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  using vec_t    = typename crsMat_t::values_type::non_const_type;
+  using KernelHandle = KokkosKernels::Experimental::KokkosKernelsHandle<
+      size_type, lno_t, scalar_t, typename device::execution_space,
+      typename device::memory_space, typename device::memory_space>;
+  const std::string filename = "kk_test_sptrsv_symbolic.bin";
+
+  size_type nnz = 0;
+  crsMat_t L =
+      KokkosSparse::Impl::kk_generate_triangular_sparse_matrix<crsMat_t>(
+          'L', numRows, numRows, nnz, row_size_variance, bandwidth);
+  auto rowmap  = L.graph.row_map;
+  auto entries = L.graph.entries;
+  vec_t b("b", numRows);
+  Kokkos::deep_copy(b, scalar_t(1));
+  vec_t x_ref("x_ref", numRows);
+  vec_t x("x", numRows);
+
+  {
+    KernelHandle kh;
+    kh.create_sptrsv_handle(algo, numRows, true);
+    sptrsv_symbolic(&kh, rowmap, entries);
+    sptrsv_save_symbolic(&kh, filename, rowmap, entries);
+    sptrsv_solve(&kh, rowmap, entries, L.values, b, x_ref);
+    kh.destroy_sptrsv_handle();
+  }
+  {
+    KernelHandle kh;
+    kh.create_sptrsv_handle(algo, numRows, true);
+    EXPECT_TRUE(sptrsv_load_symbolic(&kh, filename, rowmap, entries));
+    EXPECT_TRUE(kh.get_sptrsv_handle()->is_symbolic_complete());
+    sptrsv_solve(&kh, rowmap, entries, L.values, b, x);
+    kh.destroy_sptrsv_handle();
+  }
+  {
+    // the level schedule of L does not apply to an upper triangular solve
+    KernelHandle kh;
+    kh.create_sptrsv_handle(algo, numRows, false);
+    EXPECT_FALSE(sptrsv_load_symbolic(&kh, filename, rowmap, entries));
+    kh.destroy_sptrsv_handle();
+  }
+  auto h_x_ref =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), x_ref);
+  auto h_x = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), x);
+  for (lno_t i = 0; i < numRows; i++) {
+    EXPECT_EQ(h_x_ref(i), h_x(i));
+  }
+  std::remove(filename.c_str());
+}
+
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void run_test_spiluk_symbolic_io(
+    KokkosSparse::Experimental::SPILUKAlgorithm algo, lno_t numRows,
+    size_type nnz, lno_t bandwidth, lno_t row_size_variance) {
+  using namespace KokkosSparse;
+  using namespace KokkosSparse::Experimental;
+  using crsMat_t = CrsMatrix<scalar_t, lno_t, device, void, size_type>;
+  using RowMapType  = Kokkos::View<size_type *, device>;
+  using EntriesType = Kokkos::View<lno_t *, device>;
+  using ValuesType  = Kokkos::View<scalar_t *, device>;
+  using KernelHandle = KokkosKernels::Experimental::KokkosKernelsHandle<
+      size_type, lno_t, scalar_t, typename device::execution_space,
+      typename device::memory_space, typename device::memory_space>;
+  const std::string filename = "kk_test_spiluk_symbolic.bin";
+  const typename KernelHandle::const_nnz_lno_t fill_lev = 1;
+
+  crsMat_t A =
+      KokkosSparse::Impl::kk_generate_diagonally_dominant_sparse_matrix<
+          crsMat_t>(numRows, numRows, nnz, row_size_variance, bandwidth);
+  auto rowmap  = A.graph.row_map;
+  auto entries = A.graph.entries;
+  const size_type est_nnz = 4 * nnz;
+
+  // computes L and U values, with or without restoring the symbolic phase
+  auto factor = [&](bool load, ValuesType &L_values, ValuesType &U_values) {
+    KernelHandle kh;
+    kh.create_spiluk_handle(algo, numRows, est_nnz, est_nnz);
+    auto spiluk_handle = kh.get_spiluk_handle();
+    RowMapType L_rowmap("L_rowmap", numRows + 1);
+    EntriesType L_entries("L_entries", est_nnz);
+    RowMapType U_rowmap("U_rowmap", numRows + 1);
+    EntriesType U_entries("U_entries", est_nnz);
+    if (load) {
+      EXPECT_TRUE(spiluk_load_symbolic(&kh, filename, fill_lev, rowmap,
+                                       entries, L_rowmap, L_entries, U_rowmap,
+                                       U_entries));
+    } else {
+      spiluk_symbolic(&kh, fill_lev, rowmap, entries, L_rowmap, L_entries,
+                      U_rowmap, U_entries);
+      spiluk_save_symbolic(&kh, filename, fill_lev, rowmap, entries, L_rowmap,
+                           L_entries, U_rowmap, U_entries);
+    }
+    Kokkos::resize(L_entries, spiluk_handle->get_nnzL());
+    Kokkos::resize(U_entries, spiluk_handle->get_nnzU());
+    L_values = ValuesType("L_values", spiluk_handle->get_nnzL());
+    U_values = ValuesType("U_values", spiluk_handle->get_nnzU());
+    spiluk_numeric(&kh, fill_lev, rowmap, entries, A.values, L_rowmap,
+                   L_entries, L_values, U_rowmap, U_entries, U_values);
+    kh.destroy_spiluk_handle();
+  };
+
+  ValuesType L_ref, U_ref, L_values, U_values;
+  factor(false, L_ref, U_ref);
+  factor(true, L_values, U_values);
+  ASSERT_EQ(L_ref.extent(0), L_values.extent(0));
+  ASSERT_EQ(U_ref.extent(0), U_values.extent(0));
+  auto h_L_ref =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), L_ref);
+  auto h_L = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), L_values);
+  auto h_U_ref =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), U_ref);
+  auto h_U = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), U_values);
+  for (size_t i = 0; i < h_L.extent(0); i++) EXPECT_EQ(h_L_ref(i), h_L(i));
+  for (size_t i = 0; i < h_U.extent(0); i++) EXPECT_EQ(h_U_ref(i), h_U(i));
+
+  {
+    // another fill level must not match
+    KernelHandle kh;
+    kh.create_spiluk_handle(algo, numRows, est_nnz, est_nnz);
+    RowMapType L_rowmap("L_rowmap", numRows + 1);
+    EntriesType L_entries("L_entries", est_nnz);
+    RowMapType U_rowmap("U_rowmap", numRows + 1);
+    EntriesType U_entries("U_entries", est_nnz);
+    EXPECT_FALSE(spiluk_load_symbolic(&kh, filename, fill_lev + 1, rowmap,
+                                      entries, L_rowmap, L_entries, U_rowmap,
+                                      U_entries));
+    kh.destroy_spiluk_handle();
+  }
+  std::remove(filename.c_str());
+}
+
+}  // namespace Test
+
+template <typename scalar_t, typename lno_t, typename size_type,
+          typename device>
+void test_symbolic_io() {
+  using KokkosSparse::Experimental::SPILUKAlgorithm;
+  using KokkosSparse::Experimental::SPTRSVAlgorithm;
+  Test::run_test_gauss_seidel_symbolic_io<scalar_t, lno_t, size_type, device>(
+      1000, 1000 * 10, 100, 5);
+  Test::run_test_sptrsv_symbolic_io<scalar_t, lno_t, size_type, device>(
+      SPTRSVAlgorithm::SEQLVLSCHD_RP, 1000, 100, 5);
+  Test::run_test_sptrsv_symbolic_io<scalar_t, lno_t, size_type, device>(
+      SPTRSVAlgorithm::SEQLVLSCHD_TP1, 1000, 100, 5);
+  Test::run_test_spiluk_symbolic_io<scalar_t, lno_t, size_type, device>(
+      SPILUKAlgorithm::SEQLVLSCHD_RP, 500, 500 * 8, 50, 4);
+  Test::run_test_spiluk_symbolic_io<scalar_t, lno_t, size_type, device>(
+      SPILUKAlgorithm::SEQLVLSCHD_TP1, 500, 500 * 8, 50, 4);
+}
+
+#define KOKKOSKERNELS_EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+  TEST_F(TestCategory,                                              \
+         sparse##_##symbolic_io##_##SCALAR##_##ORDINAL##_##OFFSET##_##DEVICE) { \
+    test_symbolic_io<SCALAR, ORDINAL, OFFSET, DEVICE>();            \
+  }
+
+#define NO_TEST_COMPLEX
+
+#include <Test_Common_Test_All_Type_Combos.hpp>
+
+#undef KOKKOSKERNELS_EXECUTE_TEST
+#undef NO_TEST_COMPLEX